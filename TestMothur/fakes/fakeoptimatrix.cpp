@@ -28,10 +28,32 @@ FakeOptiMatrix::FakeOptiMatrix() : OptiData(0.03) {
             
             for (set<int>::iterator it = close.begin(); it != close.end(); it++) {
                 //add close sequences to each sequence in this set, do not include self
-                for (int j = 0; j < 10; j++) { if ((j+count) != *it) {   closeness[j+count].insert(*it);  } }
+                for (int j = 0; j < 10; j++) { if ((j+count) != *it) {   closeness.addPair(j+count, *it);  } }
             }
             count += 10;
         }
+        closeness.build();
+    }
+    catch(exception& e) {
+        m->errorOut(e, "FakeOptiMatrix", "FakeOptiMatrix");
+        exit(1);
+    }
+}
+/***********************************************************************/
+FakeOptiMatrix::FakeOptiMatrix(long long numSeqs, unsigned int seed) : OptiData(0.03) {
+    try {
+        m = MothurOut::getInstance();
+        
+        for (long long i = 0; i < numSeqs; i++) { nameMap.push_back(toString(i));  }
+        
+        closeness.resize(numSeqs);
+        for (long long i = 0; i < numSeqs; i++) {
+            for (long long j = i+1; j < min(i+9, numSeqs); j++) {
+                seed = seed * 1103515245 + 12345;
+                if (((seed >> 16) % 100) < 40) { closeness.addPair(i, j); closeness.addPair(j, i); }
+            }
+        }
+        closeness.build();
     }
     catch(exception& e) {
         m->errorOut(e, "FakeOptiMatrix", "FakeOptiMatrix");
@@ -39,4 +61,3 @@ FakeOptiMatrix::FakeOptiMatrix() : OptiData(0.03) {
     }
 }
 /***********************************************************************/
-
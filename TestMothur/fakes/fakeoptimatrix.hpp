@@ -15,6 +15,7 @@ class FakeOptiMatrix : public OptiData {
     
 public:
     FakeOptiMatrix(); 
+    FakeOptiMatrix(long long, unsigned int); //numSeqs, seed - each seq is close to some of the next 8, so the groups overlap
     ~FakeOptiMatrix(){ }
 };
 
@@ -0,0 +1,84 @@
+//
+//  testbandedneedleman.cpp
+//  Mothur
+//
+//  Created by agent on 10/18/26.
+//  Copyright © 2026 Schloss Lab. All rights reserved.
+//
+
+#include "testbandedneedleman.hpp"
+
+/**************************************************************************************************/
+TestBandedNeedleman::TestBandedNeedleman() {  //setup
+    seed = 11;
+}
+/**************************************************************************************************/
+string TestBandedNeedleman::getRandomSeq(int length) {
+    string bases = "ACGT"; string seq = "";
+    for (int i = 0; i < length; i++) {
+        seed = seed * 1103515245 + 12345;
+        seq += bases[(seed >> 16) % 4];
+    }
+    return seq;
+}
+/**************************************************************************************************/
+string TestBandedNeedleman::mutate(string seq, int every) {
+    string bases = "ACGT"; string mutated = "";
+    for (int i = 0; i < seq.length(); i++) {
+        if ((i % every) != (every-1)) { mutated += seq[i]; continue; }
+        
+        seed = seed * 1103515245 + 12345;
+        int change = (seed >> 16) % 3;
+        if (change == 0)        { mutated += bases[(seq[i] == 'A') ? 1 : 0];    } //substitution
+        else if (change == 1)   { mutated += seq[i]; mutated += 'T';            } //insertion
+    }
+    return mutated;
+}
+/**************************************************************************************************/
+string TestBandedNeedleman::dropBases(string seq, int keep, int drop) {
+    string dropped = "";
+    for (int i = 0; i < seq.length(); i++) { if ((i % (keep+drop)) < keep) { dropped += seq[i]; } }
+    return dropped;
+}
+/**************************************************************************************************/
+void TestBandedNeedleman::compare(string seqA, string seqB) {
+    int longest = max(seqA.length(), seqB.length()) + 1;
+    BandedNeedleman banded(-2.0, 1.0, -1.0, longest);
+    NeedlemanOverlap full(-2.0, 1.0, -1.0, longest);
+    
+    banded.align(seqA, seqB);
+    full.align(seqA, seqB);
+    
+    EXPECT_EQ(banded.getSeqAAln(), full.getSeqAAln());
+    EXPECT_EQ(banded.getSeqBAln(), full.getSeqBAln());
+    EXPECT_EQ(banded.getCandidateStartPos(), full.getCandidateStartPos());
+    EXPECT_EQ(banded.getCandidateEndPos(), full.getCandidateEndPos());
+    EXPECT_EQ(banded.getTemplateStartPos(), full.getTemplateStartPos());
+    EXPECT_EQ(banded.getTemplateEndPos(), full.getTemplateEndPos());
+}
+/**************************************************************************************************/
+
+TEST(Test_BandedNeedleman, matchesFull) {
+    TestBandedNeedleman test;
+    
+    string templateSeq = test.getRandomSeq(600);
+    test.compare(templateSeq, templateSeq);
+    test.compare(templateSeq, test.mutate(templateSeq, 15));
+    test.compare(templateSeq, test.mutate(templateSeq, 40).substr(50, 400)); //a read inside the template
+    test.compare(templateSeq.substr(100, 300), test.mutate(templateSeq, 25)); //the template inside the read
+    test.compare(templateSeq, test.getRandomSeq(500)); //unrelated, the band around the chance kmer matches misses the best end
+}
+/**************************************************************************************************/
+//2 bases are missing from every 12, so the alignment drifts 200 diagonals from where it starts. The band found from the
+//kmers covers about 110 of them, the path runs into its edge and the band is widened until the path fits
+TEST(Test_BandedNeedleman, pathLeavesBand) {
+    TestBandedNeedleman test;
+    
+    string templateSeq = test.getRandomSeq(1200);
+    string read = test.dropBases(templateSeq, 10, 2);
+    ASSERT_EQ(read.length(), 1000);
+    
+    test.compare(templateSeq, read);
+    test.compare(read, templateSeq);
+}
+/**************************************************************************************************/
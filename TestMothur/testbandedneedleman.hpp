@@ -0,0 +1,35 @@
+//
+//  testbandedneedleman.hpp
+//  Mothur
+//
+//  Created by agent on 10/18/26.
+//  Copyright © 2026 Schloss Lab. All rights reserved.
+//
+
+#ifndef testbandedneedleman_hpp
+#define testbandedneedleman_hpp
+
+#include "gtest/gtest.h"
+#include "bandedneedleman.hpp"
+#include "needlemanoverlap.hpp"
+
+//aligns the same pairs with BandedNeedleman and NeedlemanOverlap
+class TestBandedNeedleman {
+    
+public:
+    
+    TestBandedNeedleman();
+    ~TestBandedNeedleman() = default;
+    
+    string getRandomSeq(int);
+    string mutate(string, int); //seq, one substitution, insertion or deletion every n bases
+    string dropBases(string, int, int); //seq, keep, drop
+    
+    void compare(string, string); //seqA, seqB
+    
+private:
+    unsigned int seed;
+    
+};
+
+#endif /* testbandedneedleman_hpp */
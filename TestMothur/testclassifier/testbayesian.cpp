@@ -0,0 +1,188 @@
+//
+//  testbayesian.cpp
+//  Mothur
+//
+//  Created by agent on 10/18/26.
+//  Copyright © 2026 Schloss Lab. All rights reserved.
+//
+
+#include "testbayesian.hpp"
+
+/**************************************************************************************************/
+TestBayesian::TestBayesian() {  //setup
+    Utils util;
+    version = "1.48.0"; CurrentFile::getInstance()->setVersion(version); //tree.train is stamped with the current version
+    taxFile = "tempBayesian.tax"; templateFile = "tempBayesian.fasta";
+    probBinaryName = "tempBayesian.tempBayesian.8mer.prob.bin";
+    
+    string taxonomies[3] = { "Bacteria;Firmicutes;Clostridia;Blautia;", "Bacteria;Firmicutes;Clostridia;Anaerotruncus;", "Bacteria;Bacteroidetes;Bacteroidia;Bacteroides;" };
+    char bases[4] = { 'A', 'C', 'G', 'T' };
+    unsigned int state = 7;
+    
+    //each genus has a random sequence and a copy with every 25th base changed
+    ofstream outFasta, outTax;
+    util.openOutputFile(templateFile, outFasta); util.openOutputFile(taxFile, outTax);
+    for (int i = 0; i < 3; i++) {
+        string aligned = "";
+        for (int j = 0; j < 300; j++) { state = state * 1103515245 + 12345; aligned += bases[(state >> 16) % 4]; }
+        string mutated = aligned;
+        for (int j = 0; j < 300; j += 25) { mutated[j] = bases[(mutated[j] == 'A') ? 1 : 0]; }
+        
+        outFasta << ">seq" << (2*i) << endl << aligned << endl << ">seq" << (2*i+1) << endl << mutated << endl;
+        outTax << "seq" << (2*i) << '\t' << taxonomies[i] << endl << "seq" << (2*i+1) << '\t' << taxonomies[i] << endl;
+        
+        if (i == 1) { query.setName("query"); query.setAligned(aligned.substr(20, 250)); }
+    }
+    outFasta.close(); outTax.close();
+    
+    //the reference and every shortcut file made from it
+    outputFiles.push_back(taxFile); outputFiles.push_back(templateFile);
+    outputFiles.push_back("tempBayesian.tree.train"); outputFiles.push_back("tempBayesian.tree.sum");
+    outputFiles.push_back("tempBayesian.8mer"); outputFiles.push_back("tempBayesian.8mer.index");
+    outputFiles.push_back("tempBayesian.tempBayesian.8mer.prob"); outputFiles.push_back("tempBayesian.tempBayesian.8mer.numNonZero");
+    outputFiles.push_back(probBinaryName); outputFiles.push_back(probBinaryName + ".temp");
+}
+/**************************************************************************************************/
+TestBayesian::~TestBayesian() {
+    Utils util;
+    for (int i = 0; i < outputFiles.size(); i++) { util.mothurRemove(outputFiles[i]); }
+}
+/**************************************************************************************************/
+Bayesian* TestBayesian::getClassifier() {
+    return new Bayesian(taxFile, templateFile, "kmer", 8, 80, 100, 0, false, true, version);
+}
+/**************************************************************************************************/
+//the text .prob file rounds the table, so a binary file written after reading it is the one to compare against
+vector<float> TestBayesian::getTextTable(string& binary) {
+    Utils util;
+    Bayesian* built = getClassifier(); delete built;
+    util.mothurRemove(probBinaryName);
+    
+    Bayesian* fromText = getClassifier();
+    vector<float> table = getTable(fromText);
+    delete fromText;
+    binary = getFileContents(probBinaryName);
+    return table;
+}
+/**************************************************************************************************/
+vector<float> TestBayesian::getTable(Bayesian* b) {
+    vector<float> table;
+    for (int i = 0; i < b->WordPairDiffArr.size(); i++) { table.push_back(b->WordPairDiffArr[i].prob); }
+    table.insert(table.end(), b->genusProbTable, b->genusProbTable + (b->numKmers * b->genusStride));
+    return table;
+}
+/**************************************************************************************************/
+string TestBayesian::getFileContents(string filename) {
+    ifstream in(filename.c_str(), ios::binary);
+    return string((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+}
+/**************************************************************************************************/
+void TestBayesian::setFileContents(string filename, string contents) {
+    ofstream out(filename.c_str(), ios::binary | ios::trunc);
+    out.write(contents.c_str(), contents.length());
+}
+/**************************************************************************************************/
+TEST(Test_Bayesian, binaryProbFileRoundTrip) {
+    TestBayesian testBayesian;
+    Utils util;
+    
+    //the first run builds the table and writes the shortcut files
+    Bayesian* built = testBayesian.getClassifier();
+    EXPECT_FALSE(testBayesian.isMapped(built));
+    EXPECT_TRUE(util.fileExists(testBayesian.probBinaryName));
+    vector<float> builtTable = testBayesian.getTable(built);
+    string simpleTax; bool flipped = false;
+    string builtTax = built->getTaxonomy(&testBayesian.query, simpleTax, flipped);
+    delete built;
+    
+    //the second maps the binary file and classifies the same way
+    Bayesian* mapped = testBayesian.getClassifier();
+    EXPECT_TRUE(testBayesian.isMapped(mapped));
+    EXPECT_EQ(testBayesian.getTable(mapped), builtTable);
+    string mappedTax = mapped->getTaxonomy(&testBayesian.query, simpleTax, flipped);
+    EXPECT_EQ(mappedTax, builtTax);
+    EXPECT_NE(mappedTax.find("Anaerotruncus"), string::npos);
+    delete mapped;
+}
+/**************************************************************************************************/
+TEST(Test_Bayesian, binaryProbFileRejectsStale) {
+    TestBayesian testBayesian;
+    
+    string good;
+    vector<float> textTable = testBayesian.getTextTable(good);
+    ASSERT_GT(good.length(), 128);
+    
+    //an older mothur version, the magic, the format version, the genus totals and a short table
+    vector<string> stale;
+    string oldVersion = good; oldVersion.replace(0, 8, "#1.01.0\n"); stale.push_back(oldVersion);
+    string badMagic = good; badMagic[64] = 'X'; stale.push_back(badMagic);
+    string badFormat = good; badFormat[72]++; stale.push_back(badFormat);
+    string badTotals = good; badTotals[104]++; stale.push_back(badTotals);
+    stale.push_back(good.substr(0, good.length()-4));
+    
+    for (int i = 0; i < stale.size(); i++) {
+        testBayesian.setFileContents(testBayesian.probBinaryName, stale[i]);
+        
+        //the text files are read instead, and the binary file is written again
+        Bayesian* reread = testBayesian.getClassifier();
+        EXPECT_FALSE(testBayesian.isMapped(reread)) << "stale file " << i;
+        EXPECT_EQ(testBayesian.getTable(reread), textTable) << "stale file " << i;
+        delete reread;
+        EXPECT_TRUE(testBayesian.getFileContents(testBayesian.probBinaryName) == good) << "stale file " << i;
+    }
+}
+/**************************************************************************************************/
+TEST(Test_Bayesian, binaryProbFileRenamedIntoPlace) {
+    TestBayesian testBayesian;
+    Utils util;
+    string tempName = testBayesian.probBinaryName + ".temp";
+    
+    //a temp file left by a killed run is overwritten, and never left behind
+    string good;
+    testBayesian.getTextTable(good);
+    testBayesian.setFileContents(testBayesian.probBinaryName, good.substr(0, 100));
+    testBayesian.setFileContents(tempName, "partial");
+    
+    Bayesian* rebuilt = testBayesian.getClassifier();
+    delete rebuilt;
+    EXPECT_TRUE(testBayesian.getFileContents(testBayesian.probBinaryName) == good);
+    EXPECT_FALSE(util.fileExists(tempName));
+    
+    //replacing the file doesn't change the table a running classifier has mapped
+    Bayesian* mapped = testBayesian.getClassifier();
+    ASSERT_TRUE(testBayesian.isMapped(mapped));
+    vector<float> mappedTable = testBayesian.getTable(mapped);
+    testBayesian.writeBinary(mapped);
+    EXPECT_EQ(testBayesian.getTable(mapped), mappedTable);
+    EXPECT_TRUE(testBayesian.getFileContents(testBayesian.probBinaryName) == good);
+    delete mapped;
+}
+/**************************************************************************************************/
+TEST(Test_Bayesian, missingIndexKeepsShortcuts) {
+    TestBayesian testBayesian;
+    Utils util;
+    string kmerName = "tempBayesian.8mer"; string indexName = kmerName + ".index"; string treeName = "tempBayesian.tree.train";
+    
+    Bayesian* built = testBayesian.getClassifier();
+    string simpleTax; bool flipped = false;
+    string builtTax = built->getTaxonomy(&testBayesian.query, simpleTax, flipped);
+    delete built;
+    ASSERT_TRUE(util.fileExists(indexName));
+    
+    //without tree.train the search database is made again. readDB stops after the last kmer, so a line after it shows whether the .8mer file was rewritten
+    util.mothurRemove(indexName); util.mothurRemove(treeName);
+    ofstream out; util.openOutputFileAppend(kmerName, out); out << "#kept" << endl; out.close();
+    
+    //the .8mer shortcut is read, and the index is made from it for the next run
+    Bayesian* fromShortcut = testBayesian.getClassifier();
+    EXPECT_EQ(fromShortcut->getTaxonomy(&testBayesian.query, simpleTax, flipped), builtTax);
+    delete fromShortcut;
+    EXPECT_NE(testBayesian.getFileContents(kmerName).find("#kept"), string::npos);
+    EXPECT_TRUE(util.fileExists(indexName));
+    
+    util.mothurRemove(treeName);
+    Bayesian* fromIndex = testBayesian.getClassifier();
+    EXPECT_EQ(fromIndex->getTaxonomy(&testBayesian.query, simpleTax, flipped), builtTax);
+    delete fromIndex;
+}
+/**************************************************************************************************/
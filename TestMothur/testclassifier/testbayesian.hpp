@@ -0,0 +1,37 @@
+//
+//  testbayesian.hpp
+//  Mothur
+//
+//  Created by agent on 10/18/26.
+//  Copyright © 2026 Schloss Lab. All rights reserved.
+//
+
+#ifndef testbayesian_hpp
+#define testbayesian_hpp
+
+#include "gtest/gtest.h"
+#include "bayesian.h"
+
+//writes a 6 sequence reference from 3 genera, and reaches into a Bayesian for its probability table
+class TestBayesian {
+    
+public:
+    
+    TestBayesian();
+    ~TestBayesian();
+    
+    Bayesian* getClassifier();
+    bool isMapped(Bayesian* b) { return (b->mappedProbs != nullptr); }
+    vector<float> getTable(Bayesian*);
+    vector<float> getTextTable(string&);
+    void writeBinary(Bayesian* b) { b->writeBinaryProbFile(probBinaryName, version); }
+    
+    string getFileContents(string);
+    void setFileContents(string, string);
+    
+    Sequence query;
+    string version, taxFile, templateFile, probBinaryName;
+    vector<string> outputFiles;
+};
+
+#endif /* testbayesian_hpp */
@@ -27,7 +27,7 @@ TEST(Test_Container_CountTable, createTables) {
     //int createTable(string, string, bool); //namefile, groupfile, createGroup
     TestCountTable testData;
     CountTable ct;
-    ct.createTable(testData.namefile, testData.groupfile, false);
+    ct.createTable(testData.namefile, testData.groupfile, nullVector, false);
     
     EXPECT_EQ(ct.getNumGroups(), 10);
     EXPECT_EQ(ct.getNumSeqs(), 200);
@@ -86,7 +86,7 @@ TEST(Test_Container_CountTable, testGroups) {
     EXPECT_EQ(groups[4], "F003D008");
     EXPECT_EQ(groups[5], "F003D142");
     
-    ct.createTable(testData.namefile, testData.groupfile, false);
+    ct.createTable(testData.namefile, testData.groupfile, nullVector, false);
     CountTable ct2; ct2.copy(&ct);
     EXPECT_EQ(ct2.getNumGroups(), 10);
     EXPECT_EQ(ct2.getNumSeqs(), 200);
@@ -116,6 +116,23 @@ TEST(Test_Container_CountTable, testGroups) {
     EXPECT_EQ(groups[2], "group4");
 }
 /**************************************************************************************************/
+//adding a group that sorts before the others keeps each sequence's counts with its groups
+TEST(Test_Container_CountTable, addGroup) {
+    set<string> seqNames; seqNames.insert("seq1"); seqNames.insert("seq2");
+    set<string> groupNames; groupNames.insert("group1"); groupNames.insert("group2");
+    map<string, string> groupMap; groupMap["seq1"] = "group1"; groupMap["seq2"] = "group2";
+    CountTable ct; ct.createTable(seqNames, groupMap, groupNames);
+    
+    ct.addGroup("doNotIncludeMe");
+    EXPECT_EQ(ct.getNumGroups(), 3);
+    EXPECT_EQ(ct.getGroupCount("seq1", "group1"), 1);
+    EXPECT_EQ(ct.getGroupCount("seq2", "group2"), 1);
+    EXPECT_EQ(ct.getGroupCount("seq1", "doNotIncludeMe"), 0);
+    EXPECT_EQ(ct.getGroupCount("group1"), 1);
+    EXPECT_EQ(ct.getGroupCount("group2"), 1);
+    EXPECT_EQ(ct.getGroupCount("doNotIncludeMe"), 0);
+}
+/**************************************************************************************************/
 //Testing testGroups functions
 TEST(Test_Container_CountTable, push_backs) {
     TestCountTable testData;
@@ -144,7 +161,7 @@ TEST(Test_Container_CountTable, push_backs) {
 TEST(Test_Container_CountTable, push_backGroups) {
     TestCountTable testData;
     CountTable ct;
-    ct.createTable(testData.namefile, testData.groupfile, false);
+    ct.createTable(testData.namefile, testData.groupfile, nullVector, false);
     ct.setAbund("GQY1XT001B1CEF", "F003D000", 50);
     EXPECT_EQ(ct.getGroupCount("GQY1XT001B1CEF", "F003D000"), 50);
     
@@ -158,7 +175,7 @@ TEST(Test_Container_CountTable, push_backGroups) {
 TEST(Test_Container_CountTable, getSets) {
     TestCountTable testData;
     CountTable ct;
-    ct.createTable(testData.namefile, testData.groupfile, false);
+    ct.createTable(testData.namefile, testData.groupfile, nullVector, false);
     
     vector<string> thisSeqsGroups = ct.getGroups("GQY1XT001B1CEF");
     EXPECT_EQ(thisSeqsGroups[0], "F003D148");
@@ -177,7 +194,7 @@ TEST(Test_Container_CountTable, getSets) {
 TEST(Test_Container_CountTable, dataStructures) {
     TestCountTable testData;
     CountTable ct;
-    ct.createTable(testData.namefile, testData.groupfile, false);
+    ct.createTable(testData.namefile, testData.groupfile, nullVector, false);
     
     EXPECT_EQ(ct.getNamesOfSeqs().size(), 93);
     EXPECT_EQ(ct.getNamesOfSeqs("F003D148").size(), 19);
@@ -189,6 +206,221 @@ TEST(Test_Container_CountTable, dataStructures) {
     
 }
 /**************************************************************************************************/
+//seq1, seq2 and seq3 have one read in group1, group2 and group3, seq4 has 2 reads in group1 and 5 in group3
+void fillSharedRowsTable(CountTable& ct) {
+    set<string> seqNames; seqNames.insert("seq1"); seqNames.insert("seq2"); seqNames.insert("seq3");
+    set<string> groupNames; groupNames.insert("group1"); groupNames.insert("group2"); groupNames.insert("group3");
+    map<string, string> groupMap; groupMap["seq1"] = "group1"; groupMap["seq2"] = "group2"; groupMap["seq3"] = "group3";
+    ct.createTable(seqNames, groupMap, groupNames);
+    
+    vector<int> abunds; abunds.push_back(2); abunds.push_back(0); abunds.push_back(5);
+    ct.push_back("seq4", abunds);
+}
+/**************************************************************************************************/
+//Testing the rows sharing one cells vector
+TEST(Test_Container_CountTable, sharedRows) {
+    CountTable ct; fillSharedRowsTable(ct);
+    
+    //only the non zero counts are stored, sorted by group
+    countTableRow row = ct.getRow("seq4");
+    ASSERT_EQ(row.size, 2);
+    EXPECT_EQ(row.items[0].group, 0); EXPECT_EQ(row.items[0].abund, 2);
+    EXPECT_EQ(row.items[1].group, 2); EXPECT_EQ(row.items[1].abund, 5);
+    EXPECT_EQ(ct.getNumSeqs(), 10);
+    
+    //growing a row moves it to the end of the cells, the other rows keep their counts
+    ct.setAbund("seq1", "group2", 3);
+    EXPECT_EQ(ct.getGroupCount("seq1", "group1"), 1);
+    EXPECT_EQ(ct.getGroupCount("seq1", "group2"), 3);
+    EXPECT_EQ(ct.getNumSeqs("seq1"), 4);
+    EXPECT_EQ(ct.getGroupCount("seq2", "group2"), 1);
+    EXPECT_EQ(ct.getGroupCount("seq4", "group3"), 5);
+    EXPECT_EQ(ct.getGroupCount("group2"), 4);
+    
+    //removing a group drops the seqs only in that group
+    ct.removeGroup("group3");
+    EXPECT_EQ(ct.getNumGroups(), 2);
+    EXPECT_FALSE(ct.inTable("seq3"));
+    EXPECT_EQ(ct.getNumSeqs("seq4"), 2);
+    EXPECT_EQ(ct.getGroupCount("seq4", "group1"), 2);
+    EXPECT_EQ(ct.getGroupCount("seq1", "group2"), 3);
+    
+    //removing a seq keeps the names of the rows after it
+    ct.remove("seq1");
+    EXPECT_FALSE(ct.inTable("seq1"));
+    EXPECT_EQ(ct.getGroupCount("seq2", "group2"), 1);
+    EXPECT_EQ(ct.getGroupCount("seq4", "group1"), 2);
+    EXPECT_EQ(ct.size(), 2);
+    
+    //a removed name can be added again
+    vector<int> abunds; abunds.push_back(0); abunds.push_back(7);
+    ct.push_back("seq1", abunds);
+    EXPECT_EQ(ct.getGroupCount("seq1", "group2"), 7);
+    EXPECT_EQ(ct.getGroupCount("seq1", "group1"), 0);
+    
+    //adding a group renumbers the groups in the cells
+    ct.addGroup("group0");
+    EXPECT_EQ(ct.getGroupCount("seq4", "group1"), 2);
+    EXPECT_EQ(ct.getGroupCount("seq1", "group2"), 7);
+    EXPECT_EQ(ct.getGroupCount("seq1", "group0"), 0);
+    
+    //seqs are returned in table order
+    vector<countTableSeq> seqs = ct.getSeqs();
+    ASSERT_EQ(seqs.size(), 3);
+    EXPECT_EQ(seqs[0].getName(), "seq2"); EXPECT_EQ(seqs[0].total, 1);
+    EXPECT_EQ(seqs[1].getName(), "seq4"); EXPECT_EQ(seqs[1].total, 2);
+    EXPECT_EQ(seqs[2].getName(), "seq1"); EXPECT_EQ(seqs[2].total, 7);
+    ASSERT_EQ(seqs[1].row.size, 1);
+    EXPECT_EQ(seqs[1].row.items[0].group, 1); EXPECT_EQ(seqs[1].row.items[0].abund, 2);
+    
+    //names are returned sorted
+    vector<string> names = ct.getNamesOfSeqs();
+    ASSERT_EQ(names.size(), 3);
+    EXPECT_EQ(names[0], "seq1"); EXPECT_EQ(names[1], "seq2"); EXPECT_EQ(names[2], "seq4");
+    
+    //a merged seq is no longer returned
+    ct.mergeCounts("seq2", "seq4");
+    EXPECT_EQ(ct.getNumSeqs("seq2"), 3);
+    EXPECT_FALSE(ct.inTable("seq4"));
+    EXPECT_EQ(ct.getSeqs().size(), 2);
+}
+/**************************************************************************************************/
+TEST(Test_Container_CountTable, copySharedRows) {
+    CountTable ct; fillSharedRowsTable(ct);
+    ct.remove("seq1"); //group1 keeps seq4's reads, so all the groups stay
+    
+    CountTable ct2; ct2.copy(&ct);
+    EXPECT_EQ(ct2.getNumGroups(), 3);
+    EXPECT_EQ(ct2.getNumSeqs(), ct.getNumSeqs());
+    EXPECT_EQ(ct2.getNumUniqueSeqs(), 3);
+    EXPECT_FALSE(ct2.inTable("seq1"));
+    EXPECT_EQ(ct2.getGroupCount("seq2", "group2"), 1);
+    EXPECT_EQ(ct2.getGroupCount("seq3", "group3"), 1);
+    EXPECT_EQ(ct2.getGroupCount("seq4", "group1"), 2);
+    EXPECT_EQ(ct2.getGroupCount("seq4", "group2"), 0);
+    EXPECT_EQ(ct2.getGroupCount("seq4", "group3"), 5);
+    
+    //the copy does not share rows with the original
+    ct2.setAbund("seq4", "group2", 9);
+    EXPECT_EQ(ct.getGroupCount("seq4", "group2"), 0);
+}
+/**************************************************************************************************/
+TEST(Test_Container_CountTable, zeroOutTable) {
+    CountTable ct; fillSharedRowsTable(ct);
+    ct.zeroOutTable();
+    
+    //every seq's counts are cleared, the seqs stay in the table
+    EXPECT_EQ(ct.size(), 4);
+    EXPECT_EQ(ct.getNumSeqs("seq4"), 0);
+    EXPECT_EQ(ct.getGroupCount("seq4", "group1"), 0);
+    EXPECT_EQ(ct.getRow("seq4").size, 0);
+    EXPECT_EQ(ct.getNumSeqs("seq3"), 0);
+    
+    ct.setAbund("seq3", "group2", 4);
+    EXPECT_EQ(ct.getGroupCount("seq3", "group2"), 4);
+    EXPECT_EQ(ct.getNumSeqs("seq3"), 4);
+}
+/**************************************************************************************************/
+void expectSameTable(CountTable& ct, CountTable& ct2) {
+    EXPECT_EQ(ct.getNumSeqs(), ct2.getNumSeqs());
+    EXPECT_EQ(ct.hasGroupInfo(), ct2.hasGroupInfo());
+    
+    vector<string> names = ct.getNamesOfSeqs();
+    vector<string> groups = ct.getNamesOfGroups();
+    ASSERT_EQ(names, ct2.getNamesOfSeqs());
+    ASSERT_EQ(groups, ct2.getNamesOfGroups());
+    
+    for (int i = 0; i < names.size(); i++) {
+        EXPECT_EQ(ct.getNumSeqs(names[i]), ct2.getNumSeqs(names[i]));
+        for (int j = 0; j < groups.size(); j++) { EXPECT_EQ(ct.getGroupCount(names[i], groups[j]), ct2.getGroupCount(names[i], groups[j])); }
+    }
+}
+/**************************************************************************************************/
+//Testing the binary copy, filename.bin
+TEST(Test_Container_CountTable, binaryCopy) {
+    Utils util;
+    CountTable ct; fillSharedRowsTable(ct);
+    string file = "tempBinary.count_table"; string binaryFile = file + ".bin";
+    
+    //printing writes a copy, reading the text never writes one
+    ct.printTable(file, false);
+    EXPECT_EQ(ct.getBinaryFile(), binaryFile);
+    EXPECT_TRUE(ct.isBinaryCopy(file));
+    remove(binaryFile.c_str());
+    
+    vector<string> someGroups; someGroups.push_back("group1"); someGroups.push_back("group3");
+    unordered_set<string> someSeqs; someSeqs.insert("seq1"); someSeqs.insert("seq4");
+    CountTable text; text.readTable(file, true, false);
+    CountTable textGroups; textGroups.readTable(file, true, false, someGroups);
+    CountTable textNoGroups; textNoGroups.readTable(file, false, false);
+    CountTable textSeqs; textSeqs.readTable(file, true, false, someSeqs);
+    EXPECT_FALSE(ct.isBinaryCopy(file));
+    
+    ct.printTable(file, false);
+    EXPECT_TRUE(ct.isBinaryCopy(file));
+    
+    //every overload reads the same table it read from the text
+    CountTable binary; binary.readTable(file, true, false);
+    expectSameTable(text, binary);
+    CountTable binaryGroups; binaryGroups.readTable(file, true, false, someGroups);
+    expectSameTable(textGroups, binaryGroups);
+    EXPECT_EQ(binaryGroups.getNumGroups(), 2);
+    EXPECT_EQ(binaryGroups.getNumSeqs("seq4"), 7);
+    EXPECT_FALSE(binaryGroups.inTable("seq2"));
+    CountTable binaryNoGroups; binaryNoGroups.readTable(file, false, false);
+    expectSameTable(textNoGroups, binaryNoGroups);
+    CountTable binarySeqs; binarySeqs.readTable(file, true, false, someSeqs);
+    expectSameTable(textSeqs, binarySeqs);
+    EXPECT_EQ(binarySeqs.getNumUniqueSeqs(), 2);
+    
+    //the copy is what is read, seq4's count in group3 is stored as the only (5, 2) pair of ints
+    ifstream in(binaryFile.c_str(), ios::binary);
+    string bytes((istreambuf_iterator<char>(in)), istreambuf_iterator<char>()); in.close();
+    int pair[2] = {5, 2}; int newPair[2] = {6, 2};
+    size_t pos = bytes.find(string((char*)pair, sizeof(pair)));
+    ASSERT_NE(pos, string::npos);
+    bytes.replace(pos, sizeof(newPair), string((char*)newPair, sizeof(newPair)));
+    ofstream out(binaryFile.c_str(), ios::binary); out << bytes; out.close();
+    
+    CountTable changedBinary; changedBinary.readTable(file, true, false);
+    EXPECT_EQ(changedBinary.getGroupCount("seq4", "group3"), 6);
+    
+    //editing the text table, even keeping its size, makes the copy out of date, the text is read and the copy removed
+    ifstream inText(file.c_str());
+    string textBytes((istreambuf_iterator<char>(inText)), istreambuf_iterator<char>()); inText.close();
+    pos = textBytes.find("seq4\t7\t2\t0\t5");
+    ASSERT_NE(pos, string::npos);
+    textBytes.replace(pos, 12, "seq4\t7\t3\t0\t4");
+    ofstream outText(file.c_str()); outText << textBytes; outText.close();
+    
+    CountTable edited; edited.readTable(file, true, false);
+    EXPECT_EQ(edited.getGroupCount("seq4", "group1"), 3);
+    EXPECT_EQ(edited.getGroupCount("seq4", "group3"), 4);
+    EXPECT_FALSE(ct.isBinaryCopy(file));
+    
+    //the copy is checked against the table next to it, a copy moved next to another table is not used
+    ct.printTable(file, false);
+    string newFile = "tempBinary2.count_table";
+    ofstream outOther(newFile.c_str()); outOther << textBytes; outOther.close();
+    util.renameFile(binaryFile, newFile + ".bin");
+    
+    CountTable renamed; renamed.readTable(newFile, true, false);
+    EXPECT_EQ(renamed.getGroupCount("seq4", "group1"), 3);
+    EXPECT_FALSE(ct.isBinaryCopy(newFile));
+    util.mothurRemove(newFile);
+    
+    //printing a table that can't have a copy removes the old one
+    ct.printTable(file, false);
+    EXPECT_TRUE(ct.isBinaryCopy(file));
+    ct.printCompressedTable(file, someGroups);
+    EXPECT_EQ(ct.getBinaryFile(), "");
+    EXPECT_FALSE(ct.isBinaryCopy(file));
+    
+    CountTable subset; subset.readTable(file, true, false);
+    EXPECT_EQ(subset.getNumGroups(), 2);
+    util.mothurRemove(file);
+}
+/**************************************************************************************************/
 
 //ListVector getListVector();
 //SharedRAbundVectors* getShared();
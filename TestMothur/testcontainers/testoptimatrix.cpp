@@ -73,9 +73,9 @@ TEST(Test_Container_OptiMatrix, getCloseSeqs) {
     
     //11	GQY1XT001B04KZ,GQY1XT001EBRFH	17	32	52	55	57
     string Expected_ReturnResults = ""; Expected_ReturnResults += "17"; Expected_ReturnResults += "32"; Expected_ReturnResults += "52"; Expected_ReturnResults += "55"; Expected_ReturnResults += "57";
-    set<long long> temp = matrix.getCloseSeqs(11);
+    closeSeqs temp = matrix.getCloseSeqs(11);
     string ReturnResults = "";
-    for (set<long long>::iterator it = temp.begin(); it != temp.end(); it++) { ReturnResults += toString(*it); }
+    for (const unsigned int* it = temp.begin(); it != temp.end(); it++) { ReturnResults += toString(*it); }
     
     EXPECT_EQ(Expected_ReturnResults, ReturnResults);
     
@@ -83,7 +83,7 @@ TEST(Test_Container_OptiMatrix, getCloseSeqs) {
     Expected_ReturnResults = ""; Expected_ReturnResults += "26"; Expected_ReturnResults += "42"; Expected_ReturnResults += "46";
     temp = matrix.getCloseSeqs(21);
     ReturnResults = "";
-    for (set<long long>::iterator it = temp.begin(); it != temp.end(); it++) { ReturnResults += toString(*it); }
+    for (const unsigned int* it = temp.begin(); it != temp.end(); it++) { ReturnResults += toString(*it); }
     
     EXPECT_EQ(Expected_ReturnResults, ReturnResults);
 
@@ -91,7 +91,7 @@ TEST(Test_Container_OptiMatrix, getCloseSeqs) {
     Expected_ReturnResults = ""; Expected_ReturnResults += "20"; Expected_ReturnResults += "27";
     temp = matrix.getCloseSeqs(31);
     ReturnResults = "";
-    for (set<long long>::iterator it = temp.begin(); it != temp.end(); it++) { ReturnResults += toString(*it); }
+    for (const unsigned int* it = temp.begin(); it != temp.end(); it++) { ReturnResults += toString(*it); }
     
     EXPECT_EQ(Expected_ReturnResults, ReturnResults);
 
@@ -99,7 +99,7 @@ TEST(Test_Container_OptiMatrix, getCloseSeqs) {
     Expected_ReturnResults = ""; Expected_ReturnResults += "19"; Expected_ReturnResults += "29";
     temp = matrix.getCloseSeqs(41);
     ReturnResults = "";
-    for (set<long long>::iterator it = temp.begin(); it != temp.end(); it++) { ReturnResults += toString(*it); }
+    for (const unsigned int* it = temp.begin(); it != temp.end(); it++) { ReturnResults += toString(*it); }
     
     EXPECT_EQ(Expected_ReturnResults, ReturnResults);
 
@@ -107,7 +107,7 @@ TEST(Test_Container_OptiMatrix, getCloseSeqs) {
     Expected_ReturnResults = ""; Expected_ReturnResults += "49";
     temp = matrix.getCloseSeqs(51);
     ReturnResults = "";
-    for (set<long long>::iterator it = temp.begin(); it != temp.end(); it++) { ReturnResults += toString(*it); }
+    for (const unsigned int* it = temp.begin(); it != temp.end(); it++) { ReturnResults += toString(*it); }
     
     EXPECT_EQ(Expected_ReturnResults, ReturnResults);
 }
@@ -186,6 +186,35 @@ TEST(Test_Container_SharedRabundVector, GetSabundVector) {
     EXPECT_EQ(sabund.get(5), 10);
 }
 
+TEST(Test_Container_SharedRabundVector, Sparse) {
+    SharedRAbundVector temp(10, true);
+    EXPECT_EQ(temp.isSparse(), true);
+    EXPECT_EQ(temp.getNumBins(), 10);
+    EXPECT_EQ(temp.size(), 10);
+    EXPECT_EQ(temp.getNumEntries(), 0);
+    
+    temp.set(7, 3); temp.increment(2); temp.increment(7);
+    EXPECT_EQ(temp.getNumSeqs(), 5);
+    EXPECT_EQ(temp.getMaxRank(), 4);
+    EXPECT_EQ(temp.getNumEntries(), 2);
+    EXPECT_EQ(temp.getEntryBin(0), 2);
+    EXPECT_EQ(temp.get(7), 4);
+    EXPECT_EQ(temp.get(5), 0);
+    EXPECT_EQ(temp.get()[7], 4);
+    
+    vector<int> bins; bins.push_back(0); bins.push_back(2);
+    EXPECT_EQ(temp.remove(bins), 1);
+    EXPECT_EQ(temp.getNumBins(), 8);
+    EXPECT_EQ(temp.get(5), 4);
+    
+    temp.setSparse(false);
+    EXPECT_EQ(temp.getNumEntries(), 8);
+    EXPECT_EQ(temp.get(5), 4);
+    temp.fitStorage();
+    EXPECT_EQ(temp.isSparse(), true);
+    EXPECT_EQ(temp.getSAbundVector().get(4), 1);
+}
+
 TEST(Test_Container_SharedRabundVector, RAbundFloatVector) {
     vector<int> abunds(10, 5);
     SharedRAbundVector temp(abunds);
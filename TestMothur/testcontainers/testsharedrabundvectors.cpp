@@ -252,3 +252,21 @@ TEST(Test_Container_SharedRabundVectors, GetSharedRAbundFloatVectors) {
 /**************************************************************************************************/
 
 
+
+TEST(Test_Container_SharedRabundVectors, SetSparse) {
+    vector<int> abunds(6, 0); abunds[1] = 3; abunds[4] = 2;
+    SharedRAbundVector* temp = new SharedRAbundVector(abunds); temp->setGroup("A");
+    SharedRAbundVector* temp2 = new SharedRAbundVector(abunds); temp2->setGroup("B");
+    SharedRAbundVectors lookup; lookup.push_back(temp); lookup.push_back(temp2);
+    
+    lookup.setSparse(true);
+    EXPECT_EQ(temp->isSparse(), true);
+    EXPECT_EQ(temp2->getNumEntries(), 2);
+    EXPECT_EQ(lookup.get(4, "B"), 2);
+    
+    lookup.setSparse(false);
+    EXPECT_EQ(temp->isSparse(), false);
+    EXPECT_EQ(temp2->getNumEntries(), 6);
+    EXPECT_EQ(lookup.getRAbundVector("A").get(1), 3);
+    EXPECT_EQ(lookup.getNumSeqs("A"), 5);
+}
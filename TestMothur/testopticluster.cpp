@@ -41,15 +41,65 @@ TEST(Test_Cluster_OptiCluster, myUpdate) {
     ASSERT_NEAR(1, initialMetricValue, 0.00001); //metric value
 }
 
-TEST(Test_Cluster_OptiCluster, getCloseFarCounts) {
+TEST(Test_Cluster_OptiCluster, getCloseBins) {
     TestOptiCluster test;
     double initialMetricValue;
     test.initialize(initialMetricValue, false, "singleton"); //no randomization
     test.update(initialMetricValue);
     
-    vector<long long> results = test.getCloseFarCounts(0, 31);
+    vector<long long> counts(test.bins.size(), 0);
+    vector<long long> closeBins = test.getCloseBins(0, counts);
     
-    ASSERT_EQ(results[0], 0); //number of close sequences in bin 31 to seq 0
-    ASSERT_EQ(results[1], 10); //number of far sequences in bin 31 to seq 0
+    ASSERT_EQ(counts[31], 0); //number of close sequences in bin 31 to seq 0
+    ASSERT_EQ(test.bins[31].size() - counts[31], 10); //number of far sequences in bin 31 to seq 0
+}
+/**************************************************************************************************/
+//clusters the matrix from the same seed with the processors given and returns the OTUs
+vector<string> getOTUs(OptiData* matrix, int processors, double& metricValue) {
+    TestOptiCluster test;
+    test.setVariables(matrix, test.metric);
+    test.setProcessors(processors);
+    
+    test.initialize(metricValue, true, "singleton");
+    for (int i = 0; i < 5; i++) { test.update(metricValue); }
+    
+    vector<string> otus;
+    ListVector* list = test.getList();
+    for (int i = 0; i < list->getNumBins(); i++) { otus.push_back(list->get(i)); }
+    delete list;
+    
+    return otus;
+}
+/**************************************************************************************************/
+TEST(Test_Cluster_OptiCluster, batchUpdate) {
+    FakeOptiMatrix testMatrix;
+    double serialMetric, batchMetric;
+    
+    //the 9 groups are found either way
+    vector<string> serialOTUs = getOTUs(&testMatrix, 1, serialMetric);
+    vector<string> batchOTUs = getOTUs(&testMatrix, 4, batchMetric);
+    
+    ASSERT_NEAR(1, serialMetric, 0.00001);
+    ASSERT_NEAR(1, batchMetric, 0.00001);
+    EXPECT_EQ(serialOTUs, batchOTUs);
+}
+
+TEST(Test_Cluster_OptiCluster, batchUpdateThreads) {
+    FakeOptiMatrix testMatrix(10000, 3); //3 batches
+    double serialMetric, metric2, metric3, metric8;
+    
+    vector<string> serialOTUs = getOTUs(&testMatrix, 1, serialMetric);
+    vector<string> otus2 = getOTUs(&testMatrix, 2, metric2);
+    vector<string> otus3 = getOTUs(&testMatrix, 3, metric3);
+    vector<string> otus8 = getOTUs(&testMatrix, 8, metric8);
+    
+    //the batches don't depend on the number of threads
+    EXPECT_EQ(otus2, otus3);
+    EXPECT_EQ(otus2, otus8);
+    EXPECT_EQ(metric2, metric3);
+    EXPECT_EQ(metric2, metric8);
+    
+    //the moves are made in a different order than the serial update, but they are as good
+    EXPECT_NEAR(serialMetric, metric2, 0.01);
 }
 /**************************************************************************************************/
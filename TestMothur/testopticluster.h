@@ -30,7 +30,8 @@ public:
     using OptiCluster::setVariables;
     using OptiCluster::initialize;
     using OptiCluster::update;
-    using OptiCluster::getCloseFarCounts;
+    using OptiCluster::getCloseBins;
+    using OptiCluster::bins;
 };
 
 #endif /* defined(__Mothur__testopticluster__) */
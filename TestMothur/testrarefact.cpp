@@ -0,0 +1,111 @@
+//
+//  testrarefact.cpp
+//  Mothur
+//
+//  Created by agent on 10/18/26.
+//  Copyright © 2026 Schloss Lab. All rights reserved.
+//
+
+#include "testrarefact.hpp"
+
+/**************************************************************************************************/
+//otus with 2, 1 and 1 reads, every draw enumerated by hand
+//n=1: always 1 otu
+//n=2: 1 of the 6 draws takes both reads of the first otu, mean 11/6, var 7/2 - (11/6)^2
+//n=3: 2 of the 4 draws see all 3 otus, mean 5/2, var 13/2 - (5/2)^2
+//n=4: always 3 otus
+TEST(Test_Rarefact, expectedCurve) {
+    vector<int> abunds; abunds.push_back(2); abunds.push_back(1); abunds.push_back(1);
+    RAbundVector rabund(abunds); rabund.setLabel("0.03");
+    OrderVector order = rabund.getOrderVector(nullptr);
+    
+    TestRareDisplay* display = new TestRareDisplay(true);
+    vector<Display*> displays; displays.push_back(display);
+    set<int> ends;
+    
+    Rarefact rarefact(order, displays, ends, 1, true);
+    rarefact.getCurve(1, 1000);
+    
+    ASSERT_EQ(display->expected.size(), 4);
+    EXPECT_EQ(display->sampled.size(), 0);
+    
+    EXPECT_NEAR(display->expected[1][0], 1, 1e-9);
+    EXPECT_NEAR(display->expected[1][1], 1, 1e-9);
+    EXPECT_NEAR(display->expected[1][2], 1, 1e-9);
+    
+    double mean = 11 / 6.0; double sd = sqrt(3.5 - mean*mean);
+    EXPECT_NEAR(display->expected[2][0], mean, 1e-9);
+    EXPECT_NEAR(display->expected[2][1], mean - 1.96*sd, 1e-9);
+    EXPECT_NEAR(display->expected[2][2], 2, 1e-9); //mean + 1.96sd is 2.56, but 2 reads see at most 2 otus
+    
+    EXPECT_NEAR(display->expected[3][0], 2.5, 1e-9);
+    EXPECT_NEAR(display->expected[3][1], 2, 1e-9); //mean - 1.96sd is 1.52, but 3 reads need at least 2 otus
+    EXPECT_NEAR(display->expected[3][2], 3, 1e-9);
+    
+    EXPECT_NEAR(display->expected[4][0], 3, 1e-9);
+    EXPECT_NEAR(display->expected[4][1], 3, 1e-9);
+    EXPECT_NEAR(display->expected[4][2], 3, 1e-9);
+    
+    delete display;
+}
+/**************************************************************************************************/
+
+//expected=f averages sobs over the iterations the way it did before the closed form, lci and hci are then percentiles of the iterations
+TEST(Test_Rarefact, sampledCurve) {
+    vector<int> abunds; abunds.push_back(2); abunds.push_back(1); abunds.push_back(1);
+    RAbundVector rabund(abunds); rabund.setLabel("0.03");
+    OrderVector order = rabund.getOrderVector(nullptr);
+    
+    TestRareDisplay* display = new TestRareDisplay(true);
+    vector<Display*> displays; displays.push_back(display);
+    set<int> ends;
+    
+    Rarefact rarefact(order, displays, ends, 1, false);
+    rarefact.getCurve(1, 600);
+    
+    EXPECT_EQ(display->expected.size(), 0);
+    ASSERT_EQ(display->sampled.size(), 4);
+    
+    for (int n = 1; n <= 4; n++) { ASSERT_EQ(display->sampled[n].size(), 600); }
+    for (int i = 0; i < 600; i++) {
+        EXPECT_EQ(display->sampled[1][i], 1);
+        EXPECT_EQ(display->sampled[4][i], 3);
+    }
+    
+    //1 in 6 draws of 2 reads sees 1 otu, 1 in 2 draws of 3 reads sees 2
+    int sawOne = 0, sawTwo = 0;
+    for (int i = 0; i < 600; i++) {
+        if (display->sampled[2][i] == 1) { sawOne++; }
+        if (display->sampled[3][i] == 2) { sawTwo++; }
+    }
+    EXPECT_NEAR(sawOne / 600.0, 1 / 6.0, 0.06);
+    EXPECT_NEAR(sawTwo / 600.0, 0.5, 0.08);
+    
+    delete display;
+}
+/**************************************************************************************************/
+//with processors the closed form is computed while the worker threads run the iterations for the other calcs
+TEST(Test_Rarefact, expectedCurveWithIterations) {
+    vector<int> abunds; abunds.push_back(2); abunds.push_back(1); abunds.push_back(1);
+    RAbundVector rabund(abunds); rabund.setLabel("0.03");
+    OrderVector order = rabund.getOrderVector(nullptr);
+    
+    TestRareDisplay* expectedDisplay = new TestRareDisplay(true);
+    TestRareDisplay* iterDisplay = new TestRareDisplay(false);
+    vector<Display*> displays; displays.push_back(expectedDisplay); displays.push_back(iterDisplay);
+    set<int> ends;
+    
+    Rarefact rarefact(order, displays, ends, 3, true);
+    rarefact.getCurve(1, 100);
+    
+    ASSERT_EQ(expectedDisplay->expected.size(), 4);
+    EXPECT_EQ(expectedDisplay->sampled.size(), 0);
+    EXPECT_NEAR(expectedDisplay->expected[3][0], 2.5, 1e-9);
+    
+    EXPECT_EQ(iterDisplay->expected.size(), 0);
+    ASSERT_EQ(iterDisplay->sampled.size(), 4);
+    for (int n = 1; n <= 4; n++) { EXPECT_EQ(iterDisplay->sampled[n].size(), 100); }
+    
+    delete expectedDisplay; delete iterDisplay;
+}
+/**************************************************************************************************/
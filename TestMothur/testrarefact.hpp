@@ -0,0 +1,39 @@
+//
+//  testrarefact.hpp
+//  Mothur
+//
+//  Created by agent on 10/18/26.
+//  Copyright © 2026 Schloss Lab. All rights reserved.
+//
+
+#ifndef testrarefact_hpp
+#define testrarefact_hpp
+
+#include "gtest/gtest.h"
+#include "rarefact.h"
+
+//records the closed form curve points Rarefact sends to a display, and the number of otus each iteration sees
+class TestRareDisplay : public Display {
+    
+public:
+    
+    TestRareDisplay(bool e) : Display(), hasExpected(e) {}
+    ~TestRareDisplay() = default;
+    
+    void update(SAbundVector& rank) { lock_guard<std::mutex> guard(mutex); sampled[rank.getNumSeqs()].push_back(rank.getNumBins()); }
+    void init(string) {}
+    void reset() {}
+    void close() {}
+    bool isCalcMultiple() { return false; }
+    bool hasExpectedCurve() { return hasExpected; }
+    void updateExpected(int numSeqs, vector<double> data) { expected[numSeqs] = data; }
+    
+    map<int, vector<double> > expected; //numSeqs -> mean, lci, hci
+    map<int, vector<int> > sampled; //numSeqs -> otus seen in each iteration
+    
+private:
+    bool hasExpected;
+    std::mutex mutex;
+};
+
+#endif /* testrarefact_hpp */
@@ -0,0 +1,124 @@
+//
+//  testsharedcalcs.cpp
+//  Mothur
+//
+//  Created by agent on 10/18/26.
+//  Copyright © 2026 Schloss Lab. All rights reserved.
+//
+
+#include "testsharedcalcs.hpp"
+
+/**************************************************************************************************/
+TestSharedCalcs::TestSharedCalcs() {  //setup
+    int numGroups = 4; int numBins = 300;
+
+    //mostly empty samples, every fifth bin shared by the first two with singletons and doubletons, no bin empty in all of them
+    unsigned int seed = 7;
+    vector< vector<int> > abunds(numGroups, vector<int>(numBins, 0));
+    for (int i = 0; i < numBins; i++) {
+        bool empty = true;
+        for (int j = 0; j < numGroups; j++) {
+            seed = seed * 1103515245 + 12345; int r = (seed >> 16) % 100;
+            seed = seed * 1103515245 + 12345; int abund = (seed >> 16) % 30;
+
+            if (r < 12)         { abunds[j][i] = 1 + (abund % 3);   }
+            else if (r < 15)    { abunds[j][i] = 5 + abund;         }
+            if ((i % 5 == 0) && (j < 2)) { abunds[j][i] = 1 + (abund % 2); }
+            if (abunds[j][i] != 0) { empty = false; }
+        }
+        if (empty) { abunds[i % numGroups][i] = 1; }
+    }
+
+    for (int j = 0; j < numGroups; j++) {
+        SharedRAbundVector* temp = new SharedRAbundVector(abunds[j]);
+        temp->setLabel("0.03"); temp->setGroup("group" + toString(j+1));
+        dense.push_back(temp);
+
+        SharedRAbundVector* sparseTemp = new SharedRAbundVector(*temp);
+        sparseTemp->setSparse(true);
+        sparse.push_back(sparseTemp);
+    }
+
+    calcs.push_back(new SharedSobsCS());     calcs.push_back(new SharedChao1());      calcs.push_back(new SharedAce());
+    calcs.push_back(new JAbund());           calcs.push_back(new SorAbund());         calcs.push_back(new Jclass());
+    calcs.push_back(new SorClass());         calcs.push_back(new Jest());             calcs.push_back(new SorEst());
+    calcs.push_back(new ThetaYC());          calcs.push_back(new ThetaN());           calcs.push_back(new KSTest());
+    calcs.push_back(new SharedNSeqs());      calcs.push_back(new Ochiai());           calcs.push_back(new Anderberg());
+    calcs.push_back(new Kulczynski());       calcs.push_back(new KulczynskiCody());   calcs.push_back(new Lennon());
+    calcs.push_back(new MorHorn());          calcs.push_back(new BrayCurtis());       calcs.push_back(new Whittaker());
+    calcs.push_back(new Odum());             calcs.push_back(new Canberra());         calcs.push_back(new StructEuclidean());
+    calcs.push_back(new StructChord());      calcs.push_back(new Hellinger());        calcs.push_back(new Manhattan());
+    calcs.push_back(new StructPearson());    calcs.push_back(new Soergel());          calcs.push_back(new Spearman());
+    calcs.push_back(new StructKulczynski()); calcs.push_back(new SpeciesProfile());   calcs.push_back(new Hamming());
+    calcs.push_back(new StructChi2());       calcs.push_back(new Gower());            calcs.push_back(new MemChi2());
+    calcs.push_back(new MemChord());         calcs.push_back(new MemEuclidean());     calcs.push_back(new MemPearson());
+    calcs.push_back(new JSD());              calcs.push_back(new RJSD());
+}
+/**************************************************************************************************/
+TestSharedCalcs::~TestSharedCalcs() {
+    for (int i = 0; i < dense.size(); i++) { delete dense[i]; delete sparse[i]; }
+    for (int i = 0; i < calcs.size(); i++) { delete calcs[i]; }
+}
+/**************************************************************************************************/
+//the pair the way summary.shared and dist.shared pass it, with the rest of the samples for calcs that need them all
+vector<SharedRAbundVector*> TestSharedCalcs::getPair(vector<SharedRAbundVector*>& samples, int i, int j, bool needsAll) {
+    vector<SharedRAbundVector*> pair; pair.push_back(samples[i]); pair.push_back(samples[j]);
+    if (needsAll) {
+        for (int k = 0; k < samples.size(); k++) { if ((k != i) && (k != j)) { pair.push_back(samples[k]); } }
+    }
+    return pair;
+}
+/**************************************************************************************************/
+
+TEST(Test_Calc_SharedCalcs, sparseMatchesDense) {
+    TestSharedCalcs test;
+    ASSERT_TRUE(test.sparse[0]->isSparse());
+    ASSERT_FALSE(test.dense[0]->isSparse());
+    EXPECT_LT(test.sparse[0]->getNumEntries(), test.dense[0]->getNumEntries());
+
+    for (int c = 0; c < test.calcs.size(); c++) {
+        Calculator* calc = test.calcs[c];
+
+        for (int i = 0; i < test.dense.size(); i++) {
+            for (int j = 0; j < i; j++) {
+                EstOutput denseValues = calc->getValues(test.getPair(test.dense, i, j, calc->getNeedsAll()));
+                EstOutput sparseValues = calc->getValues(test.getPair(test.sparse, i, j, calc->getNeedsAll()));
+
+                ASSERT_EQ(denseValues.size(), sparseValues.size()) << calc->getName();
+                for (int k = 0; k < denseValues.size(); k++) { EXPECT_EQ(denseValues[k], sparseValues[k]) << calc->getName() << " " << i << " " << j; }
+            }
+        }
+
+        //summary.shared's all=t runs the calcs for more than two groups on every sample
+        if (calc->getMultiple()) {
+            EstOutput denseValues = calc->getValues(test.dense);
+            EstOutput sparseValues = calc->getValues(test.sparse);
+            EXPECT_EQ(denseValues[0], sparseValues[0]) << calc->getName();
+        }
+    }
+}
+/**************************************************************************************************/
+
+TEST(Test_Calc_SharedCalcs, pairStatsMatchDense) {
+    TestSharedCalcs test;
+    PairwiseShared pairwise(test.sparse, true);
+    sharedPairStats stats;
+
+    for (int c = 0; c < test.calcs.size(); c++) {
+        Calculator* calc = test.calcs[c];
+        if (!calc->hasPairStats() || calc->getNeedsAll()) { continue; }
+
+        for (int i = 0; i < test.dense.size(); i++) {
+            for (int j = 0; j < i; j++) {
+                ASSERT_TRUE(pairwise.getPairStats(i, j, stats));
+
+                EstOutput statsValues = calc->getValues(stats);
+                EstOutput denseValues = calc->getValues(test.getPair(test.dense, i, j, false));
+
+                ASSERT_EQ(denseValues.size(), statsValues.size()) << calc->getName();
+                for (int k = 0; k < denseValues.size(); k++) { EXPECT_EQ(denseValues[k], statsValues[k]) << calc->getName() << " " << i << " " << j; }
+            }
+        }
+    }
+}
+/**************************************************************************************************/
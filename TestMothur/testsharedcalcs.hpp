@@ -0,0 +1,74 @@
+//
+//  testsharedcalcs.hpp
+//  Mothur
+//
+//  Created by agent on 10/18/26.
+//  Copyright © 2026 Schloss Lab. All rights reserved.
+//
+
+#ifndef testsharedcalcs_hpp
+#define testsharedcalcs_hpp
+
+#include "gtest/gtest.h"
+#include "sharedsobscollectsummary.h"
+#include "sharedchao1.h"
+#include "sharedace.h"
+#include "sharednseqs.h"
+#include "sharedjabund.h"
+#include "sharedsorabund.h"
+#include "sharedjclass.h"
+#include "sharedsorclass.h"
+#include "sharedjest.h"
+#include "sharedsorest.h"
+#include "sharedthetayc.h"
+#include "sharedthetan.h"
+#include "sharedkstest.h"
+#include "whittaker.h"
+#include "sharedochiai.h"
+#include "sharedanderbergs.h"
+#include "sharedkulczynski.h"
+#include "sharedkulczynskicody.h"
+#include "sharedlennon.h"
+#include "sharedmorisitahorn.h"
+#include "sharedbraycurtis.h"
+#include "odum.h"
+#include "canberra.h"
+#include "structeuclidean.h"
+#include "structchord.h"
+#include "hellinger.h"
+#include "manhattan.h"
+#include "structpearson.h"
+#include "soergel.h"
+#include "spearman.h"
+#include "structkulczynski.h"
+#include "structchi2.h"
+#include "speciesprofile.h"
+#include "hamming.h"
+#include "gower.h"
+#include "memchi2.h"
+#include "memchord.h"
+#include "memeuclidean.h"
+#include "mempearson.h"
+#include "sharedjsd.h"
+#include "sharedrjsd.h"
+#include "pairwiseshared.hpp"
+
+//the summary.shared and dist.shared calculators run on the same samples stored dense and sparse
+class TestSharedCalcs {
+
+public:
+
+    TestSharedCalcs();
+    ~TestSharedCalcs();
+
+    vector<SharedRAbundVector*> dense;
+    vector<SharedRAbundVector*> sparse;
+    vector<Calculator*> calcs;
+
+    vector<SharedRAbundVector*> getPair(vector<SharedRAbundVector*>&, int, int, bool); //samples, i, j, needsAll
+
+private:
+
+};
+
+#endif /* testsharedcalcs_hpp */
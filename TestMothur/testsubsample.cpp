@@ -41,4 +41,72 @@ TEST(Test_SubSample, getWeightedSample) {
     EXPECT_EQ((it != names.end()),true);
 }
 
+TEST(Test_SubSample, getSampleCounts) {
+    TestSubSample test;
+    
+    vector<int> abunds;
+    abunds.push_back(0); abunds.push_back(1); abunds.push_back(5000); abunds.push_back(20); abunds.push_back(100000); //105021 total reads
+    
+    vector<int> counts = test.getSampleCounts(abunds, 50000);
+    int total = 0;
+    for (int i = 0; i < counts.size(); i++) { EXPECT_LE(counts[i], abunds[i]); total += counts[i]; }
+    EXPECT_EQ(total, 50000);
+    EXPECT_EQ(counts[0], 0);
+    
+    counts = test.getSampleCounts(abunds, 105021); //select all the reads
+    for (int i = 0; i < counts.size(); i++) { EXPECT_EQ(counts[i], abunds[i]); }
+    
+    counts = test.getSampleCountsWithReplacement(abunds, 200000);
+    total = 0;
+    for (int i = 0; i < counts.size(); i++) { total += counts[i]; }
+    EXPECT_EQ(total, 200000);
+    EXPECT_EQ(counts[0], 0);
+}
+
+//mean and variance of each otu's draw over many seeded runs, against the hypergeometric and multinomial distributions
+TEST(Test_SubSample, getSampleDistribution) {
+    MothurOut* m = MothurOut::getInstance();
+    unsigned seed = m->getRandomSeed();
+    m->setRandomSeed(19760620);
+    TestSubSample test;
+    
+    vector<int> abunds;
+    abunds.push_back(0); abunds.push_back(1); abunds.push_back(5); abunds.push_back(20); abunds.push_back(74); //100 total reads
+    double N = 100; double n = 60; int numRuns = 4000;
+    
+    for (int withReplacement = 0; withReplacement < 2; withReplacement++) {
+        vector<double> sums(abunds.size(), 0), sumSquares(abunds.size(), 0);
+        
+        for (int run = 0; run < numRuns; run++) {
+            RAbundVector* rabund = new RAbundVector(abunds);
+            if (withReplacement == 1) { test.getSampleWithReplacement(rabund, n); }
+            else { test.getSample(rabund, n); }
+            
+            ASSERT_EQ(rabund->getNumSeqs(), n);
+            for (int i = 0; i < abunds.size(); i++) {
+                double count = rabund->get(i);
+                if (withReplacement == 0) { EXPECT_LE(count, abunds[i]); }
+                sums[i] += count; sumSquares[i] += count * count;
+            }
+            delete rabund;
+        }
+        
+        for (int i = 0; i < abunds.size(); i++) {
+            double p = abunds[i] / N;
+            double expectedMean = n * p;
+            double expectedVariance = n * p * (1-p); //multinomial
+            if (withReplacement == 0) { expectedVariance *= (N-n) / (N-1); } //hypergeometric
+            
+            double mean = sums[i] / (double)numRuns;
+            double variance = (sumSquares[i] / (double)numRuns) - (mean * mean);
+            
+            //5 standard errors of the mean, variance within 15%
+            EXPECT_NEAR(mean, expectedMean, 5 * sqrt(expectedVariance / (double)numRuns) + 1e-9);
+            EXPECT_NEAR(variance, expectedVariance, 0.15 * expectedVariance + 1e-9);
+        }
+    }
+    
+    m->setRandomSeed(seed);
+}
+
 /**************************************************************************************************/
@@ -777,3 +777,121 @@ TEST(Test_TrimOligos, SingleDirectionReverseOligos) { //ATTACCGCGGCTGCTGG
 
 /**************************************************************************************************/
 
+//the barcodes that can't beat the best match are not aligned, so check the diffs, group and trim of matches found by aligning
+TEST(Test_TrimOligos, SingleDirectionStripBarcodesWithDiffs) {
+    map<string, int> barcodes; map<string, int> primers; vector<string> revPrimers;
+    barcodes["ACGTNACG"] = 0; //ambiguous, compared one at a time
+    barcodes["TGGTGAAC"] = 1;
+    barcodes["TTCGTGGC"] = 2;
+    string rest = "GCCGTCAATTCCTTTGAGTTTCACCGTTGCCGGCGTACTCCCCAGG";
+    
+    TrimOligos trim(0,0,1,primers,barcodes,revPrimers); //pdiffs, rpdiffs, bdiffs, primers, barcodes, revPrimers
+    
+    int groupIndex;
+    Sequence seq("seq1", "ACGTTACG" + rest); //N matches the T
+    vector<int> results = trim.stripBarcode(seq, groupIndex);
+    EXPECT_EQ(0, groupIndex);
+    EXPECT_EQ(0, results[0]);
+    EXPECT_EQ("match", trim.getCodeValue(results[1], 1));
+    EXPECT_EQ(rest, seq.getUnaligned());
+    
+    seq.setAligned("ACCTTACG" + rest); //1 substitution from the ambiguous barcode
+    results = trim.stripBarcode(seq, groupIndex);
+    EXPECT_EQ(0, groupIndex);
+    EXPECT_EQ(1, results[0]);
+    EXPECT_EQ("match", trim.getCodeValue(results[1], 1));
+    EXPECT_EQ(rest, seq.getUnaligned());
+    
+    seq.setAligned("TGGTGAC" + rest); //an A is missing, so 7 bases are trimmed
+    results = trim.stripBarcode(seq, groupIndex);
+    EXPECT_EQ(1, groupIndex);
+    EXPECT_EQ(1, results[0]);
+    EXPECT_EQ("match", trim.getCodeValue(results[1], 1));
+    EXPECT_EQ(rest, seq.getUnaligned());
+    
+    seq.setAligned("AAAAAAAAAA" + rest); //3 or more diffs from every barcode
+    results = trim.stripBarcode(seq, groupIndex);
+    EXPECT_LT(1, results[0]);
+    EXPECT_EQ("noMatch", trim.getCodeValue(results[1], 1));
+}
+/**************************************************************************************************/
+TEST(Test_TrimOligos, SingleDirectionStripPrimersWithDiffs) {
+    map<string, int> barcodes; map<string, int> primers; vector<string> revPrimers;
+    primers["CCGTCAATTCMTTTRAGT"] = 0;
+    primers["ATTAGAWACCCBDGTAGTCC"] = 1;
+    primers["CCTACGGGAGGCAGCAG"] = 2;
+    string rest = "TTCACCGTTGCCGGCGTACTCCCCAGGTGGAATGCTTAACGC";
+    
+    TrimOligos trim(2,0,0,primers,barcodes,revPrimers); //pdiffs, rpdiffs, bdiffs, primers, barcodes, revPrimers
+    
+    int groupIndex;
+    Sequence seq("seq1", "CCGTGAATTCATTTGTGT" + rest); //2 substitutions, the M and R match
+    vector<int> results = trim.stripForward(seq, groupIndex);
+    EXPECT_EQ(0, groupIndex);
+    EXPECT_EQ(2, results[0]);
+    EXPECT_EQ("match", trim.getCodeValue(results[1], 2));
+    EXPECT_EQ(rest, seq.getUnaligned());
+    
+    seq.setAligned("ATTAGATACACCGGTAGTCC" + rest); //1 substitution, the W, B and D match
+    results = trim.stripForward(seq, groupIndex);
+    EXPECT_EQ(1, groupIndex);
+    EXPECT_EQ(1, results[0]);
+    EXPECT_EQ("match", trim.getCodeValue(results[1], 2));
+    EXPECT_EQ(rest, seq.getUnaligned());
+    
+    seq.setAligned("CCTACGGGAGGCAGCAG" + rest); //exact
+    results = trim.stripForward(seq, groupIndex);
+    EXPECT_EQ(2, groupIndex);
+    EXPECT_EQ(0, results[0]);
+    EXPECT_EQ(rest, seq.getUnaligned());
+    
+    seq.setAligned("GGGGGGGGGGGGGGGGGGGGGG" + rest);
+    results = trim.stripForward(seq, groupIndex);
+    EXPECT_LT(2, results[0]);
+    EXPECT_EQ("noMatch", trim.getCodeValue(results[1], 2));
+}
+/**************************************************************************************************/
+//a pair with a NONE matches any sequence on that side with 0 diffs
+TEST(Test_TrimOligos, PairedStripBarcodesWithDiffs) {
+    TestTrimOligos testTrim;
+    testTrim.oligos.loadPaired();
+    oligosPair noReverse; noReverse.forward = "TTAGG"; noReverse.reverse = "NONE";
+    testTrim.oligos.ipbarcodes[9] = noReverse;
+    string middle = "ACGTAGCTAGGCTAGCATCGATCGATGCTAGCTAGT";
+    
+    TrimOligos trim(0,1,0,0,testTrim.oligos.ipprimers,testTrim.oligos.ipbarcodes,false); //pdiffs, bdiffs, ldiffs, sdiffs, primers, barcodes, hasIndex
+    
+    int groupIndex;
+    QualityScores qual;
+    Sequence seq("seq1", "CCAAC" + middle + "AACCA"); //exact F01R2B
+    vector<int> results = trim.stripBarcode(seq, qual, groupIndex);
+    EXPECT_EQ(1, groupIndex);
+    EXPECT_EQ(0, results[0]); EXPECT_EQ(0, results[1]); EXPECT_EQ(0, results[3]);
+    EXPECT_EQ(middle, seq.getUnaligned());
+    
+    seq.setAligned("CCTAC" + middle + "AACCA"); //1 diff from CCAAC and CTTAC, only F01R2B pairs with AACCA
+    results = trim.stripBarcode(seq, qual, groupIndex);
+    EXPECT_EQ(1, groupIndex);
+    EXPECT_EQ(1, results[0]);
+    EXPECT_EQ("match", trim.getCodeValue(results[1], 1));
+    EXPECT_EQ("match", trim.getCodeValue(results[3], 1));
+    EXPECT_EQ(middle, seq.getUnaligned());
+    
+    seq.setAligned("TTAGG" + middle); //exact forward, no reverse
+    results = trim.stripBarcode(seq, qual, groupIndex);
+    EXPECT_EQ(9, groupIndex);
+    EXPECT_EQ(0, results[0]); EXPECT_EQ(0, results[1]);
+    EXPECT_EQ(middle, seq.getUnaligned());
+    
+    seq.setAligned("TTAGC" + middle); //1 diff forward, the NONE reverse matches
+    results = trim.stripBarcode(seq, qual, groupIndex);
+    EXPECT_EQ(9, groupIndex);
+    EXPECT_EQ(1, results[0]);
+    EXPECT_EQ("match", trim.getCodeValue(results[1], 1));
+    
+    seq.setAligned("AAAAAAA" + middle + "AACCA"); //3 or more diffs from every forward barcode
+    results = trim.stripBarcode(seq, qual, groupIndex);
+    EXPECT_LT(1, results[0]);
+    EXPECT_EQ("noMatch", trim.getCodeValue(results[1], 1));
+}
+/**************************************************************************************************/
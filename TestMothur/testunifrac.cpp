@@ -0,0 +1,86 @@
+//
+//  testunifrac.cpp
+//  Mothur
+//
+//  Created by agent on 10/18/26.
+//  Copyright © 2026 Schloss Lab. All rights reserved.
+//
+
+#include "testunifrac.hpp"
+
+/**************************************************************************************************/
+TestUnifrac::TestUnifrac() {  //setup
+    ct = new CountTable();
+    ct->addGroup("A"); ct->addGroup("B"); ct->addGroup("C"); ct->addGroup("D");
+    
+    //B and C only meet below node 8, so leaving the root out of their pair removes node 8's branch
+    int counts[6][4] = { {3, 0, 0, 1}, {0, 2, 0, 0}, {1, 0, 4, 0}, {0, 1, 2, 0}, {2, 0, 0, 0}, {0, 0, 0, 2} };
+    vector<string> names;
+    for (int i = 0; i < 6; i++) {
+        names.push_back("s" + toString(i));
+        ct->push_back(names[i], vector<int>(counts[i], counts[i]+4));
+    }
+    
+    tree = new Tree(ct, names);
+    
+    //6 = (0,1), 7 = (2,3), 8 = (6,7), 9 = (4,5), 10 = (8,9) is the root
+    int lefts[5] = { 0, 2, 6, 4, 8 }; int rights[5] = { 1, 3, 7, 5, 9 };
+    for (int i = 0; i < 5; i++) {
+        tree->tree[6+i].setChildren(lefts[i], rights[i]);
+        tree->tree[lefts[i]].setParent(6+i);
+        tree->tree[rights[i]].setParent(6+i);
+    }
+    float lengths[10] = { 0.1, 0.2, 0.3, 0.15, 0.25, 0.05, 0.4, 0.35, 0.5, 0.6 };
+    for (int i = 0; i < 10; i++) { tree->tree[i].setBranchLength(lengths[i]); }
+    
+    tree->assembleTree();
+}
+/**************************************************************************************************/
+TestUnifrac::~TestUnifrac() { delete tree; delete ct; }
+/**************************************************************************************************/
+//the striped pass against the per pair calculations, for odd and even numbers of groups, with and without the root
+TEST(Test_Unifrac, stripedMatchesPairs) {
+    TestUnifrac test;
+    
+    vector<string> allGroups; allGroups.push_back("A"); allGroups.push_back("B"); allGroups.push_back("C"); allGroups.push_back("D");
+    
+    for (int numGroups = 3; numGroups <= 4; numGroups++) {
+        vector<string> groups(allGroups.begin(), allGroups.begin()+numGroups);
+        int numPairs = numGroups * (numGroups-1) / 2;
+        
+        for (int r = 0; r < 2; r++) {
+            bool includeRoot = (r == 1);
+            
+            for (int processors = 1; processors <= 2; processors++) {
+                StripedUnifrac striped(test.tree, groups, includeRoot);
+                EstOutput weighted = striped.getWeighted(processors);
+                EstOutput unweighted = striped.getUnweighted(processors);
+                ASSERT_EQ(weighted.size(), numPairs);
+                ASSERT_EQ(unweighted.size(), numPairs);
+                
+                //per pair weighted, in the same AB, AC, BC... order
+                Weighted weightedCalc(includeRoot, groups);
+                int pair = 0;
+                for (int i = 0; i < numGroups; i++) {
+                    for (int l = 0; l < i; l++) {
+                        EstOutput expected = weightedCalc.getValues(test.tree, groups[i], groups[l]);
+                        EXPECT_NEAR(weighted[pair], expected[0], 1e-6);
+                        pair++;
+                    }
+                }
+                
+                //per pair unweighted, a random tree with no labels swapped is the tree itself
+                Unweighted unweightedCalc(includeRoot, groups);
+                vector< vector<int> > noSwaps(numPairs);
+                EstOutput expected = unweightedCalc.getValues(test.tree, noSwaps, 1);
+                ASSERT_EQ(expected.size(), numPairs);
+                for (int i = 0; i < numPairs; i++) { EXPECT_NEAR(unweighted[i], expected[i], 1e-6); }
+                
+                //C-B by hand, unique branches s1, s2 and node 6 over s1, s2, s3 and nodes 6 and 7, plus node 8 with the root
+                if (includeRoot) { EXPECT_NEAR(unweighted[2], 0.9 / 1.9, 1e-6); }
+                else { EXPECT_NEAR(unweighted[2], 0.9 / 1.4, 1e-6); }
+            }
+        }
+    }
+}
+/**************************************************************************************************/
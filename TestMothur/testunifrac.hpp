@@ -0,0 +1,29 @@
+//
+//  testunifrac.hpp
+//  Mothur
+//
+//  Created by agent on 10/18/26.
+//  Copyright © 2026 Schloss Lab. All rights reserved.
+//
+
+#ifndef testunifrac_hpp
+#define testunifrac_hpp
+
+#include "gtest/gtest.h"
+#include "stripedunifrac.hpp"
+#include "weighted.h"
+#include "unweighted.h"
+
+//6 sequences from groups A-D on a fixed tree, ((s0,s1),(s2,s3)),(s4,s5)
+class TestUnifrac {
+    
+public:
+    
+    TestUnifrac();
+    ~TestUnifrac();
+    
+    CountTable* ct;
+    Tree* tree;
+};
+
+#endif /* testunifrac_hpp */
@@ -0,0 +1,293 @@
+/*
+ *  bandedneedleman.cpp
+ *  Mothur
+ *
+ *  Created by agent on 10/18/26.
+ *  Copyright 2026 Schloss Lab. All rights reserved.
+ *
+ */
+
+#include "bandedneedleman.hpp"
+
+#define BANDED_KMER_SIZE 8
+#define BANDED_NO_SCORE -1e30f
+
+/**************************************************************************************************/
+
+BandedNeedleman::BandedNeedleman(float gO, float f, float mm, int r) :
+Alignment(), gap(gO), match(f), mismatch(mm) {
+	try {
+		nRows = r;	nCols = r;		//	no matrix to allocate, the band is sized for each pair of sequences
+		bandLow = 0; bandHigh = 0; bandWidth = 1;
+		endGaps = 'x'; endGapRow = 0; endGapColumn = 0;
+		kmerPositions.assign(1 << (2*BANDED_KMER_SIZE), -1);
+	}
+	catch(exception& e) {
+		m->errorOut(e, "BandedNeedleman", "BandedNeedleman");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+
+void BandedNeedleman::resize(int A) { nRows = A; nCols = A; }
+
+/**************************************************************************************************/
+//returns the kmer starting at position i, or -1 if it has a base other than ACGTU
+static int getBandKmer(const string& seq, int i) {
+	int kmer = 0;
+	for (int k = 0; k < BANDED_KMER_SIZE; k++) {
+		kmer <<= 2;
+		switch (seq[i+k]) {
+			case 'A': case 'a':                     break;
+			case 'C': case 'c':         kmer |= 1;  break;
+			case 'G': case 'g':         kmer |= 2;  break;
+			case 'T': case 't': case 'U': case 'u': kmer |= 3;  break;
+			default: return -1;
+		}
+	}
+	return kmer;
+}
+/**************************************************************************************************/
+//finds the most common diagonal of the kmers that occur once in seqB, and bands around the matches near it
+void BandedNeedleman::findBand() {
+	try {
+		bandLow = -(lB-1);	bandHigh = lA-1;	//	the whole matrix if nothing better is found
+
+		int numKmersA = lA - BANDED_KMER_SIZE;	//	the strings start with a dummy space
+		int numKmersB = lB - BANDED_KMER_SIZE;
+		if ((numKmersA <= 0) || (numKmersB <= 0)) { return; }
+
+		for (int i = 1; i <= numKmersB; i++) {
+			int kmer = getBandKmer(seqB, i);
+			if (kmer == -1) { continue; }
+			if (kmerPositions[kmer] == -1)	{ kmerPositions[kmer] = i;	}
+			else							{ kmerPositions[kmer] = -2;	}
+		}
+
+		//diagonal = column - row, offset so the counts start at 0
+		diagonalCounts.assign(lA + lB, 0);
+		int offset = lB - 1;
+		int bestDiagonal = 0, bestCount = 0;
+		for (int j = 1; j <= numKmersA; j++) {
+			int kmer = getBandKmer(seqA, j);
+			if ((kmer == -1) || (kmerPositions[kmer] < 0)) { continue; }
+
+			int diagonal = j - kmerPositions[kmer];
+			int count = ++diagonalCounts[diagonal+offset];
+			if (count > bestCount) { bestCount = count; bestDiagonal = diagonal; }
+		}
+
+		//the band has room for indels around the matches that agree with the best diagonal
+		int shorter = min(lA, lB);
+		int padding = max(32, shorter / 20);
+		if (bestCount != 0) {
+			int low = bestDiagonal, high = bestDiagonal;
+			for (int d = max(bestDiagonal-padding, -(lB-1)); d <= min(bestDiagonal+padding, lA-1); d++) {
+				if (diagonalCounts[d+offset] != 0) { low = min(low, d); high = max(high, d); }
+			}
+			bandLow = max(low - padding, -(lB-1));
+			bandHigh = min(high + padding, lA-1);
+		}
+
+		for (int i = 1; i <= numKmersB; i++) {
+			int kmer = getBandKmer(seqB, i);
+			if (kmer != -1) { kmerPositions[kmer] = -1; }
+		}
+	}
+	catch(exception& e) {
+		m->errorOut(e, "BandedNeedleman", "findBand");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+
+void BandedNeedleman::align(string A, string B, bool createBaseMap){
+	try {
+
+		seqA = ' ' + A;	lA = seqA.length();		//	algorithm requires a dummy space at the beginning of each string
+		seqB = ' ' + B;	lB = seqB.length();		//	algorithm requires a dummy space at the beginning of each string
+
+		findBand();
+		fillBand();
+		setOverlap();						//	Fix gaps at the end of the sequences
+
+		//a best path that runs along the edge of the band may have been kept from a better one outside it, so the band
+		//is widened until the path stays inside it.  Once the band covers the whole matrix the result is NeedlemanOverlap's
+		while (leavesBand()) {
+			if (m->getControl_pressed()) { break; }
+
+			int width = bandHigh - bandLow + 1;
+			bandLow = max(bandLow - width, -(lB-1));
+			bandHigh = min(bandHigh + width, lA-1);
+
+			fillBand();
+			setOverlap();
+		}
+
+		traceBack(createBaseMap);			//	Traceback the alignment to populate seqAaln and seqBaln
+	}
+	catch(exception& e) {
+		m->errorOut(e, "BandedNeedleman", "align");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+//fills the cells between bandLow and bandHigh, keeping the last row, the last column and the pointers
+void BandedNeedleman::fillBand(){
+	try {
+		bandWidth = bandHigh - bandLow + 1;
+
+		traceBits.assign(((long long)(lB-1) * bandWidth + 3) / 4, 0);
+		previousRow.assign(bandWidth, BANDED_NO_SCORE);
+		currentRow.assign(bandWidth, BANDED_NO_SCORE);
+		lastColumn.assign(lB, BANDED_NO_SCORE);
+
+		for(int i=1;i<lB;i++){
+			if (m->getControl_pressed()) { break; }
+
+			int jStart = max(1, i + bandLow);
+			int jEnd = min(lA - 1, i + bandHigh);
+			long long rowStart = (long long)(i-1) * bandWidth;
+
+			for(int j=jStart;j<=jEnd;j++){
+				int p = j - i - bandLow;		//	cell (i-1, j-1) is at p in the previous row, (i-1, j) at p+1 and (i, j-1) at p-1
+
+				float diagonal = ((i == 1) || (j == 1)) ? 0 : previousRow[p];
+				if(seqB[i] == seqA[j])	{	diagonal += match;		}
+				else					{	diagonal += mismatch;	}
+
+				float up, left;
+				if (i == 1)						{	up = 0 + gap;					}
+				else if (p+1 < bandWidth)		{	up = previousRow[p+1] + gap;	}
+				else							{	up = BANDED_NO_SCORE;			}
+
+				if (j == 1)						{	left = 0 + gap;					}
+				else if (p > 0)					{	left = currentRow[p-1] + gap;	}
+				else							{	left = BANDED_NO_SCORE;			}
+
+				int pointer;					//	0 = diagonal, 1 = up, 2 = left, same ties as NeedlemanOverlap
+				if(diagonal >= up){
+					if(diagonal >= left)	{	currentRow[p] = diagonal;	pointer = 0;	}
+					else					{	currentRow[p] = left;		pointer = 2;	}
+				}
+				else{
+					if(up >= left)			{	currentRow[p] = up;			pointer = 1;	}
+					else					{	currentRow[p] = left;		pointer = 2;	}
+				}
+
+				long long cell = rowStart + p;
+				traceBits[cell >> 2] |= (pointer << ((cell & 3) * 2));
+			}
+
+			if ((jStart <= jEnd) && (jEnd == lA-1)) { lastColumn[i] = currentRow[lA-1-i-bandLow]; }
+			previousRow.swap(currentRow);	//	the last row ends up in previousRow
+		}
+	}
+	catch(exception& e) {
+		m->errorOut(e, "BandedNeedleman", "fillBand");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+//walks the path traceBack will take and checks whether it reaches an edge of the band that is not an edge of the matrix
+bool BandedNeedleman::leavesBand(){
+	try {
+		bool lowIsEdge = (bandLow == -(lB-1));
+		bool highIsEdge = (bandHigh == lA-1);
+		if (lowIsEdge && highIsEdge) { return false; }
+
+		//the end cell was only picked from the cells of the last row and column inside the band
+		int row = lB-1;
+		int column = lA-1;
+		if (endGaps == 'u')			{ row = endGapRow;			}
+		else if (endGaps == 'l')	{ column = endGapColumn;	}
+		if (((column - row - bandLow) < 0) || ((column - row - bandLow) >= bandWidth)) { return true; }
+
+		row = lB-1;
+		column = lA-1;
+		char prevCell = getPrevCell(row, column);
+
+		while (prevCell != 'x') {
+			bool endGap = ((endGaps == 'u') && (column == lA-1) && (row > endGapRow)) || ((endGaps == 'l') && (row == lB-1) && (column > endGapColumn));
+			if ((row != 0) && (column != 0) && !endGap) {
+				int p = column - row - bandLow;
+				if ((p == 0) && (column != 1) && !lowIsEdge)				{ return true; }	//	no left cell
+				if ((p == bandWidth-1) && (row != 1) && !highIsEdge)		{ return true; }	//	no up cell
+			}
+
+			if (prevCell == 'u')		{ --row;				}
+			else if (prevCell == 'l')	{ --column;				}
+			else						{ --row; --column;		}
+
+			if ((row < 0) || (column < 0)) { return false; }
+			prevCell = getPrevCell(row, column);
+		}
+
+		return ((row != 0) || (column != 0));		//	a cell outside the band
+	}
+	catch(exception& e) {
+		m->errorOut(e, "BandedNeedleman", "leavesBand");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+//the score of a cell in the last row or column, or the first row or column which are all 0
+float BandedNeedleman::getScore(int row, int column) {
+	if ((row == 0) || (column == 0))	{ return 0;						}
+	if (column == lA-1)					{ return lastColumn[row];		}
+
+	int p = column - row - bandLow;
+	if ((p < 0) || (p >= bandWidth))	{ return BANDED_NO_SCORE;		}
+	return previousRow[p];
+}
+/**************************************************************************************************/
+//picks the end gaps from the highest score in the last column and row, like Overlap::setOverlap
+void BandedNeedleman::setOverlap() {
+	try {
+		int row = lB-1;
+		int column = lA-1;
+
+		float max = -100;
+		int rowIndex = column;
+		for(int i=0;i<lB;i++){
+			float score = getScore(i, column);
+			if(score >= max){	rowIndex = i;	max = score;	}
+		}
+
+		max = -100;
+		int colIndex = row;
+		for(int i=0;i<lA;i++){
+			float score = getScore(row, i);
+			if(score >= max){	colIndex = i;	max = score;	}
+		}
+
+		endGaps = 'x';
+		if(colIndex == column && rowIndex == row){}
+		else if(getScore(row, colIndex) < getScore(rowIndex, column))	{	endGaps = 'u';	endGapRow = rowIndex;		}
+		else															{	endGaps = 'l';	endGapColumn = colIndex;	}
+	}
+	catch(exception& e) {
+		m->errorOut(e, "BandedNeedleman", "setOverlap");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+
+char BandedNeedleman::getPrevCell(int row, int column) {
+	if ((row == 0) && (column == 0))										{	return 'x';	}
+	if ((endGaps == 'u') && (column == lA-1) && (row > endGapRow))			{	return 'u';	}
+	if ((endGaps == 'l') && (row == lB-1) && (column > endGapColumn))		{	return 'l';	}
+	if (row == 0)															{	return 'l';	}
+	if (column == 0)														{	return 'u';	}
+
+	int p = column - row - bandLow;
+	if ((p < 0) || (p >= bandWidth))										{	return 'x';	}
+
+	long long cell = (long long)(row-1) * bandWidth + p;
+	int pointer = (traceBits[cell >> 2] >> ((cell & 3) * 2)) & 3;
+
+	if (pointer == 0)		{	return 'd';	}
+	else if (pointer == 1)	{	return 'u';	}
+	return 'l';
+}
+/**************************************************************************************************/
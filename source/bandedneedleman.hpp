@@ -0,0 +1,68 @@
+#ifndef BANDEDNEEDLEMAN_H
+#define BANDEDNEEDLEMAN_H
+
+/*
+ *  bandedneedleman.hpp
+ *  Mothur
+ *
+ *  Created by agent on 10/18/26.
+ *  Copyright 2026 Schloss Lab. All rights reserved.
+ *
+ *	This class is an Alignment child class that scores alignments like NeedlemanOverlap, but only fills the cells
+ *	near the diagonal the two sequences share.  The diagonal is found from the 8mers that occur once in sequence B
+ *	and also occur in sequence A, and the band covers the diagonals of those matches plus some room for indels.
+ *	If the sequences share no kmers the band covers the whole matrix.
+ *
+ *	Only two rows of scores are kept, and the pointer for each cell in the band is stored in 2 bits, so memory is
+ *	proportional to the sequence length times the band width instead of the square of the longest template.  The
+ *	first row and column are free leading gaps and the end gaps are chosen like the Overlap class does.  If the best
+ *	path in the band runs along an edge of the band that is not an edge of the matrix, or its end cell is outside the
+ *	band, the band is widened and filled again until the path stays inside it, so indels that drift the alignment off
+ *	the kmer diagonal are still found.
+ *
+ *	Gaps cost the same to open and extend, like NeedlemanOverlap.  There is no banded GotohOverlap, so align=banded
+ *	does not use the gapextend parameter.
+ *
+ */
+
+#include "mothur.h"
+#include "alignment.hpp"
+
+/**************************************************************************************************/
+
+class BandedNeedleman : public Alignment {
+
+public:
+	BandedNeedleman(float, float, float, int);
+	~BandedNeedleman() = default;
+	void align(string, string, bool createBaseMap=false);
+	void resize(int);
+
+protected:
+	char getPrevCell(int, int);
+
+private:
+	float gap;
+	float match;
+	float mismatch;
+
+	int bandLow, bandHigh, bandWidth;	//	the band is the cells where column - row is between bandLow and bandHigh
+	char endGaps;						//	'u' or 'l' if the end gaps are in the last column or row, like Overlap
+	int endGapRow, endGapColumn;
+
+	vector<unsigned char> traceBits;	//	rows 1 to lB-1, bandWidth 2 bit pointers per row
+	vector<float> previousRow, currentRow;
+	vector<float> lastColumn;
+	vector<int> kmerPositions;			//	position of each 8mer in seqB, -1 if missing, -2 if repeated
+	vector<int> diagonalCounts;
+
+	void findBand();
+	void fillBand();
+	bool leavesBand();
+	void setOverlap();
+	float getScore(int, int);
+};
+
+/**************************************************************************************************/
+
+#endif
@@ -8,6 +8,31 @@
 
 #include "calculator.h"
 
+/***********************************************************************/
+void Calculator::getNonZeroBins(SharedRAbundVector* A, SharedRAbundVector* B, vector<int>& bins, vector<int>& abundsA, vector<int>& abundsB) {
+    try {
+        bins.clear(); abundsA.clear(); abundsB.clear();
+        
+        //dense samples store the empty bins too, so they are skipped here
+        int a = 0, b = 0;
+        int numA = A->getNumEntries(), numB = B->getNumEntries();
+        while ((a < numA) || (b < numB)) {
+            int binA = (a < numA) ? A->getEntryBin(a) : -1;
+            int binB = (b < numB) ? B->getEntryBin(b) : -1;
+            
+            int bin, abundA = 0, abundB = 0;
+            if ((binB == -1) || ((binA != -1) && (binA < binB)))    { bin = binA; abundA = A->getEntryAbund(a); a++; }
+            else if ((binA == -1) || (binB < binA))                 { bin = binB; abundB = B->getEntryAbund(b); b++; }
+            else { bin = binA; abundA = A->getEntryAbund(a); abundB = B->getEntryAbund(b); a++; b++; }
+            
+            if ((abundA != 0) || (abundB != 0)) { bins.push_back(bin); abundsA.push_back(abundA); abundsB.push_back(abundB); }
+        }
+    }
+    catch(exception& e) {
+        m->errorOut(e, "Calculator", "getNonZeroBins");
+        exit(1);
+    }
+}
 /***********************************************************************/
 int DistCalc::setStart(string seqA, string seqB) {
     try {
@@ -15,6 +15,7 @@ EstOutput getValues(SharedRAbundVector* shared1, SharedRAbundVector* shared2), w
 
 
 typedef vector<double> EstOutput;
+struct sharedPairStats; //pairwiseshared.hpp
 
 /***********************************************************************/
 
@@ -30,6 +31,9 @@ public:
 	virtual EstOutput getValues(vector<SharedRAbundVector*>) = 0;
     //optional calc that returns the otus labels of shared otus
     virtual EstOutput getValues(vector<SharedRAbundVector*> sv, vector<string>&, vector<string>) { data = getValues(sv); return data; }
+    //two group calcs that only need the sums in pairwiseshared.hpp override these, so summary.shared and dist.shared scan each pair once
+    virtual bool hasPairStats()                     {   return false;   }
+    virtual EstOutput getValues(sharedPairStats&)   {   return data;    }
 	virtual void print(ostream& f)	{ f.setf(ios::fixed, ios::floatfield); f.setf(ios::showpoint);
 									  f << data[0]; for(int i=1;i<data.size();i++){	f << '\t' << data[i];	}}
     
@@ -49,6 +53,10 @@ protected:
 	int cols;
 	bool multiple;
 	bool needsAll;
+    
+    //the bins either sample has sequences in, in bin order, and their abundances in each sample. Walks the stored entries,
+    //so sparse samples are not expanded. Calculators whose sums include the bins neither sample has sequences in add them after
+    void getNonZeroBins(SharedRAbundVector*, SharedRAbundVector*, vector<int>&, vector<int>&, vector<int>&); //sampleA, sampleB, bins, abundsA, abundsB
 
 };
 
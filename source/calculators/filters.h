@@ -15,6 +15,20 @@
 #include "utils.hpp"
 
 
+/***********************************************************************/
+//column codes getFreqs counts with, 0 to 3 are A, T, G and C, 4 is anything else and 5 is a gap
+struct filterCodes {
+	unsigned char codes[256];
+	
+	filterCodes() {
+		for (int i = 0; i < 256; i++) { codes[i] = 4; }
+		codes[(int)'A'] = 0; codes[(int)'a'] = 0;
+		codes[(int)'T'] = 1; codes[(int)'t'] = 1; codes[(int)'U'] = 1; codes[(int)'u'] = 1;
+		codes[(int)'G'] = 2; codes[(int)'g'] = 2;
+		codes[(int)'C'] = 3; codes[(int)'c'] = 3;
+		codes[(int)'-'] = 5; codes[(int)'.'] = 5;
+	}
+};
 /***********************************************************************/
 
 class Filters {
@@ -29,7 +43,8 @@ public:
 	void setSoft(float s)		{		soft = s;		}
 	void setTrump(float t)		{		trump = t;		}
 	void setNumSeqs(int num)	{	numSeqs = num;		}
-	vector<int> a, t, g, c, gap;
+	vector<int> a, t, g, c;
+	vector<int> other; //number of sequences with something other than a base or a gap in the column, the rest have a gap
 	
 	
 	void initialize() {
@@ -37,7 +52,7 @@ public:
 		t.assign(alignmentLength, 0);
 		g.assign(alignmentLength, 0);
 		c.assign(alignmentLength, 0);
-		gap.assign(alignmentLength, 0);
+		other.assign(alignmentLength, 0);
 	}
 
 	void doSoft() { 
@@ -56,10 +71,21 @@ public:
 		}
 	}
 	
+	//adds the counts of a filter made from another part of the file
+	void mergeFreqs(const Filters& part) {
+		for(int i=0;i<alignmentLength;i++){
+			a[i] += part.a[i];
+			t[i] += part.t[i];
+			g[i] += part.g[i];
+			c[i] += part.c[i];
+			other[i] += part.other[i];
+		}
+	}
+	
 	void doVertical() {
 
 		for(int i=0;i<alignmentLength;i++){
-			if(gap[i] == numSeqs)	{	filter[i] = '0';	}
+			if(isAllGaps(i))	{	filter[i] = '0';	}
 		}
 	
 	}
@@ -67,7 +93,7 @@ public:
     void doVerticalAllBases() {
         
         for(int i=0;i<alignmentLength;i++){
-            if(gap[i] == numSeqs)       {	filter[i] = '0';	}
+            if(isAllGaps(i))            {	filter[i] = '0';	}
             else if(a[i] == numSeqs)	{	filter[i] = '0';	}
             else if(t[i] == numSeqs)	{	filter[i] = '0';	}
             else if(c[i] == numSeqs)	{	filter[i] = '0';	}
@@ -76,16 +102,15 @@ public:
         
     }
 	
-	void doTrump(Sequence seq) {
+	void doTrump(Sequence seq) { doTrump(seq.getAligned()); }
 	
-		string curAligned = seq.getAligned();
-
-		for(int j = 0; j < alignmentLength; j++) {
+	void doTrump(const string& curAligned) {
+		int length = min((int)curAligned.length(), alignmentLength);
+		for(int j = 0; j < length; j++) {
 			if(curAligned[j] == trump){
 				filter[j] = '0';
 			}
 		}
-
 	}
 
 	void doHard(string hard) {
@@ -99,28 +124,39 @@ public:
         if (filter.length() != alignmentLength) {  m->mothurOut("[ERROR]: Sequences are not all the same length as the filter, please correct.\n");  m->setControl_pressed(true); }
 	}
 
-	void getFreqs(Sequence seq) {
-	
-        string curAligned = seq.getAligned();
-        
-        getFreqs(curAligned);
-    }
+	void getFreqs(Sequence seq) { getFreqs(seq.getAligned()); }
     
-    void getFreqs(string seq) {
+    //gaps are not counted, so a column of gaps is skipped 8 bytes at a time
+    void getFreqs(const string& curAligned) {
+        static const filterCodes freqCodes;
+        int* counts[6] = { a.data(), t.data(), g.data(), c.data(), other.data(), other.data() };
+        
+        numSeqs++;
+        int length = min((int)curAligned.length(), alignmentLength);
+        const char* seq = curAligned.data();
         
-        string curAligned = seq; numSeqs++;
+        const unsigned long long highBits = 0xFCFCFCFCFCFCFCFCULL, gapHighBits = 0x2C2C2C2C2C2C2C2CULL, lowBits = 0x0101010101010101ULL;
         
-        for(int j=0;j<alignmentLength;j++){
-            if(toupper(curAligned[j]) == 'A')										{	a[j]++;		}
-            else if(toupper(curAligned[j]) == 'T' || toupper(curAligned[j]) == 'U')	{	t[j]++;		}
-            else if(toupper(curAligned[j]) == 'G')									{	g[j]++;		}
-            else if(toupper(curAligned[j]) == 'C')									{	c[j]++;		}
-            else if(curAligned[j] == '-' || curAligned[j] == '.')					{	gap[j]++;	}
+        int j = 0;
+        while (j < length) {
+            if ((j + 8) <= length) {
+                //'-' and '.' are the only bytes that are 001011xx with the last 2 bits different
+                unsigned long long word; memcpy(&word, seq + j, 8);
+                if (((word & highBits) == gapHighBits) && (((word ^ (word >> 1)) & lowBits) == lowBits)) { j += 8; continue; }
+            }
+            
+            //without a branch for each base, gaps add 0
+            unsigned char code = freqCodes.codes[(unsigned char)seq[j]];
+            counts[code][j] += (code != 5);
+            j++;
         }
     }
 		
 protected:
 	string filter;
+	
+	bool isAllGaps(int i) { return ((a[i] + t[i] + g[i] + c[i] + other[i]) == 0); }
+
 	int alignmentLength, numSeqs;
 	float soft;
 	char trump;
@@ -14,29 +14,28 @@ EstOutput Gower::getValues(vector<SharedRAbundVector*> shared) {
 	try {
 		data.resize(1,0);
 		
-		vector<int> maxOtus; maxOtus.resize(shared[0]->getNumBins());
-		vector<int> minOtus; minOtus.resize(shared[0]->getNumBins());
-		//for each otu
-		for (int i = 0; i < shared[0]->getNumBins(); i++) {
+		//bins neither sample has sequences in add nothing to the sum
+		vector<int> bins, abundsA, abundsB;
+		getNonZeroBins(shared[0], shared[1], bins, abundsA, abundsB);
+		
+		double sum = 0.0;
+		for (int i = 0; i < bins.size(); i++) {
+			int A = abundsA[i];
+			int B = abundsB[i];
 			
 			//set otus min and max to first one
-			minOtus[i] = shared[0]->get(i);
-			maxOtus[i] = shared[0]->get(i);
+			int minOtu = A;
+			int maxOtu = A;
 			
 			//for each group
 			for (int j = 1; j < shared.size(); j++) { 
-				maxOtus[i] = max(shared[j]->get(i), maxOtus[i]);
-				minOtus[i] = min(int(shared[j]->get(i)), minOtus[i]);
+				int abund = shared[j]->get(bins[i]);
+				maxOtu = max(abund, maxOtu);
+				minOtu = min(abund, minOtu);
 			}
-		}
-		
-		double sum = 0.0;
-		for (int i = 0; i < shared[0]->getNumBins(); i++) {
-			int A = shared[0]->get(i);
-			int B = shared[1]->get(i);
 			
 			double numerator = abs(A - B);
-			double denominator = maxOtus[i] - minOtus[i];
+			double denominator = maxOtu - minOtu;
 				
 			if (!util.isEqual(denominator, 0)) { sum += (numerator / denominator); }
 		}
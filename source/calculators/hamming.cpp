@@ -19,9 +19,12 @@ EstOutput Hamming::getValues(vector<SharedRAbundVector*> shared) {
 		int numShared = 0;
 		
 		//calc the 2 denominators
-		for (int i = 0; i < shared[0]->getNumBins(); i++) { 
-			int A = shared[0]->get(i);
-			int B = shared[1]->get(i);
+		vector<int> bins, abundsA, abundsB;
+		getNonZeroBins(shared[0], shared[1], bins, abundsA, abundsB);
+		
+		for (int i = 0; i < bins.size(); i++) { 
+			int A = abundsA[i];
+			int B = abundsB[i];
 			
 			if (A != 0) { numA++; }
 			if (B != 0) { numB++; }
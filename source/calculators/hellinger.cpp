@@ -18,18 +18,21 @@ EstOutput Hellinger::getValues(vector<SharedRAbundVector*> shared) {
 		double sumB = 0.0;
 		
 		//calc the 2 denominators
-		for (int i = 0; i < shared[0]->getNumBins(); i++) { 
-			sumA += shared[0]->get(i);
-			sumB += shared[1]->get(i);
+		vector<int> bins, abundsA, abundsB;
+		getNonZeroBins(shared[0], shared[1], bins, abundsA, abundsB);
+		
+		for (int i = 0; i < bins.size(); i++) { 
+			sumA += abundsA[i];
+			sumB += abundsB[i];
 		}
 		
 		
 		//calc sum
 		double sum = 0.0;
-		for (int i = 0; i < shared[0]->getNumBins(); i++) { 
+		for (int i = 0; i < bins.size(); i++) { 
 			
-			int Aij = shared[0]->get(i);
-			int Bij = shared[1]->get(i);
+			int Aij = abundsA[i];
+			int Bij = abundsB[i];
 			
 			double term1 = sqrt((Aij / sumA));
 			double term2 = sqrt((Bij / sumB));
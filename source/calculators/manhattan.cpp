@@ -8,6 +8,7 @@
  */
 
 #include "manhattan.h"
+#include "pairwiseshared.hpp"
 
 /***********************************************************************/
 EstOutput Manhattan::getValues(vector<SharedRAbundVector*> shared) {
@@ -16,10 +17,13 @@ EstOutput Manhattan::getValues(vector<SharedRAbundVector*> shared) {
 		
 		double sum = 0.0;
 		
-		for (int i = 0; i < shared[0]->getNumBins(); i++) { 
+		vector<int> bins, abundsA, abundsB;
+		getNonZeroBins(shared[0], shared[1], bins, abundsA, abundsB);
+		
+		for (int i = 0; i < bins.size(); i++) { 
 			
-			int Aij = shared[0]->get(i);
-			int Bij = shared[1]->get(i);
+			int Aij = abundsA[i];
+			int Bij = abundsB[i];
 			
 			sum += abs((Aij - Bij));
 		}
@@ -36,3 +40,22 @@ EstOutput Manhattan::getValues(vector<SharedRAbundVector*> shared) {
 	}
 }
 /***********************************************************************/
+
+EstOutput Manhattan::getValues(sharedPairStats& stats) {
+	try {
+		data.resize(1,0);
+		
+		//sum of |Aij - Bij| is the two totals less twice what they share
+		data[0] = stats.A->total + stats.B->total - 2 * stats.sumMin;
+		
+		if (isnan(data[0]) || isinf(data[0])) { data[0] = 0; }
+		
+		return data;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "Manhattan", "getValues");
+		exit(1);
+	}
+}
+
+/***********************************************************************/
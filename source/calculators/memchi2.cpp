@@ -20,15 +20,18 @@ EstOutput MemChi2::getValues(vector<SharedRAbundVector*> shared) {
 		//int totalGroups = shared.size();
 		
 		//for each otu
-		for (int i = 0; i < shared[0]->getNumBins(); i++) {
-			if (shared[0]->get(i) != 0) { nonZeroA++; }
-			if (shared[1]->get(i) != 0) { nonZeroB++; }
+		vector<int> bins, abundsA, abundsB;
+		getNonZeroBins(shared[0], shared[1], bins, abundsA, abundsB);
+		
+		for (int i = 0; i < bins.size(); i++) {
+			if (abundsA[i] != 0) { nonZeroA++; }
+			if (abundsB[i] != 0) { nonZeroB++; }
 		}
 		
 		double sum = 0.0;
-		for (int i = 0; i < shared[0]->getNumBins(); i++) {
-			int A = shared[0]->get(i);
-			int B = shared[1]->get(i);
+		for (int i = 0; i < bins.size(); i++) {
+			int A = abundsA[i];
+			int B = abundsB[i];
 			
 			if (A > 0) { A = 1; }
 			if (B > 0) { B = 1; }
@@ -38,7 +41,7 @@ EstOutput MemChi2::getValues(vector<SharedRAbundVector*> shared) {
 
 			int incidence = 0;
 			for(int j=0;j<shared.size();j++){
-				if(shared[j]->get(i) != 0){	incidence++;	}
+				if(shared[j]->get(bins[i]) != 0){	incidence++;	}
 			}
 			
 			if(incidence != 0){
@@ -18,18 +18,21 @@ EstOutput MemChord::getValues(vector<SharedRAbundVector*> shared) {
 		double nonZeroB = 0;
 		
 		//for each otu
-		for (int i = 0; i < shared[0]->getNumBins(); i++) {
-			if (shared[0]->get(i) != 0) { nonZeroA++; }
-			if (shared[1]->get(i) != 0) { nonZeroB++; }
+		vector<int> bins, abundsA, abundsB;
+		getNonZeroBins(shared[0], shared[1], bins, abundsA, abundsB);
+		
+		for (int i = 0; i < bins.size(); i++) {
+			if (abundsA[i] != 0) { nonZeroA++; }
+			if (abundsB[i] != 0) { nonZeroB++; }
 		}
 		
 		nonZeroA = sqrt(nonZeroA);
 		nonZeroB = sqrt(nonZeroB);
 		
 		double sum = 0.0;
-		for (int i = 0; i < shared[0]->getNumBins(); i++) {
-			int A = shared[0]->get(i);
-			int B = shared[1]->get(i);
+		for (int i = 0; i < bins.size(); i++) {
+			int A = abundsA[i];
+			int B = abundsB[i];
 			
 			if (A > 0) { A = 1; }
 			if (B > 0) { B = 1; }
@@ -15,9 +15,12 @@ EstOutput MemEuclidean::getValues(vector<SharedRAbundVector*> shared) {
 		data.resize(1,0);
 		
 		double sum = 0.0;
-		for (int i = 0; i < shared[0]->getNumBins(); i++) {
-			int A = shared[0]->get(i);
-			int B = shared[1]->get(i);
+		vector<int> bins, abundsA, abundsB;
+		getNonZeroBins(shared[0], shared[1], bins, abundsA, abundsB);
+		
+		for (int i = 0; i < bins.size(); i++) {
+			int A = abundsA[i];
+			int B = abundsB[i];
 			
 			if (A > 0) { A = 1; }
 			if (B > 0) { B = 1; }
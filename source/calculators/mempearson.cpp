@@ -19,9 +19,12 @@ EstOutput MemPearson::getValues(vector<SharedRAbundVector*> shared) {
 		int numOTUS = shared[0]->getNumBins();
 		
 		//for each otu
-		for (int i = 0; i < shared[0]->getNumBins(); i++) {
-			if (shared[0]->get(i) != 0) { nonZeroA++; }
-			if (shared[1]->get(i) != 0) { nonZeroB++; }
+		vector<int> bins, abundsA, abundsB;
+		getNonZeroBins(shared[0], shared[1], bins, abundsA, abundsB);
+		
+		for (int i = 0; i < bins.size(); i++) {
+			if (abundsA[i] != 0) { nonZeroA++; }
+			if (abundsB[i] != 0) { nonZeroB++; }
 		}
 		
 		double numTerm = 0.0;
@@ -30,9 +33,9 @@ EstOutput MemPearson::getValues(vector<SharedRAbundVector*> shared) {
 		double averageA = nonZeroA / (float) numOTUS;
 		double averageB = nonZeroB / (float) numOTUS;
 		
-		for (int i = 0; i < shared[0]->getNumBins(); i++) { 
-			int Aij =  shared[0]->get(i);
-			int Bij =  shared[1]->get(i);
+		for (int i = 0; i < bins.size(); i++) { 
+			int Aij =  abundsA[i];
+			int Bij =  abundsB[i];
 			
 			if (Aij > 0) { Aij = 1; }
 			if (Bij > 0) { Bij = 1; }
@@ -42,6 +45,14 @@ EstOutput MemPearson::getValues(vector<SharedRAbundVector*> shared) {
 			denomTerm2 += ((Bij - averageB) * (Bij - averageB));
 		}
 		
+		//each bin neither sample has sequences in adds the same terms
+		int numEmpty = numOTUS - bins.size();
+		if (numEmpty != 0) {
+			numTerm += numEmpty * (averageA * averageB);
+			denomTerm1 += numEmpty * (averageA * averageA);
+			denomTerm2 += numEmpty * (averageB * averageB);
+		}
+		
 		denomTerm1 = sqrt(denomTerm1);
 		denomTerm2 = sqrt(denomTerm2);
 		
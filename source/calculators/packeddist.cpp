@@ -0,0 +1,422 @@
+//
+//  packeddist.cpp
+//  Mothur
+//
+//  Created by agent on 10/17/26.
+//  Copyright © 2026 Schloss Lab. All rights reserved.
+//
+
+#include "packeddist.hpp"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/***********************************************************************/
+namespace {
+
+enum columnMode { eachGapCountEnds, eachGapIgnoreEnds, noGapsMode };
+
+//stop - we reached the terminal gaps, ignore - comparing gaps, not counted in the length
+template<int MODE>
+inline void classifyColumn(char a, char b, bool& stop, bool& ignore) {
+    if (MODE == eachGapCountEnds) {
+        stop = ((a == '.') && (b == '.'));
+        ignore = (((a == '-') || (a == '.')) && ((b == '-') || (b == '.')));
+    }else if (MODE == eachGapIgnoreEnds) {
+        stop = ((a == '.') || (b == '.'));
+        ignore = ((a == '-') && (b == '-'));
+    }else {
+        stop = ((a == '.') || (b == '.'));
+        ignore = ((a == '-') || (b == '-'));
+    }
+}
+
+/***********************************************************************/
+//counts the differences from start until the terminal gaps, removing the compared gaps from maxMinLength.
+//returns false if the distance goes above the cutoff.
+template<int MODE>
+bool countColumns(const char* seqA, const char* seqB, int start, int alignLength, double cutoff, int& diff, int& maxMinLength) {
+
+    int i = start;
+    diff = 0;
+
+#if defined(__SSE2__)
+    //16 columns at a time. Since diff only increases and maxMinLength only decreases the distance can only grow,
+    //so checking the cutoff once per block is the same as checking it at every column
+    const __m128i dot = _mm_set1_epi8('.');
+    const __m128i gap = _mm_set1_epi8('-');
+
+    for (; i + 16 <= alignLength; i += 16) {
+        __m128i a = _mm_loadu_si128((const __m128i*)(seqA + i));
+        __m128i b = _mm_loadu_si128((const __m128i*)(seqB + i));
+
+        __m128i dotA = _mm_cmpeq_epi8(a, dot);  __m128i dotB = _mm_cmpeq_epi8(b, dot);
+        __m128i gapA = _mm_cmpeq_epi8(a, gap);  __m128i gapB = _mm_cmpeq_epi8(b, gap);
+
+        __m128i stop, ignore;
+        if (MODE == eachGapCountEnds) {
+            stop = _mm_and_si128(dotA, dotB);
+            ignore = _mm_and_si128(_mm_or_si128(gapA, dotA), _mm_or_si128(gapB, dotB));
+        }else if (MODE == eachGapIgnoreEnds) {
+            stop = _mm_or_si128(dotA, dotB);
+            ignore = _mm_and_si128(gapA, gapB);
+        }else {
+            stop = _mm_or_si128(dotA, dotB);
+            ignore = _mm_or_si128(gapA, gapB);
+        }
+
+        int stopBits = _mm_movemask_epi8(stop);
+        int ignoreBits = _mm_movemask_epi8(ignore);
+        int mismatchBits = (~_mm_movemask_epi8(_mm_cmpeq_epi8(a, b))) & 0xFFFF;
+
+        if (stopBits != 0) { //only count the columns before the terminal gaps
+            int keep = (stopBits & -stopBits) - 1;
+            ignoreBits &= keep; mismatchBits &= keep;
+        }
+
+        int numIgnored = __builtin_popcount(ignoreBits);
+
+        //trailing '-' gaps can push maxMinLength to 0 or below, let the scalar loop handle those columns exactly
+        if ((maxMinLength - numIgnored) <= 0) { break; }
+
+        diff += __builtin_popcount(mismatchBits & ~ignoreBits);
+        maxMinLength -= numIgnored;
+
+        if (((double)diff / maxMinLength) > cutoff) { return false; }
+
+        if (stopBits != 0) { return true; }
+    }
+#endif
+
+    for (; i < alignLength; i++) {
+        bool stop, ignore;
+        classifyColumn<MODE>(seqA[i], seqB[i], stop, ignore);
+
+        if (stop)           { break;            }
+        else if (ignore)    { maxMinLength--;   }
+        else if (seqA[i] != seqB[i]) { diff++;  }
+
+        if (((double)diff / maxMinLength) > cutoff) { return false; }
+    }
+
+    return true;
+}
+
+}
+/***********************************************************************/
+PackedDist::PackedDist(string calc, bool ce) : StorageDatabase() {
+    try {
+        countends = ce;
+        alignLength = 0;
+
+        if (calc == "nogaps")           { type = noGaps;    }
+        else if (calc == "eachgap")     { type = eachGap;   }
+        else                            { type = oneGap;    }
+    }
+    catch(exception& e) {
+        m->errorOut(e, "PackedDist", "PackedDist");
+        exit(1);
+    }
+}
+/***********************************************************************/
+//the buffer is sized by the first sequence. Sequences of another length mark the database as not the same length,
+//which dist.seqs rejects, so they are padded with terminal gaps or cut to fit instead of repacking every sequence
+void PackedDist::pack(const string& name, const string& seqAligned) {
+    try {
+        if (names.size() == 0) { alignLength = (int)seqAligned.length(); }
+        if ((int)seqAligned.length() != alignLength) { samelength = false; }
+
+        int numColumns = min((int)seqAligned.length(), alignLength);
+
+        long long offset = getNumSeqs() * (long long)alignLength;
+        aligned.resize(offset + alignLength, '.');
+        copy(seqAligned.begin(), seqAligned.begin()+numColumns, aligned.begin()+offset);
+
+        names.push_back(name);
+
+        int fNonDot = noColumn; int lNonDot = -1;
+        int fBase = noColumn; int lBase = -1;
+        for (int j = 0; j < numColumns; j++) {
+            if (seqAligned[j] != '.') {
+                if (fNonDot == noColumn) { fNonDot = j; }
+                lNonDot = j;
+                if (seqAligned[j] != '-') {
+                    if (fBase == noColumn) { fBase = j; }
+                    lBase = j;
+                }
+            }
+        }
+        firstNonDot.push_back(fNonDot); lastNonDot.push_back(lNonDot);
+        firstBase.push_back(fBase); lastBase.push_back(lBase);
+    }
+    catch(exception& e) {
+        m->errorOut(e, "PackedDist", "pack");
+        exit(1);
+    }
+}
+/***********************************************************************/
+long long PackedDist::addSeqs(ifstream& filehandle) {
+    try {
+        long long firstIndex = getNumSeqs();
+
+        while (!filehandle.eof()) {
+
+            if (m->getControl_pressed()) { break; }
+
+            Sequence seq(filehandle); gobble(filehandle);
+
+            if (seq.getName() != "") { pack(seq.getName(), seq.getAligned()); }
+        }
+
+        return firstIndex;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "PackedDist", "addSeqs");
+        exit(1);
+    }
+}
+/***********************************************************************/
+long long PackedDist::addSeqs(StorageDatabase* db) {
+    try {
+        long long firstIndex = getNumSeqs();
+        int numSeqs = db->getNumSeqs();
+
+        names.reserve(firstIndex+numSeqs);
+
+        for (int i = 0; i < numSeqs; i++) {
+
+            if (m->getControl_pressed()) { break; }
+
+            Sequence seq = db->getSeq(i);
+            pack(seq.getName(), seq.getAligned());
+
+            if (i == 0) { aligned.reserve((firstIndex+numSeqs)*(long long)alignLength); }
+        }
+
+        return firstIndex;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "PackedDist", "addSeqs");
+        exit(1);
+    }
+}
+/***********************************************************************/
+void PackedDist::push_back(Sequence seq) {
+    try {
+        pack(seq.getName(), seq.getAligned());
+    }
+    catch(exception& e) {
+        m->errorOut(e, "PackedDist", "push_back");
+        exit(1);
+    }
+}
+/***********************************************************************/
+Sequence PackedDist::getSeq(int i) {
+    try {
+        Sequence seq(names[i], string(getAligned(i), alignLength));
+        return seq;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "PackedDist", "getSeq");
+        exit(1);
+    }
+}
+/***********************************************************************/
+void PackedDist::print(string outputFileName) {
+    try {
+        ofstream out; util.openOutputFile(outputFileName, out);
+
+        for (int i = 0; i < getNumSeqs(); i++) {
+            out << '>' << names[i] << endl << string(getAligned(i), alignLength) << endl;
+        }
+        out.close();
+    }
+    catch(exception& e) {
+        m->errorOut(e, "PackedDist", "print");
+        exit(1);
+    }
+}
+/***********************************************************************/
+double PackedDist::calcDist(long long i, long long j, double cutoff) const {
+    try {
+        const char* seqA = getAligned(i);
+        const char* seqB = getAligned(j);
+
+        if (type == eachGap)        { return calcEachGap(seqA, seqB, i, j, cutoff);  }
+        else if (type == oneGap)    { return calcOneGap(seqA, seqB, i, j, cutoff);   }
+
+        return calcNoGaps(seqA, seqB, i, j, cutoff);
+    }
+    catch(exception& e) {
+        m->errorOut(e, "PackedDist", "calcDist");
+        exit(1);
+    }
+}
+/***********************************************************************/
+//same as eachGapDist and eachGapIgnoreTermGapDist
+double PackedDist::calcEachGap(const char* seqA, const char* seqB, long long i, long long j, double cutoff) const {
+    try {
+        int start = 0; int end = 0;
+        int diff = 0; int maxMinLength = 0; bool belowCutoff = true;
+
+        if (countends) {
+            //first and last columns where one of you is not a terminal gap
+            start = min(firstNonDot[i], firstNonDot[j]); if (start == noColumn) { start = 0; }
+            end = max(lastNonDot[i], lastNonDot[j]); if (end == -1) { end = 0; }
+
+            maxMinLength = end - start + 1;
+            belowCutoff = countColumns<eachGapCountEnds>(seqA, seqB, start, alignLength, cutoff, diff, maxMinLength);
+        }else {
+            //first and last columns where both are bases, ignore terminal gaps
+            int low = max(firstBase[i], firstBase[j]); int high = min(lastBase[i], lastBase[j]);
+
+            start = -1;
+            for (int k = low; k <= high; k++) {
+                if ((seqA[k] != '.') && (seqB[k] != '.') && (seqA[k] != '-') && (seqB[k] != '-')) { start = k; break; }
+            }
+
+            //non-overlapping sequences
+            if (start == -1) { return 1.0000; }
+
+            for (int k = high; k >= start; k--) {
+                if ((seqA[k] != '.') && (seqB[k] != '.') && (seqA[k] != '-') && (seqB[k] != '-')) { end = k; break; }
+            }
+
+            maxMinLength = end - start + 1;
+            belowCutoff = countColumns<eachGapIgnoreEnds>(seqA, seqB, start, alignLength, cutoff, diff, maxMinLength);
+        }
+
+        if (!belowCutoff)           { return 1.0000; }
+        if (maxMinLength == 0)      { return 1.0000; }
+
+        return ((double)diff / (double)maxMinLength);
+    }
+    catch(exception& e) {
+        m->errorOut(e, "PackedDist", "calcEachGap");
+        exit(1);
+    }
+}
+/***********************************************************************/
+//same as ignoreGaps
+double PackedDist::calcNoGaps(const char* seqA, const char* seqB, long long i, long long j, double cutoff) const {
+    try {
+        //first and last columns where neither is a terminal gap
+        int low = max(firstNonDot[i], firstNonDot[j]); int high = min(lastNonDot[i], lastNonDot[j]);
+
+        int start = -1; int end = 0;
+        for (int k = low; k <= high; k++) {
+            if ((seqA[k] != '.') && (seqB[k] != '.')) { start = k; break; }
+        }
+
+        //non-overlapping sequences
+        if (start == -1) { return 1.0000; }
+
+        for (int k = high; k >= start; k--) {
+            if ((seqA[k] != '.') && (seqB[k] != '.')) { end = k; break; }
+        }
+
+        int diff = 0; int maxMinLength = end - start + 1;
+
+        if (!countColumns<noGapsMode>(seqA, seqB, start, alignLength, cutoff, diff, maxMinLength)) { return 1.0000; }
+
+        if (maxMinLength == 0) { return 1.0000; }
+
+        return ((double)diff / (double)maxMinLength);
+    }
+    catch(exception& e) {
+        m->errorOut(e, "PackedDist", "calcNoGaps");
+        exit(1);
+    }
+}
+/***********************************************************************/
+//same as oneGapDist and oneGapIgnoreTermGapDist. Gap opens depend on the previous column, so this one stays scalar.
+double PackedDist::calcOneGap(const char* seqA, const char* seqB, long long i, long long j, double cutoff) const {
+    try {
+        int difference = 0;
+        bool openGapA = false;
+        bool openGapB = false;
+
+        if (countends) {
+            int start = min(firstNonDot[i], firstNonDot[j]); if (start == noColumn) { start = 0; }
+            int end = max(lastNonDot[i], lastNonDot[j]); if (end == -1) { end = 0; }
+
+            int maxMinLength = end - start + 1;
+
+            for (int k = start; k < alignLength; k++) {
+                char a = seqA[k]; char b = seqB[k];
+
+                //comparing gaps, ignore
+                if ((a == '-' && b == '-') || (a == '.' && b == '-') || (a == '-' && b == '.')) {    maxMinLength--;    }
+                //trailing gaps, quit we already calculated all the diffs
+                else if (a == '.' && b == '.') { break; }
+
+                else if (b != '-' && (a == '-' || a == '.')) { //seqB is a base, seqA is a gap
+                    if (!openGapA) { difference++; openGapA = true; openGapB = false; }
+                    else { maxMinLength--; }
+                }
+                else if (a != '-' && (b == '-' || b == '.')) { //seqA is a base, seqB is a gap
+                    if (!openGapB) { difference++; openGapA = false; openGapB = true; }
+                    else { maxMinLength--; }
+                }
+                else if (a != '-' && b != '-') { //both bases
+                    openGapA = false; openGapB = false;
+                    if (a != b) { difference++; }
+                }
+
+                if (((double)difference / maxMinLength) > cutoff) { return 1.0000; }
+            }
+
+            if (maxMinLength == 0) { return 1.0000; }
+
+            return (double)difference / maxMinLength;
+        }
+
+        //first and last columns where both are bases, ignore terminal gaps
+        int low = max(firstBase[i], firstBase[j]); int high = min(lastBase[i], lastBase[j]);
+
+        int start = -1; int end = 0;
+        for (int k = low; k <= high; k++) {
+            if ((seqA[k] != '.') && (seqB[k] != '.') && (seqA[k] != '-') && (seqB[k] != '-')) { start = k; break; }
+        }
+
+        //non-overlapping sequences
+        if (start == -1) { return 1.0000; }
+
+        for (int k = high; k >= start; k--) {
+            if ((seqA[k] != '.') && (seqB[k] != '.') && (seqA[k] != '-') && (seqB[k] != '-')) { end = k; break; }
+        }
+
+        int maxMinLength = end - start;
+
+        for (int k = start; k <= end; k++) {
+            char a = seqA[k]; char b = seqB[k];
+
+            if (a == '-' && b == '-') {    maxMinLength--;    } //comparing gaps, ignore
+
+            else if (b != '-' && a == '-') { //seqB is a base, seqA is a gap
+                if (!openGapA) { difference++; openGapA = true; openGapB = false; }
+                else { maxMinLength--; }
+            }
+            else if (a != '-' && b == '-') { //seqA is a base, seqB is a gap
+                if (!openGapB) { difference++; openGapA = false; openGapB = true; }
+                else { maxMinLength--; }
+            }
+            else if (a != '-' && b != '-') { //both bases
+                openGapA = false; openGapB = false;
+                if (a != b) { difference++; }
+            }
+
+            if (((double)difference / maxMinLength) > cutoff) { return 1.0000; }
+        }
+
+        if (maxMinLength == 0) { return 1.0000; }
+
+        return (double)difference / maxMinLength;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "PackedDist", "calcOneGap");
+        exit(1);
+    }
+}
+/***********************************************************************/
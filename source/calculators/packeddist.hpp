@@ -0,0 +1,69 @@
+//
+//  packeddist.hpp
+//  Mothur
+//
+//  Created by agent on 10/17/26.
+//  Copyright © 2026 Schloss Lab. All rights reserved.
+//
+
+#ifndef packeddist_hpp
+#define packeddist_hpp
+
+#include "mothurout.h"
+#include "storagedatabase.hpp"
+
+/**************************************************************************************************/
+
+//  PackedDist is the StorageDatabase dist.seqs reads dna sequences into. The aligned sequences are
+//  packed as they are read into one contiguous row-major buffer (one byte per alignment column)
+//  along with the first and last non-terminal-gap and base columns of each sequence, so there is
+//  no second unpacked copy. Distances are calculated by index without copying Sequence objects or
+//  rescanning for start / end for every pair. The results are identical to the eachgap, onegap and
+//  nogaps DistCalc classes, with and without countends.
+//  Once the sequences are added calcDist is const and can be shared by all the worker threads.
+
+class PackedDist : public StorageDatabase {
+
+public:
+
+    PackedDist(string calc, bool countends);
+    ~PackedDist() = default;
+
+    long long addSeqs(ifstream&);         //packs the seqs in the fasta file, returns the index of the first seq added
+    long long addSeqs(StorageDatabase*); //packs the aligned seqs in the database, returns the index of the first seq added
+
+    int getNumSeqs()                    { return (int)names.size(); }
+    Sequence getSeq(int);                //unpacks the sequence at that location
+    void push_back(Sequence);           //packs the sequence
+    void print(string);
+
+    int getAlignLength() const       { return alignLength; }
+    const string& getName(long long i) const { return names[i]; }
+
+    double calcDist(long long i, long long j, double cutoff) const; //calc distance between 2 packed seqeunces
+
+private:
+
+    enum distType { eachGap, oneGap, noGaps };
+
+    distType type;
+    bool countends;
+    int alignLength;
+
+    vector<char> aligned; //numSeqs * alignLength
+    vector<string> names;
+    vector<int> firstNonDot, lastNonDot; //first and last columns that are not terminal gaps, noColumn / -1 if none
+    vector<int> firstBase, lastBase; //first and last columns that are not '.' or '-', noColumn / -1 if none
+    static const int noColumn = numeric_limits<int>::max();
+
+    void pack(const string&, const string&);
+    const char* getAligned(long long i) const { return &aligned[i*(long long)alignLength]; }
+
+    double calcEachGap(const char*, const char*, long long, long long, double) const;
+    double calcOneGap(const char*, const char*, long long, long long, double) const;
+    double calcNoGaps(const char*, const char*, long long, long long, double) const;
+};
+
+/**************************************************************************************************/
+
+#endif /* packeddist_hpp */
@@ -0,0 +1,121 @@
+/*
+ *  pairwiseshared.cpp
+ *  Mothur
+ *
+ *  Created by agent on 10/18/26.
+ *  Copyright 2026 Schloss Lab. All rights reserved.
+ *
+ */
+
+#include "pairwiseshared.hpp"
+#include "chao1.h"
+
+/**************************************************************************************************/
+
+PairwiseShared::PairwiseShared(vector<SharedRAbundVector*>& lookup, bool findChao) {
+    try {
+        m = MothurOut::getInstance();
+        samples.resize(lookup.size());
+
+        for (int i = 0; i < lookup.size(); i++) {
+            sharedSampleStats& sample = samples[i];
+            int numBins = lookup[i]->getNumBins();
+
+            sample.numBins = numBins;
+            sample.numSeqs = (double)lookup[i]->getNumSeqs();
+            sample.total = 0;
+            for (int j = 0; j < lookup[i]->getNumEntries(); j++) {
+                int abund = lookup[i]->getEntryAbund(j);
+                if (abund != 0) { sample.bins.push_back(lookup[i]->getEntryBin(j)); sample.abunds.push_back(abund); sample.total += abund; }
+            }
+            sample.numOTUs = sample.bins.size();
+
+            int numOTUs = sample.bins.size();
+            sample.rel.resize(numOTUs); sample.relTotal.resize(numOTUs); sample.relShared.resize(numOTUs);
+            sample.sumPsq = 0; sample.sumPcubed = 0; sample.sumRelTotalSq = 0;
+            for (int j = 0; j < numOTUs; j++) {
+                double pi = sample.abunds[j] / sample.numSeqs;
+                sample.rel[j] = pi;
+                sample.sumPsq += pi * pi;
+                sample.sumPcubed += pi * pi * pi;
+
+                float relA = sample.abunds[j] / sample.total;
+                sample.relTotal[j] = relA;
+                sample.sumRelTotalSq += relA * relA;
+
+                sample.relShared[j] = ((double)sample.abunds[j] / (float)sample.total);
+            }
+
+            sample.chao = 0;
+            if (findChao) {
+                SAbundVector sabund = lookup[i]->getSAbundVector();
+                Chao1 chao;
+                sample.chao = chao.getValues(&sabund)[0];
+            }
+
+            if (m->getControl_pressed()) { break; }
+        }
+    }
+    catch(exception& e) {
+        m->errorOut(e, "PairwiseShared", "PairwiseShared");
+        exit(1);
+    }
+}
+/**************************************************************************************************/
+//jest is the only calculator using the samples' chao1
+bool PairwiseShared::needsChao(vector<string> estimators) {
+    for (int i = 0; i < estimators.size(); i++) { if (estimators[i] == "jest") { return true; } }
+    return false;
+}
+/**************************************************************************************************/
+
+bool PairwiseShared::getPairStats(int i, int j, sharedPairStats& stats) const {
+    try {
+        const sharedSampleStats& A = samples[i];
+        const sharedSampleStats& B = samples[j];
+
+        stats.A = &A; stats.B = &B;
+        stats.numShared = 0; stats.sumMin = 0;
+        stats.sumPQ = 0; stats.sumPQsq = 0; stats.sumPsqQ = 0;
+        stats.sumRelTotalPQ = 0; stats.sumRelSharedA = 0; stats.sumRelSharedB = 0;
+        stats.f11 = 0; stats.f1A = 0; stats.f1B = 0; stats.f22 = 0; stats.f2A = 0; stats.f2B = 0;
+
+        if ((A.numSeqs == 0) || (B.numSeqs == 0) || (A.total == 0) || (B.total == 0)) { return false; }
+
+        int a = 0, b = 0;
+        int numA = A.bins.size(), numB = B.bins.size();
+        while ((a < numA) && (b < numB)) {
+            if (A.bins[a] < B.bins[b])      { a++; }
+            else if (A.bins[a] > B.bins[b]) { b++; }
+            else {
+                int abundA = A.abunds[a], abundB = B.abunds[b];
+                double pi = A.rel[a], qi = B.rel[b];
+
+                stats.numShared++;
+                if (abundA < abundB) { stats.sumMin += abundA; }
+                else { stats.sumMin += abundB; }
+
+                stats.sumPQ += pi * qi;
+                stats.sumPQsq += pi * qi * qi;
+                stats.sumPsqQ += pi * pi * qi;
+                stats.sumRelTotalPQ += A.relTotal[a] * B.relTotal[b];
+                stats.sumRelSharedA += A.relShared[a];
+                stats.sumRelSharedB += B.relShared[b];
+
+                if (abundA == 1) { stats.f1A++; if (abundB == 1) { stats.f11++; } }
+                if (abundB == 1) { stats.f1B++; }
+                if (abundA == 2) { stats.f2A++; if (abundB == 2) { stats.f22++; } }
+                if (abundB == 2) { stats.f2B++; }
+
+                a++; b++;
+            }
+        }
+
+        return true;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "PairwiseShared", "getPairStats");
+        exit(1);
+    }
+}
+/**************************************************************************************************/
@@ -0,0 +1,75 @@
+#ifndef PAIRWISESHARED_HPP
+#define PAIRWISESHARED_HPP
+
+/*
+ *  pairwiseshared.hpp
+ *  Mothur
+ *
+ *  Created by agent on 10/18/26.
+ *  Copyright 2026 Schloss Lab. All rights reserved.
+ *
+ */
+
+#include "sharedrabundvector.hpp"
+
+/* summary.shared and dist.shared run every selected calculator on every pair of samples.  PairwiseShared keeps a sparse copy
+ of each sample, the bins it has sequences in in bin order, and fills the sums the two group calculators need for a pair with
+ one merge of the two bin lists.  Calculators that override
+ Calculator::getValues(sharedPairStats&) are evaluated from the sums.  The sums are made with the same expressions, in the same bin
+ order as the calculators' own loops, so the results are identical. */
+
+/**************************************************************************************************/
+
+struct sharedSampleStats {
+    vector<int> bins;           //bins with sequences, in bin order
+    vector<int> abunds;         //abundance of each of those bins
+    vector<double> rel;         //abund / numSeqs, thetayc
+    vector<float> relTotal;     //abund / total as a float, morisitahorn
+    vector<double> relShared;   //abund / (float)total, thetan
+
+    int numBins;                //bins in the shared file, including the empty ones
+    double numSeqs, total;      //getNumSeqs() and the sum of the bins
+    double numOTUs;             //bins with sequences
+    double sumPsq, sumPcubed;   //sums of rel^2 and rel^3
+    double sumRelTotalSq;       //sum of relTotal^2
+    double chao;                //chao1 of the sample, jest. 0 unless the table was built with findChao
+};
+
+/**************************************************************************************************/
+
+struct sharedPairStats {
+    const sharedSampleStats* A;
+    const sharedSampleStats* B;
+
+    //sums over the bins both samples have sequences in
+    double numShared;                   //shared otus
+    double sumMin;                      //sum of the smaller abundance
+    double sumPQ, sumPQsq, sumPsqQ;     //rel products
+    double sumRelTotalPQ;               //relTotal product
+    double sumRelSharedA, sumRelSharedB;
+    int f11, f1A, f1B, f22, f2A, f2B;   //shared bins that are singletons or doubletons in A and B, A, or B
+};
+
+/**************************************************************************************************/
+
+class PairwiseShared {
+
+public:
+    PairwiseShared(vector<SharedRAbundVector*>&, bool); //samples, findChao
+    ~PairwiseShared() = default;
+
+    //true if one of the calculators uses the samples' chao1
+    static bool needsChao(vector<string>);
+
+    //fills the sums for samples i and j, false if either sample is empty so the calculators' own edge cases apply.
+    //the samples are not changed after the constructor, so threads can share one PairwiseShared
+    bool getPairStats(int, int, sharedPairStats&) const;
+
+private:
+    MothurOut* m;
+    vector<sharedSampleStats> samples;
+};
+
+/**************************************************************************************************/
+
+#endif
@@ -32,10 +32,13 @@ EstOutput SharedAce::getValues(vector<SharedRAbundVector*> shared) {
 		S12 = number of shared OTUs in A and B
 		This estimator was changed to reflect Caldwell's changes, eliminating the nrare / nrare - 1 */
 
-		for (int i = 0; i < shared[0]->getNumBins(); i++) {
+		vector<int> bins, abundsA, abundsB;
+		getNonZeroBins(shared[0], shared[1], bins, abundsA, abundsB);
+		
+		for (int i = 0; i < bins.size(); i++) {
 			//store in temps to avoid multiple repetitive function calls
-			tempA = shared[0]->get(i);
-			tempB = shared[1]->get(i);
+			tempA = abundsA[i];
+			tempB = abundsB[i];
 			if (!util.isEqual(tempA, 0) && !util.isEqual(tempB, 0)) {//they are shared
 				S12++;
 				//do both A and B have one
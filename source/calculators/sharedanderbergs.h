@@ -19,6 +19,8 @@ class Anderberg : public Calculator  {
 		Anderberg() :  Calculator("anderberg", 1, false) {};
 		EstOutput getValues(SAbundVector*) {return data;};
 		EstOutput getValues(vector<SharedRAbundVector*>);
+		EstOutput getValues(sharedPairStats&);
+		bool hasPairStats() { return true; }
 		string getCitation() { return "http://www.mothur.org/wiki/Anderberg"; }
 	private:
 
@@ -8,6 +8,7 @@
  */
 
 #include "sharedbraycurtis.h"
+#include "pairwiseshared.hpp"
 
 /***********************************************************************/
 //This is used by SharedJAbund and SharedSorAbund
@@ -24,10 +25,13 @@ EstOutput BrayCurtis::getValues(vector<SharedRAbundVector*> shared) {
 		sumSharedAB = the sum of the minimum otus int all shared otus in AB.
 		*/
 		
-		for (int i = 0; i < shared[0]->getNumBins(); i++) {
+		vector<int> bins, abundsA, abundsB;
+		getNonZeroBins(shared[0], shared[1], bins, abundsA, abundsB);
+		
+		for (int i = 0; i < bins.size(); i++) {
 			//store in temps to avoid multiple repetitive function calls
-			tempA = shared[0]->get(i);
-			tempB = shared[1]->get(i);
+			tempA = abundsA[i];
+			tempB = abundsB[i];
 				
 			//sum the min of tempA and tempB
 			if (tempA < tempB) { sumSharedAB += tempA; }
@@ -47,3 +51,23 @@ EstOutput BrayCurtis::getValues(vector<SharedRAbundVector*> shared) {
 }
 
 /***********************************************************************/
+
+EstOutput BrayCurtis::getValues(sharedPairStats& stats) {
+	try {
+		data.resize(1,0);
+		
+		double sumSharedA = stats.A->numSeqs; double sumSharedB = stats.B->numSeqs; double sumSharedAB = stats.sumMin;
+		
+		data[0] = 1.0 - (2 * sumSharedAB) / (float)( sumSharedA + sumSharedB);
+		
+		if (isnan(data[0]) || isinf(data[0])) { data[0] = 0; }
+		
+		return data;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "BrayCurtis", "getValues");
+		exit(1);
+	}
+}
+
+/***********************************************************************/
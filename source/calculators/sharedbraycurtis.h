@@ -18,6 +18,8 @@ public:
 	BrayCurtis() :  Calculator("braycurtis", 1, false) {};
 	EstOutput getValues(SAbundVector*) {return data;};
 	EstOutput getValues(vector<SharedRAbundVector*>);
+	EstOutput getValues(sharedPairStats&);
+	bool hasPairStats() { return true; }
 	string getCitation() { return "http://www.mothur.org/wiki/Braycurtis"; }
 private:
 	
@@ -8,6 +8,7 @@
  */
 
 #include "sharedchao1.h"
+#include "pairwiseshared.hpp"
 
 /***********************************************************************/
 EstOutput SharedChao1::getValues(vector<SharedRAbundVector*> shared){
@@ -29,7 +30,9 @@ EstOutput SharedChao1::getValues(vector<SharedRAbundVector*> shared){
 		//create and initialize trees to 0.
 		initialTree(numGroups);
 		
-		for (int i = 0; i < shared[0]->getNumBins(); i++) {
+		//only the bins the first group stores can be shared by all, so sparse samples are not expanded
+		for (int k = 0; k < shared[0]->getNumEntries(); k++) {
+			int i = shared[0]->getEntryBin(k);
 			//get bin values and calc shared 
 			bool sharedByAll = true;
 			temp.clear();
@@ -252,6 +255,44 @@ void SharedChao1::printBranch(IntNode* node) {
 
 /*****************************************************************/
 
+EstOutput SharedChao1::getValues(sharedPairStats& stats) {
+	try {
+		data.resize(1,0);
+		float Chao = 0.0; float leftvalue, rightvalue;
+		
+		//the leaves of the two group trees, left leaf is f11 and f1+ (f22 and f2+), right leaf is f+1 and the shared count (f+2 and the shared count)
+		int numShared = stats.numShared;
+		int f1lvalues[2] = { stats.f11, stats.f1B };    int f1rvalues[2] = { stats.f1A, numShared };
+		int f2lvalues[2] = { stats.f22, stats.f2B };    int f2rvalues[2] = { stats.f2A, numShared };
+		int lcoefs[2] = { 2, 1 };                       int rcoefs[2] = { 1, 0 };
+		
+		bool bias = false;
+		for(int i=0;i<2;i++){
+			if (f2lvalues[i] == 0 || f2rvalues[i] == 0) { bias = true;}
+		}
+		
+		for (int i = 0; i < 2; i++) {
+			if(bias){
+				leftvalue = (float)(f1lvalues[i] * (f1lvalues[i] - 1)) / (float)((pow(2, (float)lcoefs[i])) * (f2lvalues[i] + 1));
+				if (i != 1) {
+					rightvalue = (float)(f1rvalues[i] * (f1rvalues[i] - 1)) / (float)((pow(2, (float)rcoefs[i])) * (f2rvalues[i] + 1));
+				}else{ rightvalue = (float)(f1rvalues[i]); } //add in sobs
+			}else{
+				leftvalue = (float)(f1lvalues[i] * f1lvalues[i]) / (float)((pow(2, (float)lcoefs[i])) * f2lvalues[i]);
+				if (i != 1) {
+					rightvalue = (float)(f1rvalues[i] * f1rvalues[i]) / (float)((pow(2, (float)rcoefs[i])) * f2rvalues[i]);
+				}else{ rightvalue = (float)(f1rvalues[i]); } //add in sobs
+			}
+			Chao += leftvalue + rightvalue;
+		}
+		
+		data[0] = Chao;
+		return data;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "SharedChao1", "getValues");
+		exit(1);
+	}
+}
 
-
-
+/***********************************************************************/
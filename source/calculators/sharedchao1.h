@@ -24,6 +24,8 @@ class SharedChao1 : public Calculator  {
 		SharedChao1() : Calculator("sharedchao", 1, true) {};
 		EstOutput getValues(SAbundVector*) {return data;};
 		EstOutput getValues(vector<SharedRAbundVector*>);
+		EstOutput getValues(sharedPairStats&);
+		bool hasPairStats() { return true; }
 		string getCitation() { return "http://www.mothur.org/wiki/Sharedchao"; }
 	private:
 		IntNode* f1root;
@@ -22,6 +22,8 @@ public:
 	Jclass() :  Calculator("jclass", 1, false) {};
 	EstOutput getValues(SAbundVector*) {return data;};
 	EstOutput getValues(vector<SharedRAbundVector*>);
+	EstOutput getValues(sharedPairStats&);
+	bool hasPairStats() { return true; }
 	string getCitation() { return "http://www.mothur.org/wiki/Jclass"; }
 private:
 	
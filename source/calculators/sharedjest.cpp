@@ -10,6 +10,7 @@
 #include "sharedchao1.h"
 #include "chao1.h"
 #include "sharedjest.h"
+#include "pairwiseshared.hpp"
 
 
 /***********************************************************************/
@@ -61,3 +62,28 @@ EstOutput Jest::getValues(vector<SharedRAbundVector*> shared) {
 }
 
 /***********************************************************************/
+
+EstOutput Jest::getValues(sharedPairStats& stats) {
+	try {
+		data.resize(1,0);
+		
+		//the samples' chao1 are found once in PairwiseShared
+		SharedChao1 sharedChao;
+		EstOutput S12 = sharedChao.getValues(stats);
+		double S1 = stats.A->chao; double S2 = stats.B->chao;
+		
+		data[0] = 1.0 - S12[0] / (float)(S1 + S2 - S12[0]);
+		
+		if (isnan(data[0]) || isinf(data[0])) { data[0] = 0; }
+		if (data[0] < 0) { data[0] = 0; }
+		if (data[0] > 1) { data[0] = 1; }
+		
+		return data;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "Jest", "getValues");
+		exit(1);
+	}
+}
+
+/***********************************************************************/
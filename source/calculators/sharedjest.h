@@ -23,6 +23,8 @@ public:
 	Jest() :  Calculator("jest", 1, false) {};
 	EstOutput getValues(SAbundVector*) {return data;};
 	EstOutput getValues(vector<SharedRAbundVector*>);
+	EstOutput getValues(sharedPairStats&);
+	bool hasPairStats() { return true; }
 	string getCitation() { return "http://www.mothur.org/wiki/Jest"; }
 private:
 	
@@ -15,24 +15,44 @@ EstOutput KSTest::getValues(vector<SharedRAbundVector*> shared){
 	try {
 		data.resize(3,0);
 
-		//Must return shared1 and shared2 to original order at conclusion of kstest
-		vector<int> sortedA = shared[0]->get();  sort(sortedA.begin()+1, sortedA.end());
-		vector<int> sortedB = shared[1]->get();  sort(sortedB.begin()+1, sortedB.end());
-
+		//bin 0 is left out of the sort. Sorted, the other bins are the empty ones then the non zero abundances, so only those are kept
+		vector<int> sortedA, sortedB;
         int numNZ1 = 0;
-        for(int i = 0; i < shared[0]->getNumBins(); i++) { if(shared[0]->get(i) != 0) { numNZ1++; } } //shared[0]->numNZ();
+        for (int i = 0; i < shared[0]->getNumEntries(); i++) {
+            int abund = shared[0]->getEntryAbund(i);
+            if (abund != 0) { numNZ1++; if (shared[0]->getEntryBin(i) != 0) { sortedA.push_back(abund); } }
+        }
         int numNZ2 = 0;
-        for(int i = 0; i < shared[1]->getNumBins(); i++) { if(shared[1]->get(i) != 0) { numNZ2++; } } //shared[1]->numNZ();
+        for (int i = 0; i < shared[1]->getNumEntries(); i++) {
+            int abund = shared[1]->getEntryAbund(i);
+            if (abund != 0) { numNZ2++; if (shared[1]->getEntryBin(i) != 0) { sortedB.push_back(abund); } }
+        }
+		sort(sortedA.begin(), sortedA.end());
+		sort(sortedB.begin(), sortedB.end());
+		
 		double numInd1 = (double)shared[0]->getNumSeqs();
 		double numInd2 = (double)shared[1]->getNumSeqs();
 		
+		int numBins = shared[0]->getNumBins();
+		int numEmptyA = (numBins - 1) - sortedA.size();
+		int numEmptyB = (numBins - 1) - sortedB.size();
+		
 		double maxDiff = -1;
 		double sum1 = 0;
 		double sum2 = 0;
-		for(int i = 1; i < shared[0]->getNumBins(); i++)
+		
+		//both sums are 0 until the first non zero abundance
+		int start = min(numEmptyA, numEmptyB);
+		if (start > 0) {
+			double diff = fabs((double)sum1/numInd1 - (double)sum2/numInd2);
+			if(diff > maxDiff)
+				maxDiff = diff;
+		}
+		
+		for(int i = max(start+1, 1); i < numBins; i++)
 		{
-            sum1 += sortedA[i];
-			sum2 += sortedB[i];
+			if (i > numEmptyA) { sum1 += sortedA[i-numEmptyA-1]; }
+			if (i > numEmptyB) { sum2 += sortedB[i-numEmptyB-1]; }
 			double diff = fabs((double)sum1/numInd1 - (double)sum2/numInd2);
 			if(diff > maxDiff)
 				maxDiff = diff;
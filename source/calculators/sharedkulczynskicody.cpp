@@ -8,6 +8,7 @@
  */
 
 #include "sharedkulczynskicody.h"
+#include "pairwiseshared.hpp"
 
 /***********************************************************************/
 
@@ -21,10 +22,13 @@ EstOutput KulczynskiCody::getValues(vector<SharedRAbundVector*> shared) {
 
 		data.resize(1,0);
 		
-		for (int i = 0; i < shared[0]->getNumBins(); i++) {
+		vector<int> bins, abundsA, abundsB;
+		getNonZeroBins(shared[0], shared[1], bins, abundsA, abundsB);
+		
+		for (int i = 0; i < bins.size(); i++) {
 			//store in temps to avoid multiple repetitive function calls
-			tempA = shared[0]->get(i);
-			tempB = shared[1]->get(i);
+			tempA = abundsA[i];
+			tempB = abundsB[i];
 			
 			if (!util.isEqual(tempA, 0)) { S1++; }
 			if (!util.isEqual(tempB, 0)) { S2++; }
@@ -46,3 +50,24 @@ EstOutput KulczynskiCody::getValues(vector<SharedRAbundVector*> shared) {
 }
 
 /***********************************************************************/
+
+EstOutput KulczynskiCody::getValues(sharedPairStats& stats) {
+	try {
+		double S1, S2, S12;
+		S1 = stats.A->numOTUs; S2 = stats.B->numOTUs; S12 = stats.numShared;
+		
+		data.resize(1,0);
+		
+		data[0] = 1.0 - 0.5 * ((S12 / (float)S1) + (S12 / (float)S2));
+		
+		if (isnan(data[0]) || isinf(data[0])) { data[0] = 0; }
+		
+		return data;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "KulczynskiCody", "getValues");
+		exit(1);
+	}
+}
+
+/***********************************************************************/
@@ -21,6 +21,8 @@ public:
 	KulczynskiCody() :  Calculator("kulczynskicody", 1, false) {};
 	EstOutput getValues(SAbundVector*) {return data;};
 	EstOutput getValues(vector<SharedRAbundVector*>);
+	EstOutput getValues(sharedPairStats&);
+	bool hasPairStats() { return true; }
 	string getCitation() { return "http://www.mothur.org/wiki/Kulczynskicody"; }
 private:
 	
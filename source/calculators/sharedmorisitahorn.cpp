@@ -8,6 +8,7 @@
  */
 
 #include "sharedmorisitahorn.h"
+#include "pairwiseshared.hpp"
 
 /***********************************************************************/
 EstOutput MorHorn::getValues(vector<SharedRAbundVector*> shared) {
@@ -20,17 +21,20 @@ EstOutput MorHorn::getValues(vector<SharedRAbundVector*> shared) {
 		morhorn = 0.0; sumSharedA = 0.0; sumSharedB = 0.0; a = 0.0; b = 0.0; d = 0.0;
 		
 		//get the total values we need to calculate the theta denominator sums
-		for (int i = 0; i < shared[0]->getNumBins(); i++) {
+		vector<int> bins, abundsA, abundsB;
+		getNonZeroBins(shared[0], shared[1], bins, abundsA, abundsB);
+		
+		for (int i = 0; i < bins.size(); i++) {
 			//store in temps to avoid multiple repetitive function calls
-			Atotal += shared[0]->get(i);
-			Btotal += shared[1]->get(i);
+			Atotal += abundsA[i];
+			Btotal += abundsB[i];
 		}
 		
 		//calculate the denominator sums
-		for (int j = 0; j < shared[0]->getNumBins(); j++) {
+		for (int j = 0; j < bins.size(); j++) {
 			//store in temps to avoid multiple repetitive function calls
-			tempA = shared[0]->get(j);
-			tempB = shared[1]->get(j);
+			tempA = abundsA[j];
+			tempB = abundsB[j];
 			float relA = tempA / Atotal;
 			float relB = tempB / Btotal;
 			
@@ -54,3 +58,24 @@ EstOutput MorHorn::getValues(vector<SharedRAbundVector*> shared) {
 }
 
 /***********************************************************************/
+
+EstOutput MorHorn::getValues(sharedPairStats& stats) {
+	try {
+		data.resize(1,0);
+		
+		double a = stats.A->sumRelTotalSq; double b = stats.B->sumRelTotalSq; double d = stats.sumRelTotalPQ;
+		
+		double morhorn = 1- (2 * d) / (a + b);
+		if (isnan(morhorn) || isinf(morhorn)) { morhorn = 1; }
+		
+		data[0] = morhorn;
+		
+		return data;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "MorHorn", "getValues");
+		exit(1);
+	}
+}
+
+/***********************************************************************/
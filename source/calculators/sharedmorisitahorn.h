@@ -20,6 +20,8 @@ public:
 	MorHorn() :  Calculator("morisitahorn", 1, false) {};
 	EstOutput getValues(SAbundVector*) {return data;};
 	EstOutput getValues(vector<SharedRAbundVector*>);
+	EstOutput getValues(sharedPairStats&);
+	bool hasPairStats() { return true; }
 	string getCitation() { return "http://www.mothur.org/wiki/Morisitahorn"; }
 private:
 	
@@ -22,9 +22,12 @@ EstOutput RJSD::getValues(vector<SharedRAbundVector*> shared) {
         double totalA = shared[0]->getNumSeqs();
         double totalB = shared[1]->getNumSeqs();
         
-        for (int i = 0; i < shared[0]->getNumBins(); i++) {
-            double tempA = shared[0]->get(i) / totalA;
-            double tempB = shared[1]->get(i) / totalB;
+        vector<int> bins, abundsA, abundsB;
+        getNonZeroBins(shared[0], shared[1], bins, abundsA, abundsB);
+        
+        for (int i = 0; i < bins.size(); i++) {
+            double tempA = abundsA[i] / totalA;
+            double tempB = abundsB[i] / totalB;
             
             //tempA = shared[0]->get(i) / totalA;
             //tempB = shared[1]->get(i) / totalB;
@@ -19,10 +19,13 @@ EstOutput SharedSobs::getValues(vector<SharedRAbundVector*> shared){
 		double observed = 0;
 
 		//loop through the species in each group
-		for (int k = 0; k < shared[0]->getNumBins(); k++) {
+		vector<int> bins, abundsA, abundsB;
+		getNonZeroBins(shared[0], shared[1], bins, abundsA, abundsB);
+		
+		for (int k = 0; k < bins.size(); k++) {
 			//if you have found a new species
-			if (shared[0]->get(k) != 0) { observed++; }
-			else if ((shared[0]->get(k) == 0) && (shared[1]->get(k) != 0)) { observed++; }
+			if (abundsA[k] != 0) { observed++; }
+			else if ((abundsA[k] == 0) && (abundsB[k] != 0)) { observed++; }
 		}
 
 		data[0] = observed;
@@ -8,6 +8,7 @@
  */
 
 #include "sharedsobscollectsummary.h"
+#include "pairwiseshared.hpp"
 
 /***********************************************************************/
 //This returns the number of shared species observed in several groups.  
@@ -19,7 +20,9 @@ EstOutput SharedSobsCS::getValues(vector<SharedRAbundVector*> shared){
 		double observed = 0;
 		int numGroups = shared.size();
 
-		for (int i = 0; i < shared[0]->getNumBins(); i++) {
+		//only the bins the first group stores can be shared by all, so sparse samples are not expanded
+		for (int k = 0; k < shared[0]->getNumEntries(); k++) {
+			int i = shared[0]->getEntryBin(k);
 			//get bin values and set sharedByAll 
 			bool sharedByAll = true;
 			for (int j = 0; j < numGroups; j++) {
@@ -49,7 +52,9 @@ EstOutput SharedSobsCS::getValues(vector<SharedRAbundVector*> shared, vector<str
         int numGroups = shared.size();
         labels.clear();
         
-        for (int i = 0; i < shared[0]->getNumBins(); i++) {
+        //only the bins the first group stores can be shared by all, so sparse samples are not expanded
+        for (int k = 0; k < shared[0]->getNumEntries(); k++) {
+            int i = shared[0]->getEntryBin(k);
             //get bin values and set sharedByAll
             bool sharedByAll = true;
             for (int j = 0; j < numGroups; j++) {
@@ -71,3 +76,18 @@ EstOutput SharedSobsCS::getValues(vector<SharedRAbundVector*> shared, vector<str
 
 /***********************************************************************/
 
+EstOutput SharedSobsCS::getValues(sharedPairStats& stats) {
+	try {
+		data.resize(1,0);
+		
+		data[0] = stats.numShared;
+		
+		return data;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "SharedSobsCS", "getValues");
+		exit(1);
+	}
+}
+
+/***********************************************************************/
@@ -21,6 +21,8 @@ public:
 	SharedSobsCS() : Calculator("sharedsobs", 1, true) {};
 	EstOutput getValues(SAbundVector* rank){ return data; };
 	EstOutput getValues(vector<SharedRAbundVector*>);
+	EstOutput getValues(sharedPairStats&);
+	bool hasPairStats() { return true; }
     EstOutput getValues(vector<SharedRAbundVector*>, vector<string>&, vector<string>);
 	string getCitation() { return "http://www.mothur.org/wiki/Sharedsobs"; }
 };
@@ -8,6 +8,7 @@
  */
 
 #include "sharedthetan.h"
+#include "pairwiseshared.hpp"
 
 /***********************************************************************/
 EstOutput ThetaN::getValues(vector<SharedRAbundVector*> shared) {
@@ -20,17 +21,20 @@ EstOutput ThetaN::getValues(vector<SharedRAbundVector*> shared) {
 		numerator = 0.0; denominator = 0.0; thetaN = 0.0; sumSharedA = 0.0; sumSharedB = 0.0; a = 0.0; b = 0.0; d = 0.0;
 		
 		//get the total values we need to calculate the theta denominator sums
-		for (int i = 0; i < shared[0]->getNumBins(); i++) {
+		vector<int> bins, abundsA, abundsB;
+		getNonZeroBins(shared[0], shared[1], bins, abundsA, abundsB);
+		
+		for (int i = 0; i < bins.size(); i++) {
 			//store in temps to avoid multiple repetitive function calls
-			Atotal += shared[0]->get(i);
-			Btotal += shared[1]->get(i);
+			Atotal += abundsA[i];
+			Btotal += abundsB[i];
 		}
 		
 		//calculate the theta denominator sums
-		for (int j = 0; j < shared[0]->getNumBins(); j++) {
+		for (int j = 0; j < bins.size(); j++) {
 			//store in temps to avoid multiple repetitive function calls
-			tempA = shared[0]->get(j);
-			tempB = shared[1]->get(j);
+			tempA = abundsA[j];
+			tempB = abundsB[j];
 			
 			//they are shared
 			if (!util.isEqual(tempA, 0) && !util.isEqual(tempB, 0)) {
@@ -57,3 +61,24 @@ EstOutput ThetaN::getValues(vector<SharedRAbundVector*> shared) {
 }
 
 /***********************************************************************/
+
+EstOutput ThetaN::getValues(sharedPairStats& stats) {
+	try {
+		data.resize(1,0);
+		
+		double a = stats.sumRelSharedA; double b = stats.sumRelSharedB;
+		
+		double thetaN = (a * b) / (a + b - (a * b));
+		if (isnan(thetaN) || isinf(thetaN)) { thetaN = 0; }
+		
+		data[0] = 1.0 - thetaN;
+		
+		return data;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "ThetaN", "getValues");
+		exit(1);
+	}
+}
+
+/***********************************************************************/
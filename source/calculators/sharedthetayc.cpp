@@ -8,6 +8,7 @@
  */
 
 #include "sharedthetayc.h"
+#include "pairwiseshared.hpp"
 
 /***********************************************************************/
 EstOutput ThetaYC::getValues(vector<SharedRAbundVector*> shared) {
@@ -29,10 +30,13 @@ EstOutput ThetaYC::getValues(vector<SharedRAbundVector*> shared) {
 		double sumPsqQ = 0;
 		
 		//calculate the theta denominator sums
-		for (int j = 0; j < shared[0]->getNumBins(); j++) {
+		vector<int> bins, abundsA, abundsB;
+		getNonZeroBins(shared[0], shared[1], bins, abundsA, abundsB);
+		
+		for (int j = 0; j < bins.size(); j++) {
 			//store in temps to avoid multiple repetitive function calls
-			pi = shared[0]->get(j) / Atotal;
-			qi = shared[1]->get(j) / Btotal;
+			pi = abundsA[j] / Atotal;
+			qi = abundsB[j] / Btotal;
 					
 			a += pi * pi;
 			b += qi * qi;
@@ -81,3 +85,54 @@ EstOutput ThetaYC::getValues(vector<SharedRAbundVector*> shared) {
 }
 
 /***********************************************************************/
+
+EstOutput ThetaYC::getValues(sharedPairStats& stats) {
+	try {
+		data.resize(3,0.0000);
+		
+		double Atotal = stats.A->numSeqs;
+		double Btotal = stats.B->numSeqs;
+		double a = stats.A->sumPsq;
+		double b = stats.B->sumPsq;
+		double d = stats.sumPQ;
+		double sumPcubed = stats.A->sumPcubed;
+		double sumQcubed = stats.B->sumPcubed;
+		double sumPQsq = stats.sumPQsq;
+		double sumPsqQ = stats.sumPsqQ;
+		
+		double thetaYC = d / (a + b - d);
+		if (isnan(thetaYC) || isinf(thetaYC)) { thetaYC = 0; }
+		
+		double varA = 4 / Atotal * (sumPcubed - a * a);
+		double varB = 4 / Btotal * (sumQcubed - b * b);
+		double varD = sumPQsq / Atotal + sumPsqQ / Btotal - d * d * (1/Atotal + 1/Btotal);
+		double covAD = 2 / Atotal * (sumPsqQ - a * d);
+		double covBD = 2 / Btotal * (sumPQsq - b* d);
+		
+		double varT = d * d * (varA + varB) / pow(a + b - d, (double)4.0) + pow(a+b, (double)2.0) * varD / pow(a+b-d, (double)4.0)
+						- 2.0 * (a + b) * d / pow(a + b - d, (double)4.0) * (covAD + covBD);
+		
+		double ci = 1.95 * sqrt(varT);
+		
+		data[0] = thetaYC;
+		data[1] = thetaYC - ci;
+		data[2] = thetaYC + ci;
+		
+		if (isnan(data[0]) || isinf(data[0])) { data[0] = 0; }
+		if (isnan(data[1]) || isinf(data[1])) { data[1] = 0; }
+		if (isnan(data[2]) || isinf(data[2])) { data[2] = 0; }
+		
+		data[0] = 1.0 - data[0];
+		double hold = data[1];
+		data[1] = 1.0 - data[2];
+		data[2] = 1.0 - hold;
+		
+		return data;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "ThetaYC", "getValues");
+		exit(1);
+	}
+}
+
+/***********************************************************************/
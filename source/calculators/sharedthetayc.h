@@ -23,6 +23,8 @@ public:
 	ThetaYC() :  Calculator("thetayc", 3, false) {};
 	EstOutput getValues(SAbundVector*) {return data;};
 	EstOutput getValues(vector<SharedRAbundVector*>);
+	EstOutput getValues(sharedPairStats&);
+	bool hasPairStats() { return true; }
 	string getCitation() { return "http://www.mothur.org/wiki/Thetayc"; }
 private:
 	
@@ -18,10 +18,13 @@ EstOutput Soergel::getValues(vector<SharedRAbundVector*> shared) {
 		double sumMax = 0.0;
 		
 		//calc the 2 denominators
-		for (int i = 0; i < shared[0]->getNumBins(); i++) { 
+		vector<int> bins, abundsA, abundsB;
+		getNonZeroBins(shared[0], shared[1], bins, abundsA, abundsB);
+		
+		for (int i = 0; i < bins.size(); i++) { 
 			
-			int Aij = shared[0]->get(i);
-			int Bij = shared[1]->get(i);
+			int Aij = abundsA[i];
+			int Bij = abundsB[i];
 			
 			sumNum += abs((Aij - Bij));
 			sumMax += max(Aij, Bij);
@@ -46,15 +46,26 @@ EstOutput Spearman::getValues(vector<SharedRAbundVector*> shared) {
 		
 		
 
-		for (int i = 0; i < shared[0]->getNumBins(); i++) { 
-			int Aij = shared[0]->get(i);
-			int Bij = shared[1]->get(i);
+		vector<int> bins, abundsA, abundsB;
+		getNonZeroBins(shared[0], shared[1], bins, abundsA, abundsB);
+		
+		for (int i = 0; i < bins.size(); i++) { 
+			int Aij = abundsA[i];
+			int Bij = abundsB[i];
 			
 			float rankA = rankVectorA[Aij];
 			float rankB = rankVectorB[Bij];
 			
 			sumRanks += ((rankA - rankB) * (rankA - rankB));
 		}
+		
+		//each bin neither sample has sequences in adds the difference of the ranks of 0
+		int numEmpty = numOTUS - bins.size();
+		if (numEmpty != 0) {
+			float rankA = rankVectorA[0];
+			float rankB = rankVectorB[0];
+			sumRanks += numEmpty * ((rankA - rankB) * (rankA - rankB));
+		}
 		data[0] = 1.0 - ((6 * sumRanks) / (float) (numOTUS * ((numOTUS*numOTUS)-1)));
 		
 		if (isnan(data[0]) || isinf(data[0])) { data[0] = 0; }
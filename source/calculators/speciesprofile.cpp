@@ -17,15 +17,18 @@ EstOutput SpeciesProfile::getValues(vector<SharedRAbundVector*> shared) {
 		double sumA = 0.0;
 		double sumB = 0.0;
 		
-		for (int i = 0; i < shared[0]->getNumBins(); i++) { 
-			sumA += shared[0]->get(i);
-			sumB += shared[1]->get(i);
+		vector<int> bins, abundsA, abundsB;
+		getNonZeroBins(shared[0], shared[1], bins, abundsA, abundsB);
+		
+		for (int i = 0; i < bins.size(); i++) { 
+			sumA += abundsA[i];
+			sumB += abundsB[i];
 		}
 		
 		double sum = 0.0;
-		for (int i = 0; i < shared[0]->getNumBins(); i++) { 
-			int A = shared[0]->get(i);
-			int B = shared[1]->get(i);
+		for (int i = 0; i < bins.size(); i++) { 
+			int A = abundsA[i];
+			int B = abundsB[i];
 			
 			sum += (((A / sumA) - (B / sumB)) * ((A / sumA) - (B / sumB)));
 		}
@@ -0,0 +1,349 @@
+/*
+ *  stripedunifrac.cpp
+ *  Mothur
+ *
+ *  Created by agent on 10/18/26.
+ *  Copyright 2026 Schloss Lab. All rights reserved.
+ *
+ */
+
+#include "stripedunifrac.hpp"
+
+/**************************************************************************************************/
+
+StripedUnifrac::StripedUnifrac(Tree* t, vector<string> G, bool r) : includeRoot(r), Groups(G) {
+    try {
+        m = MothurOut::getInstance();
+        numGroups = Groups.size();
+        numNodes = t->getNumNodes();
+        numLeaves = t->getNumLeaves();
+        CountTable* ct = t->getCountTable();
+
+        map<string, int> groupIndex;
+        for (int i = 0; i < numGroups; i++) { groupIndex[Groups[i]] = i; }
+
+        groupTotals.resize(numGroups, 0);
+        for (int i = 0; i < numGroups; i++) { groupTotals[i] = ct->getGroupCount(Groups[i]); }
+
+        //read each node's pcount once
+        branchLengths.resize(numNodes, 0.0); parents.resize(numNodes, -1);
+        nodeStarts.push_back(0);
+        for (int i = 0; i < numNodes; i++) {
+            if (!util.isEqual(t->tree[i].getBranchLength(), -1)) { branchLengths[i] = abs(t->tree[i].getBranchLength()); }
+            parents[i] = t->tree[i].getParent();
+
+            vector< pair<int, int> > entries;
+            for (map<string, int>::iterator it = t->tree[i].pcount.begin(); it != t->tree[i].pcount.end(); it++) {
+                map<string, int>::iterator itIndex = groupIndex.find(it->first);
+                if (itIndex != groupIndex.end()) { entries.push_back(pair<int, int>(itIndex->second, it->second)); }
+            }
+            sort(entries.begin(), entries.end());
+
+            for (int j = 0; j < entries.size(); j++) { entryGroups.push_back(entries[j].first); entryCounts.push_back(entries[j].second); }
+            nodeStarts.push_back(entryGroups.size());
+        }
+
+        //depth of each node below the tree root
+        depths.resize(numNodes, -1);
+        int root = t->findRoot();
+        if (root != -1) {
+            vector<int> toVisit; toVisit.push_back(root); depths[root] = 0;
+            while (toVisit.size() != 0) {
+                int index = toVisit.back(); toVisit.pop_back();
+                int lc = t->tree[index].getLChild(); int rc = t->tree[index].getRChild();
+                if (lc != -1) { depths[lc] = depths[index] + 1; toVisit.push_back(lc); }
+                if (rc != -1) { depths[rc] = depths[index] + 1; toVisit.push_back(rc); }
+            }
+        }
+
+        //a group's root is the deepest node that has all the sequences the tree root has for the group
+        groupRoots.resize(numGroups, -1);
+        vector<int> rootCounts(numGroups, 0);
+        if (root != -1) { for (int i = 0; i < numGroups; i++) { rootCounts[i] = getCount(root, i); } }
+        for (int i = 0; i < numNodes; i++) {
+            if (depths[i] == -1) { continue; }
+            for (long long j = nodeStarts[i]; j < nodeStarts[i+1]; j++) {
+                int group = entryGroups[j];
+                if ((entryCounts[j] == 0) || (entryCounts[j] != rootCounts[group])) { continue; }
+                if ((groupRoots[group] == -1) || (depths[i] > depths[groupRoots[group]])) { groupRoots[group] = i; }
+            }
+        }
+
+        //leaf to tree root lengths, weighted by the leaf's count
+        leafSums.resize(numGroups, 0); toRootSums.resize(numGroups, 0);
+        for (int i = 0; i < numLeaves; i++) {
+
+            if (m->getControl_pressed()) { break; }
+
+            if (nodeStarts[i] == nodeStarts[i+1]) { continue; }
+
+            double lengthToRoot = 0.0;
+            int index = i;
+            while ((index != -1) && (parents[index] != -1)) { lengthToRoot += branchLengths[index]; index = parents[index]; }
+
+            for (long long j = nodeStarts[i]; j < nodeStarts[i+1]; j++) {
+                leafSums[entryGroups[j]] += entryCounts[j];
+                toRootSums[entryGroups[j]] += entryCounts[j] * lengthToRoot;
+            }
+        }
+    }
+    catch(exception& e) {
+        m->errorOut(e, "StripedUnifrac", "StripedUnifrac");
+        exit(1);
+    }
+}
+/**************************************************************************************************/
+//count for the group at the node, 0 if the node has none
+int StripedUnifrac::getCount(int node, int group) {
+    try {
+        vector<int>::iterator start = entryGroups.begin() + nodeStarts[node];
+        vector<int>::iterator end = entryGroups.begin() + nodeStarts[node+1];
+        vector<int>::iterator it = lower_bound(start, end, group);
+
+        if ((it != end) && (*it == group)) { return entryCounts[it - entryGroups.begin()]; }
+
+        return 0;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "StripedUnifrac", "getCount");
+        exit(1);
+    }
+}
+/**************************************************************************************************/
+//lowest node holding both groups' sequences, or the leaf's parent if that is a leaf. -1 if neither group is in the tree
+int StripedUnifrac::getPairRoot(int groupA, int groupB) {
+    try {
+        int a = groupRoots[groupA];
+        int b = groupRoots[groupB];
+
+        if (a == -1) { a = b; }
+        if (b == -1) { b = a; }
+        if (a == -1) { return -1; }
+
+        while (depths[a] > depths[b]) { a = parents[a]; }
+        while (depths[b] > depths[a]) { b = parents[b]; }
+        while (a != b) { a = parents[a]; b = parents[b]; }
+
+        if ((a < numLeaves) && (parents[a] != -1)) { a = parents[a]; }
+
+        return a;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "StripedUnifrac", "getPairRoot");
+        exit(1);
+    }
+}
+/**************************************************************************************************/
+
+void StripedUnifrac::fillStripes(int first, int num, bool weighted, vector< vector<double> >& stripes, vector< vector<double> >& totals) {
+    try {
+        stripes.assign(num, vector<double>(numGroups, 0.0));
+        if (!weighted) { totals.assign(num, vector<double>(numGroups, 0.0)); }
+
+        //each node's values are stored twice, so the pair (k, k+s) is at row[k] and row[k+s] without a mod
+        const int batchSize = 64;
+        int rowSize = 2 * numGroups;
+        vector<double> rows(batchSize * rowSize, 0.0);
+        vector<int> batchNodes;
+
+        int i = 0;
+        while (i < numNodes) {
+
+            if (m->getControl_pressed()) { break; }
+
+            batchNodes.clear();
+            while ((i < numNodes) && (batchNodes.size() < batchSize)) {
+                //nodes without a branch length or sequences from the groups add nothing
+                if (!util.isEqual(branchLengths[i], 0) && (nodeStarts[i] != nodeStarts[i+1])) {
+                    double* row = &rows[batchNodes.size() * rowSize];
+                    for (long long j = nodeStarts[i]; j < nodeStarts[i+1]; j++) {
+                        int group = entryGroups[j];
+                        double value = 1.0;
+                        if (weighted) { value = entryCounts[j] / groupTotals[group]; }
+                        row[group] = value; row[group+numGroups] = value;
+                    }
+                    batchNodes.push_back(i);
+                }
+                i++;
+            }
+
+            for (int s = 0; s < num; s++) {
+                int offset = first + s + 1;
+                int length = numGroups;
+                if ((2 * offset) == numGroups) { length = offset; } //the last stripe of an even number of groups would repeat its pairs
+
+                double* stripe = &stripes[s][0];
+                for (int b = 0; b < batchNodes.size(); b++) {
+                    const double* row = &rows[b * rowSize];
+                    const double* other = row + offset;
+                    double length2 = branchLengths[batchNodes[b]];
+
+                    if (weighted) {
+                        for (int k = 0; k < length; k++) { stripe[k] += fabs(row[k] - other[k]) * length2; }
+                    }else {
+                        double* total = &totals[s][0];
+                        for (int k = 0; k < length; k++) {
+                            stripe[k] += fabs(row[k] - other[k]) * length2;
+                            total[k] += max(row[k], other[k]) * length2;
+                        }
+                    }
+                }
+            }
+
+            //clear the rows for the next batch
+            for (int b = 0; b < batchNodes.size(); b++) {
+                double* row = &rows[b * rowSize];
+                for (long long j = nodeStarts[batchNodes[b]]; j < nodeStarts[batchNodes[b]+1]; j++) { row[entryGroups[j]] = 0.0; row[entryGroups[j]+numGroups] = 0.0; }
+            }
+        }
+    }
+    catch(exception& e) {
+        m->errorOut(e, "StripedUnifrac", "fillStripes");
+        exit(1);
+    }
+}
+/***********************************************************************/
+struct stripedUnifracData {
+    int start;
+    int num;
+    bool weighted;
+    MothurOut* m;
+    StripedUnifrac* unifrac;
+    vector< vector<double> > stripes, totals;
+
+    stripedUnifracData(){}
+    stripedUnifracData(int st, int en, bool w, StripedUnifrac* u) {
+        m = MothurOut::getInstance();
+        start = st;
+        num = en;
+        weighted = w;
+        unifrac = u;
+    }
+};
+/**************************************************************************************************/
+void driverStripedUnifrac(stripedUnifracData* params) {
+    try {
+        params->unifrac->fillStripes(params->start, params->num, params->weighted, params->stripes, params->totals);
+    }
+    catch(exception& e) {
+        params->m->errorOut(e, "StripedUnifrac", "driverStripedUnifrac");
+        exit(1);
+    }
+}
+/**************************************************************************************************/
+
+EstOutput StripedUnifrac::getWeighted(int processors) { return createProcesses(true, processors); }
+
+EstOutput StripedUnifrac::getUnweighted(int processors) { return createProcesses(false, processors); }
+
+/**************************************************************************************************/
+
+EstOutput StripedUnifrac::createProcesses(bool weighted, int processors) {
+    try {
+        EstOutput results;
+        int numStripes = numGroups / 2;
+        if (numStripes == 0) { return results; }
+
+        vector<linePair> lines;
+        int remainingStripes = numStripes;
+        if (remainingStripes < processors) { processors = remainingStripes; }
+        int startIndex = 0;
+        for (int remainingProcessors = processors; remainingProcessors > 0; remainingProcessors--) {
+            int numToProcess = remainingStripes; //case for last processor
+            if (remainingProcessors != 1) { numToProcess = ceil(remainingStripes / remainingProcessors); }
+            lines.push_back(linePair(startIndex, numToProcess)); //startIndex, numStripes
+            startIndex = startIndex + numToProcess;
+            remainingStripes = remainingStripes - numToProcess;
+        }
+
+        //create array of worker threads, the threads only read the tree's values so they can share them
+        vector<std::thread*> workerThreads;
+        vector<stripedUnifracData*> data;
+
+        //Lauch worker threads
+        for (int i = 0; i < processors-1; i++) {
+            stripedUnifracData* dataBundle = new stripedUnifracData(lines[i+1].start, lines[i+1].end, weighted, this);
+            data.push_back(dataBundle);
+
+            workerThreads.push_back(new std::thread(driverStripedUnifrac, dataBundle));
+        }
+
+        stripedUnifracData* dataBundle = new stripedUnifracData(lines[0].start, lines[0].end, weighted, this);
+        driverStripedUnifrac(dataBundle);
+        vector< vector<double> > stripes = dataBundle->stripes;
+        vector< vector<double> > totals = dataBundle->totals;
+        delete dataBundle;
+
+        for (int i = 0; i < processors-1; i++) {
+            workerThreads[i]->join();
+
+            stripes.insert(stripes.end(), data[i]->stripes.begin(), data[i]->stripes.end());
+            totals.insert(totals.end(), data[i]->totals.begin(), data[i]->totals.end());
+
+            delete data[i];
+            delete workerThreads[i];
+        }
+
+        if (m->getControl_pressed()) { return results; }
+
+        //pairs in namesOfGroupCombos order, AB, AC, BC...
+        for (int i = 0; i < numGroups; i++) {
+            for (int l = 0; l < i; l++) {
+
+                if ((groupRoots[i] == -1) && (groupRoots[l] == -1)) {
+                    m->mothurOut("[WARNING]: cannot find a nodes in the tree from grouping " + Groups[i] + "-" + Groups[l] + ", skipping.\n");
+                    results.push_back(0.0); continue;
+                }
+
+                //pair (l, i) is in stripe i-l at l, or in stripe numGroups-(i-l) at i
+                int stripe = i - l; int k = l;
+                if (stripe > numStripes) { stripe = numGroups - stripe; k = i; }
+
+                double sum = stripes[stripe-1][k];
+                double total = 0.0;
+                if (!weighted) { total = totals[stripe-1][k]; }
+
+                //take out the branches above the root for this comparison
+                double rootLength = 0.0;
+                if (!includeRoot) {
+                    for (int index = getPairRoot(i, l); index != -1; index = parents[index]) {
+                        if (util.isEqual(branchLengths[index], 0)) { continue; }
+
+                        int countI = getCount(index, i); int countL = getCount(index, l);
+                        rootLength += branchLengths[index];
+
+                        if (weighted) {
+                            double u = 0.0;
+                            if (countI != 0) { u = countI / groupTotals[i]; }
+                            if (countL != 0) { u -= countL / groupTotals[l]; }
+                            sum -= fabs(u) * branchLengths[index];
+                        }else {
+                            if ((countI != 0) != (countL != 0))    { sum -= branchLengths[index]; }
+                            if ((countI != 0) || (countL != 0))    { total -= branchLengths[index]; }
+                        }
+                    }
+                    if (sum < 0) { sum = 0; }
+                    if (total < 0) { total = 0; }
+                }
+
+                double result = 0.0;
+                if (weighted) {
+                    double D = 0.0;
+                    if (groupTotals[i] != 0) { D += (toRootSums[i] - rootLength * leafSums[i]) / groupTotals[i]; }
+                    if (groupTotals[l] != 0) { D += (toRootSums[l] - rootLength * leafSums[l]) / groupTotals[l]; }
+                    result = sum / D;
+                }else { result = sum / total; }
+
+                if (isnan(result) || isinf(result)) { result = 0; }
+                results.push_back(result);
+            }
+        }
+
+        return results;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "StripedUnifrac", "createProcesses");
+        exit(1);
+    }
+}
+/**************************************************************************************************/
@@ -0,0 +1,58 @@
+#ifndef STRIPEDUNIFRAC_HPP
+#define STRIPEDUNIFRAC_HPP
+
+/*
+ *  stripedunifrac.hpp
+ *  Mothur
+ *
+ *  Created by agent on 10/18/26.
+ *  Copyright 2026 Schloss Lab. All rights reserved.
+ *
+ */
+
+#include "treecalculator.h"
+#include "counttable.h"
+
+/* Computes the weighted or unweighted unifrac distance of every pair of groups in one pass over the tree's nodes.
+ Stripe s holds the pairs (k, k+s mod numGroups), and threads split the stripes. When the root is not included,
+ the branches above the pair's root, the lowest node holding all the pair's sequences, are left out. */
+
+/**************************************************************************************************/
+
+class StripedUnifrac {
+
+public:
+    StripedUnifrac(Tree*, vector<string>, bool); //tree, groups, includeRoot
+    ~StripedUnifrac() = default;
+
+    //distances for each pair of groups, in the order Weighted and Unweighted make namesOfGroupCombos
+    EstOutput getWeighted(int);     //processors
+    EstOutput getUnweighted(int);   //processors
+
+    //fills stripes first to first+num-1, numerators for weighted, unique and total branch length for unweighted
+    void fillStripes(int, int, bool, vector< vector<double> >&, vector< vector<double> >&);
+
+private:
+    MothurOut* m;
+    Utils util;
+    bool includeRoot;
+    int numGroups, numNodes, numLeaves;
+    vector<string> Groups;
+
+    vector<double> branchLengths;           //abs of the branch length, 0 if the node has none
+    vector<int> parents, depths;
+    vector<long long> nodeStarts;           //node i's groups are entries nodeStarts[i] to nodeStarts[i+1]-1
+    vector<int> entryGroups, entryCounts;   //sorted by group within a node
+
+    vector<double> groupTotals;             //sequences in the group
+    vector<double> leafSums, toRootSums;    //sum of the group's leaf counts, and of leaf count * leaf to tree root length
+    vector<int> groupRoots;                 //lowest node holding all the group's sequences, -1 if the group has none in the tree
+
+    EstOutput createProcesses(bool, int);
+    int getPairRoot(int, int);
+    int getCount(int, int);
+};
+
+/**************************************************************************************************/
+
+#endif
@@ -20,21 +20,29 @@ EstOutput StructChi2::getValues(vector<SharedRAbundVector*> shared) {
 		
 		for (int i = 0; i < shared.size(); i++) { totalSum += shared[i]->getNumSeqs();  }
 		
-		vector<int> sumOtus; sumOtus.resize(shared[0]->getNumBins(), 0);
-		//for each otu
-		for (int i = 0; i < shared[0]->getNumBins(); i++) {
-			//for each group
-			for (int j = 0; j < shared.size(); j++) { 
-				sumOtus[i] += shared[j]->get(i);
-			}
+		//a bin no group has sequences in divides by a total of 0, which makes the sum nan and the distance 0
+		vector<int> usedBins;
+		for (int j = 0; j < shared.size(); j++) {
+			for (int k = 0; k < shared[j]->getNumEntries(); k++) { if (shared[j]->getEntryAbund(k) != 0) { usedBins.push_back(shared[j]->getEntryBin(k)); } }
 		}
+		sort(usedBins.begin(), usedBins.end());
+		int numUsedBins = unique(usedBins.begin(), usedBins.end()) - usedBins.begin();
+		if (numUsedBins < shared[0]->getNumBins()) { data[0] = 0; return data; }
+		
+		//bins neither sample has sequences in add nothing to the sum
+		vector<int> bins, abundsA, abundsB;
+		getNonZeroBins(shared[0], shared[1], bins, abundsA, abundsB);
 		
 		double sum = 0.0;
-		for (int i = 0; i < shared[0]->getNumBins(); i++) {
-			int A = shared[0]->get(i);
-			int B = shared[1]->get(i);
+		for (int i = 0; i < bins.size(); i++) {
+			int A = abundsA[i];
+			int B = abundsB[i];
+			
+			//for each group
+			int sumOtu = 0;
+			for (int j = 0; j < shared.size(); j++) { sumOtu += shared[j]->get(bins[i]); }
 			
-			double totalTerm = 1 / (float) sumOtus[i];
+			double totalTerm = 1 / (float) sumOtu;
 			double Aterm = A / sumA;
 			double Bterm = B / sumB;
 			
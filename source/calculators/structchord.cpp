@@ -18,10 +18,13 @@ EstOutput StructChord::getValues(vector<SharedRAbundVector*> shared) {
 		double sumBj2 = 0.0;
 		
 		//calc the 2 denominators
-		for (int i = 0; i < shared[0]->getNumBins(); i++) { 
+		vector<int> bins, abundsA, abundsB;
+		getNonZeroBins(shared[0], shared[1], bins, abundsA, abundsB);
+		
+		for (int i = 0; i < bins.size(); i++) { 
 			
-			int Aij = shared[0]->get(i);
-			int Bij = shared[1]->get(i);
+			int Aij = abundsA[i];
+			int Bij = abundsB[i];
 			
 			//(Aij) ^ 2
 			sumAj2 += (Aij * Aij);
@@ -33,10 +36,10 @@ EstOutput StructChord::getValues(vector<SharedRAbundVector*> shared) {
 		
 		//calc sum
 		double sum = 0.0;
-		for (int i = 0; i < shared[0]->getNumBins(); i++) { 
+		for (int i = 0; i < bins.size(); i++) { 
 			
-			int Aij = shared[0]->get(i);
-			int Bij = shared[1]->get(i);
+			int Aij = abundsA[i];
+			int Bij = abundsB[i];
 			
 			sum += (((Aij / sumAj2) - (Bij / sumBj2)) * ((Aij / sumAj2) - (Bij / sumBj2)));
 		}
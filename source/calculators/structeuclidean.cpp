@@ -16,10 +16,13 @@ EstOutput StructEuclidean::getValues(vector<SharedRAbundVector*> shared) {
 		
 		double sum = 0.0;
 		
-		for (int i = 0; i < shared[0]->getNumBins(); i++) { 
+		vector<int> bins, abundsA, abundsB;
+		getNonZeroBins(shared[0], shared[1], bins, abundsA, abundsB);
+		
+		for (int i = 0; i < bins.size(); i++) { 
 			
-			int Aij = shared[0]->get(i);
-			int Bij = shared[1]->get(i);
+			int Aij = abundsA[i];
+			int Bij = abundsB[i];
 			
 			//(Aij - Bij) ^ 2
 			sum += ((Aij - Bij) * (Aij - Bij));
@@ -18,10 +18,13 @@ EstOutput StructKulczynski::getValues(vector<SharedRAbundVector*> shared) {
 		double sumB = 0.0;
 		double sumMin = 0.0;
 		
-		for (int i = 0; i < shared[0]->getNumBins(); i++) { 
+		vector<int> bins, abundsA, abundsB;
+		getNonZeroBins(shared[0], shared[1], bins, abundsA, abundsB);
+		
+		for (int i = 0; i < bins.size(); i++) { 
 			
-			int A = shared[0]->get(i);
-			int B = shared[1]->get(i);
+			int A = abundsA[i];
+			int B = abundsB[i];
 			
 			sumA += A;
 			sumB += B;
@@ -22,9 +22,12 @@ EstOutput StructPearson::getValues(vector<SharedRAbundVector*> shared) {
 		double denomTerm1 = 0.0;
 		double denomTerm2 = 0.0;
 		
-		for (int i = 0; i < shared[0]->getNumBins(); i++) { 
-			int Aij =  shared[0]->get(i);
-			int Bij =  shared[1]->get(i);
+		vector<int> bins, abundsA, abundsB;
+		getNonZeroBins(shared[0], shared[1], bins, abundsA, abundsB);
+		
+		for (int i = 0; i < bins.size(); i++) { 
+			int Aij =  abundsA[i];
+			int Bij =  abundsB[i];
 			
 			
 			numTerm += ((Aij - averageA) * (Bij - averageB));
@@ -32,6 +35,14 @@ EstOutput StructPearson::getValues(vector<SharedRAbundVector*> shared) {
 			denomTerm2 += ((Bij - averageB) * (Bij - averageB));
 		}
 		
+		//each bin neither sample has sequences in adds the same terms
+		int numEmpty = numOTUS - bins.size();
+		if (numEmpty != 0) {
+			numTerm += numEmpty * (averageA * averageB);
+			denomTerm1 += numEmpty * (averageA * averageA);
+			denomTerm2 += numEmpty * (averageB * averageB);
+		}
+		
 		denomTerm1 = sqrt(denomTerm1);
 		denomTerm2 = sqrt(denomTerm2);
 		
@@ -55,19 +55,6 @@ struct unweightedData {
     Utils util;
     
     unweightedData(){}
-    unweightedData(int st, int en, vector< vector<string> > ngc, Tree* tree, CountTable* count, bool ir) {
-        m = MothurOut::getInstance();
-        start = st;
-        num = en;
-        namesOfGroupCombos = ngc;
-        t = tree;
-        ct = count;
-        includeRoot = ir;
-        Treenames = tree->getTreeNames();
-        results.resize(num);
-        count = 0;
-    }
-
     unweightedData(int st, int en, vector< vector<string> > ngc, Tree* tree, CountTable* count, bool ir, vector<vector<int> > randomTreeNodes) {
         m = MothurOut::getInstance();
         start = st;
@@ -164,127 +151,13 @@ void getRoot2(MothurOut* m, Tree* t, int v, vector<string> grouping, set<int>& r
     }
 }
 /**************************************************************************************************/
-void driverUnweighted(unweightedData* params) {
-    try {
-        params->count = 0;
-
-        for (int h = params->start; h < (params->start+params->num); h++) {
-            
-            if (params->m->getControl_pressed()) { break; }
-            
-            double UniqueBL=0.0000;  //a branch length is unique if it's chidren are from the same group
-            double totalBL = 0.00;	//all branch lengths
-            double UW = 0.00;		//Unweighted Value = UniqueBL / totalBL;
-            set<int> rootBranches; //if not including root this will hold branches that are "above" the root for this comparison
-
-            int nodeBelonging = findNodeBelonging(params->m, params->namesOfGroupCombos[h], params->t->groupNodeInfo);
-            
-            if (nodeBelonging != -1) {
-
-                //fills rootBranches to exclude, if including the root then rootBranches should be empty.
-                if (!params->includeRoot) { getRoot2(params->m, params->t, nodeBelonging, params->namesOfGroupCombos[h], rootBranches); }
-
-                for(int i=0;i<params->t->getNumNodes();i++){
-                    
-                    if (params->m->getControl_pressed()) {  break; }
-                    
-                    //pcountSize = 0, they are from a branch that is entirely from a group the user doesn't want
-                    //pcountSize = 2, not unique to one group
-                    //pcountSize = 1, unique to one group
-                    
-                    int pcountSize = 0;
-                    for (int j = 0; j < params->namesOfGroupCombos[h].size(); j++) {
-                        map<string, int>::iterator itGroup = params->t->tree[i].pcount.find(params->namesOfGroupCombos[h][j]);
-                        if (itGroup != params->t->tree[i].pcount.end()) { pcountSize++; if (pcountSize > 1) { break; } }
-                    }
-                    
-                    
-                    //unique calc
-                    if (pcountSize == 0) { }
-                    else if (!params->util.isEqual(params->t->tree[i].getBranchLength(), -1) && (pcountSize == 1) && (rootBranches.count(i) == 0)) { //you have a unique branch length and you are not the root
-                        UniqueBL += abs(params->t->tree[i].getBranchLength());
-                    }
-                    
-                    //total calc
-                    if (pcountSize == 0) { }
-                    else if (!params->util.isEqual(params->t->tree[i].getBranchLength(), -1) && (pcountSize != 0) && (rootBranches.count(i) == 0)) { //you have a branch length and you are not the root
-                        totalBL += abs(params->t->tree[i].getBranchLength());
-                    }
-                }
-                
-                UW = (UniqueBL / totalBL);
-                
-                if (isnan(UW) || isinf(UW)) { UW = 0; }
-                
-                params->results[params->count] = UW;
-            }
-            params->count++;
-        }
-    }
-    catch(exception& e) {
-        params->m->errorOut(e, "Unweighted", "driverUnweighted");
-        exit(1);
-    }
-}
-/**************************************************************************************************/
 
 EstOutput Unweighted::createProcesses(Tree* t) {
 	try {
-        vector<linePair> lines;
-        int remainingPairs = namesOfGroupCombos.size();
-        if (remainingPairs < processors) { processors = remainingPairs; }
-        int startIndex = 0;
-        for (int remainingProcessors = processors; remainingProcessors > 0; remainingProcessors--) {
-            int numPairs = remainingPairs; //case for last processor
-            if (remainingProcessors != 1) { numPairs = ceil(remainingPairs / remainingProcessors); }
-            lines.push_back(linePair(startIndex, numPairs)); //startIndex, numPairs
-            startIndex = startIndex + numPairs;
-            remainingPairs = remainingPairs - numPairs;
-        }
-        
-        //create array of worker threads
-        vector<std::thread*> workerThreads;
-        vector<unweightedData*> data;
-        vector<string> Treenames; Treenames = t->getTreeNames();
-        CountTable* ct = t->getCountTable();
+        //all the pairs in one pass over the tree
+        StripedUnifrac unifrac(t, Groups, includeRoot);
         
-        //Lauch worker threads
-        for (int i = 0; i < processors-1; i++) {
-            CountTable* copyCount = new CountTable();
-            copyCount->copy(ct);
-            Tree* copyTree = new Tree(copyCount, Treenames);
-            copyTree->getCopy(t);
-            
-            unweightedData* dataBundle = new unweightedData(lines[i+1].start, lines[i+1].end, namesOfGroupCombos, copyTree, copyCount, includeRoot);
-            data.push_back(dataBundle);
-            
-            workerThreads.push_back(new std::thread(driverUnweighted, dataBundle));
-        }
-        
-        CountTable* copyCount = new CountTable();
-        copyCount->copy(ct);
-        Tree* copyTree = new Tree(copyCount, Treenames);
-        copyTree->getCopy(t);
-        
-        unweightedData* dataBundle = new unweightedData(lines[0].start, lines[0].end, namesOfGroupCombos, t, ct, includeRoot);
-        driverUnweighted(dataBundle);
-        EstOutput results = dataBundle->results;
-        delete copyTree; delete copyCount;
-        delete dataBundle;
-        
-        for (int i = 0; i < processors-1; i++) {
-            workerThreads[i]->join();
-            
-            for (int j = 0; j < data[i]->results.size(); j++) {  results.push_back(data[i]->results[j]);  }
-            if (data[i]->count != data[i]->num) { //you didn't complete your tasks
-                m->mothurOut("[ERROR]: thread " + toString(i+1) + " failed to complete it's tasks, quitting.\n");
-                m->setControl_pressed(true);
-            }
-            
-            delete data[i]->t; delete data[i]->ct; delete data[i]; delete workerThreads[i];
-        }
-        
-        return results;
+        return (unifrac.getUnweighted(processors));
 	}
 	catch(exception& e) {
 		m->errorOut(e, "Unweighted", "createProcesses");
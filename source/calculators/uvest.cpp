@@ -29,13 +29,15 @@ EstOutput UVEst::getUVest(vector<SharedRAbundVector*> shared) {
 		sumSharedA1 = the sum of all shared otus in A where B = 1
 		sumSharedB1 = the sum of all shared otus in B where A = 1 */
 		
-		for (int i = 0; i < shared[0]->getNumBins(); i++) {
+		for (int i = 0; i < shared[0]->getNumEntries(); i++) { Atotal += shared[0]->getEntryAbund(i); }
+		for (int i = 0; i < shared[1]->getNumEntries(); i++) { Btotal += shared[1]->getEntryAbund(i); }
+		
+		//only the bins A stores can be shared, so sparse samples are not expanded
+		for (int i = 0; i < shared[0]->getNumEntries(); i++) {
 			//store in temps to avoid multiple repetitive function calls
-			tempA = shared[0]->get(i);
-			tempB = shared[1]->get(i);
-
-			Atotal += tempA;
-			Btotal += tempB;
+			tempA = shared[0]->getEntryAbund(i);
+			if (tempA == 0) { continue; }
+			tempB = shared[1]->get(shared[0]->getEntryBin(i));
 			
 			if ((tempA != 0) && (tempB != 0)) {//they are shared
 				sumSharedA += tempA;
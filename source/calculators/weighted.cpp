@@ -42,30 +42,6 @@ EstOutput Weighted::getValues(Tree* t, int p) {
 	}
 }
 
-/***********************************************************************/
-struct weightedData {
-    int start;
-    int num, count;
-    MothurOut* m;
-    EstOutput results;
-    vector< vector<string> > namesOfGroupCombos;
-    Tree* t;
-    CountTable* ct;
-    bool includeRoot;
-    
-    
-    weightedData(){}
-    weightedData(int st, int en, vector< vector<string> > ngc, Tree* tree, CountTable* count, bool ir) {
-        m = MothurOut::getInstance();
-        start = st;
-        num = en;
-        namesOfGroupCombos = ngc;
-        t = tree;
-        ct = count;
-        includeRoot = ir;
-        count = 0;
-    }
-};
 /**************************************************************************************************/
 void getRoot(MothurOut* m, Tree* t, int v, vector<string> grouping, set<int>& rootForGrouping) {
     try {
@@ -254,57 +230,6 @@ double findWeightedSums(MothurOut* m, Tree* t, set<int>& rootBranches, vector<do
         m->errorOut(e, "Weighted", "findNumerator");
         exit(1);
     }
-}
-/**************************************************************************************************/
-void driverWeighted(weightedData* params) {
- try {
-        Utils util;
-		params->count = 0;
-        vector<double> nodeToRootLength;  //length from leaf to tree root, grouping root maybe smaller. Used as reference and excess root is deducted if neccasary
-        nodeToRootLength.resize(params->t->getNumLeaves(), 0.0); //set all leaf nodes length to root to zero
-
-		for (int h = params->start; h < (params->start+params->num); h++) {
-		
-            if (params->m->getControl_pressed()) { break; }
-		
-			//initialize weighted score
-			string groupA = params->namesOfGroupCombos[h][0];
-			string groupB = params->namesOfGroupCombos[h][1];
-            
-            int groupACount = params->ct->getGroupCount(groupA);
-            int groupBCount = params->ct->getGroupCount(groupB);
-            
-            set<int> rootBranches; //if not including root this will hold branches that are "above" the root for this comparison
-			
-            double WScore = 0.0;
-			double D = 0.0;
-            
-            //find a node that belongs to one of the groups in this combo
-            int nodeBelonging = findNodeBelongingToThisComparison(params->m, params->namesOfGroupCombos[h], params->t->groupNodeInfo);
-            
-            if (nodeBelonging != -1) {
-            
-                //fills rootBranches to exclude, if including the root then rootBranches should be empty.
-                if (!params->includeRoot) { getRoot(params->m, params->t, nodeBelonging, params->namesOfGroupCombos[h], rootBranches); }
-
-                WScore = findNumerator(params->m, params->t, rootBranches, groupA, groupB, groupACount, groupBCount);
-                
-                D += findWeightedSums(params->m, params->t, rootBranches, nodeToRootLength, groupA, groupACount);
-                D += findWeightedSums(params->m, params->t, rootBranches, nodeToRootLength, groupB, groupBCount);
-                
-                double result = (WScore / D);
-                if (isnan(result) || isinf(result)) { result = 0; }
-                params->results.push_back(result);
-                
-            }else { params->results.push_back(0.0); }
-            
-			params->count++;
-		}
-	}
-	catch(exception& e) {
-		params->m->errorOut(e, "Weighted", "driverWeighted");
-		exit(1);
-	}
 }
  /**************************************************************************************************/
 EstOutput Weighted::getValues(Tree* t, string groupA, string groupB) { 
@@ -353,63 +278,10 @@ EstOutput Weighted::getValues(Tree* t, string groupA, string groupB) {
 
 EstOutput Weighted::createProcesses(Tree* t) {
     try {
-        vector<linePair> lines;
-        int remainingPairs = namesOfGroupCombos.size();
-        if (remainingPairs < processors) { processors = remainingPairs; }
-        int startIndex = 0;
-        for (int remainingProcessors = processors; remainingProcessors > 0; remainingProcessors--) {
-            int numPairs = remainingPairs; //case for last processor
-            if (remainingProcessors != 1) { numPairs = ceil(remainingPairs / remainingProcessors); }
-            lines.push_back(linePair(startIndex, numPairs)); //startIndex, numPairs
-            startIndex = startIndex + numPairs;
-            remainingPairs = remainingPairs - numPairs;
-        }
-        
-        //create array of worker threads
-        vector<std::thread*> workerThreads;
-        vector<weightedData*> data;
-        vector<string> Treenames; Treenames = t->getTreeNames();
-        CountTable* ct = t->getCountTable();
-        
-        //Lauch worker threads
-        for (int i = 0; i < processors-1; i++) {
-            CountTable* copyCount = new CountTable();
-            copyCount->copy(ct);
-            Tree* copyTree = new Tree(copyCount, Treenames);
-            copyTree->getCopy(t);
-            
-            weightedData* dataBundle = new weightedData(lines[i+1].start, lines[i+1].end, namesOfGroupCombos, copyTree, copyCount, includeRoot);
-            data.push_back(dataBundle);
-            
-            workerThreads.push_back(new std::thread(driverWeighted, dataBundle));
-        }
-        CountTable* copyCount = new CountTable();
-        copyCount->copy(ct);
-        Tree* copyTree = new Tree(copyCount, Treenames);
-        copyTree->getCopy(t);
-        
-        weightedData* dataBundle = new weightedData(lines[0].start, lines[0].end, namesOfGroupCombos, copyTree, copyCount, includeRoot);
-        driverWeighted(dataBundle);
-        EstOutput results = dataBundle->results;
-        delete copyTree; delete copyCount;
-        delete dataBundle;
-        
-        for (int i = 0; i < processors-1; i++) {
-            workerThreads[i]->join();
-            
-            for (int j = 0; j < data[i]->results.size(); j++) {  results.push_back(data[i]->results[j]);  }
-            if (data[i]->count != data[i]->num) { //you didn't complete your tasks
-                m->mothurOut("[ERROR]: thread " + toString(i+1) + " failed to complete it's tasks, quitting.\n");
-                m->setControl_pressed(true);
-            }
-            
-            delete data[i]->t;
-            delete data[i]->ct;
-            delete data[i];
-            delete workerThreads[i];
-        }
+        //all the pairs in one pass over the tree
+        StripedUnifrac unifrac(t, Groups, includeRoot);
         
-        return results;
+        return (unifrac.getWeighted(processors));
     }
     catch(exception& e) {
         m->errorOut(e, "Weighted", "createProcesses");
@@ -13,6 +13,7 @@
 
 #include "treecalculator.h"
 #include "counttable.h"
+#include "stripedunifrac.hpp"
 
 /***********************************************************************/
 
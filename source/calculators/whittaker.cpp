@@ -8,6 +8,7 @@
  */
 
 #include "whittaker.h"
+#include "pairwiseshared.hpp"
 
 /***********************************************************************/
 
@@ -18,9 +19,12 @@ EstOutput Whittaker::getValues(vector<SharedRAbundVector*> shared){
 		int countA = 0;
 		int countB = 0;
 		int sTotal = shared[0]->getNumBins();
-		for(int i=0;i<sTotal;i++){
-			if(shared[0]->get(i) != 0){	countA++;	}
-			if(shared[1]->get(i) != 0){	countB++;	}		
+		vector<int> bins, abundsA, abundsB;
+		getNonZeroBins(shared[0], shared[1], bins, abundsA, abundsB);
+		
+		for(int i=0;i<bins.size();i++){
+			if(abundsA[i] != 0){	countA++;	}
+			if(abundsB[i] != 0){	countB++;	}		
 		}
 		
 		data[0] = 2-2*sTotal/(float)(countA+countB);
@@ -33,3 +37,23 @@ EstOutput Whittaker::getValues(vector<SharedRAbundVector*> shared){
 }
 
 /***********************************************************************/
+
+EstOutput Whittaker::getValues(sharedPairStats& stats) {
+	try {
+		data.resize(1);
+		
+		int countA = stats.A->numOTUs;
+		int countB = stats.B->numOTUs;
+		int sTotal = stats.A->numBins;
+		
+		data[0] = 2-2*sTotal/(float)(countA+countB);
+		
+		return data;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "Whittaker", "getValues");
+		exit(1);
+	}
+}
+
+/***********************************************************************/
@@ -11,9 +11,22 @@
 #include "kmer.hpp"
 #include "phylosummary.h"
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#ifdef NON_WINDOWS
+#include <sys/mman.h>
+#include <fcntl.h>
+#endif
+
+#define BAYESIAN_PROB_MAGIC "MOTHBPRB"
+#define BAYESIAN_PROB_VERSION 1
+#define BAYESIAN_PROB_BYTEORDER 0x01020304
+
 /**************************************************************************************************/
 Bayesian::Bayesian(string txfile, string tempFile, string method, int ksize, int cutoff, int i, int tid, bool f, bool sh, string version) :
-Classify(), kmerSize(ksize), confidenceThreshold(cutoff), iters(i) {
+Classify(), genusStride(0), genusProbTable(nullptr), mappedProbs(nullptr), mappedProbsSize(0), kmerSize(ksize), confidenceThreshold(cutoff), iters(i) {
 	try {
 		
 		threadID = tid;
@@ -30,6 +43,7 @@ Classify(), kmerSize(ksize), confidenceThreshold(cutoff), iters(i) {
         string phyloTreeSumName = tfileroot + "tree.sum";
         string probFileName = tfileroot + tempfileroot + char('0'+ kmerSize) + "mer.prob";
         string probFileName2 = tfileroot + tempfileroot + char('0'+ kmerSize) + "mer.numNonZero";
+        string probBinaryName = probFileName + ".bin";
         
         ofstream out;
         ofstream out2;
@@ -59,7 +73,10 @@ Classify(), kmerSize(ksize), confidenceThreshold(cutoff), iters(i) {
 			genusTotals = phyloTree->getGenusTotals();
 			
             m->mothurOut("Reading template probabilities...     "); cout.flush();
-            readProbFile(*probFileTest, *probFileTest2, probFileName, probFileName2);
+            if (!readBinaryProbFile(probBinaryName, version)) {
+                readProbFile(*probFileTest, *probFileTest2, probFileName, probFileName2);
+                if (shortcuts && !m->getControl_pressed()) { writeBinaryProbFile(probBinaryName, version); } //shortcuts from before the binary file was added
+            }
 			
         }else{
 		
@@ -67,7 +84,7 @@ Classify(), kmerSize(ksize), confidenceThreshold(cutoff), iters(i) {
 			generateDatabaseAndNames(txfile, tempFile, method, ksize, 0.0, 0.0, 0.0, 0.0, version);
 			
 			//prevents errors caused by creating shortcut files if you had an error in the sanity check.
-			if (m->getControl_pressed()) {  util.mothurRemove(phyloTreeName);  util.mothurRemove(probFileName); util.mothurRemove(probFileName2); }
+			if (m->getControl_pressed()) {  util.mothurRemove(phyloTreeName);  util.mothurRemove(probFileName); util.mothurRemove(probFileName2); util.mothurRemove(probBinaryName); }
 			else{ 
 				genusNodes = phyloTree->getGenusNodes(); 
 				genusTotals = phyloTree->getGenusTotals();
@@ -83,10 +100,8 @@ Classify(), kmerSize(ksize), confidenceThreshold(cutoff), iters(i) {
 				numKmers = database->getMaxKmer() + 1;
 			
 				//initialze probabilities
-				wordGenusProb.resize(numKmers);
+				initWordGenusProb();
                 for (int j = 0; j < numKmers; j++) {  diffPair tempDiffPair; WordPairDiffArr.push_back(tempDiffPair); }
-			
-                for (int j = 0; j < wordGenusProb.size(); j++) {	wordGenusProb[j].resize(genusNodes.size(), 0.0);		}
                 ofstream out; ofstream out2;
 
                 if (shortcuts) { 
@@ -126,14 +141,15 @@ Classify(), kmerSize(ksize), confidenceThreshold(cutoff), iters(i) {
 					WordPairDiffArr[i] = tempProb;
 						
 					int numNotZero = 0;
+					float* thisKmersProbs = getWordGenusProb(i);
 					for (int k = 0; k < genusNodes.size(); k++) {
 						//probabilityInThisTaxonomy = (# of seqs with that word in this taxonomy + probabilityInTemplate) / (total number of seqs in this taxonomy + 1);
 						
 						
-						wordGenusProb[i][k] = log((count[k] + probabilityInTemplate) / (float) (genusTotals[k] + 1));  
+						thisKmersProbs[k] = log((count[k] + probabilityInTemplate) / (float) (genusTotals[k] + 1));  
 									
 						if (count[k] != 0) {
-                            if (shortcuts) { out << k << '\t' << wordGenusProb[i][k] << '\t' ; }
+                            if (shortcuts) { out << k << '\t' << thisKmersProbs[k] << '\t' ; }
 							numNotZero++;
 						}
 					}
@@ -146,6 +162,7 @@ Classify(), kmerSize(ksize), confidenceThreshold(cutoff), iters(i) {
                     
 				}
                 if (shortcuts) { out.close(); out2.close();  }
+                if (shortcuts && !m->getControl_pressed()) { writeBinaryProbFile(probBinaryName, version); }
 				
 				//read in new phylotree with less info. - its faster
 				ifstream phyloTreeTest(phyloTreeName.c_str());
@@ -160,6 +177,8 @@ Classify(), kmerSize(ksize), confidenceThreshold(cutoff), iters(i) {
 		generateWordPairDiffArr();
         if (m->getDebug()) { m->mothurOut("[DEBUG]: done generateWordPairDiffArr\n"); }
         
+        if (!m->getControl_pressed()) { initTaxNodes(); }
+        
         for (int i = 0; i < files.size(); i++) { delete files[i]; }
 			
 		m->mothurOut("DONE.\n");
@@ -175,6 +194,9 @@ Bayesian::~Bayesian() {
 	try {
         if (phyloTree != nullptr) { delete phyloTree; }
         if (database != nullptr) {  delete database; }
+#ifdef NON_WINDOWS
+        if (mappedProbs != nullptr) { munmap(mappedProbs, mappedProbsSize); }
+#endif
 	}
 	catch(exception& e) {
 		m->errorOut(e, "Bayesian", "~Bayesian");
@@ -187,40 +209,33 @@ string Bayesian::getTaxonomy(Sequence* seq, string& simpleTax, bool& flipped) {
 	try {
 		string tax = "";
         simpleTax = "";
-		Kmer kmer(kmerSize);
 		flipped = false;
 		
-		//get words contained in query
-		//getKmerString returns a string where the index in the string is hte kmer number 
-		//and the character at that index can be converted to be the number of times that kmer was seen
-		string queryKmerString = kmer.getKmerString(seq->getUnaligned()); 
+		//shared by every query this thread classifies
+		thread_local bayesianScratch scratch;
 		
-		vector<int> queryKmers;
-		for (int i = 0; i < queryKmerString.length()-1; i++) {	// the -1 is to ignore any kmer with an N in it
-			if (queryKmerString[i] != '!') { //this kmer is in the query
-				queryKmers.push_back(i);
-			}
-		}
+		//get words contained in query, in kmer order
+		fillQueryKmers(seq->getUnaligned(), scratch);
 		
 		//if user wants to test reverse compliment and its reversed use that instead
 		if (flip) {	
-			if (isReversed(queryKmers)) { 
+			if (isReversed(scratch.queryKmers)) { 
 				flipped = true;
 				seq->reverseComplement(); 
-				queryKmerString = kmer.getKmerString(seq->getUnaligned()); 
-				queryKmers.clear();
-				for (int i = 0; i < queryKmerString.length()-1; i++) {	// the -1 is to ignore any kmer with an N in it
-					if (queryKmerString[i] != '!') { //this kmer is in the query
-						queryKmers.push_back(i);
-					}
-				}
+				fillQueryKmers(seq->getUnaligned(), scratch);
 			}  
 		}
 		
+		vector<int>& queryKmers = scratch.queryKmers;
 		if (queryKmers.size() == 0) {  m->mothurOut(seq->getName() + " is bad. It has no kmers of length " + toString(kmerSize) + ".\n");  simpleTax = "unknown;";  return "unknown;"; }
 		
 		
-		int index = getMostProbableTaxonomy(queryKmers);
+		//find the query's rows once, the bootstrap samples from them
+		scratch.queryRows.resize(queryKmers.size());
+		for (int i = 0; i < queryKmers.size(); i++) { scratch.queryRows[i] = getWordGenusProb(queryKmers[i]); }
+		
+		scratch.genusProbs.resize(genusStride);
+		int index = getMostProbableTaxonomy(scratch.queryRows, scratch.genusProbs);
 		
 		if (m->getControl_pressed()) { return tax; }
 					
@@ -229,7 +244,7 @@ string Bayesian::getTaxonomy(Sequence* seq, string& simpleTax, bool& flipped) {
 	
         if (m->getDebug()) {  m->mothurOut(seq->getName() + "\t"); }
         
-		tax = bootstrapResults(queryKmers, index, numToSelect, simpleTax);
+		tax = bootstrapResults(scratch, index, numToSelect, simpleTax);
         
         if (m->getDebug()) {  m->mothurOut("\n"); }
 		
@@ -241,54 +256,67 @@ string Bayesian::getTaxonomy(Sequence* seq, string& simpleTax, bool& flipped) {
 	}
 }
 /**************************************************************************************************/
-string Bayesian::bootstrapResults(vector<int> kmers, int tax, int numToSelect, string& simpleTax) {
+//the distinct kmers in the sequence in increasing order, ignoring kmers with an N in them
+void Bayesian::fillQueryKmers(const string& sequence, bayesianScratch& scratch) {
 	try {
-				
-		map<int, int> confidenceScores; 
+		Kmer kmer(kmerSize);
+		int nKmer = 1;
+		for (int i = 0; i < kmerSize; i++) { nKmer *= 4; } //getKmerNumber returns this for a kmer with an N
+		
+		if (scratch.kmerSeen.size() != nKmer+1) { scratch.kmerSeen.assign(nKmer+1, 0); }
 		
-		//initialize confidences to 0 
-		int seqIndex = tax;
-		TaxNode seq = phyloTree->get(tax);
-		confidenceScores[tax] = 0;
+		vector<int>& queryKmers = scratch.queryKmers;
+		queryKmers.clear();
 		
-		while (seq.level != 0) { //while you are not at the root
-			seqIndex = seq.parent;
-			confidenceScores[seqIndex] = 0;
-			seq = phyloTree->get(seq.parent);
+		int numPositions = (int)sequence.length() - kmerSize + 1;
+		for (int i = 0; i < numPositions; i++) {
+			int kmerNumber = kmer.getKmerNumber(sequence, i);
+			if ((kmerNumber != nKmer) && (scratch.kmerSeen[kmerNumber] == 0)) { scratch.kmerSeen[kmerNumber] = 1; queryKmers.push_back(kmerNumber); }
 		}
-				
-		map<int, int>::iterator itBoot;
-		map<int, int>::iterator itBoot2;
-		map<int, int>::iterator itConvert;
+		
+		for (int i = 0; i < queryKmers.size(); i++) { scratch.kmerSeen[queryKmers[i]] = 0; }
+		sort(queryKmers.begin(), queryKmers.end());
+	}
+	catch(exception& e) {
+		m->errorOut(e, "Bayesian", "fillQueryKmers");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+string Bayesian::bootstrapResults(bayesianScratch& scratch, int tax, int numToSelect, string& simpleTax) {
+	try {
+		
+		//the nodes from the best taxonomy up to, but not including, the root are the ones we need confidences for
+		if (scratch.pathSlot.size() != nodeParents.size()) { scratch.pathSlot.assign(nodeParents.size(), -1); }
+		vector<int>& path = scratch.path; path.clear();
+		for (int node = tax; nodeLevels[node] != 0; node = nodeParents[node]) { scratch.pathSlot[node] = (int)path.size(); path.push_back(node); }
+		scratch.confidence.assign(path.size(), 0);
+        
+        //seeded per query like a new Utils, so a sequence gets the same confidences however the seqs are split between threads
+        scratch.randomEngine.seed(m->getRandomSeed());
         
+        vector<const float*>& kmers = scratch.queryRows;
         int numKmers = kmers.size()-1;
-        Utils util;
+        vector<const float*>& temp = scratch.sampleRows; temp.resize(numToSelect);
 		for (int i = 0; i < iters; i++) {
-			if (m->getControl_pressed()) { return "control"; }
+			if (m->getControl_pressed()) { for (int j = 0; j < path.size(); j++) { scratch.pathSlot[path[j]] = -1; } return "control"; }
 			
-            vector<int> temp;
 			for (int j = 0; j < numToSelect; j++) {
-				int index = util.getRandomIndex(numKmers);
+				int index = 0;
+				if (numKmers != 0) { uniform_int_distribution<int> dis(0, numKmers); index = dis(scratch.randomEngine); }
                 
 				//add word to temp
-				temp.push_back(kmers[index]);
+				temp[j] = kmers[index];
 			}
             
 			//get taxonomy
-			int newTax = getMostProbableTaxonomy(temp);
-			//int newTax = 1;
-			TaxNode taxonomyTemp = phyloTree->get(newTax);
+			int newTax = getMostProbableTaxonomy(temp, scratch.genusProbs);
 			
 			//add to confidence results
-			while (taxonomyTemp.level != 0) { //while you are not at the root
-				itBoot2 = confidenceScores.find(newTax); //is this a classification we already have a count on
-				
-				if (itBoot2 != confidenceScores.end()) { //this is a classification we need a confidence for
-					(itBoot2->second)++;
-				}
-				
-				newTax = taxonomyTemp.parent;
-				taxonomyTemp = phyloTree->get(newTax);
+			while (nodeLevels[newTax] != 0) { //while you are not at the root
+				int slot = scratch.pathSlot[newTax];
+				if (slot != -1) { scratch.confidence[slot]++; } //this is a classification we need a confidence for
+				newTax = nodeParents[newTax];
 			}
 	
 		}
@@ -296,28 +324,17 @@ string Bayesian::bootstrapResults(vector<int> kmers, int tax, int numToSelect, s
 		string confidenceTax = "";
 		simpleTax = "";
 		
-		int seqTaxIndex = tax;
-		TaxNode seqTax = phyloTree->get(tax);
-		
-        
-		while (seqTax.level != 0) { //while you are not at the root
-					
-				itBoot2 = confidenceScores.find(seqTaxIndex); //is this a classification we already have a count on
+		for (int j = 0; j < path.size(); j++) { //from the best taxonomy to the root
+				string name = phyloTree->getName(path[j]);
+				int confidence = scratch.confidence[j];
+				scratch.pathSlot[path[j]] = -1;
 				
-				int confidence = 0;
-				if (itBoot2 != confidenceScores.end()) { //already in confidence scores
-					confidence = itBoot2->second;
-				}
-				
-                if (m->getDebug()) { m->mothurOut(seqTax.name + "(" + toString(((confidence/(float)iters) * 100)) + ");"); }
+                if (m->getDebug()) { m->mothurOut(name + "(" + toString(((confidence/(float)iters) * 100)) + ");"); }
             
 				if (((confidence/(float)iters) * 100) >= confidenceThreshold) {
-					confidenceTax = seqTax.name + "(" + toString(((confidence/(float)iters) * 100)) + ");" + confidenceTax;
-					simpleTax = seqTax.name + ";" + simpleTax;
+					confidenceTax = name + "(" + toString(((confidence/(float)iters) * 100)) + ");" + confidenceTax;
+					simpleTax = name + ";" + simpleTax;
 				}
-            
-				seqTaxIndex = seqTax.parent;
-				seqTax = phyloTree->get(seqTax.parent);
 		}
 		
 		if (confidenceTax == "") { confidenceTax = "unknown;"; simpleTax = "unknown;";  }
@@ -331,23 +348,53 @@ string Bayesian::bootstrapResults(vector<int> kmers, int tax, int numToSelect, s
 	}
 }
 /**************************************************************************************************/
-int Bayesian::getMostProbableTaxonomy(vector<int> queryKmer) {
+void Bayesian::initTaxNodes() {
+	try {
+		int numNodes = phyloTree->getNumNodes();
+		nodeParents.resize(numNodes); nodeLevels.resize(numNodes);
+		for (int i = 0; i < numNodes; i++) {
+			TaxNode node = phyloTree->get(i);
+			nodeParents[i] = node.parent;
+			nodeLevels[i] = node.level;
+		}
+	}
+	catch(exception& e) {
+		m->errorOut(e, "Bayesian", "initTaxNodes");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+//sums the probabilities of the query's kmers for all the genera a row at a time, so the table is read in order.
+//The sums are doubles added in kmer order like the per genus loop they replace, so the results are identical.
+int Bayesian::getMostProbableTaxonomy(vector<const float*>& queryRows, vector<double>& genusProbs) {
 	try {
 		int indexofGenus = 0;
 		
+		double* probs = &genusProbs[0];
+		for (long long k = 0; k < genusStride; k++) { probs[k] = 0.0000; }
+		
+		for (int i = 0; i < queryRows.size(); i++) {
+			const float* row = queryRows[i];
+			long long k = 0;
+#if defined(__SSE2__)
+			for (; k + 4 <= genusStride; k += 4) {
+				__m128 fourProbs = _mm_loadu_ps(row + k);
+				__m128d low = _mm_cvtps_pd(fourProbs);
+				__m128d high = _mm_cvtps_pd(_mm_movehl_ps(fourProbs, fourProbs));
+				_mm_storeu_pd(probs + k, _mm_add_pd(_mm_loadu_pd(probs + k), low));
+				_mm_storeu_pd(probs + k + 2, _mm_add_pd(_mm_loadu_pd(probs + k + 2), high));
+			}
+#endif
+			for (; k < genusStride; k++) { probs[k] += row[k]; }
+		}
+		
 		double maxProbability = -1000000.0;
 		//find taxonomy with highest probability that this sequence is from it
-
         for (int k = 0; k < genusNodes.size(); k++) {
-			//for each taxonomy calc its probability
-			
-			double prob = 0.0000;
-			for (int i = 0; i < queryKmer.size(); i++) { prob += wordGenusProb[queryKmer[i]][k]; }
-
 			//is this the taxonomy with the greatest probability?
-			if (prob > maxProbability) { 
+			if (probs[k] > maxProbability) { 
 				indexofGenus = genusNodes[k];
-				maxProbability = prob;
+				maxProbability = probs[k];
 			}
 		}
 			
@@ -358,6 +405,21 @@ int Bayesian::getMostProbableTaxonomy(vector<int> queryKmer) {
 		exit(1);
 	}
 }
+/**************************************************************************************************/
+//one contiguous table, each kmer's row padded to a multiple of 4 floats so the rows can be summed 4 genera at a time
+void Bayesian::initWordGenusProb() {
+	try {
+		genusStride = ((genusNodes.size() + 3) / 4) * 4;
+		
+		vector<float> temp; wordGenusProb.swap(temp);
+		wordGenusProb.resize(numKmers*genusStride, 0.0);
+		genusProbTable = wordGenusProb.data();
+	}
+	catch(exception& e) {
+		m->errorOut(e, "Bayesian", "initWordGenusProb");
+		exit(1);
+	}
+}
 //********************************************************************************************************************
 //if it is more probable that the reverse compliment kmers are in the template, then we assume the sequence is reversed.
 bool Bayesian::isReversed(vector<int>& queryKmers){
@@ -408,8 +470,7 @@ void Bayesian::readProbFile(ifstream& in, ifstream& inNum, string inName, string
         in >> numKmers; gobble(in);
         //initialze probabilities
         
-        wordGenusProb.resize(numKmers);
-        for (int j = 0; j < wordGenusProb.size(); j++) {	wordGenusProb[j].resize(genusNodes.size());		}
+        initWordGenusProb();
         
         int kmer, name, count;  count = 0;
         vector<int> num; num.resize(numKmers);
@@ -437,14 +498,15 @@ void Bayesian::readProbFile(ifstream& in, ifstream& inNum, string inName, string
             in >> kmer;
             
             //set them all to zero value
+            float* thisKmersProbs = getWordGenusProb(kmer);
             for (int i = 0; i < genusNodes.size(); i++) {
-                wordGenusProb[kmer][i] = log(zeroCountProb[kmer] / (float) (genusTotals[i]+1));
+                thisKmersProbs[i] = log(zeroCountProb[kmer] / (float) (genusTotals[i]+1));
             }
            
             //get probs for nonzero values
             for (int i = 0; i < num[kmer]; i++) {
                 in >> name >> prob;
-                wordGenusProb[kmer][name] = prob;
+                thisKmersProbs[name] = prob;
                 if (m->getDebug()) { m->mothurOut("[DEBUG]: " + toString(name) + '\t' + toString(prob) + '\t' + toString(kmer) + "\n"); }
             }
             
@@ -459,6 +521,140 @@ void Bayesian::readProbFile(ifstream& in, ifstream& inNum, string inName, string
 	}
 }
 /**************************************************************************************************/
+//  The .prob.bin file holds the same probabilities as the .prob and .numNonZero files as one table the
+//  classifier can use in place, so every process classifying against the same template shares the pages.
+//
+//  0:   "#version\n" padded to 64 bytes, checked like the text shortcut files
+//  64:  magic "MOTHBPRB", uint32 version, uint32 byte order check, uint64 numKmers, uint64 numGenera,
+//       uint64 genusStride, uint64 total seqs in the genus nodes, padded to 128 bytes
+//  128: float32 log probability of each kmer in the template, padded to a multiple of 64 bytes
+//  then float32 wordGenusProb[numKmers*genusStride]
+static unsigned long long probHeaderSize() { return 128; }
+static unsigned long long probTableOffset(unsigned long long numKmers) { return probHeaderSize() + ((numKmers * sizeof(float) + 63) / 64) * 64; }
+/**************************************************************************************************/
+void Bayesian::writeBinaryProbFile(string filename, string version) {
+	try{
+		Utils util;
+		
+		unsigned long long numK = numKmers, numGenera = genusNodes.size(), stride = genusStride, totalSeqs = 0;
+		for (int i = 0; i < genusTotals.size(); i++) { totalSeqs += genusTotals[i]; }
+		
+		vector<char> header(probHeaderSize(), '\0');
+		string versionLine = "#" + version + "\n";
+		if (versionLine.length() > 64) { return; }
+		memcpy(&header[0], versionLine.c_str(), versionLine.length());
+		
+		unsigned int fileVersion = BAYESIAN_PROB_VERSION;
+		unsigned int byteOrder = BAYESIAN_PROB_BYTEORDER;
+		memcpy(&header[64], BAYESIAN_PROB_MAGIC, 8);
+		memcpy(&header[72], &fileVersion, sizeof(unsigned int));
+		memcpy(&header[76], &byteOrder, sizeof(unsigned int));
+		memcpy(&header[80], &numK, sizeof(unsigned long long));
+		memcpy(&header[88], &numGenera, sizeof(unsigned long long));
+		memcpy(&header[96], &stride, sizeof(unsigned long long));
+		memcpy(&header[104], &totalSeqs, sizeof(unsigned long long));
+		
+		vector<float> kmerProbs(numKmers);
+		for (int i = 0; i < numKmers; i++) { kmerProbs[i] = WordPairDiffArr[i].prob; }
+		vector<char> padding(probTableOffset(numK) - probHeaderSize() - numK * sizeof(float), '\0');
+		
+		//write to a temp file and rename so another process never maps a partial file
+		string tempName = filename + ".temp";
+		ofstream out; util.openOutputFileBinary(tempName, out);
+		out.write(&header[0], header.size());
+		out.write((char*)&kmerProbs[0], numK * sizeof(float));
+		if (padding.size() != 0) { out.write(&padding[0], padding.size()); }
+		out.write((char*)genusProbTable, numK * stride * sizeof(float));
+		bool good = (bool)out;
+		out.close();
+		
+		if (good) { util.renameFile(tempName, filename); }
+		else { util.mothurRemove(tempName); }
+	}
+	catch(exception& e) {
+		m->errorOut(e, "Bayesian", "writeBinaryProbFile");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+//returns false if the file is missing, old or does not match the tree, so the text files are read instead
+bool Bayesian::readBinaryProbFile(string filename, string version) {
+	try{
+		Utils util;
+		
+		ifstream* in = new ifstream(filename.c_str(), ios::binary);
+		if (!(*in)) { delete in; return false; }
+		
+		vector<ifstream*> files; files.push_back(in);
+		if (!checkReleaseDate(files, version)) { delete in; return false; }
+		
+		vector<char> header(probHeaderSize(), '\0');
+		in->read(&header[0], header.size());
+		if (!(*in)) { in->close(); delete in; return false; }
+		
+		unsigned int fileVersion, byteOrder;
+		unsigned long long numK, numGenera, stride, totalSeqs, fileTotalSeqs = 0;
+		memcpy(&fileVersion, &header[72], sizeof(unsigned int));
+		memcpy(&byteOrder, &header[76], sizeof(unsigned int));
+		memcpy(&numK, &header[80], sizeof(unsigned long long));
+		memcpy(&numGenera, &header[88], sizeof(unsigned long long));
+		memcpy(&stride, &header[96], sizeof(unsigned long long));
+		memcpy(&fileTotalSeqs, &header[104], sizeof(unsigned long long));
+		
+		totalSeqs = 0;
+		for (int i = 0; i < genusTotals.size(); i++) { totalSeqs += genusTotals[i]; }
+		
+		bool good = (memcmp(&header[64], BAYESIAN_PROB_MAGIC, 8) == 0) && (fileVersion == BAYESIAN_PROB_VERSION) && (byteOrder == BAYESIAN_PROB_BYTEORDER);
+		if (good) { good = (numGenera == genusNodes.size()) && (stride == ((numGenera + 3) / 4) * 4) && (totalSeqs == fileTotalSeqs); }
+		
+		unsigned long long tableOffset = probTableOffset(numK);
+		unsigned long long fileSize = tableOffset + numK * stride * sizeof(float);
+		if (good) { in->seekg(0, ios::end); good = ((unsigned long long)in->tellg() == fileSize); }
+		if (!good) { in->close(); delete in; return false; }
+		
+		numKmers = numK;
+		genusStride = stride;
+		
+		vector<float> kmerProbs(numKmers);
+		in->seekg(probHeaderSize());
+		in->read((char*)&kmerProbs[0], numK * sizeof(float));
+		
+		WordPairDiffArr.clear();
+		for (int j = 0; j < numKmers; j++) {  diffPair tempDiffPair; tempDiffPair.prob = kmerProbs[j]; WordPairDiffArr.push_back(tempDiffPair); }
+		
+#ifdef NON_WINDOWS
+		in->close(); delete in;
+		
+		//map the file read only, the pages are shared with any other process using this template
+		int fd = ::open(filename.c_str(), O_RDONLY);
+		if (fd == -1) { WordPairDiffArr.clear(); return false; }
+		void* mapped = mmap(nullptr, fileSize, PROT_READ, MAP_SHARED, fd, 0);
+		::close(fd);
+		if (mapped == MAP_FAILED) { WordPairDiffArr.clear(); return false; }
+		
+		vector<float> temp; wordGenusProb.swap(temp);
+		mappedProbs = mapped;
+		mappedProbsSize = fileSize;
+		genusProbTable = (float*)((char*)mapped + tableOffset);
+#else
+		vector<float> temp; wordGenusProb.swap(temp);
+		wordGenusProb.resize(numKmers*genusStride);
+		in->seekg(tableOffset);
+		in->read((char*)&wordGenusProb[0], numK * stride * sizeof(float));
+		good = (bool)(*in);
+		in->close(); delete in;
+		if (!good) { WordPairDiffArr.clear(); return false; }
+		genusProbTable = wordGenusProb.data();
+#endif
+		
+		return true;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "Bayesian", "readBinaryProbFile");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
 
 
 
@@ -13,10 +13,27 @@
 #include "mothur.h"
 #include "classify.h"
 
+/**************************************************************************************************/
+//working space for classifying one query, reused by each thread so the classifier can be shared without allocating per query
+struct bayesianScratch {
+	vector<int> queryKmers;
+	vector<char> kmerSeen;              //one per kmer, cleared after each query
+	vector<const float*> queryRows;
+	vector<const float*> sampleRows;    //the bootstrap sample
+	vector<double> genusProbs;
+	vector<int> path;                   //the best taxonomy's nodes up to the root
+	vector<int> pathSlot;               //one per tree node, its index in path or -1
+	vector<int> confidence;             //bootstrap counts for the nodes in path
+	mt19937_64 randomEngine;
+};
 /**************************************************************************************************/
 
 class Bayesian : public Classify {
 	
+#ifdef UNIT_TEST
+	friend class TestBayesian;
+#endif
+	
 public:
 	Bayesian(string, string, string, int, int, int, int, bool, bool, string);
 	~Bayesian();
@@ -24,19 +41,31 @@ public:
 	string getTaxonomy(Sequence*, string&, bool&);
 	
 private:
-	vector< vector<float> > wordGenusProb;	//vector of maps from genus to probability
-										//wordGenusProb[0][392] = probability that a sequence within genus that's index in the tree is 392 would contain kmer 0;
+	vector<float> wordGenusProb;	//one row per kmer, genusStride floats per row
+									//wordGenusProb[0*genusStride+392] = probability that a sequence within genus that's index in the tree is 392 would contain kmer 0;
+	long long genusStride;  //genusNodes.size() rounded up to a multiple of 4, the padding is 0
+	float* genusProbTable;  //points to wordGenusProb, or to the table in the mapped .prob.bin file
+	void* mappedProbs;      //nullptr unless the probabilities are memory mapped
+	unsigned long long mappedProbsSize;
 	
 	vector<int> genusTotals;
 	vector<int> genusNodes;  //indexes in phyloTree where genus' are located
 	
 	vector<diffPair> WordPairDiffArr; 
 	
+	vector<int> nodeParents, nodeLevels; //copied from phyloTree so the bootstrap walks the tree without copying TaxNodes
+	
 	int kmerSize, numKmers, confidenceThreshold, iters;
 	
-	string bootstrapResults(vector<int>, int, int, string&);
-	int getMostProbableTaxonomy(vector<int>);
+	string bootstrapResults(bayesianScratch&, int, int, string&);
+	void fillQueryKmers(const string&, bayesianScratch&);
+	void initTaxNodes();
+	int getMostProbableTaxonomy(vector<const float*>&, vector<double>&);
+	void initWordGenusProb();
+	float* getWordGenusProb(int kmer) { return &genusProbTable[kmer*genusStride]; }
 	void readProbFile(ifstream&, ifstream&, string, string);
+	bool readBinaryProbFile(string, string);
+	void writeBinaryProbFile(string, string);
 	bool isReversed(vector<int>&);
 	vector<int> createWordIndexArr(Sequence*);
 	int generateWordPairDiffArr();
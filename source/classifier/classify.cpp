@@ -34,13 +34,23 @@ void Classify::generateDatabaseAndNames(string tfile, string tempFile, string me
         }
         
         bool needToGenerate = true;
+        bool hasIndex = false;
         string dBName;
         if(method == "kmer")			{
             database = new KmerDB(tempFile, kmerSize);
             
+            //the index has the names and postings, so the template doesn't need to be read
+            ReferenceIndex* referenceIndex = new ReferenceIndex(tempFile, kmerSize);
+            if (referenceIndex->open()) {
+                for (int i = 0; i < referenceIndex->getNumSeqs(); i++) { names.push_back(referenceIndex->getName(i)); }
+                ((KmerDB*)database)->setIndex(referenceIndex);
+                hasIndex = true; needToGenerate = false;
+            }else { delete referenceIndex; }
+            
             dBName = tempFile.substr(0,tempFile.find_last_of(".")+1) + char('0'+ kmerSize) + "mer";
             ifstream kmerFileTest(dBName.c_str());
-            if(kmerFileTest){
+            if (hasIndex) { }
+            else if(kmerFileTest){
                 string line = util.getline(kmerFileTest);
                 bool GoodFile = util.checkReleaseVersion(line, version); kmerFileTest.close();
                 int shortcutTimeStamp = util.getTimeStamp(dBName);
@@ -60,7 +70,12 @@ void Classify::generateDatabaseAndNames(string tfile, string tempFile, string me
         }
         
         if (!m->getControl_pressed()) {
-            if (needToGenerate) {
+            if (hasIndex) { } //searching the index
+            else if (needToGenerate) {
+                //the index is shared with align.seqs, so it holds the templates as well as their names
+                ReferenceIndex* newIndex = nullptr;
+                if ((method == "kmer") && (shortcuts)) { newIndex = new ReferenceIndex(tempFile, kmerSize); }
+                
                 ifstream fastaFile; util.openInputFile(tempFile, fastaFile);
                 
                 while (!fastaFile.eof()) {
@@ -69,24 +84,35 @@ void Classify::generateDatabaseAndNames(string tfile, string tempFile, string me
                     names.push_back(temp.getName());
                     
                     database->addSequence(temp);
+                    if (newIndex != nullptr) { newIndex->addSequence(temp); }
                 }
                 fastaFile.close();
                 
                 if ((method == "kmer") && (!shortcuts)) {;} //don't print
                 else {database->generateDB(); }
                 
+                if (newIndex != nullptr) { ((KmerDB*)database)->writeIndex(newIndex); delete newIndex; }
+                
             }else if ((method == "kmer") && (!needToGenerate)) {
                 ifstream FileTest(dBName.c_str());
                 database->readDB(FileTest);
                 
+                //the .8mer shortcut numbers the templates in fasta order, so the index can be made from it for the next run
+                ReferenceIndex* newIndex = nullptr;
+                if (shortcuts) { newIndex = new ReferenceIndex(tempFile, kmerSize); }
+                
                 ifstream fastaFile; util.openInputFile(tempFile, fastaFile);
                 
                 while (!fastaFile.eof()) {
                     Sequence temp(fastaFile); gobble(fastaFile);
                     
                     names.push_back(temp.getName());
+                    if (newIndex != nullptr) { newIndex->addSequence(temp); }
                 }
                 fastaFile.close();
+                
+                //if the index can't be written, the .8mer shortcut is still used
+                if (newIndex != nullptr) { ((KmerDB*)database)->writeIndex(newIndex); delete newIndex; }
             }
             database->setNumSeqs(names.size());
             
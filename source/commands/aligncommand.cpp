@@ -24,12 +24,13 @@ vector<string> AlignCommand::setParameters(){
 		CommandParameter psearch("search", "Multiple", "kmer-suffix", "kmer", "", "", "","",false,false,true); parameters.push_back(psearch);
 		CommandParameter pksize("ksize", "Number", "", "8", "", "", "","",false,false); parameters.push_back(pksize);
 		CommandParameter pmatch("match", "Number", "", "1.0", "", "", "","",false,false); parameters.push_back(pmatch);
-		CommandParameter palign("align", "Multiple", "needleman-gotoh-noalign", "needleman", "", "", "","",false,false,true); parameters.push_back(palign);
+		CommandParameter palign("align", "Multiple", "needleman-gotoh-banded-noalign", "needleman", "", "", "","",false,false,true); parameters.push_back(palign);
 		CommandParameter pmismatch("mismatch", "Number", "", "-1.0", "", "", "","",false,false); parameters.push_back(pmismatch);
 		CommandParameter pgapopen("gapopen", "Number", "", "-5.0", "", "", "","",false,false); parameters.push_back(pgapopen);
 		CommandParameter pgapextend("gapextend", "Number", "", "-2.0", "", "", "","",false,false); parameters.push_back(pgapextend);
 		CommandParameter pprocessors("processors", "Number", "", "1", "", "", "","",false,false,true); parameters.push_back(pprocessors);
 		CommandParameter pflip("flip", "Boolean", "", "T", "", "", "","",false,false); parameters.push_back(pflip);
+		CommandParameter pkeeporder("keeporder", "Boolean", "", "F", "", "", "","",false,false); parameters.push_back(pkeeporder);
 		CommandParameter pthreshold("threshold", "Number", "", "0.50", "", "", "","",false,false); parameters.push_back(pthreshold);
 		CommandParameter pseed("seed", "Number", "", "0", "", "", "","",false,false); parameters.push_back(pseed);
         CommandParameter pinputdir("inputdir", "String", "", "", "", "", "","",false,false); parameters.push_back(pinputdir);
@@ -59,7 +60,7 @@ string AlignCommand::getHelpString(){
 		helpString += "The align.seqs command parameters are " + getCommandParameters() + ".\n";
 		helpString += "The reference and fasta parameters are required. You may leave fasta blank if you have a valid fasta file.\n";
 		helpString += "The search parameter allows you to specify the method to find most similar reference sequence.  Your options are: suffix or kmer. The default is kmer.\n";
-		helpString += "The align parameter allows you to specify the alignment method to use.  Your options are: gotoh, needleman and noalign. The default is needleman.\n";
+		helpString += "The align parameter allows you to specify the alignment method to use.  Your options are: gotoh, needleman, banded and noalign. The default is needleman. The banded option scores like needleman, but only fills the part of the alignment matrix near the diagonal the sequences share, so it uses much less memory and time on long sequences. It widens the band when the alignment runs into its edge. Like needleman it does not use the gapextend penalty.\n";
 		helpString += "The ksize parameter allows you to specify the kmer size for finding most similar reference to a given sequence.  The default is 8.\n";
 		helpString += "The match parameter allows you to specify the bonus for having the same base. Default=1.0.\n";
 		helpString += "The mistmatch parameter allows you to specify the penalty for having different bases. Default=-1.0.\n";
@@ -68,6 +69,7 @@ string AlignCommand::getHelpString(){
         helpString += "If the flip parameter is set to true the reverse complement of the sequence is aligned and the better alignment is reported.";
 		helpString += " By default, mothur will align the reverse compliment of your sequences when the alignment process removes more than 50% of the bases indicating the read may be flipped. This process assembles the best possible alignment, and downstream analysis will remove any poor quality reads remaining.\n";
 		helpString += "The threshold is used to specify a cutoff at which an alignment is deemed 'bad' and the reverse complement may be tried. The default threshold is 0.50, meaning 50% of the bases are removed in the alignment.\n";
+		helpString += "The keeporder parameter keeps the sequences in the output files in the order of the input when processors is greater than 1. The threads that finish early hold their output until the threads before them are done. The default is F.\n";
 		helpString += "The align.seqs command should be in the following format: ";
 		helpString += "align.seqs(reference=yourTemplateFile, fasta=yourUnalignedFastaFile)\n";
 		helpString += "Example: align.seqs(fasta=water.fasta, template=silva.v4.fasta)\n\n";
@@ -175,6 +177,9 @@ AlignCommand::AlignCommand(string option) : Command()  {
 			temp = validParameter.valid(parameters, "flip");			if (temp == "not found"){	temp = "t";				}
 			flip = util.isTrue(temp);
 			
+			temp = validParameter.valid(parameters, "keeporder");		if (temp == "not found"){	temp = "f";				}
+			keepOrder = util.isTrue(temp);
+			
 			temp = validParameter.valid(parameters, "threshold");	if (temp == "not found"){	temp = "0.50";			}
 			util.mothurConvert(temp, threshold); 
 			
@@ -182,7 +187,7 @@ AlignCommand::AlignCommand(string option) : Command()  {
 			if ((search != "suffix") && (search != "kmer")) { m->mothurOut("invalid search option: choices are kmer or suffix.\n");  abort=true; }
 			
 			align = validParameter.valid(parameters, "align");		if (align == "not found"){	align = "needleman";	}
-			if ((align != "needleman") && (align != "gotoh") && (align != "noalign")) { m->mothurOut("invalid align option: choices are needleman, gotoh or noalign.\n");  abort=true; }
+			if ((align != "needleman") && (align != "gotoh") && (align != "banded") && (align != "noalign")) { m->mothurOut("invalid align option: choices are needleman, gotoh, banded or noalign.\n");  abort=true; }
 		}
 		
 	}
@@ -307,6 +312,7 @@ struct alignStruct {
         if (m->getDebug()) { m->mothurOut("[DEBUG]: template longest base = "  + toString(longestBase) + " \n");            }
         if(al == "gotoh")            {    alignment = new GotohOverlap(gapOpen, gapExtend, match, misMatch, longestBase);   }
         else if(al == "needleman")    {    alignment = new NeedlemanOverlap(gapOpen, match, misMatch, longestBase);         }
+        else if(al == "banded")       {    alignment = new BandedNeedleman(gapOpen, match, misMatch, longestBase);          }
         else if(al == "noalign")        {    alignment = new NoAlign();                                                     }
         else {
             m->mothurOut(al + " is not a valid alignment option. I will run the command using needleman.\n");
@@ -485,10 +491,12 @@ long long AlignCommand::createProcesses(string alignFileName, string reportFileN
         auto synchronizedOutputAccnosFile = std::make_shared<SynchronizedOutputFile>(accnosFName);
 
         for (int i = 0; i < processors-1; i++) {
+            long long writerOrder = -1; //unordered unless keeporder=t
+            if (keepOrder) { writerOrder = i+1; }
             
-            OutputWriter* threadAlignWriter = new OutputWriter(synchronizedOutputAlignFile);
-            OutputWriter* threadReportWriter = new OutputWriter(synchronizedOutputReportFile);
-            OutputWriter* threadAccnosWriter = new OutputWriter(synchronizedOutputAccnosFile);
+            OutputWriter* threadAlignWriter = new OutputWriter(synchronizedOutputAlignFile, writerOrder);
+            OutputWriter* threadReportWriter = new OutputWriter(synchronizedOutputReportFile, writerOrder);
+            OutputWriter* threadAccnosWriter = new OutputWriter(synchronizedOutputAccnosFile, writerOrder);
 
             
             alignStruct* dataBundle = new alignStruct(lines[i+1], threadAlignWriter, threadReportWriter, threadAccnosWriter, filename, templateDB, align, match, misMatch, gapOpen, gapExtend, threshold, flip, kmerSize, search);
@@ -497,9 +505,11 @@ long long AlignCommand::createProcesses(string alignFileName, string reportFileN
             workerThreads.push_back(new std::thread(alignDriver, dataBundle));
          }
         
-        OutputWriter* threadAlignWriter = new OutputWriter(synchronizedOutputAlignFile);
-        OutputWriter* threadReportWriter = new OutputWriter(synchronizedOutputReportFile);
-        OutputWriter* threadAccnosWriter = new OutputWriter(synchronizedOutputAccnosFile);
+        long long writerOrder = -1;
+        if (keepOrder) { writerOrder = 0; }
+        OutputWriter* threadAlignWriter = new OutputWriter(synchronizedOutputAlignFile, writerOrder);
+        OutputWriter* threadReportWriter = new OutputWriter(synchronizedOutputReportFile, writerOrder);
+        OutputWriter* threadAccnosWriter = new OutputWriter(synchronizedOutputAccnosFile, writerOrder);
         
         alignStruct* dataBundle = new alignStruct(lines[0], threadAlignWriter, threadReportWriter, threadAccnosWriter, filename, templateDB, align, match, misMatch, gapOpen, gapExtend, threshold, flip, kmerSize, search);
         alignDriver(dataBundle);
@@ -16,6 +16,7 @@
 #include "sequence.hpp"
 #include "gotohoverlap.hpp"
 #include "needlemanoverlap.hpp"
+#include "bandedneedleman.hpp"
 #include "noalign.hpp"
 #include "nast.hpp"
 #include "alignreport.hpp"
@@ -54,7 +55,7 @@ protected:
 	int processors, kmerSize;
 	vector<string> outputNames;
 	
-	bool abort, flip, calledHelp, save;
+	bool abort, flip, calledHelp, save, keepOrder;
     AlignmentDB* templateDB;
 
 };
@@ -25,6 +25,7 @@ vector<string> ClassifySeqsCommand::setParameters(){
 		CommandParameter pksize("ksize", "Number", "", "8", "", "", "","",false,false); parameters.push_back(pksize);
 		CommandParameter pmethod("method", "Multiple", "wang-knn-zap", "wang", "", "", "","",false,false); parameters.push_back(pmethod);
 		CommandParameter pprocessors("processors", "Number", "", "1", "", "", "","",false,false,true); parameters.push_back(pprocessors);
+		CommandParameter pkeeporder("keeporder", "Boolean", "", "F", "", "", "","",false,false); parameters.push_back(pkeeporder);
 		CommandParameter pmatch("match", "Number", "", "1.0", "", "", "","",false,false); parameters.push_back(pmatch);
         CommandParameter pprintlevel("printlevel", "Number", "", "-1", "", "", "","",false,false); parameters.push_back(pprintlevel);
 		CommandParameter pmismatch("mismatch", "Number", "", "-1.0", "", "", "","",false,false); parameters.push_back(pmismatch);
@@ -70,6 +71,7 @@ string ClassifySeqsCommand::getHelpString(){
 		helpString += "The method parameter allows you to specify classification method to use.  Your options are: wang, knn and zap. The default is wang.\n";
 		helpString += "The ksize parameter allows you to specify the kmer size for finding most similar template to candidate.  The default is 8.\n";
 		helpString += "The processors parameter allows you to specify the number of processors to use. The default is all available.\n";
+		helpString += "The keeporder parameter keeps the sequences in the output files in the order of the input when processors is greater than 1. The threads that finish early hold their output until the threads before them are done. The default is F.\n";
 		helpString += "The match parameter allows you to specify the bonus for having the same base. The default is 1.0.\n";
 		helpString += "The mistmatch parameter allows you to specify the penalty for having different bases.  The default is -1.0.\n";
 		helpString += "The gapopen parameter allows you to specify the penalty for opening a gap in an alignment. The default is -2.0.\n";
@@ -195,6 +197,9 @@ ClassifySeqsCommand::ClassifySeqsCommand(string option) : Command()  {
 			string temp;
 			temp = validParameter.valid(parameters, "processors");	if (temp == "not found"){	temp = current->getProcessors();	}
 			processors = current->setProcessors(temp);
+			
+			temp = validParameter.valid(parameters, "keeporder");	if (temp == "not found"){	temp = "f";	}
+			keepOrder = util.isTrue(temp);
 
 			//this has to go after save so that if the user sets save=t and provides no reference we abort
 			templateFileName = validParameter.validFile(parameters, "reference");
@@ -565,9 +570,12 @@ int ClassifySeqsCommand::createProcesses(string taxFileName, string tempTaxFile,
 
         //Lauch worker threads
         for (int i = 0; i < processors-1; i++) {
-            OutputWriter* threadTaxWriter = new OutputWriter(synchronizedTaxFile);
-            OutputWriter* threadTaxTWriter = new OutputWriter(synchronizedTaxTFile);
-            OutputWriter* threadAccnosWriter = new OutputWriter(synchronizedAccnosFile);
+            long long writerOrder = -1; //unordered unless keeporder=t
+            if (keepOrder) { writerOrder = i+1; }
+            
+            OutputWriter* threadTaxWriter = new OutputWriter(synchronizedTaxFile, writerOrder);
+            OutputWriter* threadTaxTWriter = new OutputWriter(synchronizedTaxTFile, writerOrder);
+            OutputWriter* threadAccnosWriter = new OutputWriter(synchronizedAccnosFile, writerOrder);
             
             classifyData* dataBundle = new classifyData(threadAccnosWriter, probs, threadTaxWriter, threadTaxTWriter, filename, lines[i+1].start, lines[i+1].end, flip, classify);
             data.push_back(dataBundle);
@@ -575,9 +583,11 @@ int ClassifySeqsCommand::createProcesses(string taxFileName, string tempTaxFile,
             workerThreads.push_back(new std::thread(driverClassifier, dataBundle));
         }
         
-        OutputWriter* threadTaxWriter = new OutputWriter(synchronizedTaxFile);
-        OutputWriter* threadTaxTWriter = new OutputWriter(synchronizedTaxTFile);
-        OutputWriter* threadAccnosWriter = new OutputWriter(synchronizedAccnosFile);
+        long long writerOrder = -1;
+        if (keepOrder) { writerOrder = 0; }
+        OutputWriter* threadTaxWriter = new OutputWriter(synchronizedTaxFile, writerOrder);
+        OutputWriter* threadTaxTWriter = new OutputWriter(synchronizedTaxTFile, writerOrder);
+        OutputWriter* threadAccnosWriter = new OutputWriter(synchronizedAccnosFile, writerOrder);
         
         classifyData* dataBundle = new classifyData(threadAccnosWriter, probs, threadTaxWriter, threadTaxTWriter, filename, lines[0].start, lines[0].end, flip, classify);
         driverClassifier(dataBundle);
@@ -61,7 +61,7 @@ private:
 	string fastafile, templateFileName, countfile, distanceFileName, namefile, search, method, taxonomyFileName, groupfile, output;
 	int processors, kmerSize, numWanted, cutoff, iters, printlevel;
 	float match, misMatch, gapOpen, gapExtend;
-	bool abort, probs, save, flip, hasName, hasCount, writeShortcuts, relabund;
+	bool abort, probs, save, flip, hasName, hasCount, writeShortcuts, relabund, keepOrder;
 	
 	int createProcesses(string, string, string, string); 
 };
@@ -87,7 +87,7 @@ string ClusterCommand::getHelpString(){
         helpString += "The initialize parameter allows to select the initial randomization for the opticluster method. Options are singleton, meaning each sequence is randomly assigned to its own OTU, or oneotu meaning all sequences are assigned to one otu. Default=singleton.\n";
         helpString += "The delta parameter allows to set the stable value for the metric in the opticluster method (delta=0.0001). \n";
         helpString += "The method parameter allows you to enter your clustering mothod. Options are furthest, nearest, average, weighted, agc, dgc, unique and opti. Default=opti.  The agc and dgc methods require a fasta file.";
-        helpString += "The processors parameter allows you to specify the number of processors to use. The default is 1.\n";
+        helpString += "The processors parameter allows you to specify the number of processors to use. The default is 1. With the opti method, setting processors above 1 evaluates the sequences in batches, so the OTUs may differ slightly from a 1 processor run, but are the same for any number of processors with the same seed.\n";
          helpString += "The vsearch parameter allows you to specify the name and location of your vsearch executable if using agc or dgc clustering methods. By default mothur will look in your path, mothur's executable and mothur tools locations.  You can set the vsearch location as follows, vsearch=/usr/bin/vsearch.\n";
        helpString += "The cluster command should be in the following format: \n";
 		helpString += "cluster(method=yourMethod, cutoff=yourCutoff, precision=yourPrecision) \n";
@@ -286,10 +286,13 @@ ClusterCommand::ClusterCommand(string option) : Command()  {
             
             if ((method == "agc") || (method == "dgc")) {
                 if (fastafile == "") { m->mothurOut("[ERROR]: You must provide a fasta file when using the agc or dgc clustering methods, aborting\n."); abort = true;}
-            }else if (setProcessors) {
-                m->mothurOut("[WARNING]: You can only use the processors option when using the agc or dgc clustering methods. Using 1 processor.\n.");
+            }else if (setProcessors && (method != "opti")) {
+                m->mothurOut("[WARNING]: You can only use the processors option when using the agc, dgc or opti clustering methods. Using 1 processor.\n.");
             }
             
+            //multithreaded opticlust finds different OTUs than the serial method, so only use it if asked
+            if ((method == "opti") && !setProcessors) { processors = 1; }
+            
             cutOffSet = false;
             temp = validParameter.valid(parameters, "cutoff");
             if (temp == "not found") { if ((method == "opti") || (method == "agc") || (method == "dgc")) { temp = "0.03"; }else { temp = "0.15"; } }
@@ -829,6 +832,7 @@ int ClusterCommand::runOptiCluster(){
             OptiData* matrix = new OptiMatrix(distfile, thisNamefile, nameOrCount, format, cutoff, false);
             
             OptiCluster cluster(matrix, metric, 0);
+            cluster.setProcessors(processors);
             
             int iters = 0;
             double listVectorMetric = 0; //worst state
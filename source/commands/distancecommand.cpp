@@ -15,7 +15,7 @@ vector<string> DistanceCommand::setParameters(){
 		CommandParameter pcolumn("column", "InputTypes", "", "", "none", "none", "OldFastaColumn","column",false,false); parameters.push_back(pcolumn);
 		CommandParameter poldfasta("oldfasta", "InputTypes", "", "", "none", "none", "OldFastaColumn","",false,false); parameters.push_back(poldfasta);
 		CommandParameter pfasta("fasta", "InputTypes", "", "", "none", "none", "none","phylip-column",false,true, true); parameters.push_back(pfasta);
-		CommandParameter poutput("output", "Multiple", "column-lt-square", "column", "", "", "","phylip-column",false,false, true); parameters.push_back(poutput);
+		CommandParameter poutput("output", "Multiple", "column-lt-square-binary", "column", "", "", "","phylip-column",false,false, true); parameters.push_back(poutput);
 		CommandParameter pcalc("calc", "Multiple", "nogaps-eachgap-onegap-jtt-pmb-pam-kimura", "onegap", "", "", "","",false,false); parameters.push_back(pcalc);
 		CommandParameter pcountends("countends", "Boolean", "", "T", "", "", "","",false,false); parameters.push_back(pcountends);
         CommandParameter pfitcalc("fitcalc", "Boolean", "", "F", "", "", "","",false,false); parameters.push_back(pfitcalc);
@@ -26,7 +26,7 @@ vector<string> DistanceCommand::setParameters(){
         CommandParameter pinputdir("inputdir", "String", "", "", "", "", "","",false,false); parameters.push_back(pinputdir);
 		CommandParameter poutputdir("outputdir", "String", "", "", "", "", "","",false,false); parameters.push_back(poutputdir);
 		
-        abort = false; calledHelp = false;
+        abort = false; calledHelp = false; packed = nullptr;
        
         vector<string> tempOutNames;
         outputTypes["phylip"] = tempOutNames;
@@ -52,7 +52,7 @@ string DistanceCommand::getHelpString(){
 		helpString += "The calc parameter allows you to specify the method of calculating the distances.  Your options are: nogaps, onegap or eachgap for dna/rna sequences. If using protein sequences, your calc options are jtt, pmb, pam and kimura. The default is onegap.\n";
 		helpString += "The countends parameter allows you to specify whether to include terminal gaps in distance.  Your options are: T or F. The default is T.\n";
 		helpString += "The cutoff parameter allows you to specify maximum distance to keep. The default is 1.0.\n";
-		helpString += "The output parameter allows you to specify format of your distance matrix. Options are column, lt, and square. The default is column.\n";
+		helpString += "The output parameter allows you to specify format of your distance matrix. Options are column, lt, square and binary. The default is column. The binary option writes a sparse binary distance file that the cluster and sens.spec commands can read with the column parameter without parsing. It is not compressed by the compress parameter.\n";
 		helpString += "The processors parameter allows you to specify number of processors to use.  The default is 1.\n";
 		helpString += "The compress parameter allows you to indicate that you want the resulting distance file compressed.  The default is false.\n";
 		helpString += "The dist.seqs command should be in the following format: \n";
@@ -144,7 +144,9 @@ DistanceCommand::DistanceCommand(string option) : Command() {
 			
 			if ((column != "") && (oldfastafile != "") && (output != "column")) { m->mothurOut("You have provided column and oldfasta, indicating you want to append distances to your column file. Your output must be in column format to do so.\n"); abort=true; }
 			
-			if ((output != "column") && (output != "lt") && (output != "square")) { m->mothurOut(output + " is not a valid output form. Options are column, lt and square. I will use column.\n");  output = "column"; }
+			if ((output != "column") && (output != "lt") && (output != "square") && (output != "binary")) { m->mothurOut(output + " is not a valid output form. Options are column, lt, square and binary. I will use column.\n");  output = "column"; }
+            
+            if (compress && (output == "binary")) { m->mothurOut("The binary distance file is read in place, so it will not be compressed.\n"); compress = false; }
             
             if ((calc != "onegap") && (calc != "eachgap") && (calc != "nogaps") && (calc != "jtt") && (calc != "pmb") && (calc != "pam") && (calc != "kimura")) { m->mothurOut(calc + " is not a valid calc. Options are eachgap, onegap, nogaps, jtt, pmb, pam and kimura. I'll use onegap.\n");  calc = "onegap";  }
             
@@ -161,7 +163,7 @@ DistanceCommand::DistanceCommand(string option) : Command() {
 //**********************************************************************************************************************
 DistanceCommand::DistanceCommand(StorageDatabase*& storageDB, string outputFileRoot, double cut, string outputformat, int proc) : Command() {
     try {
-        abort = false; calledHelp = false;
+        abort = false; calledHelp = false; packed = nullptr;
         vector<string> tempOutNames;
         outputTypes["phylip"] = tempOutNames;
         outputTypes["column"] = tempOutNames;
@@ -202,9 +204,14 @@ DistanceCommand::DistanceCommand(StorageDatabase*& storageDB, string outputFileR
        
         
         m->mothurOut("\nSequence\tTime\tNum_Dists_Below_Cutoff\n");
-                     
+        
+        //the database belongs to the calling command, so the packed copy only lives while the distances are calculated
+        packed = new PackedDist(calc, countends); packed->addSeqs(db);
+        
         createProcesses(outputFile);
         
+        delete packed; packed = nullptr;
+        
         m->mothurOut("\nOutput File Names:\n"); m->mothurOut(outputFile+"\n\n");
         
     }
@@ -224,7 +231,7 @@ int DistanceCommand::execute(){
         
         ifstream inFASTA; util.openInputFile(fastafile, inFASTA);
         if (prot) { db = new ProteinDB(inFASTA);  }
-        else      { db = new SequenceDB(inFASTA); }
+        else      { packed = new PackedDist(calc, countends); packed->addSeqs(inFASTA); db = packed; } //packed as read, no SequenceDB copy
         inFASTA.close();
 		
 		//save number of new sequence
@@ -252,8 +259,9 @@ int DistanceCommand::execute(){
 			util.mothurRemove(outputFile); outputTypes["phylip"].push_back(outputFile);
 			
 			//output numSeqs to phylip formatted dist file
-		}else if (output == "column") { //user wants column format
+		}else if ((output == "column") || (output == "binary")) { //user wants column format
             if (fitCalc) {  variables["[outputtag]"] = "fit";  }
+            if (output == "binary") { variables["[outputtag]"] = "bin"; }
 			outputFile = getOutputFileName("column", variables);
 			outputTypes["column"].push_back(outputFile);
             
@@ -274,6 +282,8 @@ int DistanceCommand::execute(){
                      
         createProcesses(outputFile);
         
+        delete db; db = nullptr; packed = nullptr;
+        
 		if (m->getControl_pressed()) { outputTypes.clear();  util.mothurRemove(outputFile); return 0; }
 		
 		ifstream fileHandle; fileHandle.open(outputFile.c_str());
@@ -333,45 +343,46 @@ int DistanceCommand::execute(){
 	}
 }
 /**************************************************************************************************/
-void driverColumn(distanceData* params){
+//dna distances are calculated by the PackedDist shared by all threads, each thread creates its own protein calculator
+DistCalc* createProteinCalc(distanceData* params){
     try {
         ValidCalculators validCalculator;
-        DistCalc* distCalculator;
-
-        if (!params->prot) {
-            if (params->countends) {
-                if (validCalculator.isValidCalculator("distance", params->calc) ) {
-                    if (params->calc == "nogaps")			{	distCalculator = new ignoreGaps(params->cutoff);	}
-                    else if (params->calc == "eachgap")	{	distCalculator = new eachGapDist(params->cutoff);	}
-                    else if (params->calc == "onegap")		{	distCalculator = new oneGapDist(params->cutoff);	}
-                }
-            }else {
-                if (validCalculator.isValidCalculator("distance", params->calc) ) {
-                    if (params->calc == "nogaps")		{	distCalculator = new ignoreGaps(params->cutoff);					}
-                    else if (params->calc == "eachgap"){	distCalculator = new eachGapIgnoreTermGapDist(params->cutoff);	}
-                    else if (params->calc == "onegap")	{	distCalculator = new oneGapIgnoreTermGapDist(params->cutoff);		}
-                }
-            }
-        }else {
-            if (validCalculator.isValidCalculator("protdist", params->calc) ) {
-                if (params->calc == "jtt")        {    distCalculator = new JTT(params->cutoff);                    }
-                else if (params->calc == "pmb")        {    distCalculator = new PMB(params->cutoff);               }
-                else if (params->calc == "pam")        {    distCalculator = new PAM(params->cutoff);               }
-                else if (params->calc == "kimura")        {    distCalculator = new Kimura(params->cutoff);               }
-            }
+        DistCalc* distCalculator = nullptr;
+        
+        if (validCalculator.isValidCalculator("protdist", params->calc) ) {
+            if (params->calc == "jtt")        {    distCalculator = new JTT(params->cutoff);                    }
+            else if (params->calc == "pmb")        {    distCalculator = new PMB(params->cutoff);               }
+            else if (params->calc == "pam")        {    distCalculator = new PAM(params->cutoff);               }
+            else if (params->calc == "kimura")        {    distCalculator = new Kimura(params->cutoff);               }
         }
-            
+        
+        return distCalculator;
+    }
+    catch(exception& e) {
+        params->m->errorOut(e, "DistanceCommand", "createProteinCalc");
+        exit(1);
+    }
+}
+/**************************************************************************************************/
+void driverColumn(distanceData* params){
+    try {
+        DistCalc* distCalculator = nullptr;
+        if (params->prot) { distCalculator = createProteinCalc(params); }
         
         int startTime = time(nullptr);
        
         params->count = 0;
         string buffer = "";
         
+        //binary rows are written as they finish, the file for the thread's rows is joined to the others by BinaryDistFile
+        ofstream binaryOut; vector<sparseDistCell> row;
+        if (params->binary) { params->util.openOutputFileBinary(params->outputFileName, binaryOut); }
+        
         for(int i=params->startLine;i<params->endLine;i++){
             
-            Sequence seqI; Protein seqIP; string nameI = "";
+            Protein seqIP; string nameI = "";
             if (params->prot)   { seqIP = params->db->getProt(i);   nameI = seqIP.getName();    }
-            else                { seqI = params->db->getSeq(i);     nameI = seqI.getName();     }
+            else                { nameI = params->packed->getName(i);                           }
             
             for(int j=0;j<i;j++){
                 
@@ -381,15 +392,18 @@ void driverColumn(distanceData* params){
                 
                 double dist = 1.0; string nameJ = "";
                 if (params->prot)   { Protein seqJP = params->db->getProt(j); nameJ = seqJP.getName(); dist = distCalculator->calcDist(seqIP, seqJP);   }
-                else                { Sequence seqJ = params->db->getSeq(j);  nameJ = seqJ.getName(); dist = distCalculator->calcDist(seqI, seqJ);       }
+                else                { nameJ = params->packed->getName(j); dist = params->packed->calcDist(i, j, params->cutoff);       }
                 
                 
                 if(dist <= params->cutoff){
-                    buffer += (nameI + " " + nameJ + " " + toString(dist) + "\n");
+                    if (params->binary) { row.push_back(sparseDistCell(j, BinaryDistFile::roundDist(dist))); }
+                    else                { buffer += (nameI + " " + nameJ + " " + toString(dist) + "\n"); }
                     params->count++;
                 }
             }
             
+            if (params->binary) { BinaryDistFile::writeRow(binaryOut, row); params->rowSizes.push_back(row.size()); row.clear(); }
+            
             if(i % 100 == 0){ params->threadWriter->write(buffer);  buffer = ""; params->m->mothurOutJustToScreen(toString(i) + "\t" + toString(time(nullptr) - startTime) + "\t" + toString(params->count) +"\n"); }
             
         }
@@ -397,6 +411,7 @@ void driverColumn(distanceData* params){
         
         if((params->endLine-1) % 100 != 0){ params->m->mothurOutJustToScreen(toString(params->endLine-1) + "\t" + toString(time(nullptr) - startTime) + "\t" + toString(params->count) +"\n"); }
         
+        if (params->binary) { binaryOut.close(); }
         delete distCalculator;
     }
     catch(exception& e) {
@@ -405,34 +420,56 @@ void driverColumn(distanceData* params){
     }
 }
 /**************************************************************************************************/
-void driverLt(distanceData* params){
+//same output as driverColumn, but the work is pulled from the shared tile queue so the seqs being compared stay in cache
+void driverColumnTiled(distanceData* params){
     try {
-        ValidCalculators validCalculator;
-        DistCalc* distCalculator;
-        double cutoff = 1.0;
+        int startTime = time(nullptr);
         
-        if (!params->prot) {
-            if (params->countends) {
-                if (validCalculator.isValidCalculator("distance", params->calc) ) {
-                    if (params->calc == "nogaps")			{	distCalculator = new ignoreGaps(cutoff);	}
-                    else if (params->calc == "eachgap")	{	distCalculator = new eachGapDist(cutoff);	}
-                    else if (params->calc == "onegap")		{	distCalculator = new oneGapDist(cutoff);	}
-                }
-            }else {
-                if (validCalculator.isValidCalculator("distance", params->calc) ) {
-                    if (params->calc == "nogaps")		{	distCalculator = new ignoreGaps(cutoff);					}
-                    else if (params->calc == "eachgap"){	distCalculator = new eachGapIgnoreTermGapDist(cutoff);	}
-                    else if (params->calc == "onegap")	{	distCalculator = new oneGapIgnoreTermGapDist(cutoff);		}
+        params->count = 0;
+        long long numTiles = params->tiles->getNumTiles();
+        string buffer = "";
+        distanceTile tile;
+        
+        while (params->tiles->getNext(tile)) {
+            
+            if (params->m->getControl_pressed()) { break;  }
+            
+            for (long long i = tile.rowStart; i < tile.rowEnd; i++) {
+                
+                const string& nameI = params->packed->getName(i);
+                long long colEnd = min(tile.colEnd, i); //lower triangle only
+                
+                for (long long j = tile.colStart; j < colEnd; j++) {
+                    
+                    if ((i >= params->numNewFasta) && (j >= params->numNewFasta)) { break; }
+                    
+                    double dist = params->packed->calcDist(i, j, params->cutoff);
+                    
+                    if(dist <= params->cutoff){
+                        buffer += (nameI + " " + params->packed->getName(j) + " " + toString(dist) + "\n");
+                        params->count++;
+                    }
                 }
             }
-        }else {
-            if (validCalculator.isValidCalculator("protdist", params->calc) ) {
-                if (params->calc == "jtt")        {    distCalculator = new JTT(params->cutoff);                    }
-                else if (params->calc == "pmb")        {    distCalculator = new PMB(params->cutoff);               }
-                else if (params->calc == "pam")        {    distCalculator = new PAM(params->cutoff);               }
-                else if (params->calc == "kimura")        {    distCalculator = new Kimura(params->cutoff);         }
-            }
+            
+            params->threadWriter->write(buffer);  buffer = "";
+            
+            //tiles finish in any order, so report how many are done rather than a sequence
+            long long numCompleted = params->tiles->finishTile();
+            if((numCompleted % 100 == 0) || (numCompleted == numTiles)){ params->m->mothurOutJustToScreen(toString(numCompleted) + "/" + toString(numTiles) + " tiles\t" + toString(time(nullptr) - startTime) + "\t" + toString(params->count) +"\n"); }
         }
+    }
+    catch(exception& e) {
+        params->m->errorOut(e, "DistanceCommand", "driverColumnTiled");
+        exit(1);
+    }
+}
+/**************************************************************************************************/
+void driverLt(distanceData* params){
+    try {
+        DistCalc* distCalculator = nullptr;
+        double cutoff = 1.0;
+        if (params->prot) { distCalculator = createProteinCalc(params); }
         
         int startTime = time(nullptr);
         long long numSeqs = params->db->getNumSeqs();
@@ -446,9 +483,9 @@ void driverLt(distanceData* params){
         params->count = 0;
         for(int i=params->startLine;i<params->endLine;i++){
             
-            Sequence seqI; Protein seqIP; string nameI = "";
+            Protein seqIP; string nameI = "";
             if (params->prot)   { seqIP = params->db->getProt(i);   nameI = seqIP.getName();    }
-            else                { seqI = params->db->getSeq(i);     nameI = seqI.getName();     }
+            else                { nameI = params->packed->getName(i);                           }
             
             if (nameI.length() < 10) {  while (nameI.length() < 10) {  nameI += " ";  } }
             outFile << nameI;
@@ -461,7 +498,7 @@ void driverLt(distanceData* params){
                 
                 double dist = 1.0;
                 if (params->prot)   { Protein seqJP = params->db->getProt(j);  dist = distCalculator->calcDist(seqIP, seqJP);   }
-                else                { Sequence seqJ = params->db->getSeq(j);  dist = distCalculator->calcDist(seqI, seqJ);       }
+                else                { dist = params->packed->calcDist(i, j, cutoff);                           }
                 
                 if(dist <= params->cutoff){ params->count++; }
                 outFile  << '\t' << dist;
@@ -486,32 +523,9 @@ void driverLt(distanceData* params){
 /**************************************************************************************************/
 void driverSquare(distanceData* params){
     try {
-        ValidCalculators validCalculator;
-        DistCalc* distCalculator;
+        DistCalc* distCalculator = nullptr;
         double cutoff = 1.0;
-        
-        if (!params->prot) {
-            if (params->countends) {
-                if (validCalculator.isValidCalculator("distance", params->calc) ) {
-                    if (params->calc == "nogaps")			{	distCalculator = new ignoreGaps(cutoff);	}
-                    else if (params->calc == "eachgap")	{	distCalculator = new eachGapDist(cutoff);	    }
-                    else if (params->calc == "onegap")		{	distCalculator = new oneGapDist(cutoff);	}
-                }
-            }else {
-                if (validCalculator.isValidCalculator("distance", params->calc) ) {
-                    if (params->calc == "nogaps")		{	distCalculator = new ignoreGaps(cutoff);					}
-                    else if (params->calc == "eachgap"){	distCalculator = new eachGapIgnoreTermGapDist(cutoff);	}
-                    else if (params->calc == "onegap")	{	distCalculator = new oneGapIgnoreTermGapDist(cutoff);		}
-                }
-            }
-        }else {
-            if (validCalculator.isValidCalculator("protdist", params->calc) ) {
-                if (params->calc == "jtt")        {    distCalculator = new JTT(params->cutoff);                    }
-                else if (params->calc == "pmb")        {    distCalculator = new PMB(params->cutoff);               }
-                else if (params->calc == "pam")        {    distCalculator = new PAM(params->cutoff);               }
-                else if (params->calc == "kimura")        {    distCalculator = new Kimura(params->cutoff);         }
-            }
-        }
+        if (params->prot) { distCalculator = createProteinCalc(params); }
         
         int startTime = time(nullptr);
         
@@ -526,9 +540,9 @@ void driverSquare(distanceData* params){
         params->count = 0;
         for(int i=params->startLine;i<params->endLine;i++){
             
-            Sequence seqI; Protein seqIP; string nameI = "";
+            Protein seqIP; string nameI = "";
             if (params->prot)   { seqIP = params->db->getProt(i);   nameI = seqIP.getName();    }
-            else                { seqI = params->db->getSeq(i);     nameI = seqI.getName();     }
+            else                { nameI = params->packed->getName(i);                           }
             
             if (nameI.length() < 10) {  while (nameI.length() < 10) {  nameI += " ";  } }
             outFile << nameI << '\t';
@@ -541,7 +555,7 @@ void driverSquare(distanceData* params){
                 if (i == j) { dist = 0.0000; }
                 else {
                     if (params->prot)   { Protein seqJP = params->db->getProt(j);  dist = distCalculator->calcDist(seqIP, seqJP);   }
-                    else                { Sequence seqJ = params->db->getSeq(j);  dist = distCalculator->calcDist(seqI, seqJ);       }
+                    else                { dist = params->packed->calcDist(i, j, cutoff);                           }
                 }
                 
                 if(dist <= params->cutoff){ params->count++; }
@@ -567,50 +581,27 @@ void driverSquare(distanceData* params){
 /**************************************************************************************************/
 void driverFitCalc(distanceData* params){
     try {
-        ValidCalculators validCalculator;
-        DistCalc* distCalculator;
-        
-        if (!params->prot) {
-            if (params->countends) {
-                if (validCalculator.isValidCalculator("distance", params->calc) ) {
-                    if (params->calc == "nogaps")			{	distCalculator = new ignoreGaps(params->cutoff);	}
-                    else if (params->calc == "eachgap")	{	distCalculator = new eachGapDist(params->cutoff);	}
-                    else if (params->calc == "onegap")		{	distCalculator = new oneGapDist(params->cutoff);	}
-                }
-            }else {
-                if (validCalculator.isValidCalculator("distance", params->calc) ) {
-                    if (params->calc == "nogaps")		{	distCalculator = new ignoreGaps(params->cutoff);					}
-                    else if (params->calc == "eachgap"){	distCalculator = new eachGapIgnoreTermGapDist(params->cutoff);	}
-                    else if (params->calc == "onegap")	{	distCalculator = new oneGapIgnoreTermGapDist(params->cutoff);		}
-                }
-            }
-        }else {
-            if (validCalculator.isValidCalculator("protdist", params->calc) ) {
-                if (params->calc == "jtt")        {    distCalculator = new JTT(params->cutoff);                    }
-                else if (params->calc == "pmb")        {    distCalculator = new PMB(params->cutoff);               }
-                else if (params->calc == "pam")        {    distCalculator = new PAM(params->cutoff);               }
-                else if (params->calc == "kimura")        {    distCalculator = new Kimura(params->cutoff);         }
-            }
-        }
+        DistCalc* distCalculator = nullptr;
+        if (params->prot) { distCalculator = createProteinCalc(params); }
         
         int startTime = time(nullptr);
         params->count = 0;
         string buffer = "";
         for(int i=params->startLine;i<params->endLine;i++){
             
-            Sequence seqI; Protein seqIP; string nameI = "";
+            Protein seqIP; string nameI = "";
             if (params->prot)   { seqIP = params->oldFastaDB->getProt(i);   nameI = seqIP.getName();    }
-            else                { seqI = params->oldFastaDB->getSeq(i);     nameI = seqI.getName();     }
+            else                { nameI = params->packed->getName(params->oldFastaOffset+i);            }
             
             
-            for(int j = 0; j < params->db->getNumSeqs(); j++){
+            for(int j = 0; j < params->numNewFasta; j++){
                 
                 if (params->m->getControl_pressed()) { break;  }
                 
                 double dist = 1.0; string nameJ = "";
                 
                 if (params->prot)   { Protein seqJP = params->db->getProt(j); nameJ = seqJP.getName(); dist = distCalculator->calcDist(seqIP, seqJP);   }
-                else                { Sequence seqJ = params->db->getSeq(j);  nameJ = seqJ.getName(); dist = distCalculator->calcDist(seqI, seqJ);       }
+                else                { nameJ = params->packed->getName(j); dist = params->packed->calcDist(params->oldFastaOffset+i, j, params->cutoff);  }
                 
                 if(dist <= params->cutoff){
                     buffer += nameI + " " + nameJ + " " + toString(dist) + "\n";
@@ -664,19 +655,28 @@ void DistanceCommand::createProcesses(string filename) {
             }
         }
         
+        //binary output is calculated like column output, but the threads write their rows to their own files
+        bool columnFormat = ((output == "column") || (output == "binary"));
+        
         auto synchronizedOutputFile = std::make_shared<SynchronizedOutputFile>(filename);
         synchronizedOutputFile->setFixedShowPoint(); synchronizedOutputFile->setPrecision(4);
         
-        StorageDatabase* oldFastaDB;
+        //the aligned sequences were packed as they were read, all threads share the read only copy
+        long long oldFastaOffset = 0;
+        long long numOldFasta = 0;
+        
+        StorageDatabase* oldFastaDB = nullptr;
         if (fitCalc) {
             ifstream inFASTA; util.openInputFile(oldfastafile, inFASTA);
-            if (!prot) { oldFastaDB = new SequenceDB(inFASTA); }
-            else                    { oldFastaDB = new ProteinDB(inFASTA); }
+            if (!prot) { oldFastaOffset = packed->addSeqs(inFASTA); numOldFasta = packed->getNumSeqs() - oldFastaOffset; }
+            else       { oldFastaDB = new ProteinDB(inFASTA); numOldFasta = oldFastaDB->getNumSeqs(); }
             inFASTA.close();
             
+            if (!prot && !packed->sameLength()) { m->mothurOut("[ERROR]: fasta files do not have the same alignment length, aborting.\n"); m->setControl_pressed(true); return; }
+            
             lines.clear();
-            if (processors > oldFastaDB->getNumSeqs()) { processors = oldFastaDB->getNumSeqs(); }
-            int remainingSeqs = oldFastaDB->getNumSeqs();
+            if (processors > numOldFasta) { processors = numOldFasta; }
+            int remainingSeqs = numOldFasta;
             int startIndex = 0;
             for (int remainingProcessors = processors; remainingProcessors > 0; remainingProcessors--) {
                 int numSeqsToFit = remainingSeqs; //case for last processor
@@ -687,21 +687,37 @@ void DistanceCommand::createProcesses(string filename) {
             }
         }
         
+        //with multiple processors the column distances are calculated in tiles sized so two blocks of sequences fit in
+        //the L2 cache, and threads take tiles from a shared queue instead of owning a band of rows. Binary rows are
+        //written whole and in order, so binary output keeps the bands of rows
+        DistanceTileQueue* tiles = nullptr;
+        if ((output == "column") && !fitCalc && !prot && (processors > 1)) {
+            long long cacheSize = 262144; long long minTileSize = 16; long long maxTileSize = 1024;
+            long long blockSize = cacheSize / (2 * max(1, packed->getAlignLength()));
+            blockSize = max(minTileSize, min(maxTileSize, blockSize));
+            tiles = new DistanceTileQueue(numSeqs, numNewFasta, blockSize);
+        }
+        
         //Lauch worker threads
         for (int i = 0; i < processors-1; i++) {
             OutputWriter* threadWriter = nullptr;
             distanceData* dataBundle = nullptr;
             string extension = toString(i+1) + ".temp";
-            if (output == "column") {
+            if (columnFormat) {
                 threadWriter = new OutputWriter(synchronizedOutputFile);
                 dataBundle = new distanceData(threadWriter);
             }else { dataBundle = new distanceData(filename+extension); }
             dataBundle->setVariables(lines[i+1].start, lines[i+1].end, cutoff, db, oldFastaDB, calc, prot, numNewFasta, countends);
+            dataBundle->setPacked(packed, oldFastaOffset);
+            dataBundle->tiles = tiles;
+            dataBundle->binary = (output == "binary");
+            if (dataBundle->binary) { dataBundle->outputFileName = filename+extension; }
             data.push_back(dataBundle);
             
             std::thread* thisThread = nullptr;
-            if (output == "column")     {
+            if (columnFormat)     {
                 if (fitCalc)    { thisThread = new std::thread(driverFitCalc, dataBundle);   }
+                else if (tiles != nullptr) { thisThread = new std::thread(driverColumnTiled, dataBundle);   }
                 else            {  thisThread = new std::thread(driverColumn, dataBundle);   }
             }
             else if (output == "lt")    { thisThread = new std::thread(driverLt, dataBundle);            }
@@ -711,26 +727,38 @@ void DistanceCommand::createProcesses(string filename) {
         
         OutputWriter* threadWriter = nullptr;
         distanceData* dataBundle = nullptr;
-        if (output == "column") {
+        if (columnFormat) {
             threadWriter = new OutputWriter(synchronizedOutputFile);
             dataBundle = new distanceData(threadWriter);
         }else { dataBundle = new distanceData(filename); }
         dataBundle->setVariables(lines[0].start, lines[0].end, cutoff, db, oldFastaDB, calc, prot, numNewFasta, countends);
+        dataBundle->setPacked(packed, oldFastaOffset);
+        dataBundle->tiles = tiles;
+        dataBundle->binary = (output == "binary");
+        if (dataBundle->binary) { dataBundle->outputFileName = filename+"0.temp"; }
         
-        if (output == "column")     {
+        if (columnFormat)     {
             if (fitCalc)    { driverFitCalc(dataBundle);    }
+            else if (tiles != nullptr) { driverColumnTiled(dataBundle); }
             else            { driverColumn(dataBundle);     }
         }
         else if (output == "lt")    { driverLt(dataBundle);            }
         else                        { driverSquare(dataBundle);        }
         distsBelowCutoff = dataBundle->count;
         
+        //the bands of rows are in order, so the rows files are joined in thread order
+        vector<string> rowFiles; rowFiles.push_back(dataBundle->outputFileName);
+        vector<unsigned long long> rowSizes = dataBundle->rowSizes;
         
         for (int i = 0; i < processors-1; i++) {
             workerThreads[i]->join();
             
             distsBelowCutoff += data[i]->count;
-            if (output == "column") {  delete data[i]->threadWriter; }
+            if (data[i]->binary) {
+                rowFiles.push_back(data[i]->outputFileName);
+                rowSizes.insert(rowSizes.end(), data[i]->rowSizes.begin(), data[i]->rowSizes.end());
+            }
+            if (columnFormat) {  delete data[i]->threadWriter; }
             else {
                 string extension = toString(i+1) + ".temp";
                 util.appendFiles((filename+extension), filename);
@@ -739,8 +767,22 @@ void DistanceCommand::createProcesses(string filename) {
             delete data[i];
             delete workerThreads[i];
         }
-        if (output == "column")     { synchronizedOutputFile->close(); delete threadWriter; }
+        if (columnFormat)     { synchronizedOutputFile->close(); delete threadWriter; }
+        
+        if (output == "binary") {
+            if (m->getControl_pressed()) { for (int i = 0; i < rowFiles.size(); i++) { util.mothurRemove(rowFiles[i]); } }
+            else {
+                vector<string> names;
+                for (long long i = 0; i < num; i++) {
+                    if (prot)   { names.push_back(db->getProt(i).getName());   }
+                    else        { names.push_back(packed->getName(i));         }
+                }
+                BinaryDistFile binaryFile; binaryFile.write(filename, names, rowFiles, rowSizes);
+            }
+        }
         delete dataBundle;
+        delete oldFastaDB;
+        delete tiles;
         
         time(&end);
         m->mothurOut("\nIt took " + toString(difftime(end, start)) + " secs to find distances for " + toString(num) + " sequences. " + toString(distsBelowCutoff+numDistsBelowCutoff) + " distances below cutoff " + toString(cutoff) + ".\n\n");
@@ -26,28 +26,89 @@
 #include "pmb.hpp"
 #include "pam.hpp"
 #include "kimura.hpp"
+#include "packeddist.hpp"
+#include "binarydist.h"
 
+#include <atomic>
+
+/**************************************************************************************************/
+//a square block of the lower triangle, rows [rowStart, rowEnd) against columns [colStart, colEnd)
+struct distanceTile {
+    long long rowStart, rowEnd, colStart, colEnd;
+    
+    distanceTile() { rowStart = 0; rowEnd = 0; colStart = 0; colEnd = 0; }
+    distanceTile(long long rs, long long re, long long cs, long long ce) : rowStart(rs), rowEnd(re), colStart(cs), colEnd(ce) {}
+};
+/**************************************************************************************************/
+//splits the lower triangle into tiles of blockSize x blockSize sequences. Threads take the next tile index from a
+//shared counter until all the tiles are taken, so a thread that finishes early picks up the remaining work. The tile
+//bounds are calculated from the index, so no list of tiles is stored.
+class DistanceTileQueue {
+    
+public:
+    DistanceTileQueue(long long numSeqs, long long nnf, long long bs) : next(0), completed(0) {
+        blockSize = bs; numRows = numSeqs; numNewFasta = nnf;
+        numBlocks = (numSeqs + blockSize - 1) / blockSize;
+        
+        //with oldfasta we only need the tiles that include a new sequence, so each row of tiles stops at the new blocks
+        newBlocks = min(numBlocks, (numNewFasta + blockSize - 1) / blockSize);
+        triangleTiles = newBlocks * (newBlocks + 1) / 2;
+        numTiles = triangleTiles + ((numBlocks - newBlocks) * newBlocks);
+    }
+    
+    bool getNext(distanceTile& tile) {
+        long long index = next++;
+        if (index >= numTiles) { return false; }
+        
+        long long row, col;
+        if (index < triangleTiles) { //rows before the old sequences have row+1 tiles
+            row = (long long)((sqrt(8.0 * index + 1.0) - 1.0) / 2.0);
+            while (row * (row + 1) / 2 > index)             { row--; }
+            while ((row + 1) * (row + 2) / 2 <= index)      { row++; }
+            col = index - (row * (row + 1) / 2);
+        }else { //rows of old sequences have newBlocks tiles
+            row = newBlocks + (index - triangleTiles) / newBlocks;
+            col = (index - triangleTiles) % newBlocks;
+        }
+        
+        tile.rowStart = row * blockSize; tile.rowEnd = min(numRows, tile.rowStart + blockSize);
+        tile.colStart = col * blockSize; tile.colEnd = min(tile.rowEnd, tile.colStart + blockSize);
+        return true;
+    }
+    long long finishTile()  { return ++completed; } //returns the number of tiles completed
+    long long getNumTiles() { return numTiles; }
+    
+private:
+    long long blockSize, numRows, numNewFasta, numBlocks, newBlocks, triangleTiles, numTiles;
+    std::atomic<long long> next, completed;
+};
 /**************************************************************************************************/
 struct distanceData {
     long long startLine, endLine, numNewFasta, count;
 	float cutoff;
     StorageDatabase* db;
     StorageDatabase* oldFastaDB;
+    PackedDist* packed;
+    DistanceTileQueue* tiles;
+    vector<unsigned long long> rowSizes; //distances below the cutoff in each row for binary output, the rows go to outputFileName
+    long long oldFastaOffset;
 	MothurOut* m;
 	OutputWriter* threadWriter;
     string outputFileName, calc;
-	bool countends, prot;
+	bool countends, prot, binary;
     Utils util;
 	
 	distanceData(){}
     distanceData(OutputWriter* ofn) {
         threadWriter = ofn;
         m = MothurOut::getInstance();
+        packed = nullptr; tiles = nullptr; oldFastaOffset = 0; binary = false;
     }
     
     distanceData(string ofn) {
         outputFileName = ofn;
         m = MothurOut::getInstance();
+        packed = nullptr; tiles = nullptr; oldFastaOffset = 0; binary = false;
     }
 	void setVariables(int s, int e,  float c, StorageDatabase*& dbsp, StorageDatabase*& oldfn, string Est, bool met, long long num, bool cnt) {
 		startLine = s;
@@ -61,6 +122,7 @@ struct distanceData {
 		countends = cnt;
         count = 0;
 	}
+    void setPacked(PackedDist* p, long long offset) { packed = p; oldFastaOffset = offset; }
 };
 /**************************************************************************************************/
 class DistanceCommand : public Command {
@@ -86,6 +148,7 @@ public:
 private:
 	
     StorageDatabase* db;
+    PackedDist* packed; //dna seqs packed for the distance calculation, db when reading the fasta file
 	string output, fastafile, calc,  oldfastafile, column;
     int processors;
     long long numNewFasta, numSeqs, numDistsBelowCutoff;
@@ -182,6 +182,7 @@ int DistSharedCommand::execute(){
         time_t start = time(nullptr);
         
 		InputData input(sharedfile, "sharedfile", Groups);
+		input.setSparse(true); //the calculators walk the stored bins
 		set<string> processedLabels;
         set<string> userLabels = labels;
         string lastLabel = "";
@@ -274,8 +275,12 @@ void DistSharedCommand::printDists(ostream& out, vector< vector<double> >& simMa
     }
 }
 /**************************************************************************************************/
-int driver(vector<SharedRAbundVector*>& thisLookup, vector< vector<seqDist> >& calcDists, vector<Calculator*> matrixCalculators, MothurOut* m) {
+int driver(vector<SharedRAbundVector*>& thisLookup, vector< vector<seqDist> >& calcDists, vector<Calculator*> matrixCalculators, bool findChao, MothurOut* m) {
     try {
+        //sparse copies of the samples, so the two group calcs can share one pass over each pair
+        PairwiseShared pairwise(thisLookup, findChao);
+        sharedPairStats stats;
+        
         vector<SharedRAbundVector*> subset;
         
         for (int k = 0; k < thisLookup.size(); k++) { // pass cdd each set of groups to compare
@@ -286,6 +291,7 @@ int driver(vector<SharedRAbundVector*>& thisLookup, vector< vector<seqDist> >& c
                     subset.clear(); //clear out old pair of sharedrabunds
                     //add new pair of sharedrabunds
                     subset.push_back(thisLookup[k]); subset.push_back(thisLookup[l]);
+                    bool hasStats = pairwise.getPairStats(k, l, stats);
                     
                     for(int i=0;i<matrixCalculators.size();i++) {
                         
@@ -297,7 +303,9 @@ int driver(vector<SharedRAbundVector*>& thisLookup, vector< vector<seqDist> >& c
                             }
                         }
                         
-                        vector<double> tempdata = matrixCalculators[i]->getValues(subset); //saves the calculator outputs
+                        vector<double> tempdata;
+                        if (hasStats && (subset.size() == 2) && matrixCalculators[i]->hasPairStats()) { tempdata = matrixCalculators[i]->getValues(stats); }
+                        else { tempdata = matrixCalculators[i]->getValues(subset); } //saves the calculator outputs
                         
                         if (m->getControl_pressed()) { return 1; }
                         
@@ -415,6 +423,7 @@ int process(distSharedData* params){
         for (int i=0; i<matrixCalculators.size(); i++) { params->Estimators.push_back(matrixCalculators[i]->getName()); }
         
         vector< vector<seqDist>  > calcDists; calcDists.resize(matrixCalculators.size()); 		
+        bool findChao = PairwiseShared::needsChao(params->Estimators);
         SubSample sample;
         for (int thisIter = 0; thisIter < params->numIters; thisIter++) {
             SharedRAbundVectors* thisItersLookup = new SharedRAbundVectors(*params->thisLookup);
@@ -434,7 +443,7 @@ int process(distSharedData* params){
             vector<string> thisItersGroupNames = params->thisLookup->getNamesGroups();
             
             start = time(nullptr);
-            driver(thisItersRabunds, calcDists, matrixCalculators, params->m);
+            driver(thisItersRabunds, calcDists, matrixCalculators, findChao, params->m);
             if (params->m->getDebug()) { params->m->mothurOut("\nIt took " + toString(time(nullptr) - start) + " seconds to calc dist for shared file.\n");  }
             
             //params->m->mothurOut(toString(thisIter) + " It took " + toString(time(nullptr) - start) + " seconds to calc dist for shared file.\n");
@@ -55,6 +55,7 @@
 #include "mempearson.h"
 #include "sharedjsd.h"
 #include "sharedrjsd.h"
+#include "pairwiseshared.hpp"
 
 
 
@@ -304,6 +304,80 @@ int FilterSeqsCommand::filterSequences() {
 	}
 }
 /**************************************************************************************/
+//the characters Sequence keeps in an aligned sequence, it makes everything but gaps and ACGTN an N
+struct filterSeqChars {
+	char mapped[256];
+	bool ambig[256];
+	bool gap[256];
+	
+	filterSeqChars() {
+		for (int i = 0; i < 256; i++) {
+			char c = ::toupper((char)i);
+			ambig[i] = ((c != '.') && (c != '-') && (c != 'A') && (c != 'T') && (c != 'G') && (c != 'C') && (c != 'N'));
+			mapped[i] = ambig[i] ? 'N' : c;
+			gap[i] = ((mapped[i] == '.') || (mapped[i] == '-'));
+		}
+	}
+};
+/**************************************************************************************/
+//reads the next sequence into name and aligned the same way Sequence(ifstream&) would, without making the unaligned copies
+//Sequence's extra passes were most of the time filter.seqs spent on wide alignments. Returns false if the name is blank.
+static bool readFilterSeq(ifstream& in, string& name, string& aligned, Utils& util, MothurOut* m) {
+	static const filterSeqChars seqChars;
+	
+	name = ""; aligned = "";
+	in >> name;
+	if (name.length() == 0) {
+		if (!in.eof()) { m->mothurOut("Error in reading your fastafile, at position " + toString(in.tellg()) + ". Blank name.\n");  m->setControl_pressed(true);  }
+		return false;
+	}
+	
+	//commented out sequences are left to Sequence
+	if ((name.length() > 1) && (name[1] == '#')) {
+		in.seekg(-(long long)name.length(), ios::cur);
+		Sequence seq(in);
+		name = seq.getName(); aligned = seq.getAligned();
+		return (name != "");
+	}
+	
+	name = name.substr(1);
+	util.checkName(name);
+	if (m->getControl_pressed()) { return true; }
+	
+	//rest of the name line
+	while (in) {
+		char letter = in.get();
+		if ((letter == '\r') || (letter == '\n') || (letter == -1)) { gobble(in); break; }
+	}
+	
+	int numAmbig = 0, numGaps = 0;
+	while ((in.peek() != '>') && (in.peek() != EOF)) {
+		if (m->getControl_pressed()) { break; }
+		
+		string line = util.getline(in);
+		
+		int start = aligned.length();
+		aligned.resize(start + line.length());
+		for (int i = 0; i < line.length(); i++) {
+			unsigned char c = line[i];
+			aligned[start+i] = seqChars.mapped[c];
+			numAmbig += seqChars.ambig[c];
+			numGaps += seqChars.gap[c];
+		}
+	}
+	
+	//if the alignment starts with a gap, the end gaps are periods
+	if ((aligned.length() != 0) && (aligned[0] == '-')) {
+		for (int i = 0; (i < aligned.length()) && (aligned[i] == '-'); i++)		{ aligned[i] = '.'; }
+		for (int i = aligned.length()-1; (i >= 0) && (aligned[i] == '-'); i--)	{ aligned[i] = '.'; }
+	}
+	
+	int numBases = aligned.length() - numGaps;
+	if ((numAmbig / (float) numBases) > 0.25) { m->mothurOut("[WARNING]: We found more than 25% of the bases in sequence " + name + " to be ambiguous. Mothur is not setup to process protein sequences.\n");  }
+	
+	return true;
+}
+/**************************************************************************************/
 void driverRunFilter(filterRunData* params) {
 	try {
         ifstream in; params->util.openInputFile(params->filename, in);
@@ -316,20 +390,29 @@ void driverRunFilter(filterRunData* params) {
 		bool done = false;
 		params->count = 0;
         
+        //the columns to keep, copied straight from each sequence to the output
+        vector<int> keptColumns;
+        for(int j=0;j<params->alignmentLength;j++){ if(params->filter[j] == '1'){ keptColumns.push_back(j); } }
+        
         string outBuffer = "";
+        string name, align;
 	
 		while (!done) {
 				
 				if (params->m->getControl_pressed()) { break; }
 				
-				Sequence seq(in); gobble(in);
-				if (seq.getName() != "") {
-					string align = seq.getAligned();
-					string filterSeq = "";
-                
-					for(int j=0;j<params->alignmentLength;j++){ if(params->filter[j] == '1'){ filterSeq += align[j]; } }
+				bool hasName = readFilterSeq(in, name, align, params->util, params->m); gobble(in);
+				if (hasName) {
+					outBuffer += '>' + name + '\n';
 					
-					outBuffer += '>' + seq.getName() + '\n' + filterSeq + '\n';
+					int length = 0;
+					while ((length < keptColumns.size()) && (keptColumns[length] < align.length())) { length++; }
+					
+					int start = outBuffer.length();
+					outBuffer.resize(start + length + 1);
+					char* filterSeq = &outBuffer[start];
+					for (int j = 0; j < length; j++) { filterSeq[j] = align[keptColumns[j]]; }
+					filterSeq[length] = '\n';
                 }
 				params->count++;
         
@@ -469,18 +552,19 @@ void driverCreateFilter(filterData* params) {
 		bool done = false;
 		params->count = 0;
         bool error = false;
+        string name, align;
         
 		while (!done) {
 				
             if (params->m->getControl_pressed()) { break; }
 					
-			Sequence seq(in); gobble(in);
-			if (seq.getName() != "") {
-                    if (params->m->getDebug()) { params->m->mothurOutJustToScreen("[DEBUG]: " + seq.getName() + " length = " + toString(seq.getAligned().length()) + '\n'); }
-                if (seq.getAligned().length() != params->alignmentLength) { params->m->mothurOut("[ERROR]: Sequences are not all the same length, please correct.\n"); error = true; if (!params->m->getDebug()) { params->m->setControl_pressed(true); }else{ params->m->mothurOutJustToLog("[DEBUG]: " + seq.getName() + " length = " + toString(seq.getAligned().length()) + '\n'); } }
+			bool hasName = readFilterSeq(in, name, align, params->util, params->m); gobble(in);
+			if (hasName) {
+                    if (params->m->getDebug()) { params->m->mothurOutJustToScreen("[DEBUG]: " + name + " length = " + toString(align.length()) + '\n'); }
+                if (align.length() != params->alignmentLength) { params->m->mothurOut("[ERROR]: Sequences are not all the same length, please correct.\n"); error = true; if (!params->m->getDebug()) { params->m->setControl_pressed(true); }else{ params->m->mothurOutJustToLog("[DEBUG]: " + name + " length = " + toString(align.length()) + '\n'); } }
 					
-					if(params->trump != '*')                    {	params->F.doTrump(seq);		}
-					if(params->vertical || !params->util.isEqual(params->soft, 0))	{	params->F.getFreqs(seq);	}
+					if(params->trump != '*')                    {	params->F.doTrump(align);		}
+					if(params->vertical || !params->util.isEqual(params->soft, 0))	{	params->F.getFreqs(align);	}
 					cout.flush();
 					params->count++;
             }
@@ -556,12 +640,7 @@ long long FilterSeqsCommand::createProcessesCreateFilter(Filters& F, string file
         
         num = dataBundle->count;
         F.mergeFilter(dataBundle->F.getFilter());
-        
-        for (int k = 0; k < alignmentLength; k++) {	 F.a[k] += dataBundle->F.a[k];       }
-        for (int k = 0; k < alignmentLength; k++) {	 F.t[k] += dataBundle->F.t[k];       }
-        for (int k = 0; k < alignmentLength; k++) {	 F.g[k] += dataBundle->F.g[k];       }
-        for (int k = 0; k < alignmentLength; k++) {	 F.c[k] += dataBundle->F.c[k];       }
-        for (int k = 0; k < alignmentLength; k++) {	 F.gap[k] += dataBundle->F.gap[k];   }
+        F.mergeFreqs(dataBundle->F);
 
         delete dataBundle;
         
@@ -570,12 +649,7 @@ long long FilterSeqsCommand::createProcessesCreateFilter(Filters& F, string file
             
             num += data[i]->count;
             F.mergeFilter(data[i]->F.getFilter());
-            
-            for (int k = 0; k < alignmentLength; k++) {	 F.a[k] += data[i]->F.a[k];       }
-            for (int k = 0; k < alignmentLength; k++) {	 F.t[k] += data[i]->F.t[k];       }
-            for (int k = 0; k < alignmentLength; k++) {	 F.g[k] += data[i]->F.g[k];       }
-            for (int k = 0; k < alignmentLength; k++) {	 F.c[k] += data[i]->F.c[k];       }
-            for (int k = 0; k < alignmentLength; k++) {	 F.gap[k] += data[i]->F.gap[k];   }
+            F.mergeFreqs(data[i]->F);
             
             delete data[i];
             delete workerThreads[i];
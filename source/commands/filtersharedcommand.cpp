@@ -202,6 +202,7 @@ int FilterSharedCommand::execute(){
 		if (abort) { if (calledHelp) { return 0; }  return 2;	}
 		
         InputData input(sharedfile, "sharedfile", Groups);
+        input.setSparse(true); //only walks the stored bins
 		set<string> processedLabels;
         set<string> userLabels = labels;
         string lastLabel = "";
@@ -252,6 +253,10 @@ int FilterSharedCommand::processShared(SharedRAbundVectors*& sharedLookup) {
         int numGroups = Groups.size();
         float defaultSetting = -0.01;
         
+        //the samples' nonzero abunds by otu, otuStarts[i] to otuStarts[i+1] are otu i's. zeros are the samples not listed
+        vector<long long> otuStarts; vector<int> otuGroups, otuAbunds;
+        sharedLookup->getColumns(otuStarts, otuGroups, otuAbunds);
+        
         //you want to remove a percentage of OTUs
         set<string> removeLabels;
         if (!util.isEqual(rarePercent, defaultSetting)) {
@@ -259,7 +264,7 @@ int FilterSharedCommand::processShared(SharedRAbundVectors*& sharedLookup) {
             //rank otus by abundance
             for (int i = 0; i < sharedLookup->getNumBins(); i++) {
                 float otuTotal = 0.0;
-                for (int j = 0; j < numGroups; j++) { otuTotal += sharedLookup->get(i, Groups[j]); }
+                for (long long j = otuStarts[i]; j < otuStarts[i+1]; j++) { otuTotal += otuAbunds[j]; }
                 spearmanRank temp(sharedLookup->getOTUName(i), otuTotal);
                 otus.push_back(temp);
             }
@@ -289,6 +294,9 @@ int FilterSharedCommand::processShared(SharedRAbundVectors*& sharedLookup) {
             for (int i = 0; i < indexFirstNotRare; i++) { removeLabels.insert(otus[i].name); }
         }
         
+        double totalSeqs = 0;
+        for (int j = 0; j < numGroups; j++) { totalSeqs += sharedLookup->getNumSeqs(Groups[j]); }
+        
         bool filteredSomething = false;
         int numRemoved = 0;
         vector<int> binsToRemove;
@@ -296,49 +304,42 @@ int FilterSharedCommand::processShared(SharedRAbundVectors*& sharedLookup) {
             
             if (m->getControl_pressed()) { return 0; }
             
-            vector<int> abunds = sharedLookup->getOTU(i);
+            int numNonZero = otuStarts[i+1] - otuStarts[i];
             
             bool okay = true; //innocent until proven guilty
             if (minAbund != -1) {
-                for (int j = 0; j < numGroups; j++) {
-                    if (abunds[j] < minAbund) { okay = false; break; }
+                if ((numNonZero < numGroups) && (0 < minAbund)) { okay = false; }
+                for (long long j = otuStarts[i]; j < otuStarts[i+1]; j++) {
+                    if (otuAbunds[j] < minAbund) { okay = false; break; }
                 }
             }
             
             if (okay && (minTotal != -1)) {
                 int otuTotal = 0;
-                for (int j = 0; j < numGroups; j++) {
-                    otuTotal += abunds[j];
+                for (long long j = otuStarts[i]; j < otuStarts[i+1]; j++) {
+                    otuTotal += otuAbunds[j];
                 }
                 if (otuTotal < minTotal) { okay = false; }
             }
             
             if (okay && (!util.isEqual(minPercent, defaultSetting))) {
                 double otuTotal = 0;
-                double total = 0;
-                for (int j = 0; j < numGroups; j++) {
-                    otuTotal += abunds[j];
-                    total += sharedLookup->getNumSeqs(Groups[j]);
+                for (long long j = otuStarts[i]; j < otuStarts[i+1]; j++) {
+                    otuTotal += otuAbunds[j];
                 }
-                double percent = otuTotal / total; 
+                double percent = otuTotal / totalSeqs; 
                 if (percent < minPercent) { okay = false; }
             }
             
             
             if (okay && (minSamples != -1)) {
-                int samples = 0;
-                for (int j = 0; j < numGroups; j++) {
-                    if (abunds[j] != 0) { samples++; }
-                }
+                int samples = numNonZero;
                 if (samples < minSamples) { okay = false; }
             }
             
             if (okay && (!util.isEqual(minPercentSamples, defaultSetting))) {
-                double samples = 0;
+                double samples = numNonZero;
                 double total = numGroups;
-                for (int j = 0; j < numGroups; j++) {
-                    if (abunds[j] != 0) { samples++; }
-                }
                 double percent = samples / total; 
                 if (percent < minPercentSamples) { okay = false; }
             }
@@ -354,8 +355,8 @@ int FilterSharedCommand::processShared(SharedRAbundVectors*& sharedLookup) {
                 
                 filteredSomething = true;
                 if (makeRare) {
-                    for (int j = 0; j < numGroups; j++) {
-                        rareCounts[j] += abunds[j];
+                    for (long long j = otuStarts[i]; j < otuStarts[i+1]; j++) {
+                        rareCounts[otuGroups[j]] += otuAbunds[j];
                     }
                 }
                 if (m->getDebug()) { m->mothurOut("[DEBUG]: removing OTU " + sharedLookup->getOTUName(i) + "\n"); }
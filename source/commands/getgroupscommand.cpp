@@ -298,8 +298,8 @@ int GetGroupsCommand::execute(){
             
             m->mothurOut("Selected " + toString(selectedCount) + " sequences from your count file.\n");
 
-            vector<string> thisGroupsSeqs = ct.getNamesOfSeqs();
-            for (int j = 0; j < thisGroupsSeqs.size(); j++) { names.insert(thisGroupsSeqs[j]); }
+            vector<countTableSeq> thisGroupsSeqs = ct.getSeqs();
+            for (int j = 0; j < thisGroupsSeqs.size(); j++) { names.insert(thisGroupsSeqs[j].getName()); }
         }
 		
 		if (m->getControl_pressed()) { return 0; }
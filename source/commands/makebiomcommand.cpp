@@ -288,6 +288,7 @@ int MakeBiomCommand::execute(){
         SharedRAbundVectors* lookup = nullptr; SharedRAbundFloatVectors* lookupRel = nullptr;
         
 		InputData input(inputFileName, fileFormat, Groups);
+		input.setSparse(true); //only walks the stored bins
         set<string> processedLabels;
         set<string> userLabels = labels;
         string lastLabel = "";
@@ -113,6 +113,7 @@ vector<string> MakeContigsCommand::setParameters(){
         CommandParameter pdeltaq("deltaq", "Number", "", "6", "", "", "","",false,false); parameters.push_back(pdeltaq);
         CommandParameter maxee("maxee", "Number", "", "10000", "", "", "","",false,false); parameters.push_back(maxee);
 				CommandParameter pprocessors("processors", "Number", "", "1", "", "", "","",false,false,true); parameters.push_back(pprocessors);
+        CommandParameter pkeeporder("keeporder", "Boolean", "", "F", "", "", "","",false,false); parameters.push_back(pkeeporder);
         CommandParameter pformat("format", "Multiple", "sanger-illumina-solexa-illumina1.8+", "illumina1.8+", "", "", "","",false,false,true); parameters.push_back(pformat);
         CommandParameter pksize("ksize", "Number", "", "8", "", "", "","",false,false); parameters.push_back(pksize);
         CommandParameter pmaxambig("maxambig", "Number", "", "-1", "", "", "","",false,false); parameters.push_back(pmaxambig);
@@ -171,7 +172,7 @@ string MakeContigsCommand::getHelpString(){
 		helpString += "The gapopen parameter allows you to specify the penalty for opening a gap in an alignment. The default is -2.0.\n";
 		helpString += "The gapextend parameter allows you to specify the penalty for extending a gap in an alignment.  The default is -1.0.\n";
         helpString += "The insert parameter allows you to set a quality scores threshold. In the case where we are trying to decide whether to keep a base or remove it because the base is compared to a gap in the other fragment, if the base has a quality score equal to or below the threshold we eliminate it. Default=20.\n";
-        helpString += "The processors parameter allows you to specify how many processors you would like to use.  The default is all available.\n";
+        helpString += "The keeporder parameter keeps the sequences in the output files in the order of the input when processors is greater than 1. The threads that finish early hold their output until the threads before them are done. The default is F. Compressed files assembled on more than one processor are always written in the order they are read.\n";
         helpString += "The allfiles parameter will create separate group and fasta file for each grouping. The default is F.\n";
 
         helpString += "The trimoverlap parameter allows you to trim the sequences to only the overlapping section. The default is F.\n";
@@ -317,6 +318,9 @@ MakeContigsCommand::MakeContigsCommand(string option) : Command()  {
 
 			temp = validParameter.valid(parameters, "processors");	if (temp == "not found"){	temp = current->getProcessors();	}
 			processors = current->setProcessors(temp);
+            
+            temp = validParameter.valid(parameters, "keeporder");	if (temp == "not found"){	temp = "f";	}
+            keepOrder = util.isTrue(temp);
 
             temp = validParameter.valid(parameters, "bdiffs");		if (temp == "not found") { temp = "0"; }
 			util.mothurConvert(temp, bdiffs);
@@ -689,6 +693,61 @@ unsigned long long MakeContigsCommand::processSingleFileOption(string& outFastaF
     }
 }
 /**************************************************************************************************/
+//a read pair waiting to be assembled
+struct contigsReadPair {
+    Sequence fSeq, rSeq;
+    QualityScores* fQual;
+    QualityScores* rQual;
+    Sequence findexBarcode, rindexBarcode;
+
+    contigsReadPair(Sequence f, Sequence r, QualityScores* fq, QualityScores* rq, Sequence fi, Sequence ri) : fSeq(f), rSeq(r), fQual(fq), rQual(rq), findexBarcode(fi), rindexBarcode(ri) {}
+};
+/**************************************************************************************************/
+#define contigsBatchSize 1000
+
+//batches of read pairs passed from the thread reading compressed files to the threads assembling them.
+//push blocks while the queue is full so the reader can't get too far ahead of the assemblers.
+//the batches are numbered in the order they are read, so their output can be written in that order.
+class contigsPairQueue {
+
+public:
+    contigsPairQueue(int mb) : maxBatches(mb), numBatches(0), done(false) {}
+    ~contigsPairQueue() = default;
+
+    void push(vector<contigsReadPair>* batch) {
+        std::unique_lock<std::mutex> lock(queueMutex);
+        notFull.wait(lock, [this]{ return (batches.size() < maxBatches); });
+        batches.push_back(make_pair(numBatches, batch));
+        numBatches++;
+        notEmpty.notify_one();
+    }
+
+    //returns nullptr once the reader is finished and the queue is empty
+    vector<contigsReadPair>* pop(long long& batchNumber) {
+        std::unique_lock<std::mutex> lock(queueMutex);
+        notEmpty.wait(lock, [this]{ return (!batches.empty() || done); });
+        if (batches.empty()) { return nullptr; }
+        batchNumber = batches.front().first;
+        vector<contigsReadPair>* batch = batches.front().second; batches.pop_front();
+        notFull.notify_one();
+        return batch;
+    }
+
+    void finish() {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        done = true;
+        notEmpty.notify_all();
+    }
+
+private:
+    std::mutex queueMutex;
+    std::condition_variable notEmpty, notFull;
+    deque< pair<long long, vector<contigsReadPair>*> > batches;
+    size_t maxBatches;
+    long long numBatches;
+    bool done;
+};
+/**************************************************************************************************/
 struct contigsData {
     MothurOut* m;
     Utils util;
@@ -709,6 +768,8 @@ struct contigsData {
     linePair qlinesInput;
     linePair qlinesInputReverse;
     long long count;
+    contigsPairQueue* pairQueue; //set when the compressed files are read by one thread and assembled by others
+    std::shared_ptr<SynchronizedOutputFile> trimFile, scrapFile, trimQFile, scrapQFile, misMatchFile; //the files the batches' writers share
 
     vector<string> primerNameVector;
     vector<string> barcodeNameVector;
@@ -718,7 +779,7 @@ struct contigsData {
     map<int, oligosPair> pairedPrimers, reorientedPairedPrimers, reversedPairedPrimers;
 
 
-    contigsData(){}
+    contigsData(){ pairQueue = nullptr; }
     ~contigsData(){}
     contigsData(OutputWriter* tn, OutputWriter* sn, OutputWriter* tqn, OutputWriter* sqn, OutputWriter* mmf) {
         trimFileName = tn;
@@ -728,6 +789,7 @@ struct contigsData {
         misMatchesFile = mmf;
         m = MothurOut::getInstance();
         count = 0;
+        pairQueue = nullptr;
         makeQualFile = true;
         if (trimQFileName == nullptr) { makeQualFile = false; }
     }
@@ -746,6 +808,7 @@ struct contigsData {
         qlinesInput = qli;
         qlinesInputReverse = qlir;
         count = 0;
+        pairQueue = nullptr;
         makeQualFile = true;
         if (trimQFileName == nullptr) { makeQualFile = false; }
     }
@@ -785,6 +848,28 @@ struct contigsData {
         maxLength = maxL;
         maxAmbig = maxAm;
     }
+    //the assembling threads write each batch of read pairs after the batches read before it, so the files match processors=1
+    void setBatchFiles(std::shared_ptr<SynchronizedOutputFile> tf, std::shared_ptr<SynchronizedOutputFile> sf, std::shared_ptr<SynchronizedOutputFile> tqf, std::shared_ptr<SynchronizedOutputFile> sqf, std::shared_ptr<SynchronizedOutputFile> mmf) {
+        trimFile = tf; scrapFile = sf; trimQFile = tqf; scrapQFile = sqf; misMatchFile = mmf;
+    }
+    void openBatchWriters(long long batchNumber) {
+        trimFileName = new OutputWriter(trimFile, batchNumber);
+        scrapFileName = new OutputWriter(scrapFile, batchNumber);
+        misMatchesFile = new OutputWriter(misMatchFile, batchNumber);
+        if (makeQualFile) {
+            trimQFileName = new OutputWriter(trimQFile, batchNumber);
+            scrapQFileName = new OutputWriter(scrapQFile, batchNumber);
+        }
+    }
+    void closeBatchWriters() {
+        delete trimFileName; trimFileName = nullptr;
+        delete scrapFileName; scrapFileName = nullptr;
+        delete misMatchesFile; misMatchesFile = nullptr;
+        if (makeQualFile) {
+            delete trimQFileName; trimQFileName = nullptr;
+            delete scrapQFileName; scrapQFileName = nullptr;
+        }
+    }
     void copyVariables(contigsData* copy) {
         gz = copy->gz;
         delim = copy->delim;
@@ -1691,19 +1776,165 @@ vector<int> trimBarCodesAndPrimers(Sequence& fSeq, Sequence& rSeq, QualityScores
     }
 }
 //**********************************************************************************************************************
-//vector<vector<string> > fastaFileNames, vector<vector<string> > qualFileNames, , string group
-void driverContigs(contigsData* params){
-    try {
-        vector< vector<double> > qual_match_simple_bayesian;
+//**********************************************************************************************************************
+//the scoring tables, oligos and aligner a thread needs to assemble read pairs
+struct contigsAssembler {
+    vector< vector<double> > qual_match_simple_bayesian;
+    vector< vector<double> > qual_mismatch_simple_bayesian;
+    vector<TrimOligos*> trims;
+    Alignment* alignment;
+    bool hasQuality, hasIndex;
+    int numPrimers, numBarcodes;
+
+    contigsAssembler(contigsData* params) {
         qual_match_simple_bayesian.resize(47);
         for (int i = 0; i < qual_match_simple_bayesian.size(); i++) { qual_match_simple_bayesian[i].resize(47);  }
 
-        vector< vector<double> > qual_mismatch_simple_bayesian;
         qual_mismatch_simple_bayesian.resize(47);
         for (int i = 0; i < qual_mismatch_simple_bayesian.size(); i++) { qual_mismatch_simple_bayesian[i].resize(47);  }
 
         loadQmatchValues(qual_match_simple_bayesian, qual_mismatch_simple_bayesian);
 
+        hasQuality = false;
+        hasIndex = false;
+        if (params->delim == '@') { //fastq files so make an output quality
+            hasQuality = true;
+            for (int i = 0; i < params->qualOrIndexFiles.size(); i++) {
+                if ((params->qualOrIndexFiles[i] != "") && (params->qualOrIndexFiles[i] != "NONE")) {  hasIndex = true; }
+            }
+        }else if ((params->delim == '>') && (params->qualOrIndexFiles.size() != 0)) { hasQuality = true; }
+
+        numPrimers = params->pairedPrimers.size();
+        numBarcodes = params->pairedBarcodes.size();
+
+        if ((numPrimers != 0) || (numBarcodes != 0)) {
+            //standard
+            trims.push_back(new TrimOligos(params->pdiffs, params->bdiffs, 0, 0, params->pairedPrimers, params->pairedBarcodes, hasIndex));
+
+            if (params->reorient) {
+                //reoriented
+                trims.push_back(new TrimOligos(params->pdiffs, params->bdiffs, 0, 0, params->reorientedPairedPrimers, params->reorientedPairedBarcodes, hasIndex));
+                //reversed
+                trims.push_back(new TrimOligos(params->pdiffs, params->bdiffs, 0, 0, params->reversedPairedPrimers, params->reversedPairedBarcodes, hasIndex));
+            }
+        }
+        alignment = nullptr; int longestBase = 1000;
+        if(params->align == "gotoh")			{	alignment = new GotohOverlap(params->gapOpen, params->gapExtend, params->match, params->misMatch, longestBase);			}
+        else if(params->align == "needleman")	{	alignment = new NeedlemanOverlap(params->gapOpen, params->match, params->misMatch, longestBase);                        }
+        else if(params->align == "kmer")        {   alignment = new KmerAlign(params->kmerSize);                                                                            }
+    }
+    ~contigsAssembler() {
+        for (int i = 0; i < trims.size(); i++) {  delete trims[i]; }
+        delete alignment;
+    }
+};
+//**********************************************************************************************************************
+//trims, assembles, screens and writes one read pair. Deletes the quality scores.
+void assembleContigsPair(contigsData* params, contigsAssembler& assembler, Sequence& fSeq, Sequence& rSeq, QualityScores* fQual, QualityScores* rQual, Sequence& findexBarcode, Sequence& rindexBarcode) {
+    try {
+        bool ignore = false;
+
+        //remove primers and barcodes if neccessary
+        vector<string> codes;
+        vector<int> oligosResults = trimBarCodesAndPrimers(fSeq, rSeq, fQual, rQual, findexBarcode, rindexBarcode, assembler.trims, codes, assembler.numBarcodes, assembler.numPrimers, assembler.hasQuality, assembler.hasIndex, params->pdiffs, params->bdiffs, params->tdiffs, params->m);
+        
+        string trashCode = codes[0];
+        string commentString = codes[1];
+        int barcodeIndex = oligosResults[0];
+        int primerIndex = oligosResults[1];
+        
+        //assemble reads
+        string contig = "";
+        int oend, oStart;
+        int numMismatches = 0;
+        vector<int> scores1, scores2;
+        if(assembler.hasQuality){
+            scores1 = fQual->getScores(); scores2 = rQual->getScores();
+            delete rQual;
+        }
+        vector<int> contigScores = assembleFragments(assembler.qual_match_simple_bayesian, assembler.qual_mismatch_simple_bayesian, fSeq, rSeq, scores1, scores2, assembler.hasQuality, assembler.alignment, contig, trashCode, oend, oStart, numMismatches, params->insert, params->deltaq, params->trimOverlap);
+
+        //Note that usearch/vsearch cap the maximum Q value at 41 - perhaps due to ascii
+        //limits? we leave this value unbounded. if two sequences have a 40 then the
+        //assembled quality score will be 85. If two 250 nt reads are all 40 and they
+        //perfectly match each other, then the difference in the number of expected errors
+        //between using 85 and 41 all the way across will be 0.01986 - this is a "worst"
+        //case scenario
+        double expected_errors = 0;
+        if(assembler.hasQuality){
+            fQual->setScores(contigScores);
+            expected_errors = fQual->calculateExpectedErrors();
+            delete fQual;
+        }
+
+        if(expected_errors > params->maxee) { trashCode += 'e' ;}
+        
+        if (params->screenSequences) { screenSequence(contig, trashCode, params); }
+
+        if(trashCode.length() == 0){
+            string thisGroup = params->group; //group from file file
+            if (params->createGroupFromOligos) { //overwrite file file group for oligos group
+                if(assembler.numBarcodes != 0){
+                    thisGroup = params->barcodeNameVector[barcodeIndex];
+                    if (assembler.numPrimers != 0) {
+                        if (params->primerNameVector[primerIndex] != "") {
+                            if(thisGroup != "") { thisGroup += "." + params->primerNameVector[primerIndex]; }
+                            else                { thisGroup = params->primerNameVector[primerIndex];        }
+                        }
+                    }
+                }
+            }
+
+            int pos = thisGroup.find("ignore");
+            if (pos == string::npos) {
+                if (thisGroup != "") {
+                    params->groupMap[fSeq.getName()] = thisGroup;
+
+                    map<string, int>::iterator it = params->groupCounts.find(thisGroup);
+                    if (it == params->groupCounts.end()) {	params->groupCounts[thisGroup] = 1; }
+                    else { params->groupCounts[it->first] ++; }
+                }
+            }else { ignore = true; }
+
+            //print good stuff
+            if(!ignore){
+                //output
+                string output = ">" + fSeq.getName() + '\t' + "ee=" + toString(expected_errors) + '\t' + commentString + "\n" + contig + "\n";
+                params->trimFileName->write(output);
+                if (assembler.hasQuality && params->makeQualFile) {
+                    output = ">" + fSeq.getName() + '\t' + "ee=" + toString(expected_errors) + '\t' + commentString +"\n";
+                    for (int i = 0; i < contigScores.size(); i++) { output += toString(contigScores[i]) + " "; }  output += "\n";
+                    params->trimQFileName->write(output);
+                }
+                int numNs = 0;
+                for (int i = 0; i < contig.length(); i++) { if (contig[i] == 'N') { numNs++; }  }
+                output = fSeq.getName() + '\t' + toString(contig.length()) + '\t' + toString(oend-oStart) + '\t' + toString(oStart) + '\t' + toString(oend) + '\t' + toString(numMismatches) + '\t' + toString(numNs) + '\t' + toString(expected_errors) + "\n";
+                params->misMatchesFile->write(output);
+            }
+        }else{
+            params->badNames.insert(fSeq.getName());
+
+            string output = ">" + fSeq.getName() + " | " + trashCode + '\t' + "ee=" +  toString(expected_errors) + '\t' + commentString + "\n" + contig + "\n";
+            params->scrapFileName->write(output);
+
+            if (assembler.hasQuality && params->makeQualFile) {
+                output = ">" + fSeq.getName() + " | " + trashCode + '\t' + "ee=" + toString(expected_errors) + '\t' + commentString + "\n";
+                for (int i = 0; i < contigScores.size(); i++) { output += toString(contigScores[i]) + " "; }  output += "\n";
+                params->scrapQFileName->write(output);
+            }
+        }
+        if (params->m->getDebug()) { params->m->mothurOut("\n"); }
+    }
+    catch(exception& e) {
+        params->m->errorOut(e, "MakeContigsCommand", "assembleContigsPair");
+        exit(1);
+    }
+}
+//vector<vector<string> > fastaFileNames, vector<vector<string> > qualFileNames, , string group
+void driverContigs(contigsData* params){
+    try {
+        contigsAssembler assembler(params);
+
         params->count = 0;
         string thisfqualindexfile, thisrqualindexfile, thisffastafile, thisrfastafile;
         thisfqualindexfile = ""; thisrqualindexfile = "";
@@ -1758,35 +1989,10 @@ void driverContigs(contigsData* params){
             else { thisrqualindexfile = ""; }
         }
 
-        bool hasQuality = false;
-        bool hasIndex = false;
-        if (params->delim == '@') { //fastq files so make an output quality
-            hasQuality = true;
-            if (thisfqualindexfile != "")           { if (thisfqualindexfile != "NONE") {  hasIndex = true; } }
-            if (thisrqualindexfile != "")           { if (thisrqualindexfile != "NONE") {  hasIndex = true; } }
-        }else if ((params->delim == '>') && (params->qualOrIndexFiles.size() != 0)) { hasQuality = true; }
+        if (params->m->getDebug()) { if (assembler.hasQuality) { params->m->mothurOut("[DEBUG]: hasQuality = true\n");  } else { params->m->mothurOut("[DEBUG]: hasQuality = false\n"); } }
 
-        if (params->m->getDebug()) { if (hasQuality) { params->m->mothurOut("[DEBUG]: hasQuality = true\n");  } else { params->m->mothurOut("[DEBUG]: hasQuality = false\n"); } }
-
-        int numPrimers = params->pairedPrimers.size();
-        int numBarcodes = params->pairedBarcodes.size();
-        
-        vector<TrimOligos*> trims;
-        if ((numPrimers != 0) || (numBarcodes != 0)) {
-            //standard
-            trims.push_back(new TrimOligos(params->pdiffs, params->bdiffs, 0, 0, params->pairedPrimers, params->pairedBarcodes, hasIndex));
-    
-            if (params->reorient) {
-                //reoriented
-                trims.push_back(new TrimOligos(params->pdiffs, params->bdiffs, 0, 0, params->reorientedPairedPrimers, params->reorientedPairedBarcodes, hasIndex));
-                //reversed
-                trims.push_back(new TrimOligos(params->pdiffs, params->bdiffs, 0, 0, params->reversedPairedPrimers, params->reversedPairedBarcodes, hasIndex));
-            }
-        }
-        Alignment* alignment; int longestBase = 1000;
-        if(params->align == "gotoh")			{	alignment = new GotohOverlap(params->gapOpen, params->gapExtend, params->match, params->misMatch, longestBase);			}
-        else if(params->align == "needleman")	{	alignment = new NeedlemanOverlap(params->gapOpen, params->match, params->misMatch, longestBase);                        }
-        else if(params->align == "kmer")        {   alignment = new KmerAlign(params->kmerSize);                                                                            }
+        vector<contigsReadPair>* batch = nullptr;
+        if (params->pairQueue != nullptr) { batch = new vector<contigsReadPair>(); batch->reserve(contigsBatchSize); }
 
         bool good = true;
         while (good) {
@@ -1808,95 +2014,10 @@ void driverContigs(contigsData* params){
             }
 
             if (!ignore) {
-                //remove primers and barcodes if neccessary
-                vector<string> codes;
-                vector<int> oligosResults = trimBarCodesAndPrimers(fSeq, rSeq, fQual, rQual, findexBarcode, rindexBarcode, trims, codes, numBarcodes, numPrimers, hasQuality, hasIndex, params->pdiffs, params->bdiffs, params->tdiffs, params->m);
-                
-                string trashCode = codes[0];
-                string commentString = codes[1];
-                int barcodeIndex = oligosResults[0];
-                int primerIndex = oligosResults[1];
-                
-                //assemble reads
-                string contig = "";
-                int oend, oStart;
-                int numMismatches = 0;
-                vector<int> scores1, scores2;
-                if(hasQuality){
-                    scores1 = fQual->getScores(); scores2 = rQual->getScores();
-                    delete fQual; delete rQual;
-                }
-                vector<int> contigScores = assembleFragments(qual_match_simple_bayesian, qual_mismatch_simple_bayesian, fSeq, rSeq, scores1, scores2, hasQuality, alignment, contig, trashCode, oend, oStart, numMismatches, params->insert, params->deltaq, params->trimOverlap);
-
-								//Note that usearch/vsearch cap the maximum Q value at 41 - perhaps due to ascii
-								//limits? we leave this value unbounded. if two sequences have a 40 then the
-								//assembled quality score will be 85. If two 250 nt reads are all 40 and they
- 								//perfectly match each other, then the difference in the number of expected errors
-								//between using 85 and 41 all the way across will be 0.01986 - this is a "worst"
-								//case scenario
-
-								double expected_errors = 0;
-								for(int i=0;i<contigScores.size();i++){
-									expected_errors += convertQToProb(contigScores[i]);
-								}
-
-								if(expected_errors > params->maxee) { trashCode += 'e' ;}
-                
-                if (params->screenSequences) { screenSequence(contig, trashCode, params); }
-
-                if(trashCode.length() == 0){
-                    string thisGroup = params->group; //group from file file
-                    if (params->createGroupFromOligos) { //overwrite file file group for oligos group
-                        if(numBarcodes != 0){
-                            thisGroup = params->barcodeNameVector[barcodeIndex];
-                            if (numPrimers != 0) {
-                                if (params->primerNameVector[primerIndex] != "") {
-                                    if(thisGroup != "") { thisGroup += "." + params->primerNameVector[primerIndex]; }
-                                    else                { thisGroup = params->primerNameVector[primerIndex];        }
-                                }
-                            }
-                        }
-                    }
-
-                    int pos = thisGroup.find("ignore");
-                    if (pos == string::npos) {
-                        if (thisGroup != "") {
-                            params->groupMap[fSeq.getName()] = thisGroup;
-
-                            map<string, int>::iterator it = params->groupCounts.find(thisGroup);
-                            if (it == params->groupCounts.end()) {	params->groupCounts[thisGroup] = 1; }
-                            else { params->groupCounts[it->first] ++; }
-                        }
-                    }else { ignore = true; }
-
-                    //print good stuff
-                    if(!ignore){
-                        //output
-                        string output = ">" + fSeq.getName() + '\t' + "ee=" + toString(expected_errors) + '\t' + commentString + "\n" + contig + "\n";
-                        params->trimFileName->write(output);
-                        if (hasQuality && params->makeQualFile) {
-                            output = ">" + fSeq.getName() + '\t' + "ee=" + toString(expected_errors) + '\t' + commentString +"\n";
-                            for (int i = 0; i < contigScores.size(); i++) { output += toString(contigScores[i]) + " "; }  output += "\n";
-                            params->trimQFileName->write(output);
-                        }
-                        int numNs = 0;
-                        for (int i = 0; i < contig.length(); i++) { if (contig[i] == 'N') { numNs++; }  }
-                        output = fSeq.getName() + '\t' + toString(contig.length()) + '\t' + toString(oend-oStart) + '\t' + toString(oStart) + '\t' + toString(oend) + '\t' + toString(numMismatches) + '\t' + toString(numNs) + '\t' + toString(expected_errors) + "\n";
-                        params->misMatchesFile->write(output);
-                    }
-                }else{
-                    params->badNames.insert(fSeq.getName());
-
-                    string output = ">" + fSeq.getName() + " | " + trashCode + '\t' + "ee=" +  toString(expected_errors) + '\t' + commentString + "\n" + contig + "\n";
-                    params->scrapFileName->write(output);
-
-                    if (hasQuality && params->makeQualFile) {
-                        output = ">" + fSeq.getName() + " | " + trashCode + '\t' + "ee=" + toString(expected_errors) + '\t' + commentString + "\n";
-                        for (int i = 0; i < contigScores.size(); i++) { output += toString(contigScores[i]) + " "; }  output += "\n";
-                        params->scrapQFileName->write(output);
-                    }
-                }
-                if (params->m->getDebug()) { params->m->mothurOut("\n"); }
+                if (params->pairQueue != nullptr) { //hand the pair to the assembling threads
+                    batch->push_back(contigsReadPair(fSeq, rSeq, fQual, rQual, findexBarcode, rindexBarcode));
+                    if (batch->size() == contigsBatchSize) { params->pairQueue->push(batch); batch = new vector<contigsReadPair>(); batch->reserve(contigsBatchSize); }
+                }else { assembleContigsPair(params, assembler, fSeq, rSeq, fQual, rQual, findexBarcode, rindexBarcode); }
             }
             params->count++;
 
@@ -1923,6 +2044,11 @@ void driverContigs(contigsData* params){
             if((params->count) % 1000 == 0){	params->m->mothurOutJustToScreen(toString(params->count)+"\n"); }
         }
 
+        if (batch != nullptr) {
+            if (batch->size() != 0) { params->pairQueue->push(batch); }
+            else { delete batch; }
+        }
+
         //report progress
         if((params->count) % 1000 != 0){	params->m->mothurOutJustToScreen(toString(params->count)+"\n"); }
 
@@ -1951,7 +2077,7 @@ void driverContigs(contigsData* params){
                 }
             }
         }else{
-            if (hasQuality) {
+            if (assembler.hasQuality) {
                 inFQualIndex.close();
                 inRQualIndex.close();
                 if (params->gz) {
@@ -1961,11 +2087,6 @@ void driverContigs(contigsData* params){
                 }
             }
         }
-
-        //cleanup memory
-        for (int i = 0; i < trims.size(); i++) {  delete trims[i]; }
-        delete alignment;
-        
     }
     catch(exception& e) {
         params->m->errorOut(e, "MakeContigsCommand", "driverContigs");
@@ -1973,6 +2094,32 @@ void driverContigs(contigsData* params){
     }
 }
 //**********************************************************************************************************************
+//assembles the batches of read pairs read by driverContigs from compressed files
+void driverContigsBatches(contigsData* params){
+    try {
+        params->count = 0;
+        contigsAssembler assembler(params);
+
+        long long batchNumber = 0;
+        vector<contigsReadPair>* batch = params->pairQueue->pop(batchNumber);
+        while (batch != nullptr) {
+            params->openBatchWriters(batchNumber);
+            for (int i = 0; i < batch->size(); i++) {
+                contigsReadPair& pair = (*batch)[i];
+                if (params->m->getControl_pressed()) { delete pair.fQual; delete pair.rQual; continue; } //keep emptying the queue so the reader isn't blocked
+                assembleContigsPair(params, assembler, pair.fSeq, pair.rSeq, pair.fQual, pair.rQual, pair.findexBarcode, pair.rindexBarcode);
+            }
+            params->closeBatchWriters();
+            delete batch;
+            batch = params->pairQueue->pop(batchNumber);
+        }
+    }
+    catch(exception& e) {
+        params->m->errorOut(e, "MakeContigsCommand", "driverContigsBatches");
+        exit(1);
+    }
+}
+//**********************************************************************************************************************
 //fileInputs[0] = forward Fasta or Forward Fastq, fileInputs[1] = reverse Fasta or reverse Fastq. if qualOrIndexFiles.size() != 0, then qualOrIndexFiles[0] = forward qual or Forward index, qualOrIndexFiles[1] = reverse qual or reverse index.
 //lines[0] - ffasta, lines[1] - rfasta) - processor1
 //lines[2] - ffasta, lines[3] - rfasta) - processor2
@@ -1996,7 +2143,6 @@ unsigned long long MakeContigsCommand::createProcesses(vector<string> fileInputs
                 lines.push_back(linePair(0, 1000));
                 qLines.push_back(linePair(0, 1000));
             }
-            processors = fileInputs.size() / 2;
         }else        {
             //divides the files so that the processors can share the workload.
             setLines(fileInputs, qualOrIndexFiles, lines, qLines, delim);
@@ -2016,40 +2162,64 @@ unsigned long long MakeContigsCommand::createProcesses(vector<string> fileInputs
         auto synchronizedOutputQTrimFile = std::make_shared<SynchronizedOutputFile>(outputQual);
         auto synchronizedOutputQScrapFile = std::make_shared<SynchronizedOutputFile>(outputScrapQual);
        
+        //compressed files can't be divided, so this thread decompresses the reads and the worker threads assemble them
+        contigsPairQueue* pairQueue = nullptr;
+        int numWorkers = processors-1;
+        if (gz && (processors > 1)) { pairQueue = new contigsPairQueue(2*processors); numWorkers = processors; }
 
         //Lauch worker threads
-        for (int i = 0; i < processors-1; i++) {
-            OutputWriter* threadFastaTrimWriter = new OutputWriter(synchronizedOutputFastaTrimFile);
-            OutputWriter* threadFastaScrapWriter = new OutputWriter(synchronizedOutputFastaScrapFile);
-            OutputWriter* threadMismatchWriter = new OutputWriter(synchronizedMisMatchFile);
+        for (int i = 0; i < numWorkers; i++) {
+            long long writerOrder = -1; //unordered unless keeporder=t
+            if (keepOrder) { writerOrder = i+1; }
+
+            //the threads assembling batches open a set of ordered writers for each batch
+            OutputWriter* threadFastaTrimWriter = nullptr;
+            OutputWriter* threadFastaScrapWriter = nullptr;
+            OutputWriter* threadMismatchWriter = nullptr;
             OutputWriter* threadQTrimWriter = nullptr;
             OutputWriter* threadQScrapWriter = nullptr;
-            if (makeQualFile) {
-                threadQTrimWriter = new OutputWriter(synchronizedOutputQTrimFile);
-                threadQScrapWriter = new OutputWriter(synchronizedOutputQScrapFile);
+            if (pairQueue == nullptr) {
+                threadFastaTrimWriter = new OutputWriter(synchronizedOutputFastaTrimFile, writerOrder);
+                threadFastaScrapWriter = new OutputWriter(synchronizedOutputFastaScrapFile, writerOrder);
+                threadMismatchWriter = new OutputWriter(synchronizedMisMatchFile, writerOrder);
+                if (makeQualFile) {
+                    threadQTrimWriter = new OutputWriter(synchronizedOutputQTrimFile, writerOrder);
+                    threadQScrapWriter = new OutputWriter(synchronizedOutputQScrapFile, writerOrder);
+                }
             }
 
-            int spot = (i+1)*2;
+            int spot = 0;
+            if (pairQueue == nullptr) { spot = (i+1)*2; }
             contigsData* dataBundle = new contigsData(threadFastaTrimWriter, threadFastaScrapWriter, threadQTrimWriter, threadQScrapWriter, threadMismatchWriter, fileInputs, qualOrIndexFiles, lines[spot], lines[spot+1], qLines[spot], qLines[spot+1]);
             dataBundle->setVariables(gz, delim, nameType, offByOneTrimLength, pairedBarcodes, pairedPrimers, rpairedBarcodes, rpairedPrimers, revpairedBarcodes, revpairedPrimers, primerNames, barcodeNames, reorient, pdiffs, bdiffs, tdiffs, align, match, misMatch, gapOpen, gapExtend, insert, deltaq, maxee, kmerSize, format, trimOverlap, createOligosGroup, createFileGroup, group, screenSequences, maxHomoP, maxLength, maxAmbig);
+            dataBundle->pairQueue = pairQueue;
+            if (pairQueue != nullptr) {
+                dataBundle->makeQualFile = makeQualFile;
+                dataBundle->setBatchFiles(synchronizedOutputFastaTrimFile, synchronizedOutputFastaScrapFile, synchronizedOutputQTrimFile, synchronizedOutputQScrapFile, synchronizedMisMatchFile);
+            }
             data.push_back(dataBundle);
 
-            workerThreads.push_back(new std::thread(driverContigs, dataBundle));
+            if (pairQueue == nullptr)   { workerThreads.push_back(new std::thread(driverContigs, dataBundle));          }
+            else                        { workerThreads.push_back(new std::thread(driverContigsBatches, dataBundle));   }
         }
 
-        OutputWriter* threadMisMatchWriter = new OutputWriter(synchronizedMisMatchFile);
-        OutputWriter* threadFastaTrimWriter = new OutputWriter(synchronizedOutputFastaTrimFile);
-        OutputWriter* threadFastaScrapWriter = new OutputWriter(synchronizedOutputFastaScrapFile);
+        long long writerOrder = -1; //this thread only reads when the batches are assembled by the others
+        if (keepOrder && (pairQueue == nullptr)) { writerOrder = 0; }
+        OutputWriter* threadMisMatchWriter = new OutputWriter(synchronizedMisMatchFile, writerOrder);
+        OutputWriter* threadFastaTrimWriter = new OutputWriter(synchronizedOutputFastaTrimFile, writerOrder);
+        OutputWriter* threadFastaScrapWriter = new OutputWriter(synchronizedOutputFastaScrapFile, writerOrder);
         OutputWriter* threadQTrimWriter = nullptr;
         OutputWriter* threadQScrapWriter = nullptr;
         if (makeQualFile) {
-            threadQTrimWriter = new OutputWriter(synchronizedOutputQTrimFile);
-            threadQScrapWriter = new OutputWriter(synchronizedOutputQScrapFile);
+            threadQTrimWriter = new OutputWriter(synchronizedOutputQTrimFile, writerOrder);
+            threadQScrapWriter = new OutputWriter(synchronizedOutputQScrapFile, writerOrder);
         }
         contigsData* dataBundle = new contigsData(threadFastaTrimWriter, threadFastaScrapWriter, threadQTrimWriter, threadQScrapWriter, threadMisMatchWriter, fileInputs, qualOrIndexFiles, lines[0], lines[1], qLines[0], qLines[1]);
         dataBundle->setVariables(gz, delim, nameType, offByOneTrimLength, pairedBarcodes, pairedPrimers, rpairedBarcodes, rpairedPrimers, revpairedBarcodes, revpairedPrimers, primerNames, barcodeNames, reorient, pdiffs, bdiffs, tdiffs, align, match, misMatch, gapOpen, gapExtend, insert, deltaq, maxee, kmerSize, format, trimOverlap, createOligosGroup, createFileGroup, group, screenSequences, maxHomoP, maxLength, maxAmbig);
+        dataBundle->pairQueue = pairQueue;
 
         driverContigs(dataBundle);
+        if (pairQueue != nullptr) { pairQueue->finish(); }
 
         long long num = dataBundle->count;
         badNames.insert(dataBundle->badNames.begin(), dataBundle->badNames.end());
@@ -2060,7 +2230,7 @@ unsigned long long MakeContigsCommand::createProcesses(vector<string> fileInputs
             else { groupCounts[it->first] = it->second; }
         }
 
-        for (int i = 0; i < processors-1; i++) {
+        for (int i = 0; i < numWorkers; i++) {
             workerThreads[i]->join();
             num += data[i]->count;
 
@@ -2083,6 +2253,7 @@ unsigned long long MakeContigsCommand::createProcesses(vector<string> fileInputs
             delete data[i];
             delete workerThreads[i];
         }
+        delete pairQueue;
 
         delete threadFastaTrimWriter;
         delete threadFastaScrapWriter;
@@ -2225,14 +2396,17 @@ unsigned long long MakeContigsCommand::createProcessesGroups(vector< vector<stri
 
         //Lauch worker threads
         for (int i = 0; i < processors-1; i++) {
-            OutputWriter* threadFastaTrimWriter = new OutputWriter(synchronizedOutputFastaTrimFile);
-            OutputWriter* threadFastaScrapWriter = new OutputWriter(synchronizedOutputFastaScrapFile);
-            OutputWriter* threadMismatchWriter = new OutputWriter(synchronizedMisMatchFile);
+            long long writerOrder = -1; //unordered unless keeporder=t
+            if (keepOrder) { writerOrder = i+1; }
+
+            OutputWriter* threadFastaTrimWriter = new OutputWriter(synchronizedOutputFastaTrimFile, writerOrder);
+            OutputWriter* threadFastaScrapWriter = new OutputWriter(synchronizedOutputFastaScrapFile, writerOrder);
+            OutputWriter* threadMismatchWriter = new OutputWriter(synchronizedMisMatchFile, writerOrder);
             OutputWriter* threadQTrimWriter = nullptr;
             OutputWriter* threadQScrapWriter = nullptr;
             if (makeQualFile) {
-                threadQTrimWriter = new OutputWriter(synchronizedOutputQTrimFile);
-                threadQScrapWriter = new OutputWriter(synchronizedOutputQScrapFile);
+                threadQTrimWriter = new OutputWriter(synchronizedOutputQTrimFile, writerOrder);
+                threadQScrapWriter = new OutputWriter(synchronizedOutputQScrapFile, writerOrder);
             }
 
             contigsData* dataBundle = new contigsData(threadFastaTrimWriter, threadFastaScrapWriter, threadQTrimWriter, threadQScrapWriter, threadMismatchWriter);
@@ -2243,14 +2417,16 @@ unsigned long long MakeContigsCommand::createProcessesGroups(vector< vector<stri
             workerThreads.push_back(new std::thread(driverContigsGroups, groupDataBundle));
         }
 
-        OutputWriter* threadMisMatchWriter = new OutputWriter(synchronizedMisMatchFile);
-        OutputWriter* threadFastaTrimWriter = new OutputWriter(synchronizedOutputFastaTrimFile);
-        OutputWriter* threadFastaScrapWriter = new OutputWriter(synchronizedOutputFastaScrapFile);
+        long long writerOrder = -1;
+        if (keepOrder) { writerOrder = 0; }
+        OutputWriter* threadMisMatchWriter = new OutputWriter(synchronizedMisMatchFile, writerOrder);
+        OutputWriter* threadFastaTrimWriter = new OutputWriter(synchronizedOutputFastaTrimFile, writerOrder);
+        OutputWriter* threadFastaScrapWriter = new OutputWriter(synchronizedOutputFastaScrapFile, writerOrder);
         OutputWriter* threadQTrimWriter = nullptr;
         OutputWriter* threadQScrapWriter = nullptr;
         if (makeQualFile) {
-            threadQTrimWriter = new OutputWriter(synchronizedOutputQTrimFile);
-            threadQScrapWriter = new OutputWriter(synchronizedOutputQScrapFile);
+            threadQTrimWriter = new OutputWriter(synchronizedOutputQTrimFile, writerOrder);
+            threadQScrapWriter = new OutputWriter(synchronizedOutputQScrapFile, writerOrder);
         }
         contigsData* dataBundle = new contigsData(threadFastaTrimWriter, threadFastaScrapWriter, threadQTrimWriter, threadQScrapWriter, threadMisMatchWriter);
         dataBundle->setVariables(gz, delim, nameType, offByOneTrimLength, pairedBarcodes, pairedPrimers, rpairedBarcodes, rpairedPrimers, revpairedBarcodes, revpairedPrimers, primerNames, barcodeNames, reorient, pdiffs, bdiffs, tdiffs, align, match, misMatch, gapOpen, gapExtend, insert, deltaq, maxee, kmerSize, format, trimOverlap, createOligosGroup, createFileGroup, "", screenSequences, maxHomoP, maxLength, maxAmbig);
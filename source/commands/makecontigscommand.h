@@ -21,6 +21,8 @@
 #include "kmeralign.h"
 #include "splitgroupscommand.h"
 #include "filefile.hpp"
+#include <condition_variable>
+#include <deque>
 
 
 #        define PROBABILITY(score) (pow(10.0, (-(double)(score)) / 10.0))
@@ -65,7 +67,7 @@ private:
 #define offByOne  3
 
     char delim;
-    bool abort, allFiles, trimOverlap, createFileGroup, createOligosGroup, makeCount, noneOk, reorient, gz, makeQualFile, screenSequences;
+    bool abort, allFiles, trimOverlap, createFileGroup, createOligosGroup, makeCount, noneOk, reorient, gz, makeQualFile, screenSequences, keepOrder;
     string  ffastqfile, rfastqfile, align, oligosfile, rfastafile, ffastafile, rqualfile, fqualfile, findexfile, rindexfile, file, format, inputDir;
 	float match, misMatch, gapOpen, gapExtend, maxee;
 	int processors, longestBase, insert, tdiffs, bdiffs, pdiffs, ldiffs, sdiffs, deltaq, kmerSize, nameType, offByOneTrimLength, maxAmbig, maxHomoP, maxLength;
@@ -672,10 +672,12 @@ SharedRAbundVectors* SharedCommand::readData(string matrixFormat, string line, s
         SharedRAbundVectors* lookup = new SharedRAbundVectors();
         
         //creates new sharedRAbunds
+        vector<SharedRAbundVector*> samples;
         for (int i = 0; i < groupNames.size(); i++) {
-            SharedRAbundVector* temp = new SharedRAbundVector(numOTUs); //sets all abunds to 0
+            SharedRAbundVector* temp = new SharedRAbundVector(numOTUs, (matrixFormat == "sparse")); //sets all abunds to 0
             temp->setGroup(groupNames[i]);
             lookup->push_back(temp);
+            samples.push_back(temp);
         }
         lookup->setLabels("userLabel");
 
@@ -738,6 +740,7 @@ SharedRAbundVectors* SharedCommand::readData(string matrixFormat, string line, s
         }
 
         if (pickedGroups) { lookup->eliminateZeroOTUS(); }
+        for (int i = 0; i < samples.size(); i++) {  samples[i]->fitStorage();  }
 
         return lookup;
     }
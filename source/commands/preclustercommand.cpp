@@ -337,19 +337,19 @@ struct preClusterData {
 
 /**************************************************************************************************/
 
-int calcMisMatches(string seq1, string seq2, preClusterData* params){
+int calcMisMatches(const string& alignedSeq1, const string& alignedSeq2, preClusterData* params){
   try {
     int numBad = 0;
 
     if (params->align_method == "unaligned") {
       //align to eachother
-      Sequence seqI("seq1", seq1);
-      Sequence seqJ("seq2", seq2);
+      Sequence seqI("seq1", alignedSeq1);
+      Sequence seqJ("seq2", alignedSeq2);
 
       //align seq2 to seq1 - less abundant to more abundant
       params->alignment->align(seqJ.getUnaligned(), seqI.getUnaligned());
-      seq2 = params->alignment->getSeqAAln();
-      seq1 = params->alignment->getSeqBAln();
+      string seq2 = params->alignment->getSeqAAln();
+      string seq1 = params->alignment->getSeqBAln();
 
       //chop gap ends
       int startPos = 0;
@@ -365,9 +365,9 @@ int calcMisMatches(string seq1, string seq2, preClusterData* params){
 
     } else {
       //count diffs
-      for (int i = 0; i < seq1.length(); i++) {
+      for (int i = 0; i < alignedSeq1.length(); i++) {
         //do they match
-        if (seq1[i] != seq2[i]) { numBad++; }
+        if (alignedSeq1[i] != alignedSeq2[i]) { numBad++; }
         if (numBad > params->diffs) { return params->length;  } //too far to cluster
       }
     }
@@ -452,6 +452,57 @@ void mergeSeqs(seqPNode* representative, seqPNode* duplicate, string& chunk, int
     }
 }
 /**************************************************************************************************/
+//  Pigeonhole filter for the aligned methods. If two aligned seqs of the same length differ at no more than maxDiffs
+//  positions, splitting them into maxDiffs+1 segments leaves at least one segment identical. Each segment is hashed,
+//  and only the seqs that share a segment with a seq have their mismatches counted. Unaligned seqs, or seqs too short
+//  to split, get every less abundant seq as a candidate like before.
+struct preClusterSegmentIndex {
+    vector<int> segmentStarts; //numSegments+1 boundaries
+    vector< unordered_map<unsigned long long, vector<int> > > buckets; //for each segment, hash of the segment -> seqs with it, in order
+    vector<int> lastSeen;
+    long long numSeqs;
+    bool useIndex;
+    
+    preClusterSegmentIndex(vector<seqPNode*>& seqs, int maxDiffs, bool aligned) : numSeqs(seqs.size()), useIndex(false) {
+        if (!aligned || (numSeqs == 0) || (maxDiffs < 0)) { return; }
+        
+        int length = seqs[0]->sequence.length();
+        for (long long i = 0; i < numSeqs; i++) { if (seqs[i]->sequence.length() != length) { return; } }
+        
+        int numSegments = maxDiffs+1;
+        if (length < numSegments) { return; }
+        
+        for (int k = 0; k <= numSegments; k++) { segmentStarts.push_back((int)(((long long)length * k) / numSegments)); }
+        
+        buckets.resize(numSegments);
+        for (long long i = 0; i < numSeqs; i++) {
+            for (int k = 0; k < numSegments; k++) { buckets[k][hashSegment(seqs[i]->sequence, k)].push_back(i); }
+        }
+        lastSeen.assign(numSeqs, -1);
+        useIndex = true;
+    }
+    
+    unsigned long long hashSegment(const string& seq, int k) {
+        unsigned long long hash = 14695981039346656037ULL; //FNV-1a
+        for (int i = segmentStarts[k]; i < segmentStarts[k+1]; i++) { hash ^= (unsigned char)seq[i]; hash *= 1099511628211ULL; }
+        return hash;
+    }
+    
+    //seqs after i that share a segment with it, in increasing order
+    void getCandidates(vector<seqPNode*>& seqs, long long i, vector<int>& candidates) {
+        candidates.clear();
+        if (!useIndex) { for (long long j = i+1; j < numSeqs; j++) { candidates.push_back(j); } return; }
+        
+        for (int k = 0; k < buckets.size(); k++) {
+            vector<int>& bucket = buckets[k][hashSegment(seqs[i]->sequence, k)];
+            for (vector<int>::iterator it = upper_bound(bucket.begin(), bucket.end(), (int)i); it != bucket.end(); it++) {
+                if (lastSeen[*it] != i) { lastSeen[*it] = i; candidates.push_back(*it); }
+            }
+        }
+        sort(candidates.begin(), candidates.end());
+    }
+};
+/**************************************************************************************************/
 
 int process(string group, string newMapFile, preClusterData* params){
     try {
@@ -476,15 +527,22 @@ int process(string group, string newMapFile, preClusterData* params){
         bool lessThan = true;
         if (params->clump == "lessthanequal") { lessThan = false; }
         
+        bool aligned = (params->align_method != "unaligned");
+        vector<int> candidates;
+        
         if(params->pc_method == "simple"){
+            preClusterSegmentIndex segmentIndex(params->alignSeqs, params->diffs, aligned);
+            
             for (int i = 0; i < numSeqs; i++) {
                 
                 if (params->alignSeqs[i]->numIdentical != 0) {  //this sequence has not been merged yet
                     
                     string chunk = params->alignSeqs[i]->name + "\t" + params->alignSeqs[i]->name + "\t" + toString(originalCount[i]) + "\t" + toString(0) + "\t" + params->alignSeqs[i]->sequence + "\n";
                     
-                    //try to merge it with all smaller seqs
-                    for (int j = i+1; j < numSeqs; j++) {
+                    //try to merge it with all smaller seqs that could be within diffs
+                    segmentIndex.getCandidates(params->alignSeqs, i, candidates);
+                    for (int k = 0; k < candidates.size(); k++) {
+                        int j = candidates[k];
                         
                         if (params->m->getControl_pressed()) { out.close(); return 0; }
                         
@@ -515,14 +573,18 @@ int process(string group, string newMapFile, preClusterData* params){
                 beta[i] = pow(0.5, params->alpha * i + 1.0);
             }
             
+            preClusterSegmentIndex segmentIndex(params->alignSeqs, params->diffs, aligned);
+            
             for (int i = 0; i < numSeqs; i++) {
                 
                 if (params->alignSeqs[i]->numIdentical != 0) {  //this sequence has not been merged yet
                     
                     string chunk = params->alignSeqs[i]->name + "\t" + params->alignSeqs[i]->name + "\t" + toString(originalCount[i]) + "\t" + toString(0) + "\t" + params->alignSeqs[i]->sequence + "\n";
                     
-                    //try to merge it with all smaller seqs
-                    for (int j = i+1; j < numSeqs; j++) {
+                    //try to merge it with all smaller seqs that could be within diffs
+                    segmentIndex.getCandidates(params->alignSeqs, i, candidates);
+                    for (int k = 0; k < candidates.size(); k++) {
+                        int j = candidates[k];
                         
                         if (params->m->getControl_pressed()) { out.close(); return 0; }
                         
@@ -553,11 +615,16 @@ int process(string group, string newMapFile, preClusterData* params){
                 cluster[i] = i;
             }
             
+            //only seqs one mismatch apart are joined
+            preClusterSegmentIndex segmentIndex(params->alignSeqs, 1, aligned);
+            
             for (int i=0;i<numSeqs-1;i++) {
                 
                 if (params->m->getControl_pressed()) { out.close(); return 0; }
                 
-                for (int j=i+1;j<numSeqs;j++) {
+                segmentIndex.getCandidates(params->alignSeqs, i, candidates);
+                for (int k = 0; k < candidates.size(); k++) {
+                    int j = candidates[k];
                     
                     if (params->m->getControl_pressed()) { out.close(); return 0; }
                     
@@ -41,6 +41,7 @@ vector<string> RareFactCommand::setParameters(){
 		CommandParameter pabund("abund", "Number", "", "10", "", "", "","",false,false); parameters.push_back(pabund);
         CommandParameter palpha("alpha", "Multiple", "0-1-2", "1", "", "", "","",false,false,true); parameters.push_back(palpha);
 		CommandParameter pgroupmode("groupmode", "Boolean", "", "T", "", "", "","",false,false); parameters.push_back(pgroupmode);
+        CommandParameter pexpected("expected", "Boolean", "", "T", "", "", "","",false,false); parameters.push_back(pexpected);
 		CommandParameter pseed("seed", "Number", "", "0", "", "", "","",false,false); parameters.push_back(pseed);
         CommandParameter pprocessors("processors", "Number", "", "1", "", "", "","",false,false,true); parameters.push_back(pprocessors);
         CommandParameter pinputdir("inputdir", "String", "", "", "", "", "","",false,false); parameters.push_back(pinputdir);
@@ -80,13 +81,14 @@ string RareFactCommand::getHelpString(){
 	try {
 		ValidCalculators validCalculator;
 		string helpString = "";
-		helpString += "The rarefaction.single command parameters are list, sabund, rabund, shared, label, iters, freq, calc, groupmode, groups, processors and abund.  list, sabund, rabund or shared is required unless you have a valid current file. \n";
+		helpString += "The rarefaction.single command parameters are list, sabund, rabund, shared, label, iters, freq, calc, groupmode, expected, groups, processors and abund.  list, sabund, rabund or shared is required unless you have a valid current file. \n";
 		helpString += "The freq parameter is used indicate when to output your data, by default it is set to 100. But you can set it to a percentage of the number of sequence. For example freq=0.10, means 10%. \n";
 		helpString += "The rarefaction.single command should be in the following format: \n";
 		helpString += "rarefaction.single(label=yourLabel, iters=yourIters, freq=yourFreq, calc=yourEstimators).\n";
 		helpString += "Example rarefaction.single(label=unique-.01-.03, iters=10000, freq=10, calc=sobs-rchao-race-rjack-rbootstrap-rshannon-rnpshannon-rsimpson).\n";
 		helpString += "The default values for iters is 1000, freq is 100, and calc is rarefaction which calculates the rarefaction curve for the observed richness.\n";
         helpString += "The alpha parameter is used to set the alpha value for the shannonrange calculator.\n";
+        helpString += "The expected parameter computes the sobs curve from its closed form instead of averaging it over the iterations. Its lci and hci are then the mean -/+ 1.96 standard deviations, limited to the number of OTUs a draw can see, rather than the 2.5 and 97.5 percentiles of the iterations. Set expected=f for the sampled curve. (Default=true).\n";
 		validCalculator.printCalc("rarefaction");
 		helpString += "If you are running rarefaction.single with a shared file and would like your results collated in one file, set groupmode=t. (Default=true).\n";
 		helpString += "The label parameter is used to analyze specific labels in your input.\n";
@@ -224,6 +226,9 @@ RareFactCommand::RareFactCommand(string option) : Command()  {
 			temp = validParameter.valid(parameters, "groupmode");		if (temp == "not found") { temp = "T"; }
 			groupMode = util.isTrue(temp);
             
+            temp = validParameter.valid(parameters, "expected");		if (temp == "not found") { temp = "T"; }
+			expected = util.isTrue(temp);
+            
             temp = validParameter.valid(parameters, "processors");	if (temp == "not found"){	temp = current->getProcessors();	}
             processors = current->setProcessors(temp);
             
@@ -285,7 +290,7 @@ int RareFactCommand::execute(){
                 map<string, set<int> >::iterator itEndings = labelToEnds.find(order->getLabel());
                 set<int> ends;
                 if (itEndings != labelToEnds.end()) { ends = itEndings->second; }
-                Rarefact* rCurve = new Rarefact(*order, rDisplays, ends, processors);
+                Rarefact* rCurve = new Rarefact(*order, rDisplays, ends, processors, expected);
                 rCurve->getCurve(freq, nIters);
                 delete rCurve; delete order;
                 
@@ -40,7 +40,7 @@ private:
 	int nIters, abund, processors, alpha;
 	float freq;
 	
-	bool abort, allLines, groupMode;
+	bool abort, allLines, groupMode, expected;
 	set<string> labels; //holds labels to be used
 	string label, calc, sharedfile, listfile, rabundfile, sabundfile, format, inputfile;
 	vector<string>  Estimators;
@@ -294,16 +294,14 @@ int RemoveGroupsCommand::execute(){
             ct.readTable(countfile, true, false);
             int oldTotal = ct.getNumSeqs();
             
-            vector<string> namesOfSeqs = ct.getNamesOfSeqs(); //all names
+            vector<string> namesOfSeqs; //all names
+            vector<countTableSeq> seqs = ct.getSeqs();
+            for (int i = 0; i < seqs.size(); i++) { namesOfSeqs.push_back(seqs[i].getName()); }
             
             for (int i = 0; i < Groups.size(); i++) { ct.removeGroup(Groups[i]); }
             
-            vector<string> newSeqs = ct.getNamesOfSeqs(); //names of seqs left after removing groups
-            
-            unordered_set<string> goodNames = util.mothurConvert(newSeqs);
-            
             for (int i = 0; i < namesOfSeqs.size(); i++) {
-                if (goodNames.count(namesOfSeqs[i]) == 0) { //you aren't on good list
+                if (!ct.inTable(namesOfSeqs[i])) { //removed with the groups
                     names.insert(namesOfSeqs[i]); //add to remove list
                 }
             }
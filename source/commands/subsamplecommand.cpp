@@ -701,6 +701,7 @@ vector<string> SubSampleCommand::readNames() {
 int SubSampleCommand::getSubSampleShared() {
 	try {
 		InputData input(sharedfile, "sharedfile", Groups);
+		input.setSparse(true); //only walks the stored bins
 		set<string> processedLabels;
         set<string> userLabels = labels;
         string lastLabel = "";
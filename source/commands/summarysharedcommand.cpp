@@ -288,6 +288,7 @@ int SummarySharedCommand::execute(){
 		else{ if (all){  for (int i = 0; i < sumCalculators.size(); i++) { if (sumCalculators[i]->getMultiple() ) { mult = true; } } } }
 			
 		InputData input(sharedfile, "sharedfile", Groups);
+		input.setSparse(true); //the calculators walk the stored bins
 		set<string> processedLabels;
         set<string> userLabels = labels;
         string lastLabel = "";
@@ -563,6 +564,8 @@ void driverSummaryShared(summarySharedData* params) {
         ofstream outputFileHandle;
         if (!params->subsample) {  params->util.openOutputFile(params->sumFile, outputFileHandle); }
         
+        sharedPairStats stats;
+        
         vector<SharedRAbundVector*> subset;
         for (int k = params->start; k < params->end; k++) { // pass cdd each set of groups to compare
             
@@ -573,6 +576,7 @@ void driverSummaryShared(summarySharedData* params) {
                 subset.clear(); //clear out old pair of sharedrabunds
                 //add new pair of sharedrabunds
                 subset.push_back(params->thisLookup[k]); subset.push_back(params->thisLookup[l]);
+                bool hasStats = params->pairwise->getPairStats(k, l, stats);
                 
                 if (!params->subsample) {
                     outputFileHandle << params->thisLookup[0]->getLabel() << '\t';
@@ -594,7 +598,9 @@ void driverSummaryShared(summarySharedData* params) {
                         }
                     }
                     
-                    vector<double> tempdata = sumCalculators[i]->getValues(subset); //saves the calculator outputs
+                    vector<double> tempdata;
+                    if (hasStats && (subset.size() == 2) && sumCalculators[i]->hasPairStats()) { tempdata = sumCalculators[i]->getValues(stats); }
+                    else { tempdata = sumCalculators[i]->getValues(subset); } //saves the calculator outputs
                     
                     if (params->m->getControl_pressed()) { break; }
                     
@@ -626,21 +632,26 @@ int SummarySharedCommand::runCalcs(SharedRAbundVectors*& thisItersLookup, string
         vector<std::thread*> workerThreads;
         vector<summarySharedData*> data;
         
+        //make copy of lookup so we don't get access violations
+        //SharedRAbundVectors* newLookup = new SharedRAbundVectors(*thisItersLookup);
+        string extension = toString(0) + ".temp";
+        summarySharedData* dataBundle = new summarySharedData(sumFileName+extension, sumAllFile+extension, m, lines[0].start, lines[0].end, Estimators, thisItersLookup, true, mult, subsample);
+        
+        //sparse copies of the samples, so the two group calcs can share one pass over each pair. the threads only read it
+        PairwiseShared pairwise(dataBundle->thisLookup, PairwiseShared::needsChao(Estimators));
+        dataBundle->pairwise = &pairwise;
+        
         //Lauch worker threads
         for (int i = 0; i < processors-1; i++) {
             // Allocate memory for thread data.
             string extension = toString(i+1) + ".temp";
             summarySharedData* dataBundle = new summarySharedData(sumFileName+extension, sumAllFile+extension, m, lines[i+1].start, lines[i+1].end, Estimators, thisItersLookup, false, mult, subsample);
+            dataBundle->pairwise = &pairwise;
             
             data.push_back(dataBundle);
             workerThreads.push_back(new std::thread(driverSummaryShared, dataBundle));
         }
         
-        //make copy of lookup so we don't get access violations
-        //SharedRAbundVectors* newLookup = new SharedRAbundVectors(*thisItersLookup);
-        string extension = toString(0) + ".temp";
-        summarySharedData* dataBundle = new summarySharedData(sumFileName+extension, sumAllFile+extension, m, lines[0].start, lines[0].end, Estimators, thisItersLookup, true, mult, subsample);
-        
         driverSummaryShared(dataBundle);
         for (int k = 0; k < calcDists.size(); k++) {
             int size = dataBundle->calcDists[k].size();
@@ -57,6 +57,7 @@
 #include "mempearson.h"
 #include "sharedjsd.h"
 #include "sharedrjsd.h"
+#include "pairwiseshared.hpp"
 
 class SummarySharedCommand : public Command {
 
@@ -100,6 +101,7 @@ private:
 // that can be passed using a single void pointer (LPVOID).
 struct summarySharedData {
     vector<SharedRAbundVector*> thisLookup;
+    const PairwiseShared* pairwise; //built once by runCalcs and shared by the threads
     vector< vector<seqDist> > calcDists;
     vector<string>  Estimators;
 	unsigned long long start;
@@ -124,6 +126,7 @@ struct summarySharedData {
         main = mai;
         mult = mu;
         subsample = sub;
+        pairwise = nullptr;
 	}
     ~summarySharedData() { for (int j = 0; j < thisLookup.size(); j++) { delete thisLookup[j]; } thisLookup.clear(); }
 };
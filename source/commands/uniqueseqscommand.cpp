@@ -18,6 +18,7 @@ vector<string> UniqueSeqsCommand::setParameters(){
         CommandParameter pcount("count", "InputTypes", "", "", "namecount", "none", "none","count",false,false,true); parameters.push_back(pcount);
         CommandParameter pformat("format", "Multiple", "count-name", "count", "", "", "","",false,false, true); parameters.push_back(pformat);
         CommandParameter poutput("output", "Multiple", "count-name", "count", "", "", "","",false,false, true); parameters.push_back(poutput);
+        CommandParameter pprocessors("processors", "Number", "", "1", "", "", "","",false,false,true); parameters.push_back(pprocessors);
         CommandParameter pseed("seed", "Number", "", "0", "", "", "","",false,false); parameters.push_back(pseed);
         CommandParameter pinputdir("inputdir", "String", "", "", "", "", "","",false,false); parameters.push_back(pinputdir);
 		CommandParameter poutputdir("outputdir", "String", "", "", "", "", "","",false,false); parameters.push_back(poutputdir);
@@ -43,10 +44,11 @@ string UniqueSeqsCommand::getHelpString(){
 	try {
 		string helpString = "";
 		helpString += "The unique.seqs command reads a fastafile and creates a name or count file.\n";
-		helpString += "The unique.seqs command parameters are fasta, name, count and format.  fasta is required, unless there is a valid current fasta file.\n";
+		helpString += "The unique.seqs command parameters are fasta, name, count, format and processors.  fasta is required, unless there is a valid current fasta file.\n";
         helpString += "The name parameter is used to provide an existing name file associated with the fasta file. \n";
         helpString += "The count parameter is used to provide an existing count file associated with the fasta file. \n";
         helpString += "The format parameter is used to indicate what type of file you want outputted.  Choices are name and count, default=count unless name file used then default=name.\n";
+        helpString += "The processors parameter allows you to specify the number of processors to use. The default is 1.\n";
 		helpString += "The unique.seqs command should be in the following format: \n";
 		helpString += "unique.seqs(fasta=yourFastaFile) \n";	
 		return helpString;
@@ -118,6 +120,9 @@ UniqueSeqsCommand::UniqueSeqsCommand(string option) : Command()  {
                 }
             }
             
+            string temp = validParameter.valid(parameters, "processors");	if (temp == "not found"){	temp = current->getProcessors();	}
+			processors = current->setProcessors(temp);
+            
             if ((format != "name") && (format != "count")) {
                 m->mothurOut(format + " is not a valid format option. Options are count or name.");
                 if (countfile == "") { m->mothurOut("I will use count.\n"); format = "count"; }
@@ -213,11 +218,10 @@ string UniqueSeqsCommand::processCount(string countfile) { //countfile can be bl
         ofstream outFasta; util.openOutputFile(outFastaFile, outFasta);
         outputNames.push_back(outFastaFile); outputTypes["fasta"].push_back(outFastaFile);
         
-        map<string, string> sequenceStrings; //sequenceString -> list of names.  "atgc...." -> seq1,seq2,seq3.
-        map<string, string>::iterator itStrings;
-        set<string> nameInFastaFile; //for sanity checking
-        set<string>::iterator itname;
-        vector<string> nameFileOrder;
+        UniqueSeqsTable uniqueSeqs(processors); //sequenceString -> unique, numbered in the order they are found
+        UniqueSeqsTable uniqueNames(processors); //for sanity checking
+        vector<string> repNames; //name of the first copy of each unique
+        vector<int> numDups; //copies after the first, if there is no countfile
         
         int count = 0;
         
@@ -225,23 +229,27 @@ string UniqueSeqsCommand::processCount(string countfile) { //countfile can be bl
             
             if (m->getControl_pressed()) { break; }
             
-            Sequence seq(in); gobble(in);
+            vector<Sequence> seqs; vector<string> seqStrings, seqNames;
+            readBatch(in, seqs, seqStrings, seqNames);
             
-            if (seq.getName() != "") { //not end of file
+            vector<int> ids, nameIds; vector<bool> isNew, isNewName;
+            uniqueSeqs.add(seqStrings, ids, isNew);
+            uniqueNames.add(seqNames, nameIds, isNewName);
+            
+            for (int i = 0; i < seqs.size(); i++) {
+                
+                if (m->getControl_pressed()) { break; }
                 
                 //sanity checks
-                itname = nameInFastaFile.find(seq.getName());
-                if (itname == nameInFastaFile.end()) { nameInFastaFile.insert(seq.getName());  }
-                else { m->mothurOut("[ERROR]: You already have a sequence named " + seq.getName() + " in your fasta file, sequence names must be unique, please correct.\n");  }
+                if (!isNewName[i]) { m->mothurOut("[ERROR]: You already have a sequence named " + seqNames[i] + " in your fasta file, sequence names must be unique, please correct.\n");  }
                 
-                itStrings = sequenceStrings.find(seq.getAligned());
-                string seqName = seq.getName();
+                string seqName = seqNames[i];
                 int numCurrentReps = 0;
                 
-                if (itStrings == sequenceStrings.end()) { //this is a new unique sequence
+                if (isNew[i]) { //this is a new unique sequence
                     
-                    seq.printSequence(outFasta); //output to unique fasta file
-                    sequenceStrings[seq.getAligned()] = seqName;    nameFileOrder.push_back(seq.getAligned());
+                    seqs[i].printSequence(outFasta); //output to unique fasta file
+                    repNames.push_back(seqName); numDups.push_back(0);
                     
                     if (countfile != "") { numCurrentReps = ct.getNumSeqs(seqName); } //checks to make sure seq is in table
                     else { newCt.push_back(seqName); }
@@ -250,41 +258,37 @@ string UniqueSeqsCommand::processCount(string countfile) { //countfile can be bl
                     
                     if (countfile != "") {
                         
-                        numCurrentReps = newCt.getNumSeqs(seq.getName()); //checks to make sure seq is in table
+                        numCurrentReps = newCt.getNumSeqs(seqName); //checks to make sure seq is in table
                         
                         if (numCurrentReps != 0) { //its in the table
-                            newCt.mergeCounts(itStrings->second, seq.getName()); //merges counts and saves in uniques name
+                            newCt.mergeCounts(repNames[ids[i]], seqName); //merges counts and saves in uniques name
                         }
-                    }else {
-                        numCurrentReps = newCt.getNumSeqs(itStrings->second);
-                        newCt.setNumSeqs(itStrings->second, numCurrentReps+1);
-                    }
+                    }else { numDups[ids[i]]++; }
                 }
                 count++;
+                
+                if(count % 1000 == 0)    { m->mothurOutJustToScreen(toString(count) + "\t" + toString(repNames.size()) + "\n");    }
             }
-            
-            
-            if(count % 1000 == 0)    { m->mothurOutJustToScreen(toString(count) + "\t" + toString(sequenceStrings.size()) + "\n");    }
         }
         
-        if(count % 1000 != 0)    { m->mothurOut(toString(count) + "\t" + toString(sequenceStrings.size())); m->mothurOutEndLine();    }
+        if(count % 1000 != 0)    { m->mothurOut(toString(count) + "\t" + toString(repNames.size())); m->mothurOutEndLine();    }
         
         in.close(); outFasta.close();
         if (m->getControl_pressed()) {  util.mothurRemove(outFastaFile); }
         
+        //add the dups to the uniques counts
+        for (int i = 0; i < numDups.size(); i++) {
+            if (numDups[i] != 0) { newCt.setNumSeqs(repNames[i], newCt.getNumSeqs(repNames[i])+numDups[i]); }
+        }
+        
         //print new names file
         ofstream outCount; util.openOutputFile(outCountFile, outCount); outputTypes["count"].push_back(outCountFile); outputNames.push_back(outCountFile);
         
         newCt.printCompressedHeaders(outCount);
         
-        for (int i = 0; i < nameFileOrder.size(); i++) {
+        for (int i = 0; i < repNames.size(); i++) {
             if (m->getControl_pressed()) { break; }
-            
-            itStrings = sequenceStrings.find(nameFileOrder[i]);
-            
-            if (itStrings != sequenceStrings.end()) {
-                newCt.printCompressedSeq(outCount, itStrings->second);
-            }else{ m->mothurOut("[ERROR]: mismatch in namefile print.\n");  m->setControl_pressed(true); }
+            newCt.printCompressedSeq(outCount, repNames[i]);
         }
         outCount.close();
         
@@ -344,56 +348,61 @@ string UniqueSeqsCommand::processName(string namefile) { //namefile can be blank
         ofstream outFasta; util.openOutputFile(outFastaFile, outFasta);
         outputNames.push_back(outFastaFile); outputTypes["fasta"].push_back(outFastaFile);
         
-        map<string, string> sequenceStrings; //sequenceString -> list of names.  "atgc...." -> seq1,seq2,seq3.
-        map<string, string>::iterator itStrings;
-        set<string> nameInFastaFile; //for sanity checking
-        set<string>::iterator itname;
-        vector<string> nameFileOrder;
+        UniqueSeqsTable uniqueSeqs(processors); //sequenceString -> unique, numbered in the order they are found
+        UniqueSeqsTable uniqueNames(processors); //for sanity checking
+        
+        //the names of each unique are a list through the reads, the names are stored one after another in keys
+        string keys; vector<unsigned long long> keyStarts;
+        vector<int> nextRead;
+        vector<int> firstRead, lastRead;
         
         int count = 0;
         while (!in.eof()) {
             
             if (m->getControl_pressed()) { break; }
             
-            Sequence seq(in); gobble(in);
+            vector<Sequence> seqs; vector<string> seqStrings, seqNames;
+            readBatch(in, seqs, seqStrings, seqNames);
             
-            if (seq.getName() != "") { //not end of file
+            vector<int> ids, nameIds; vector<bool> isNew, isNewName;
+            uniqueSeqs.add(seqStrings, ids, isNew);
+            uniqueNames.add(seqNames, nameIds, isNewName);
+            
+            for (int i = 0; i < seqs.size(); i++) {
+                
+                if (m->getControl_pressed()) { break; }
                 
                 //sanity checks
-                itname = nameInFastaFile.find(seq.getName());
-                if (itname == nameInFastaFile.end()) { nameInFastaFile.insert(seq.getName());  }
-                else { m->mothurOut("[ERROR]: You already have a sequence named " + seq.getName() + " in your fasta file, sequence names must be unique, please correct.\n");  }
+                if (!isNewName[i]) { m->mothurOut("[ERROR]: You already have a sequence named " + seqNames[i] + " in your fasta file, sequence names must be unique, please correct.\n");  }
                 
-                string key = seq.getName();
+                int read = keyStarts.size();
+                keyStarts.push_back(keys.length()); nextRead.push_back(-1);
                 
                 if (namefile != "") {
-                    itNames = nameMap.find(seq.getName());
+                    itNames = nameMap.find(seqNames[i]);
                     
                     if (itNames == nameMap.end()) { //namefile and fastafile do not match
-                        m->mothurOut("[ERROR]: " + seq.getName() + " is in your fasta file, and not in your namefile, please correct.\n");
-                    }else { key = itNames->second;  }
-                }
-
-                itStrings = sequenceStrings.find(seq.getAligned());
+                        m->mothurOut("[ERROR]: " + seqNames[i] + " is in your fasta file, and not in your namefile, please correct.\n");
+                        keys += seqNames[i];
+                    }else { keys += itNames->second;  }
+                }else { keys += seqNames[i]; }
                 
-                if (itStrings == sequenceStrings.end()) { //this is a new unique sequence
-                    
-                    seq.printSequence(outFasta); //output to unique fasta file
+                if (isNew[i]) { //this is a new unique sequence
                     
-                    //add new unique sequence to seqStrings
-                    sequenceStrings[seq.getAligned()] = key;    nameFileOrder.push_back(seq.getAligned());
+                    seqs[i].printSequence(outFasta); //output to unique fasta file
+                    firstRead.push_back(read); lastRead.push_back(read);
                     
                 }else { //this is a dup
-                     sequenceStrings[seq.getAligned()] += "," + key;
+                    nextRead[lastRead[ids[i]]] = read; lastRead[ids[i]] = read;
                 }
                 count++;
+                
+                if(count % 1000 == 0)    { m->mothurOutJustToScreen(toString(count) + "\t" + toString(firstRead.size()) + "\n");    }
             }
-            
-            
-            if(count % 1000 == 0)    { m->mothurOutJustToScreen(toString(count) + "\t" + toString(sequenceStrings.size()) + "\n");    }
         }
+        keyStarts.push_back(keys.length());
         
-        if(count % 1000 != 0)    { m->mothurOut(toString(count) + "\t" + toString(sequenceStrings.size())); m->mothurOutEndLine();    }
+        if(count % 1000 != 0)    { m->mothurOut(toString(count) + "\t" + toString(firstRead.size())); m->mothurOutEndLine();    }
         
         in.close(); outFasta.close();
         if (m->getControl_pressed()) {  return outFastaFile;  }
@@ -401,22 +410,23 @@ string UniqueSeqsCommand::processName(string namefile) { //namefile can be blank
         ofstream outNames; util.openOutputFile(outNameFile, outNames);
         outputNames.push_back(outNameFile); outputTypes["name"].push_back(outNameFile);
          
-        for (int i = 0; i < nameFileOrder.size(); i++) {
+        for (int i = 0; i < firstRead.size(); i++) {
             if (m->getControl_pressed()) { break; }
             
-            itStrings = sequenceStrings.find(nameFileOrder[i]);
+            string names = "";
+            for (int read = firstRead[i]; read != -1; read = nextRead[read]) {
+                if (names != "") { names += ","; }
+                names.append(keys, keyStarts[read], keyStarts[read+1]-keyStarts[read]);
+            }
             
-            if (itStrings != sequenceStrings.end()) {
-                //get rep name
-                int pos = (itStrings->second).find_first_of(',');
-                
-                if (pos == string::npos) { // only reps itself
-                    outNames << itStrings->second << '\t' << itStrings->second << endl;
-                }else {
-                    outNames << (itStrings->second).substr(0, pos) << '\t' << itStrings->second << endl;
-                }
-                
-            }else{ m->mothurOut("[ERROR]: mismatch in namefile print.\n");  m->setControl_pressed(true); }
+            //get rep name
+            int pos = names.find_first_of(',');
+            
+            if (pos == string::npos) { // only reps itself
+                outNames << names << '\t' << names << endl;
+            }else {
+                outNames << names.substr(0, pos) << '\t' << names << endl;
+            }
         }
         outNames.close();
         
@@ -430,6 +440,26 @@ string UniqueSeqsCommand::processName(string namefile) { //namefile can be blank
     }
 }
 /**************************************************************************************/
+//reads the next UNIQUE_BATCH_SIZE sequences
+void UniqueSeqsCommand::readBatch(ifstream& in, vector<Sequence>& seqs, vector<string>& seqStrings, vector<string>& seqNames) {
+    try {
+        while ((seqs.size() < UNIQUE_BATCH_SIZE) && !in.eof()) {
+            
+            if (m->getControl_pressed()) { break; }
+            
+            Sequence seq(in); gobble(in);
+            
+            if (seq.getName() != "") { //not end of file
+                seqs.push_back(seq); seqStrings.push_back(seq.getAligned()); seqNames.push_back(seq.getName());
+            }
+        }
+    }
+    catch(exception& e) {
+        m->errorOut(e, "UniqueSeqsCommand", "readBatch");
+        exit(1);
+    }
+}
+/**************************************************************************************/
 string UniqueSeqsCommand::createNewNameFile(string countfile, map<string, int> nameMap) { //namefile can be blank, indicating no namefile provided
     try {
         map<string, string> variables;
@@ -12,6 +12,10 @@
 #include "command.hpp"
 #include "fastamap.h"
 #include "counttable.h"
+#include "uniqueseqstable.hpp"
+#include "sequence.hpp"
+
+#define UNIQUE_BATCH_SIZE 10000
 
 /* The unique.seqs command reads a fasta file, finds the duplicate sequences and outputs a names file
 	containing 2 columns.  The first being the groupname and the second the list of identical sequence names. */ 
@@ -42,10 +46,12 @@ private:
 	vector<string> outputNames;
 
 	bool abort;
+    int processors;
     
     string processName(string); //not recommended
     string processCount(string);
     string createNewNameFile(string, map<string, int>);
+    void readBatch(ifstream&, vector<Sequence>&, vector<string>&, vector<string>&);
 };
 
 #endif
@@ -77,22 +77,22 @@ void Alignment::traceBack(bool createBaseMap){			//	This traceback routine is us
 		//	seqAstart = 1;
 		//	seqAend = column;
 		
-		AlignmentCell currentCell = alignment[row][column];	//	Start the traceback from the bottom-right corner of the
+		char prevCell = getPrevCell(row, column);	//	Start the traceback from the bottom-right corner of the
 		//	matrix
 		
-		if(currentCell.prevCell == 'x'){	seqAaln = seqBaln = "NOALIGNMENT";		}//If there's an 'x' in the bottom-
+		if(prevCell == 'x'){	seqAaln = seqBaln = "NOALIGNMENT";		}//If there's an 'x' in the bottom-
 		else{	//	right corner bail out because it means nothing got aligned
             int count = 0;
-			while(currentCell.prevCell != 'x'){				//	while the previous cell isn't an 'x', keep going...
+			while(prevCell != 'x'){				//	while the previous cell isn't an 'x', keep going...
 				
-				if(currentCell.prevCell == 'u'){			//	if the pointer to the previous cell is 'u', go up in the
+				if(prevCell == 'u'){			//	if the pointer to the previous cell is 'u', go up in the
 					seqAaln = '-' + seqAaln;				//	matrix.  this indicates that we need to insert a gap in
 					seqBaln = seqB[row] + seqBaln;			//	seqA and a base in seqB
                     if (createBaseMap) { BBaseMap[row] = count; }
 					//currentCell = alignment[--row][column];
                     --row;
 				}
-				else if(currentCell.prevCell == 'l'){		//	if the pointer to the previous cell is 'l', go to the left
+				else if(prevCell == 'l'){		//	if the pointer to the previous cell is 'l', go to the left
 					seqBaln = '-' + seqBaln;				//	in the matrix.  this indicates that we need to insert a gap
 					seqAaln = seqA[column] + seqAaln;		//	in seqB and a base in seqA
                     if (createBaseMap) { ABaseMap[column] = count; }
@@ -109,7 +109,7 @@ void Alignment::traceBack(bool createBaseMap){			//	This traceback routine is us
 					//currentCell = alignment[--row][--column];
                     --row; --column;
 				}
-                if ((row >= 0) && (column >= 0)) { currentCell = alignment[row][column]; }
+                if ((row >= 0) && (column >= 0)) { prevCell = getPrevCell(row, column); }
                 else { break; }
                 count++;
 			}
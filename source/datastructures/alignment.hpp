@@ -48,6 +48,7 @@ public:
 protected:
     
 	void traceBack(bool createBaseMap);
+	virtual char getPrevCell(int row, int column) { return alignment[row][column].prevCell; } //banded aligners do not keep the full matrix
     void proteinTraceBack(vector<string>, vector<AminoAcid>);
 	string seqA, seqAaln;
 	string seqB, seqBaln;
@@ -24,35 +24,48 @@ AlignmentDB::AlignmentDB(string fastaFileName, string s, int kmerSize, float gap
         
         long start = time(nullptr);
         m->mothurOut("\nReading in the " + fastaFileName + " template sequences...\t");	cout.flush();
-        //bool aligned = false;
-        int tempLength = 0;
         
-        ifstream fastaFile; util.openInputFile(fastaFileName, fastaFile);
+        //the index has the templates and their kmers, so the fasta file is only read if it doesn't exist or is out of date
+        referenceIndex = nullptr;
+        if (method == "kmer") {
+            referenceIndex = new ReferenceIndex(fastaFileName, kmerSize);
+            if (!referenceIndex->open()) { delete referenceIndex; referenceIndex = nullptr; }
+        }
         
-        while (!fastaFile.eof()) {
-            Sequence temp(fastaFile);  gobble(fastaFile);
+        if (referenceIndex != nullptr) {
+            numSeqs = referenceIndex->getNumSeqs();
+            longest = referenceIndex->getLongest();
+        }else {
+            //bool aligned = false;
+            int tempLength = 0;
             
-            if (m->getControl_pressed()) {  templateSequences.clear(); break;  }
+            ifstream fastaFile; util.openInputFile(fastaFileName, fastaFile);
             
-            if (temp.getName() != "") {
-                templateSequences.push_back(temp);
+            while (!fastaFile.eof()) {
+                Sequence temp(fastaFile);  gobble(fastaFile);
                 
-                //save longest base
-                if (temp.getUnaligned().length() >= longest)  { longest = ((int)temp.getUnaligned().length()+1); }
+                if (m->getControl_pressed()) {  templateSequences.clear(); break;  }
                 
-                if (tempLength != 0) {
-                    if (tempLength != temp.getAligned().length()) { m->mothurOut("[ERROR]: template is not aligned, aborting.\n"); m->setControl_pressed(true); }
-                }else { tempLength = (int)temp.getAligned().length(); }
+                if (temp.getName() != "") {
+                    templateSequences.push_back(temp);
+                    
+                    //save longest base
+                    if (temp.getUnaligned().length() >= longest)  { longest = ((int)temp.getUnaligned().length()+1); }
+                    
+                    if (tempLength != 0) {
+                        if (tempLength != temp.getAligned().length()) { m->mothurOut("[ERROR]: template is not aligned, aborting.\n"); m->setControl_pressed(true); }
+                    }else { tempLength = (int)temp.getAligned().length(); }
+                }
             }
+            fastaFile.close();
+            
+            numSeqs = (int)templateSequences.size();
         }
-        fastaFile.close();
-        
-        numSeqs = (int)templateSequences.size();
         //all of this is elsewhere already!
         
         m->mothurOut("DONE.\n");
         cout.flush();
-        m->mothurOut("It took " + toString(time(nullptr) - start) + " to read  " + toString(templateSequences.size()) + " sequences.\n");   
+        m->mothurOut("It took " + toString(time(nullptr) - start) + " to read  " + toString(numSeqs) + " sequences.\n");   
 
 		
 		//in case you delete the seqs and then ask for them
@@ -70,7 +83,8 @@ AlignmentDB::AlignmentDB(string fastaFileName, string s, int kmerSize, float gap
             
             ifstream kmerFileTest(kmerDBName.c_str());
 				
-            if(kmerFileTest){
+            if (referenceIndex != nullptr) { ((KmerDB*)search)->setIndex(referenceIndex); needToGenerate = false; }
+            else if(kmerFileTest){
                 string line = util.getline(kmerFileTest);
                 bool GoodFile = util.checkReleaseVersion(line, current->getVersion());  kmerFileTest.close();
                 int shortcutTimeStamp = util.getTimeStamp(kmerDBName);
@@ -91,7 +105,16 @@ AlignmentDB::AlignmentDB(string fastaFileName, string s, int kmerSize, float gap
 		}
 		
 		if (!m->getControl_pressed()) {
-			if (needToGenerate) {
+			//make the index for the next run from the templates read this time, the postings are made from them too so they are numbered the same
+			ReferenceIndex* newIndex = nullptr;
+			if ((method == "kmer") && (referenceIndex == nullptr) && (writeShortcut)) {
+				newIndex = new ReferenceIndex(fastaFileName, kmerSize);
+				for (int i = 0; i < templateSequences.size(); i++) { newIndex->addSequence(templateSequences[i]); }
+				needToGenerate = true;
+			}
+			
+			if (referenceIndex != nullptr) { } //searching the index
+			else if (needToGenerate) {
 				//add sequences to search 
 				for (int i = 0; i < templateSequences.size(); i++) {
 					search->addSequence(templateSequences[i]);
@@ -107,6 +130,8 @@ AlignmentDB::AlignmentDB(string fastaFileName, string s, int kmerSize, float gap
 				ifstream kmerFileTest(kmerDBName.c_str());
 				search->readDB(kmerFileTest);
 			}
+			
+			if (newIndex != nullptr) { ((KmerDB*)search)->writeIndex(newIndex); delete newIndex; }
 		
 			search->setNumSeqs(numSeqs);
 		}
@@ -122,6 +147,7 @@ AlignmentDB::AlignmentDB(string s){
 	try {											
 		m = MothurOut::getInstance();
 		method = s;
+		referenceIndex = nullptr;
 		
 		if(method == "suffix")		{	search = new SuffixDB();	}
 		else						{	search = new KmerDB();		}
@@ -148,7 +174,11 @@ Sequence AlignmentDB::findClosestSequence(Sequence* seq, float& searchScore) con
         vector<float> scores;
 		vector<int> spot = search->findClosestSequences(seq, 1, scores);
 	
-        if (spot.size() != 0)	{	searchScore = scores[0]; return templateSequences[spot[0]];	}
+        if (spot.size() != 0)	{
+            searchScore = scores[0];
+            if (referenceIndex != nullptr) { return referenceIndex->getSequence(spot[0]); }
+            return templateSequences[spot[0]];
+        }
         else					{ 	searchScore = 0; return emptySequence;                      }
 		
 	}
@@ -15,6 +15,7 @@
 #include "searchdatabase.hpp"
 #include "utils.hpp"
 #include "currentfile.h"
+#include "referenceindex.hpp"
 
 /**************************************************************************************************/
 
@@ -35,6 +36,7 @@ private:
 	
     SearchDatabase* search;
 	vector<Sequence> templateSequences;
+	ReferenceIndex* referenceIndex; //holds the templates instead of templateSequences if the reference has an index, the kmer database deletes it
 	Sequence emptySequence;
 	MothurOut* m;
     CurrentFile* current;
@@ -490,11 +490,13 @@ SharedRAbundVectors* BiomSimple::extractOTUData(string line, vector<string>& gro
         SharedRAbundVectors* lookup = new SharedRAbundVectors();
         
         //creates new sharedRAbunds
+        vector<SharedRAbundVector*> samples;
         for (int i = 0; i < groupNames.size(); i++) {
-            SharedRAbundVector* temp = new SharedRAbundVector(numOTUs); //sets all abunds to 0
+            SharedRAbundVector* temp = new SharedRAbundVector(numOTUs, (matrixFormat == "sparse")); //sets all abunds to 0
             temp->setLabel(label);
             temp->setGroup(groupNames[i]);
             lookup->push_back(temp);
+            samples.push_back(temp);
         }
         
         if (matrixElementType == "float") {
@@ -590,6 +592,8 @@ SharedRAbundVectors* BiomSimple::extractOTUData(string line, vector<string>& gro
             }
         }
         
+        for (int i = 0; i < samples.size(); i++) {  samples[i]->fitStorage();  }
+        
         return lookup;
     }
     catch(exception& e) {
@@ -685,16 +689,16 @@ void BiomSimple::print(string filename, vector<string> sampleMetadata, Picrust*
              ]*/
             
             if (matrixElementType == "int") {
+                //only nonzero values are printed, so read them by otu from the samples' stored bins
+                vector<long long> otuStarts; vector<int> otuGroups, otuAbunds;
+                shared->getColumns(otuStarts, otuGroups, otuAbunds);
+                
                 for (int i = 0; i < shared->getNumBins(); i++) {
                 
                     if (m->getControl_pressed()) { out.close(); return; }
-                    vector<int> binAbunds = shared->getOTU(i);
                 
-                    for (int j = 0; j < binAbunds.size(); j++) {
-                        int abund = binAbunds[j];
-                        string binInfo = "[" + toString(i) + "," + toString(j) + "," + toString(abund) + "]";
-                        //only print non zero values
-                        if (abund != 0) { dataRows.push_back(binInfo); }
+                    for (long long j = otuStarts[i]; j < otuStarts[i+1]; j++) {
+                        dataRows.push_back("[" + toString(i) + "," + toString(otuGroups[j]) + "," + toString(otuAbunds[j]) + "]");
                     }
                 }
             }else {
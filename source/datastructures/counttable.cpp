@@ -9,6 +9,15 @@
 #include "counttable.h"
 #include "groupmap.h"
 
+#ifdef NON_WINDOWS
+#include <sys/mman.h>
+#include <fcntl.h>
+#endif
+
+#define COUNTTABLE_BINARY_MAGIC "MOTHCNTB"
+#define COUNTTABLE_BINARY_VERSION 2
+#define COUNTTABLE_BINARY_BYTEORDER 0x01020304
+
 /************************************************************/
 //used by tree commands
 int CountTable::createTable(map<string, string>& g) {
@@ -40,8 +49,8 @@ int CountTable::createTable(set<string>& n, map<string, string>& g, set<string>&
         groups.clear();
         totalGroups.clear();
         indexGroupMap.clear();
-        indexNameMap.clear();
-        counts.clear();
+        clearNames();
+        clearRows();
         for (set<string>::iterator it = gs.begin(); it != gs.end(); it++) { string gName = *it; util.checkGroupName(gName); groups.push_back(gName);  hasGroups = true; }
         numGroups = groups.size();
         totalGroups.resize(numGroups, 0);
@@ -74,11 +83,9 @@ int CountTable::createTable(set<string>& n, map<string, string>& g, set<string>&
                 m->mothurOut("[ERROR]: Your group file does not contain " + seqName + ". Please correct.\n");
             }
 
-            map<string, int>::iterator it2 = indexNameMap.find(seqName);
-            if (it2 == indexNameMap.end()) {
-                if (hasGroups) { counts.push_back(groupCounts); }
-                indexNameMap[seqName] = uniques;
-                totals.push_back(1);
+            if (findRow(seqName) == -1) {
+                if (!hasGroups) { groupCounts.clear(); }
+                addRow(seqName, groupCounts, 1);
                 total++;
                 uniques++;
             }else {
@@ -186,8 +193,8 @@ int CountTable::createTable(string namefile, string groupfile, vector<string> se
         groups.clear();
         totalGroups.clear();
         indexGroupMap.clear();
-        indexNameMap.clear();
-        counts.clear();
+        clearNames();
+        clearRows();
         map<int, string> originalGroupIndexes;
         uniques = 0;
         total = 0;
@@ -269,12 +276,10 @@ int CountTable::createTable(string namefile, string groupfile, vector<string> se
                     
                 }
                 
-                map<string, int>::iterator it = indexNameMap.find(firstCol);
-                if (it == indexNameMap.end()) {
+                if (findRow(firstCol) == -1) {
                     
-                    if (hasGroups) {  counts.push_back(thisGroupsCount);  }
-                    indexNameMap[firstCol] = uniques;
-                    totals.push_back(thisTotal);
+                    if (!hasGroups) {  thisGroupsCount.clear();  }
+                    addRow(firstCol, thisGroupsCount, thisTotal);
                     total += thisTotal;
                     uniques++;
                     
@@ -296,12 +301,9 @@ int CountTable::createTable(string namefile, string groupfile, vector<string> se
                 intPair thisAbund(1, groupIndex);
                 abunds.push_back(thisAbund);
                 
-                map<string, int>::iterator it = indexNameMap.find(names[i]);
-                if (it == indexNameMap.end()) {
+                if (findRow(names[i]) == -1) {
                     
-                    counts.push_back(abunds);
-                    indexNameMap[names[i]] = uniques;
-                    totals.push_back(1);
+                    addRow(names[i], abunds, 1);
                     total++;
                     uniques++;
                     
@@ -336,8 +338,8 @@ int CountTable::readTable(string file, string format) {
         groups.clear();
         totalGroups.clear();
         indexGroupMap.clear();
-        indexNameMap.clear();
-        counts.clear();
+        clearNames();
+        clearRows();
         bool error = false;
         uniques = 0;
         total = 0;
@@ -354,10 +356,8 @@ int CountTable::readTable(string file, string format) {
                 string name = seq.getName();
                 if (m->getDebug()) { m->mothurOut("[DEBUG]: " + name + '\t' + toString(1) + "\n"); }
 
-                map<string, int>::iterator it = indexNameMap.find(name);
-                if (it == indexNameMap.end()) {
-                    indexNameMap[name] = uniques;
-                    totals.push_back(1);
+                if (findRow(name) == -1) {
+                    addRow(name, vector<intPair>(), 1);
                     total ++;
                     uniques++;
                 }else {
@@ -375,8 +375,7 @@ int CountTable::readTable(string file, string format) {
             for (map<string, int>::iterator it = nameFileCounts.begin(); it != nameFileCounts.end(); it++){
                 if (m->getControl_pressed()) { break; }
                 
-                indexNameMap[it->first] = uniques;
-                totals.push_back(it->second);
+                addRow(it->first, vector<intPair>(), it->second);
                 total += it->second;
                 uniques++;
             }
@@ -452,6 +451,8 @@ bool CountTable::isCountTable(string file) {
 int CountTable::readTable(string file, bool readGroups, bool mothurRunning, vector<string> selectedGroups) {
     try {
         filename = file;
+        if (readBinaryTable(filename, readGroups, mothurRunning, selectedGroups)) { return 0; }
+        
         ifstream in; util.openInputFile(filename, in);
         
         readTable(in, readGroups, mothurRunning, selectedGroups);
@@ -497,8 +498,8 @@ int CountTable::readTable(ifstream& in, bool readGroups, bool mothurRunning, vec
         groups.clear();
         totalGroups.clear();
         indexGroupMap.clear();
-        indexNameMap.clear();
-        counts.clear();
+        clearNames();
+        clearRows();
         map<int, string> originalGroupIndexes;
         if ((columnHeaders.size() > 2) && readGroups) { hasGroups = true; numGroupsInFile = columnHeaders.size() - 2;  }
         
@@ -625,17 +626,15 @@ int CountTable::readTable(ifstream& in, bool readGroups, bool mothurRunning, vec
                 }
             }
             
-            map<string, int>::iterator it = indexNameMap.find(name);
-            if (it == indexNameMap.end()) {
+            if (findRow(name) == -1) {
                 bool saveSeq = true;
+                vector<intPair> thisGroupsCount;
                 if (hasGroups && readGroups) {
-                    vector<intPair> thisGroupsCount = compressAbunds(groupCounts);
+                    thisGroupsCount = compressAbunds(groupCounts);
                     if (thisGroupsCount.size() == 0) {  saveSeq = false; }
-                    else { counts.push_back(thisGroupsCount); }
                 }
                 if (saveSeq) {
-                    indexNameMap[name] = uniques;
-                    totals.push_back(thisTotal);
+                    addRow(name, thisGroupsCount, thisTotal);
                     total += thisTotal;
                     uniques++;
                 }
@@ -701,8 +700,8 @@ int CountTable::readTable(string file, bool readGroups, bool mothurRunning, unor
         groups.clear();
         totalGroups.clear();
         indexGroupMap.clear();
-        indexNameMap.clear();
-        counts.clear();
+        clearNames();
+        clearRows();
         map<int, string> originalGroupIndexes;
         if ((columnHeaders.size() > 2) && readGroups) { hasGroups = true; numGroupsInFile = columnHeaders.size() - 2;  }
         
@@ -742,8 +741,7 @@ int CountTable::readTable(string file, bool readGroups, bool mothurRunning, unor
             }
             
             bool saveSeq = true;
-            map<string, int>::iterator it = indexNameMap.find(name);
-            if (it == indexNameMap.end()) {
+            if (findRow(name) == -1) {
                 if (selectedSeqs.count(name) == 0) { saveSeq = false; }
             }else {
                 error = true;
@@ -781,12 +779,9 @@ int CountTable::readTable(string file, bool readGroups, bool mothurRunning, unor
             }
             
             if (saveSeq) {
-                if (hasGroups && readGroups) {
-                    vector<intPair> thisGroupsCount = compressAbunds(groupCounts);
-                    counts.push_back(thisGroupsCount);
-                }
-                indexNameMap[name] = uniques;
-                totals.push_back(thisTotal);
+                vector<intPair> thisGroupsCount;
+                if (hasGroups && readGroups) { thisGroupsCount = compressAbunds(groupCounts); }
+                addRow(name, thisGroupsCount, thisTotal);
                 total += thisTotal;
                 uniques++;
             }
@@ -820,11 +815,10 @@ int CountTable::readTable(string file, bool readGroups, bool mothurRunning, unor
 int CountTable::zeroOutTable() {
   try {
 
-		for(int i=0;i<counts.size();i++){
-			for(int j=0;j<counts[0].size();j++){
-                counts[j].clear();
-			}
-		}
+		cells.clear();
+		rowStarts.assign(rowStarts.size(), 0);
+		rowSizes.assign(rowSizes.size(), 0);
+		unusedCells = 0;
 
 		totals.assign(totals.size(), 0);
 
@@ -843,10 +837,9 @@ int CountTable::clearTable() {
         total = 0;
         uniques = 0;
         groups.clear();
-        counts.clear();
-        totals.clear();
+        clearRows();
         totalGroups.clear();
-        indexNameMap.clear();
+        clearNames();
         indexGroupMap.clear();
         
         return 0;
@@ -874,23 +867,21 @@ vector<string> CountTable::printTable(string file) {
         util.openOutputFile(file, out);
         
         vector<string> namesInTable;
+        vector<int> printedRows;
         
         if (total != 0) {
             printHeaders(out);
             
-            map<int, string> reverse; //use this to preserve order
-            for (map<string, int>::iterator it = indexNameMap.begin(); it !=indexNameMap.end(); it++) { reverse[it->second] = it->first;  }
-            
-            for (int i = 0; i < totals.size(); i++) {
+            for (int i = 0; i < totals.size(); i++) { //rows are in the original order
                 if (totals[i] != 0) {
 
-                    map<int, string>::iterator itR = reverse.find(i);
-                
-                    if (itR != reverse.end()) {
+                    if (rowNames[i] != -1) {
                         
-                        namesInTable.push_back(itR->second);
+                        string seqName = getName(rowNames[i]);
+                        namesInTable.push_back(seqName);
+                        printedRows.push_back(i);
                         
-                        out << itR->second << '\t' << totals[i];
+                        out << seqName << '\t' << totals[i];
                         
                         if (hasGroups) { printGroupAbunds(out, i); }
                         
@@ -900,6 +891,9 @@ vector<string> CountTable::printTable(string file) {
             }
         }
         out.close();
+        
+        printBinaryCopy(file, printedRows, false, hasGroups, (total != 0));
+        
         return namesInTable;
     }
 	catch(exception& e) {
@@ -916,29 +910,30 @@ vector<string> CountTable::printNoGroupsTable(string file) {
         util.openOutputFile(file, out);
         
         vector<string> namesInTable;
+        vector<int> printedRows;
         
         if (total != 0) {
             vector<string> headers = getHardCodedHeaders();
             out << headers[0] << '\t' << headers[1] << endl;
             
-            map<int, string> reverse; //use this to preserve order
-            for (map<string, int>::iterator it = indexNameMap.begin(); it !=indexNameMap.end(); it++) { reverse[it->second] = it->first;  }
-            
-            for (int i = 0; i < totals.size(); i++) {
+            for (int i = 0; i < totals.size(); i++) { //rows are in the original order
                 if (totals[i] != 0) {
 
-                    map<int, string>::iterator itR = reverse.find(i);
-                
-                    if (itR != reverse.end()) {
+                    if (rowNames[i] != -1) {
                         
-                        namesInTable.push_back(itR->second);
+                        string seqName = getName(rowNames[i]);
+                        namesInTable.push_back(seqName);
+                        printedRows.push_back(i);
                         
-                        out << itR->second << '\t' << totals[i] << endl;
+                        out << seqName << '\t' << totals[i] << endl;
                     }
                 }
             }
         }
         out.close();
+        
+        printBinaryCopy(file, printedRows, false, false, (total != 0));
+        
         return namesInTable;
     }
     catch(exception& e) {
@@ -964,23 +959,21 @@ vector<string> CountTable::printTable(string file, bool compressedFormat) {
         util.openOutputFile(file, out);
         
         vector<string> namesInTable;
+        vector<int> printedRows;
         
         if (total != 0) {
             printHeaders(out);
             
-            map<int, string> reverse; //use this to preserve order
-            for (map<string, int>::iterator it = indexNameMap.begin(); it !=indexNameMap.end(); it++) { reverse[it->second] = it->first;  }
-            
-            for (int i = 0; i < totals.size(); i++) {
+            for (int i = 0; i < totals.size(); i++) { //rows are in the original order
                 
                 if (totals[i] != 0) {
                     
-                    map<int, string>::iterator itR = reverse.find(i);
-                    
-                    if (itR != reverse.end()) {
-                        namesInTable.push_back(itR->second);
+                    if (rowNames[i] != -1) {
+                        string seqName = getName(rowNames[i]);
+                        namesInTable.push_back(seqName);
+                        printedRows.push_back(i);
                         
-                        out << itR->second << '\t' << totals[i];
+                        out << seqName << '\t' << totals[i];
                         
                         if (hasGroups) { printGroupAbunds(out, i); }
                         
@@ -990,6 +983,9 @@ vector<string> CountTable::printTable(string file, bool compressedFormat) {
             }
         }
         out.close();
+        
+        printBinaryCopy(file, printedRows, false, hasGroups, (total != 0));
+        
         return namesInTable;
     }
     catch(exception& e) {
@@ -1004,48 +1000,50 @@ vector<string> CountTable::printCompressedTable(string file, vector<string> grou
         ofstream out; util.openOutputFile(file, out);
         
         vector<string> namesInTable;
+        vector<int> printedRows;
         bool pickedGroups = false;
         if (groupsToPrint.size() != 0) { if (hasGroups) { pickedGroups = true; } } //if no groups selected, print all groups
         
+        //the headers remove empty groups after listing their indexes, so the binary copy would not match a re-read of the text
+        bool writeBinary = !pickedGroups && (total != 0);
+        for (int i = 0; i < totalGroups.size(); i++) { if (totalGroups[i] == 0) { writeBinary = false; } }
+        
         set<int> selectedGroupsIndicies = printCompressedHeaders(out, groupsToPrint);
         
         if (total != 0) {
             
-            map<int, string> reverse; //use this to preserve order
-            for (map<string, int>::iterator it = indexNameMap.begin(); it !=indexNameMap.end(); it++) { reverse[it->second] = it->first;  }
-            
-            for (int i = 0; i < totals.size(); i++) {
+            for (int i = 0; i < totals.size(); i++) { //rows are in the original order
                 if (totals[i] != 0) {
+                    intPair* row = getCells(i);
                     if (pickedGroups) {
                         string groupOutput = "";
                         long long thisTotal = 0;
-                        for (int j = 0; j < counts[i].size(); j++) {
-                            if (selectedGroupsIndicies.count(counts[i][j].group) != 0) { //this is a group we want
-                                groupOutput += '\t' + toString(counts[i][j].group+1) + ',' + toString(counts[i][j].abund);
-                                thisTotal += counts[i][j].abund;
+                        for (int j = 0; j < rowSizes[i]; j++) {
+                            if (selectedGroupsIndicies.count(row[j].group) != 0) { //this is a group we want
+                                groupOutput += '\t' + toString(row[j].group+1) + ',' + toString(row[j].abund);
+                                thisTotal += row[j].abund;
                             }
                         }
                         
                         if (thisTotal != 0) {
-                            map<int, string>::iterator itR = reverse.find(i);
-                            
-                            if (itR != reverse.end()) {
-                                namesInTable.push_back(itR->second);
+                            if (rowNames[i] != -1) {
+                                string seqName = getName(rowNames[i]);
+                                namesInTable.push_back(seqName);
                                 
-                                out << itR->second << '\t' << thisTotal << groupOutput << endl;
+                                out << seqName << '\t' << thisTotal << groupOutput << endl;
                             }
                         }
                     }
                     else {
-                        map<int, string>::iterator itR = reverse.find(i);
-                        
-                        if (itR != reverse.end()) {
-                            namesInTable.push_back(itR->second);
+                        if (rowNames[i] != -1) {
+                            string seqName = getName(rowNames[i]);
+                            namesInTable.push_back(seqName);
+                            printedRows.push_back(i);
                             
-                            out << itR->second << '\t' << totals[i];
+                            out << seqName << '\t' << totals[i];
                             if (hasGroups) {
-                                for (int j = 0; j < counts[i].size(); j++) {
-                                    out  << '\t' << counts[i][j].group+1 << ',' << counts[i][j].abund;
+                                for (int j = 0; j < rowSizes[i]; j++) {
+                                    out  << '\t' << row[j].group+1 << ',' << row[j].abund;
                                 }
                             }
                             out << endl;
@@ -1056,6 +1054,8 @@ vector<string> CountTable::printCompressedTable(string file, vector<string> grou
         }
         out.close();
         
+        printBinaryCopy(file, printedRows, hasGroups, hasGroups, writeBinary);
+        
         return namesInTable;
     }
     catch(exception& e) {
@@ -1071,10 +1071,11 @@ int CountTable::find(int seq, int group, bool returnNext) {
         //if (!returnNext) { return find(seq, group); }
         int index = -1;
         
-        for (int i = 0; i < counts[seq].size(); i++) {
-            if (counts[seq][i].group >= group) { //found it or done looking
+        intPair* row = getCells(seq);
+        for (int i = 0; i < rowSizes[seq]; i++) {
+            if (row[i].group >= group) { //found it or done looking
                 
-                if (counts[seq][i].group == group) { index = i;  }
+                if (row[i].group == group) { index = i;  }
                 break;
             }
         }
@@ -1092,7 +1093,7 @@ int CountTable::getAbund(int seq, int group) {
         int index = find(seq, group, false);
         
         if (index != -1) { //this seq has a non zero abundance for this group
-            return counts[seq][index].abund;
+            return getCells(seq)[index].abund;
         }
         
         return 0;
@@ -1124,8 +1125,9 @@ vector<int> CountTable::expandAbunds(int index) {
         vector<int> abunds; abunds.resize(groups.size(), 0); //prefill with 0's
         
         
-        for (int i = 0; i < counts[index].size(); i++) { //for each non zero entry
-            abunds[counts[index][i].group] = counts[index][i].abund; //set abund for group
+        intPair* row = getCells(index);
+        for (int i = 0; i < rowSizes[index]; i++) { //for each non zero entry
+            abunds[row[i].group] = row[i].abund; //set abund for group
         }
         
         return abunds;
@@ -1183,13 +1185,16 @@ vector<string> CountTable::printSortedTable(string file) {
         printHeaders(out);
         
         vector<string> namesInTable;
+        vector<int> printedRows;
         
-        for (map<string, int>::iterator it = indexNameMap.begin(); it !=indexNameMap.end(); it++) {
-            string seqName = it->first;
-            int index = it->second;
+        vector<int> sortedNames = getSortedNames();
+        for (int i = 0; i < sortedNames.size(); i++) {
+            string seqName = getName(sortedNames[i]);
+            int index = nameRows[sortedNames[i]];
             
             if (totals[index] != 0) {
                 namesInTable.push_back(seqName);
+                printedRows.push_back(index);
                 
                 out << seqName << '\t' << totals[index];
                 if (hasGroups) {
@@ -1200,6 +1205,8 @@ vector<string> CountTable::printSortedTable(string file) {
         }
         out.close();
         
+        printBinaryCopy(file, printedRows, false, hasGroups, true);
+        
         return namesInTable;
     }
     catch(exception& e) {
@@ -1298,14 +1305,14 @@ set<int> CountTable::printCompressedHeaders(ofstream& out, vector<string> groups
 /************************************************************/
 int CountTable::printSeq(ofstream& out, string seqName) {
     try {
-		map<string, int>::iterator it = indexNameMap.find(seqName);
-        if (it == indexNameMap.end()) {
+        int index = findRow(seqName);
+        if (index == -1) {
             m->mothurOut("[ERROR]: " + seqName + " is not in your count table. Please correct.\n"); m->setControl_pressed(true);
         }else {
-            if (totals[it->second] != 0) {
-                out << it->first << '\t' << totals[it->second];
+            if (totals[index] != 0) {
+                out << seqName << '\t' << totals[index];
                 
-                if (hasGroups) { printGroupAbunds(out, it->second); }
+                if (hasGroups) { printGroupAbunds(out, index); }
                 
                 out << endl;
             }
@@ -1320,11 +1327,11 @@ int CountTable::printSeq(ofstream& out, string seqName) {
 /************************************************************/
 int CountTable::printCompressedSeq(ofstream& out, string seqName, vector<string> groupsToPrint) {
     try {
-        map<string, int>::iterator itName = indexNameMap.find(seqName);
-        if (itName == indexNameMap.end()) {
+        int i = findRow(seqName);
+        if (i == -1) {
             m->mothurOut("[ERROR]: " + seqName + " is not in your count table. Please correct.\n"); m->setControl_pressed(true);
         }else {
-            int i = itName->second;
+            intPair* row = getCells(i);
             if (totals[i] != 0) {
                 
                 if (hasGroups) {
@@ -1347,26 +1354,26 @@ int CountTable::printCompressedSeq(ofstream& out, string seqName, vector<string>
                         
                         string groupOutput = "";
                         long long thisTotal = 0;
-                        for (int j = 0; j < counts[i].size(); j++) {
+                        for (int j = 0; j < rowSizes[i]; j++) {
                             
-                            if (selectedGroupsIndicies.count(counts[i][j].group) != 0) { //this is a group we want
-                                groupOutput += '\t' + toString(counts[i][j].group+1) + ',' + toString(counts[i][j].abund);
-                                thisTotal += counts[i][j].abund;
+                            if (selectedGroupsIndicies.count(row[j].group) != 0) { //this is a group we want
+                                groupOutput += '\t' + toString(row[j].group+1) + ',' + toString(row[j].abund);
+                                thisTotal += row[j].abund;
                             }
                         }
                         
                         if (thisTotal != 0) {
-                            out << itName->first << '\t' << thisTotal << groupOutput << endl;
+                            out << seqName << '\t' << thisTotal << groupOutput << endl;
                         }
                     }
                     else {
-                        out << itName->first << '\t' << totals[i];
+                        out << seqName << '\t' << totals[i];
                         
-                        for (int j = 0; j < counts[i].size(); j++) {
-                            out  << '\t' << counts[i][j].group+1 << ',' << counts[i][j].abund;
+                        for (int j = 0; j < rowSizes[i]; j++) {
+                            out  << '\t' << row[j].group+1 << ',' << row[j].abund;
                         }
                     }
-                }else { out << itName->first << '\t' << totals[i]; }
+                }else { out << seqName << '\t' << totals[i]; }
                 
                 out << endl;
             }
@@ -1382,9 +1389,12 @@ int CountTable::printCompressedSeq(ofstream& out, string seqName, vector<string>
 //group counts for a seq
 vector<int> CountTable::getGroupCounts(string seqName) {
     try {
-        vector<intPair> temp = getItems(seqName);
-        return (expandAbunds(temp)); 
+        countTableRow row = getRow(seqName);
+        
+        vector<int> abunds; abunds.resize(groups.size(), 0); //prefill with 0's
+        for (int i = 0; i < row.size; i++) { abunds[row.items[i].group] = row.items[i].abund; }
         
+        return abunds;
     }
 	catch(exception& e) {
 		m->errorOut(e, "CountTable", "getGroupCounts");
@@ -1392,27 +1402,27 @@ vector<int> CountTable::getGroupCounts(string seqName) {
 	}
 }
 /************************************************************/
-//group counts for a seq
-vector<intPair> CountTable::getItems(string seqName) {
+//group counts for a seq, without copying them
+countTableRow CountTable::getRow(const string& seqName) {
     try {
-        vector<intPair> temp;
+        countTableRow row;
         if (hasGroups) {
-            map<string, int>::iterator it = indexNameMap.find(seqName);
-            if (it == indexNameMap.end()) {
+            int index = findRow(seqName);
+            if (index == -1) {
                 //look for it in names of groups to see if the user accidently used the wrong file
                 if (util.inUsersGroups(seqName, groups)) {
                     m->mothurOut("[WARNING]: Your group or design file contains a group named " + seqName + ".  Perhaps you are used a group file instead of a design file? A common cause of this is using a tree file that relates your groups (created by the tree.shared command) with a group file that assigns sequences to a group.\n"); 
                 }
                 m->mothurOut("[ERROR]: " + seqName + " is not in your count table. Please correct.\n"); m->setControl_pressed(true);
             }else {
-                temp = counts[it->second];
+                row = countTableRow(getCells(index), rowSizes[index]);
             }
         }else{  m->mothurOut("[ERROR]: Your count table does not have group info. Please correct.\n"); m->setControl_pressed(true); }
         
-        return temp;
+        return row;
     }
     catch(exception& e) {
-        m->errorOut(e, "CountTable", "getGroupCounts");
+        m->errorOut(e, "CountTable", "getRow");
         exit(1);
     }
 }
@@ -1445,15 +1455,15 @@ int CountTable::getGroupCount(string seqName, string groupName) {
             if (it == indexGroupMap.end()) {
                 m->mothurOut("[ERROR]: group " + groupName + " is not in your count table. Please correct.\n"); m->setControl_pressed(true);
             }else {
-                map<string, int>::iterator it2 = indexNameMap.find(seqName);
-                if (it2 == indexNameMap.end()) {
+                int index = findRow(seqName);
+                if (index == -1) {
                     //look for it in names of groups to see if the user accidently used the wrong file
                     if (util.inUsersGroups(seqName, groups)) {
                         m->mothurOut("[WARNING]: Your group or design file contains a group named " + seqName + ".  Perhaps you are used a group file instead of a design file? A common cause of this is using a tree file that relates your groups (created by the tree.shared command) with a group file that assigns sequences to a group.\n"); 
                     }
                     m->mothurOut("[ERROR]: seq " + seqName + " is not in your count table. Please correct.\n"); m->setControl_pressed(true);
                 }else {
-                    return expandAbunds(it2->second)[it->second];
+                    return getAbund(index, it->second);
                 }
             }
         }else{  m->mothurOut("[ERROR]: Your count table does not have group info. Please correct.\n");  m->setControl_pressed(true); }
@@ -1474,29 +1484,31 @@ int CountTable::setAbund(string seqName, string groupName, int num) {
             if (it == indexGroupMap.end()) {
                 m->mothurOut("[ERROR]: " + groupName + " is not in your count table. Please correct.\n"); m->setControl_pressed(true);
             }else {
-                map<string, int>::iterator it2 = indexNameMap.find(seqName);
-                if (it2 == indexNameMap.end()) {
+                int index = findRow(seqName);
+                if (index == -1) {
                     //look for it in names of groups to see if the user accidently used the wrong file
                     if (util.inUsersGroups(seqName, groups)) {
                         m->mothurOut("[WARNING]: Your group or design file contains a group named " + seqName + ".  Perhaps you are used a group file instead of a design file? A common cause of this is using a tree file that relates your groups (created by the tree.shared command) with a group file that assigns sequences to a group.\n"); 
                     }
                     m->mothurOut("[ERROR]: " + seqName + " is not in your count table. Please correct.\n"); m->setControl_pressed(true);
                 }else {
-                    int indexOfGroup = find(it2->second, it->second, false);
+                    int indexOfGroup = find(index, it->second, false);
                     int oldCount = 0;
                     
                     if (indexOfGroup == -1) { //create item for this group
+                        vector<intPair> row(getCells(index), getCells(index)+rowSizes[index]);
                         intPair newItem(num, it->second);
-                        counts[it2->second].push_back(newItem);
-                        sortRow(it2->second);
+                        row.push_back(newItem);
+                        setRow(index, row);
+                        sortRow(index);
                     }else { //update total for group
-                        oldCount = counts[it2->second][indexOfGroup].abund;
-                        counts[it2->second][indexOfGroup].abund = num;
+                        oldCount = getCells(index)[indexOfGroup].abund;
+                        getCells(index)[indexOfGroup].abund = num;
                     }
                     
                     totalGroups[it->second] += (num - oldCount);
                     total += (num - oldCount);
-                    totals[it2->second] += (num - oldCount);
+                    totals[index] += (num - oldCount);
                 }
             }
         }else{  m->mothurOut("[ERROR]: Your count table does not have group info. Please correct.\n");  m->setControl_pressed(true); }
@@ -1515,8 +1527,7 @@ int CountTable::addGroup(string groupName) {
         bool sanity = util.inUsersGroups(groupName, groups);
         if (sanity) { m->mothurOut("[ERROR]: " + groupName + " is already in the count table, cannot add again.\n"); m->setControl_pressed(true);  return 0; }
 
-        groups.push_back(groupName);
-        if (!hasGroups) { counts.resize(uniques);  }
+        groups.push_back(groupName); //rows without groups are already empty
         
         totalGroups.push_back(0);
         indexGroupMap[groupName] = groups.size()-1;
@@ -1527,13 +1538,18 @@ int CountTable::addGroup(string groupName) {
 
         //fix indexGroupMap && totalGroups
         vector<int> newTotals; newTotals.resize(groups.size(), 0);
+        vector<int> newIndexes; newIndexes.resize(groups.size(), 0);
         for (int i = 0; i < groups.size(); i++) {
             indexGroupMap[groups[i]] = i;
             //find original spot of group[i]
             int index = originalGroupMap[groups[i]];
             newTotals[i] = totalGroups[index];
+            newIndexes[index] = i;
         }
         totalGroups = newTotals;
+        
+        //the cells hold group indexes, groups after the new one move down one. The order within a row is unchanged
+        for (int i = 0; i < cells.size(); i++) { if (cells[i].group != -1) { cells[i].group = newIndexes[cells[i].group]; } }
 
         hasGroups = true;
 
@@ -1549,12 +1565,7 @@ int CountTable::addGroup(string groupName) {
 int CountTable::removeGroup(string groupName) {
     try {
         if (hasGroups) {
-            //save for later in case removing a group means we need to remove a seq.
-            map<int, string> reverse;
-            map<string, int>::iterator it;
-            for (it = indexNameMap.begin(); it !=indexNameMap.end(); it++) { reverse[it->second] = it->first;  }
-            
-            it = indexGroupMap.find(groupName);
+            map<string, int>::iterator it = indexGroupMap.find(groupName);
             if (it == indexGroupMap.end()) {
                 m->mothurOut("[ERROR]: " + groupName + " is not in your count table. Please correct.\n"); m->setControl_pressed(true);
             }else {
@@ -1571,47 +1582,39 @@ int CountTable::removeGroup(string groupName) {
                 groups = newGroups;
                 totalGroups.erase(totalGroups.begin()+indexOfGroupToRemove);
                 
-                int thisIndex = 0;
-                map<string, int> newIndexNameMap;
-                for (int i = 0; i < counts.size(); i++) {
-                    
-                    if (m->getControl_pressed()) { break; }
+                //rewrite the rows without the group, the cells are compacted as we go
+                vector<intPair> newCells; newCells.reserve(cells.size() - unusedCells);
+                int numRows = 0;
+                for (int i = 0; i < totals.size(); i++) {
                     
-                    int indexOfGroup = -1; bool found = false;
-                    for (int j = 0; j < counts[i].size(); j++) {
-                        if (counts[i][j].group >= indexOfGroupToRemove) { //found it or done looking
-                            
-                            indexOfGroup = j;
-                            if (counts[i][j].group == indexOfGroupToRemove) {   found = true; }
-                            break;
-                        }
+                    intPair* row = getCells(i);
+                    long long start = newCells.size();
+                    bool found = false;
+                    for (int j = 0; j < rowSizes[i]; j++) {
+                        if (row[j].group == indexOfGroupToRemove) { //you have an abundance for this group
+                            found = true;
+                            totals[i] -= row[j].abund;
+                            total -= row[j].abund;
+                        }else if (row[j].group > indexOfGroupToRemove) { newCells.push_back(intPair(row[j].abund, row[j].group-1)); }
+                        else { newCells.push_back(row[j]); }
                     }
                     
-                    if (found) { //you have an abundance for this group
-                        int num = counts[i][indexOfGroup].abund;
-                        counts[i].erase(counts[i].begin()+indexOfGroup);
-                        totals[i] -= num;
-                        total -= num;
-                        
-                        if (totals[i] == 0) { //your sequences are only from the group we want to remove, then remove you.
-                            counts.erase(counts.begin()+i);
-                            totals.erase(totals.begin()+i);
-                            uniques--;
-                            i--;
-                            if (i == -1) { i = 0; }
-                            indexOfGroup = counts[i].size(); //don't adjust the the group indexes because we removed the read
-                        }else { newIndexNameMap[reverse[thisIndex]] = i; }
-                    }else { //you don't have this group, nothing to remove
-                        
-                        if (indexOfGroup == -1) { indexOfGroup = counts[i].size(); }
-                        newIndexNameMap[reverse[thisIndex]] = i;
+                    if (found && (totals[i] == 0)) { //your sequences are only from the group we want to remove, then remove you.
+                        newCells.resize(start);
+                        if (rowNames[i] != -1) { removeName(rowNames[i]); }
+                        uniques--;
+                    }else {
+                        rowStarts[numRows] = start;
+                        rowSizes[numRows] = newCells.size() - start;
+                        totals[numRows] = totals[i];
+                        rowNames[numRows] = rowNames[i];
+                        if (rowNames[i] != -1) { nameRows[rowNames[i]] = numRows; }
+                        numRows++;
                     }
-                    
-                    for (int j = indexOfGroup; j < counts[i].size(); j++) { counts[i][j].group -= 1; }
-                    
-                    thisIndex++;
                 }
-                indexNameMap = newIndexNameMap;
+                rowStarts.resize(numRows); rowSizes.resize(numRows); totals.resize(numRows); rowNames.resize(numRows);
+                cells.swap(newCells);
+                unusedCells = 0;
                 
                 if (groups.size() == 0) { hasGroups = false; }
             }
@@ -1646,14 +1649,14 @@ int CountTable::removeGroup(int minSize){
 vector<string> CountTable::getGroups(string seqName) {
     try {
         vector<string> thisGroups;
-        map<string, int>::iterator it = indexNameMap.find(seqName);
-        if (it == indexNameMap.end()) {
+        int index = findRow(seqName);
+        if (index == -1) {
             m->mothurOut("[ERROR]: " + seqName + " is not in your count table. Please correct.\n"); m->setControl_pressed(true);
         }else {
             if (hasGroups) {
-                int index = it->second;
-                for (int i = 0; i < counts[index].size(); i++) {
-                    thisGroups.push_back(groups[counts[index][i].group]);
+                intPair* row = getCells(index);
+                for (int i = 0; i < rowSizes[index]; i++) {
+                    thisGroups.push_back(groups[row[i].group]);
                 }
             }else{  m->mothurOut("[ERROR]: Your count table does not have group info. Please correct.\n");  m->setControl_pressed(true); }
         }
@@ -1670,8 +1673,8 @@ vector<string> CountTable::getGroups(string seqName) {
 int CountTable::renameSeq(string oldSeqName, string newSeqName) {
     try {
 
-        map<string, int>::iterator it = indexNameMap.find(oldSeqName);
-        if (it == indexNameMap.end()) {
+        int id = findName(oldSeqName);
+        if (id == -1) {
             if (hasGroupInfo()) {
                 //look for it in names of groups to see if the user accidently used the wrong file
                 if (util.inUsersGroups(oldSeqName, groups)) {
@@ -1680,9 +1683,13 @@ int CountTable::renameSeq(string oldSeqName, string newSeqName) {
             }
             m->mothurOut("[ERROR]: " + oldSeqName + " is not in your count table. Please correct.\n"); m->setControl_pressed(true);
         }else {
-            int index = it->second;
-            indexNameMap.erase(it);
-            indexNameMap[newSeqName] = index;
+            int index = nameRows[id];
+            removeName(id);
+            
+            int oldId = findName(newSeqName); //the new name replaces a seq already using it
+            if (oldId != -1) { rowNames[nameRows[oldId]] = -1; removeName(oldId); }
+            
+            rowNames[index] = addName(newSeqName, index);
         }
 
         return 0;
@@ -1698,8 +1705,8 @@ int CountTable::renameSeq(string oldSeqName, string newSeqName) {
 int CountTable::getNumSeqs(string seqName) {
     try {
 
-        map<string, int>::iterator it = indexNameMap.find(seqName);
-        if (it == indexNameMap.end()) {
+        int index = findRow(seqName);
+        if (index == -1) {
             if (hasGroupInfo()) {
                 //look for it in names of groups to see if the user accidently used the wrong file
                 if (util.inUsersGroups(seqName, groups)) {
@@ -1708,7 +1715,7 @@ int CountTable::getNumSeqs(string seqName) {
             }
             m->mothurOut("[ERROR]: " + seqName + " is not in your count table. Please correct.\n"); m->setControl_pressed(true);
         }else {
-            return totals[it->second];
+            return totals[index];
         }
 
         return 0;
@@ -1723,12 +1730,12 @@ int CountTable::getNumSeqs(string seqName) {
 int CountTable::setNumSeqs(string seqName, int abund) {
     try {
 
-        map<string, int>::iterator it = indexNameMap.find(seqName);
-        if (it == indexNameMap.end()) {
+        int index = findRow(seqName);
+        if (index == -1) {
             m->mothurOut("[ERROR]: " + seqName + " is not in your count table. Please correct.\n"); m->setControl_pressed(true); return -1;
         }else {
-            int diff = totals[it->second] - abund;
-            totals[it->second] = abund;
+            int diff = totals[index] - abund;
+            totals[index] = abund;
             total-=diff;
         }
 
@@ -1743,20 +1750,20 @@ int CountTable::setNumSeqs(string seqName, int abund) {
 int CountTable::zeroOutSeq(string seqName) {
     try {
 
-        map<string, int>::iterator it = indexNameMap.find(seqName);
-        if (it == indexNameMap.end()) {
+        int index = findRow(seqName);
+        if (index == -1) {
             m->mothurOut("[ERROR]: " + seqName + " is not in your count table. Please correct.\n"); m->setControl_pressed(true); return -1;
         }else {
-            int abund = totals[it->second];
-            totals[it->second] = 0;
+            int abund = totals[index];
+            totals[index] = 0;
             total-=abund;
             
             if (hasGroups) {
-                int seqIndexIntoCounts = it->second;
-                for (int i = 0; i < counts[seqIndexIntoCounts].size(); i++) {
-                    totalGroups[counts[seqIndexIntoCounts][i].group] -= counts[seqIndexIntoCounts][i].abund;
+                intPair* row = getCells(index);
+                for (int i = 0; i < rowSizes[index]; i++) {
+                    totalGroups[row[i].group] -= row[i].abund;
                 }
-                counts[seqIndexIntoCounts].clear();
+                setRow(index, vector<intPair>());
             }
         }
 
@@ -1772,8 +1779,8 @@ int CountTable::zeroOutSeq(string seqName) {
 int CountTable::get(string seqName) {
     try {
 
-        map<string, int>::iterator it = indexNameMap.find(seqName);
-        if (it == indexNameMap.end()) {
+        int index = findRow(seqName);
+        if (index == -1) {
             if (hasGroupInfo()) {
                 //look for it in names of groups to see if the user accidently used the wrong file
                 if (util.inUsersGroups(seqName, groups)) {
@@ -1781,7 +1788,7 @@ int CountTable::get(string seqName) {
                 }
             }
             m->mothurOut("[ERROR]: " + seqName + " is not in your count table. Please correct.\n"); m->setControl_pressed(true);
-        }else { return it->second; }
+        }else { return index; }
 
         return -1;
     }
@@ -1794,11 +1801,9 @@ int CountTable::get(string seqName) {
 //add seqeunce without group info
 int CountTable::push_back(string seqName) {
     try {
-        map<string, int>::iterator it = indexNameMap.find(seqName);
-        if (it == indexNameMap.end()) {
+        if (findRow(seqName) == -1) {
             if (hasGroups) {  m->mothurOut("[ERROR]: Your count table has groups and I have no group information for " + seqName + ".\n");  m->setControl_pressed(true);  }
-            indexNameMap[seqName] = uniques;
-            totals.push_back(1);
+            addRow(seqName, vector<intPair>(), 1);
             total++;
             uniques++;
         }else {
@@ -1816,8 +1821,7 @@ int CountTable::push_back(string seqName) {
 //
 bool CountTable::inTable(string seqName) {
     try {
-        map<string, int>::iterator it = indexNameMap.find(seqName);
-        if (it != indexNameMap.end()) { return true; }
+        if (findRow(seqName) != -1) { return true; }
         return false;
         
     }
@@ -1831,32 +1835,18 @@ bool CountTable::inTable(string seqName) {
 //remove sequence
 int CountTable::remove(string seqName) {
     try {
-        map<string, int>::iterator it = indexNameMap.find(seqName);
-        if (it != indexNameMap.end()) {
-            int seqIndexIntoCounts = it->second;
+        int seqIndexIntoCounts = findRow(seqName);
+        if (seqIndexIntoCounts != -1) {
             uniques--;
             if (hasGroups){ //remove this sequences counts from group totals
-                for (int i = 0; i < counts[seqIndexIntoCounts].size(); i++) {
-                    totalGroups[counts[seqIndexIntoCounts][i].group] -= counts[seqIndexIntoCounts][i].abund;
+                intPair* row = getCells(seqIndexIntoCounts);
+                for (int i = 0; i < rowSizes[seqIndexIntoCounts]; i++) {
+                    totalGroups[row[i].group] -= row[i].abund;
                 }
             }
             
-            //save for later in case removing a group means we need to remove a seq.
-            map<int, string> reverse;
-            for (map<string, int>::iterator it2 = indexNameMap.begin(); it2 !=indexNameMap.end(); it2++) { reverse[it2->second] = it2->first;  }
-            
-            int newIndex = 0;
-            map<string, int> newIndexNameMap;
-            for (int i = 0; i < counts.size(); i++) {
-                if (i == seqIndexIntoCounts) { }//you are the seq we are trying to remove
-                else {   newIndexNameMap[reverse[i]] = newIndex; newIndex++;  }
-            }
-            indexNameMap = newIndexNameMap;
-
-            counts.erase(counts.begin()+seqIndexIntoCounts);
-            int thisTotal = totals[seqIndexIntoCounts];
-            totals.erase(totals.begin()+seqIndexIntoCounts);
-            total -= thisTotal;
+            total -= totals[seqIndexIntoCounts];
+            eraseRow(seqIndexIntoCounts);
             
             //remove group if all reads are removed
             for (int i = 0; i < totalGroups.size(); i++) {
@@ -1886,11 +1876,9 @@ int CountTable::remove(string seqName) {
 //add seqeunce without group info
 int CountTable::push_back(string seqName, int thisTotal) {
     try {
-        map<string, int>::iterator it = indexNameMap.find(seqName);
-        if (it == indexNameMap.end()) {
+        if (findRow(seqName) == -1) {
             if (hasGroups) {  m->mothurOut("[ERROR]: Your count table has groups and I have no group information for " + seqName + ".\n"); m->setControl_pressed(true);  }
-            indexNameMap[seqName] = uniques;
-            totals.push_back(thisTotal);
+            addRow(seqName, vector<intPair>(), thisTotal);
             total+=thisTotal;
             uniques++;
         }else {
@@ -1909,14 +1897,13 @@ int CountTable::push_back(string seqName, int thisTotal) {
 int CountTable::push_back(string seqName, vector<int> groupCounts, bool ignoreDup=false) {
     try {
         int thisTotal = 0;
-        map<string, int>::iterator it = indexNameMap.find(seqName);
-        if (it == indexNameMap.end()) {
+        if (findRow(seqName) == -1) {
             if ((hasGroups) && (groupCounts.size() != getNumGroups())) {  m->mothurOut("[ERROR]: Your count table has a " + toString(getNumGroups()) + " groups and " + seqName + " has " + toString(groupCounts.size()) + ", please correct.\n");  m->setControl_pressed(true);  }
             
             for (int i = 0; i < getNumGroups(); i++) {   totalGroups[i] += groupCounts[i];  thisTotal += groupCounts[i]; }
-            if (hasGroups) {  counts.push_back(compressAbunds(groupCounts));  }
-            indexNameMap[seqName] = uniques;
-            totals.push_back(thisTotal);
+            vector<intPair> row;
+            if (hasGroups) {  row = compressAbunds(groupCounts);  }
+            addRow(seqName, row, thisTotal);
             total+= thisTotal;
             uniques++;
         }else {
@@ -1938,14 +1925,13 @@ int CountTable::push_back(string seqName, vector<int> groupCounts, bool ignoreDu
 int CountTable::push_back(string seqName, vector<int> groupCounts) {
     try {
         int thisTotal = 0;
-        map<string, int>::iterator it = indexNameMap.find(seqName);
-        if (it == indexNameMap.end()) {
+        if (findRow(seqName) == -1) {
             if ((hasGroups) && (groupCounts.size() != getNumGroups())) {  m->mothurOut("[ERROR]: Your count table has a " + toString(getNumGroups()) + " groups and " + seqName + " has " + toString(groupCounts.size()) + ", please correct.\n");  m->setControl_pressed(true);  }
 
             for (int i = 0; i < getNumGroups(); i++) {   totalGroups[i] += groupCounts[i];  thisTotal += groupCounts[i]; }
-            if (hasGroups) {  counts.push_back(compressAbunds(groupCounts));  }
-            indexNameMap[seqName] = uniques;
-            totals.push_back(thisTotal);
+            vector<intPair> row;
+            if (hasGroups) {  row = compressAbunds(groupCounts);  }
+            addRow(seqName, row, thisTotal);
             total+= thisTotal;
             uniques++;
         }else {
@@ -1984,10 +1970,11 @@ int CountTable::getNumSeqsSmallestGroup() {
 //create ListVector from uniques
 ListVector CountTable::getListVector() {
     try {
-        ListVector list(indexNameMap.size(), "ASV");
-        for (map<string, int>::iterator it = indexNameMap.begin(); it != indexNameMap.end(); it++) {
+        ListVector list(numNames, "ASV");
+        vector<int> sortedNames = getSortedNames();
+        for (int i = 0; i < sortedNames.size(); i++) {
             if (m->getControl_pressed()) { break; }
-            list.set(it->second, it->first);
+            list.set(nameRows[sortedNames[i]], getName(sortedNames[i]));
         }
         return list;
     }
@@ -1997,13 +1984,35 @@ ListVector CountTable::getListVector() {
 	}
 }
 
+/************************************************************/
+//returns views of all unique sequences in the order they were added to the table
+vector<countTableSeq> CountTable::getSeqs() {
+    try {
+        vector<countTableSeq> seqs; seqs.reserve(numNames);
+        for (int i = 0; i < rowNames.size(); i++) {
+            int id = rowNames[i];
+            if (id == -1) { continue; } //merged into another seq
+            
+            countTableRow row;
+            if (hasGroups) { row = countTableRow(getCells(i), rowSizes[i]); }
+            seqs.push_back(countTableSeq(nameArena.data() + nameStarts[id], nameLengths[id], totals[i], row));
+        }
+        
+        return seqs;
+    }
+	catch(exception& e) {
+		m->errorOut(e, "CountTable", "getSeqs");
+		exit(1);
+	}
+}
 /************************************************************/
 //returns the names of all unique sequences in file
 vector<string> CountTable::getNamesOfSeqs() {
     try {
-        vector<string> names;
-        for (map<string, int>::iterator it = indexNameMap.begin(); it != indexNameMap.end(); it++) {
-            names.push_back(it->first);
+        vector<int> sortedNames = getSortedNames();
+        vector<string> names; names.reserve(sortedNames.size());
+        for (int i = 0; i < sortedNames.size(); i++) {
+            names.push_back(getName(sortedNames[i]));
         }
 
         return names;
@@ -2018,8 +2027,9 @@ vector<string> CountTable::getNamesOfSeqs() {
 map<string, int> CountTable::getNameMap() {
     try {
         map<string, int> names;
-        for (map<string, int>::iterator it = indexNameMap.begin(); it != indexNameMap.end(); it++) {
-            names[it->first] = totals[it->second];
+        vector<int> sortedNames = getSortedNames();
+        for (int i = 0; i < sortedNames.size(); i++) { //sorted, so each name goes at the end of the map
+            names.insert(names.end(), pair<string, int>(getName(sortedNames[i]), totals[nameRows[sortedNames[i]]]));
         }
 
         return names;
@@ -2040,9 +2050,10 @@ map<string, int> CountTable::getNameMap(string group) {
             if (it == indexGroupMap.end()) {
                 m->mothurOut("[ERROR]: " + group + " is not in your count table. Please correct.\n"); m->setControl_pressed(true);
             }else {
-                for (map<string, int>::iterator it2 = indexNameMap.begin(); it2 != indexNameMap.end(); it2++) {
-                    int abund = getAbund(it2->second, it->second);
-                    if (abund != 0) {  names[it2->first] = abund; }
+                vector<int> sortedNames = getSortedNames();
+                for (int i = 0; i < sortedNames.size(); i++) { //sorted, so each name goes at the end of the map
+                    int abund = getAbund(nameRows[sortedNames[i]], it->second);
+                    if (abund != 0) {  names.insert(names.end(), pair<string, int>(getName(sortedNames[i]), abund)); }
                 }
             }
         }else{  m->mothurOut("[ERROR]: Your count table does not have group info. Please correct.\n");  m->setControl_pressed(true); }
@@ -2064,8 +2075,9 @@ vector<string> CountTable::getNamesOfSeqs(string group) {
             if (it == indexGroupMap.end()) {
                 m->mothurOut("[ERROR]: " + group + " is not in your count table. Please correct.\n"); m->setControl_pressed(true);
             }else {
-                for (map<string, int>::iterator it2 = indexNameMap.begin(); it2 != indexNameMap.end(); it2++) {
-                    if (getAbund(it2->second, it->second) != 0) {  names.push_back(it2->first); }
+                vector<int> sortedNames = getSortedNames();
+                for (int i = 0; i < sortedNames.size(); i++) {
+                    if (getAbund(nameRows[sortedNames[i]], it->second) != 0) {  names.push_back(getName(sortedNames[i])); }
                 }
             }
         }else{  m->mothurOut("[ERROR]: Your count table does not have group info. Please correct.\n");  m->setControl_pressed(true); }
@@ -2106,8 +2118,8 @@ vector<string> CountTable::getNamesOfSeqs(vector<string> chosenGroups) {
 //merges counts of seq1 and seq2, saving in seq1
 int CountTable::mergeCounts(string seq1, string seq2) {
     try {
-        map<string, int>::iterator it = indexNameMap.find(seq1);
-        if (it == indexNameMap.end()) {
+        int index1 = findRow(seq1);
+        if (index1 == -1) {
             if (hasGroupInfo()) {
                 //look for it in names of groups to see if the user accidently used the wrong file
                 if (util.inUsersGroups(seq1, groups)) {
@@ -2116,8 +2128,8 @@ int CountTable::mergeCounts(string seq1, string seq2) {
             }
             m->mothurOut("[ERROR]: " + seq1 + " is not in your count table. Please correct.\n"); m->setControl_pressed(true);
         }else {
-            map<string, int>::iterator it2 = indexNameMap.find(seq2);
-            if (it2 == indexNameMap.end()) {
+            int id2 = findName(seq2);
+            if (id2 == -1) {
                 if (hasGroupInfo()) {
                     //look for it in names of groups to see if the user accidently used the wrong file
                     if (util.inUsersGroups(seq2, groups)) {
@@ -2128,16 +2140,17 @@ int CountTable::mergeCounts(string seq1, string seq2) {
             }else {
                 if (hasGroupInfo()) { //if no group data then counts are empty
                     //merge data
-                    vector<int> countsSeq1 = expandAbunds(it->second);
-                    vector<int> countsSeq2 = expandAbunds(it2->second);
+                    vector<int> countsSeq1 = expandAbunds(index1);
+                    vector<int> countsSeq2 = expandAbunds(nameRows[id2]);
                 
                     for (int i = 0; i < groups.size(); i++) { countsSeq1[i] += countsSeq2[i]; }
                 
-                    counts[it->second] = compressAbunds(countsSeq1);
+                    setRow(index1, compressAbunds(countsSeq1));
                 }
-                totals[it->second] += totals[it2->second];
+                totals[index1] += totals[nameRows[id2]];
                 uniques--;
-                indexNameMap.erase(it2);
+                rowNames[nameRows[id2]] = -1; //seq2's row stays, but is no longer printed
+                removeName(id2);
             }
         }
         return 0;
@@ -2180,7 +2193,7 @@ int CountTable::sortCountTable(){
         
         //sorts each rows abunds by group
         //counts[i] = (1,4),(1,2),(3,7) -> (1,2),(1,4),(3,7)
-        for (int i = 0; i < counts.size(); i++) {  sort(counts[i].begin(), counts[i].end(), compareGroups); }
+        for (int i = 0; i < rowSizes.size(); i++) {  sort(getCells(i), getCells(i)+rowSizes[i], compareGroups); }
         
         return 0;
     }
@@ -2195,7 +2208,7 @@ int CountTable::sortRow(int index){
     try {
         
         //saves time in getSmallestCell, by making it so you dont search the repeats
-        sort(counts[index].begin(), counts[index].end(), compareGroups);
+        sort(getCells(index), getCells(index)+rowSizes[index], compareGroups);
         
         return 0;
     }
@@ -2206,3 +2219,544 @@ int CountTable::sortRow(int index){
 }
 
 /************************************************************/
+//FNV-1a
+static unsigned long long hashName(const char* name, int length) {
+    unsigned long long hash = 14695981039346656037ULL;
+    for (int i = 0; i < length; i++) { hash ^= (unsigned char)name[i]; hash *= 1099511628211ULL; }
+    return hash ^ (hash >> 32);
+}
+/************************************************************/
+//returns the id of the name, -1 if it is not in the table
+int CountTable::findName(const string& seqName) {
+    try {
+        unsigned long long mask = nameSlots.size() - 1;
+        unsigned long long slot = hashName(seqName.data(), seqName.length()) & mask;
+        
+        while (nameSlots[slot] != -1) {
+            int id = nameSlots[slot];
+            if ((nameRows[id] != -1) && (nameLengths[id] == seqName.length())) {
+                if (memcmp(nameArena.data() + nameStarts[id], seqName.data(), seqName.length()) == 0) { return id; }
+            }
+            slot = (slot + 1) & mask;
+        }
+        
+        return -1;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "CountTable", "findName");
+        exit(1);
+    }
+}
+/************************************************************/
+int CountTable::addName(const string& seqName, int row) {
+    try {
+        int id = nameRows.size();
+        nameStarts.push_back(nameArena.size());
+        nameLengths.push_back(seqName.length());
+        nameArena.insert(nameArena.end(), seqName.begin(), seqName.end());
+        nameRows.push_back(row);
+        
+        unsigned long long mask = nameSlots.size() - 1;
+        unsigned long long slot = hashName(seqName.data(), seqName.length()) & mask;
+        while (nameSlots[slot] != -1) { slot = (slot + 1) & mask; }
+        nameSlots[slot] = id;
+        
+        numNames++; numSlotsUsed++;
+        if (numSlotsUsed * 2 > nameSlots.size()) { resizeNameSlots(); }
+        
+        return id;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "CountTable", "addName");
+        exit(1);
+    }
+}
+/************************************************************/
+//the id stays in nameSlots until they are resized
+void CountTable::removeName(int id) {
+    nameRows[id] = -1;
+    numNames--;
+}
+/************************************************************/
+//rehashes the names in the table, dropping the removed ones
+void CountTable::resizeNameSlots() {
+    try {
+        long long numSlots = 1024;
+        while (numSlots < 4 * (long long)numNames) { numSlots *= 2; }
+        nameSlots.assign(numSlots, -1);
+        
+        unsigned long long mask = numSlots - 1;
+        numSlotsUsed = 0;
+        for (int id = 0; id < nameRows.size(); id++) {
+            if (nameRows[id] == -1) { continue; }
+            
+            unsigned long long slot = hashName(nameArena.data() + nameStarts[id], nameLengths[id]) & mask;
+            while (nameSlots[slot] != -1) { slot = (slot + 1) & mask; }
+            nameSlots[slot] = id;
+            numSlotsUsed++;
+        }
+    }
+    catch(exception& e) {
+        m->errorOut(e, "CountTable", "resizeNameSlots");
+        exit(1);
+    }
+}
+/************************************************************/
+void CountTable::clearNames() {
+    nameArena.clear(); nameStarts.clear(); nameLengths.clear(); nameRows.clear();
+    nameSlots.assign(1024, -1);
+    numNames = 0; numSlotsUsed = 0;
+}
+/************************************************************/
+//same order as string's operator<
+bool CountTable::isNameLess(int id1, int id2) {
+    int length = min(nameLengths[id1], nameLengths[id2]);
+    int result = memcmp(nameArena.data() + nameStarts[id1], nameArena.data() + nameStarts[id2], length);
+    
+    if (result != 0) { return (result < 0); }
+    return (nameLengths[id1] < nameLengths[id2]);
+}
+/************************************************************/
+//not saved, so tables can be read by several threads
+vector<int> CountTable::getSortedNames() {
+    try {
+        vector<int> sortedNames; sortedNames.reserve(numNames);
+        for (int id = 0; id < nameRows.size(); id++) {
+            if (nameRows[id] != -1) { sortedNames.push_back(id); }
+        }
+        
+        sort(sortedNames.begin(), sortedNames.end(), [this](int id1, int id2) { return isNameLess(id1, id2); });
+        
+        return sortedNames;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "CountTable", "getSortedNames");
+        exit(1);
+    }
+}
+/************************************************************/
+int CountTable::addRow(const string& seqName, const vector<intPair>& items, int thisTotal) {
+    try {
+        int row = totals.size();
+        
+        rowStarts.push_back(cells.size());
+        rowSizes.push_back(items.size());
+        cells.insert(cells.end(), items.begin(), items.end());
+        totals.push_back(thisTotal);
+        rowNames.push_back(addName(seqName, row));
+        
+        return row;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "CountTable", "addRow");
+        exit(1);
+    }
+}
+/************************************************************/
+//a row that fits is overwritten, otherwise it is moved to the end of cells
+void CountTable::setRow(int row, const vector<intPair>& items) {
+    try {
+        if (items.size() <= rowSizes[row]) {
+            std::copy(items.begin(), items.end(), cells.begin() + rowStarts[row]);
+            unusedCells += rowSizes[row] - items.size();
+        }else {
+            unusedCells += rowSizes[row];
+            rowStarts[row] = cells.size();
+            cells.insert(cells.end(), items.begin(), items.end());
+        }
+        rowSizes[row] = items.size();
+        
+        if (unusedCells * 2 > cells.size()) { compactCells(); }
+    }
+    catch(exception& e) {
+        m->errorOut(e, "CountTable", "setRow");
+        exit(1);
+    }
+}
+/************************************************************/
+//removes the row and its name, the rows after it move up one
+void CountTable::eraseRow(int row) {
+    try {
+        if (rowNames[row] != -1) { removeName(rowNames[row]); }
+        unusedCells += rowSizes[row];
+        
+        rowStarts.erase(rowStarts.begin()+row);
+        rowSizes.erase(rowSizes.begin()+row);
+        rowNames.erase(rowNames.begin()+row);
+        totals.erase(totals.begin()+row);
+        
+        for (int i = row; i < rowNames.size(); i++) {
+            if (rowNames[i] != -1) { nameRows[rowNames[i]] = i; }
+        }
+        
+        if (unusedCells * 2 > cells.size()) { compactCells(); }
+    }
+    catch(exception& e) {
+        m->errorOut(e, "CountTable", "eraseRow");
+        exit(1);
+    }
+}
+/************************************************************/
+void CountTable::compactCells() {
+    try {
+        vector<intPair> newCells; newCells.reserve(cells.size() - unusedCells);
+        
+        for (int i = 0; i < rowStarts.size(); i++) {
+            long long start = newCells.size();
+            newCells.insert(newCells.end(), cells.begin() + rowStarts[i], cells.begin() + rowStarts[i] + rowSizes[i]);
+            rowStarts[i] = start;
+        }
+        
+        cells.swap(newCells);
+        unusedCells = 0;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "CountTable", "compactCells");
+        exit(1);
+    }
+}
+/************************************************************/
+void CountTable::clearRows() {
+    cells.clear(); rowStarts.clear(); rowSizes.clear(); rowNames.clear(); totals.clear();
+    unusedCells = 0;
+}
+/************************************************************/
+//  The binary copy of a count table, filename.bin. The sections after the header start on 8 byte boundaries.
+//
+//  0:   magic "MOTHCNTB", uint32 version, uint32 byte order check
+//  16:  uint64 size and uint64 hash of the whole text table, 8 unused bytes
+//  40:  uint64 numGroups, uint64 numSeqs, uint64 numCells, uint64 bytes of group names, uint64 bytes of seq names
+//  80:  uint32 1 if the text table is compressed, padded to 128 bytes
+//  128: the group names sorted, each followed by '\n'
+//  then int32 total of each seq
+//  then uint64 start of each seq's name, numSeqs+1 of them
+//  then uint64 start of each seq's cells, numSeqs+1 of them
+//  then int32 pairs (abund, group) of each seq's non zero counts, sorted by group
+//  then the seq names back to back
+static unsigned long long binaryTableHeaderSize() { return 128; }
+static unsigned long long alignBinaryTable(unsigned long long bytes) { return ((bytes + 7) / 8) * 8; }
+
+//offsets of the group names, totals, name starts, cell starts, cells, names and the end of the file
+static vector<unsigned long long> getBinaryTableOffsets(unsigned long long groupBytes, unsigned long long numSeqs, unsigned long long numCells, unsigned long long nameBytes) {
+    vector<unsigned long long> offsets(7, 0);
+    offsets[0] = binaryTableHeaderSize();
+    offsets[1] = offsets[0] + alignBinaryTable(groupBytes);
+    offsets[2] = offsets[1] + alignBinaryTable(numSeqs * sizeof(int));
+    offsets[3] = offsets[2] + (numSeqs+1) * sizeof(unsigned long long);
+    offsets[4] = offsets[3] + (numSeqs+1) * sizeof(unsigned long long);
+    offsets[5] = offsets[4] + numCells * 2 * sizeof(int);
+    offsets[6] = offsets[5] + nameBytes;
+    return offsets;
+}
+/************************************************************/
+bool CountTable::isBinaryCopy(string textFile) {
+    try {
+        string binaryName = textFile + ".bin";
+        ifstream in(binaryName.c_str(), ios::binary);
+        if (!in) { return false; }
+        
+        char magic[8];
+        in.read(magic, 8);
+        bool isBinary = in && (memcmp(magic, COUNTTABLE_BINARY_MAGIC, 8) == 0);
+        in.close();
+        
+        return isBinary;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "CountTable", "isBinaryCopy");
+        exit(1);
+    }
+}
+/************************************************************/
+//writes the binary copy if the table can have one, otherwise removes an old copy so it can't outlive its table
+void CountTable::printBinaryCopy(string textFile, const vector<int>& rows, bool compressed, bool withGroups, bool canWrite) {
+    try {
+        binaryFile = "";
+        string binaryName = textFile + ".bin";
+        
+        if (canWrite && writeBinaryTable(textFile, rows, compressed, withGroups)) { binaryFile = binaryName; }
+        else if (isBinaryCopy(textFile)) { util.mothurRemove(binaryName); }
+    }
+    catch(exception& e) {
+        m->errorOut(e, "CountTable", "printBinaryCopy");
+        exit(1);
+    }
+}
+/************************************************************/
+//rows must have names. Returns false if the copy could not be written, the text table is still read if there is no binary copy.
+bool CountTable::writeBinaryTable(string textFile, const vector<int>& rows, bool compressed, bool withGroups) {
+    try {
+        unsigned long long textSize, textChecksum;
+        if (!util.getFileChecksum(textFile, textSize, textChecksum)) { return false; }
+        
+        //the text table's groups are sorted when it is read
+        vector<string> sortedGroups;
+        vector<int> sortedIndexes(groups.size(), 0);
+        if (withGroups) {
+            sortedGroups = groups; sort(sortedGroups.begin(), sortedGroups.end());
+            for (int i = 0; i < groups.size(); i++) { sortedIndexes[i] = lower_bound(sortedGroups.begin(), sortedGroups.end(), groups[i]) - sortedGroups.begin(); }
+        }
+        string groupNames = "";
+        for (int i = 0; i < sortedGroups.size(); i++) { groupNames += sortedGroups[i] + '\n'; }
+        
+        unsigned long long numSeqs = rows.size(), numCells = 0, nameBytes = 0;
+        vector<int> seqTotals(numSeqs, 0);
+        vector<unsigned long long> nameStartsOut(numSeqs+1, 0), cellStartsOut(numSeqs+1, 0);
+        for (int i = 0; i < rows.size(); i++) {
+            int row = rows[i];
+            seqTotals[i] = totals[row];
+            nameBytes += nameLengths[rowNames[row]];
+            if (withGroups) {
+                intPair* rowCells = getCells(row);
+                for (int j = 0; j < rowSizes[row]; j++) { if (rowCells[j].abund != 0) { numCells++; } }
+            }
+            nameStartsOut[i+1] = nameBytes;
+            cellStartsOut[i+1] = numCells;
+        }
+        
+        vector<unsigned long long> offsets = getBinaryTableOffsets(groupNames.length(), numSeqs, numCells, nameBytes);
+        
+        vector<char> header(binaryTableHeaderSize(), '\0');
+        unsigned int fileVersion = COUNTTABLE_BINARY_VERSION;
+        unsigned int byteOrder = COUNTTABLE_BINARY_BYTEORDER;
+        unsigned long long numGroups = sortedGroups.size(), groupBytes = groupNames.length();
+        unsigned int compressedFlag = compressed;
+        memcpy(&header[0], COUNTTABLE_BINARY_MAGIC, 8);
+        memcpy(&header[8], &fileVersion, sizeof(unsigned int));
+        memcpy(&header[12], &byteOrder, sizeof(unsigned int));
+        memcpy(&header[16], &textSize, sizeof(unsigned long long));
+        memcpy(&header[24], &textChecksum, sizeof(unsigned long long));
+        memcpy(&header[40], &numGroups, sizeof(unsigned long long));
+        memcpy(&header[48], &numSeqs, sizeof(unsigned long long));
+        memcpy(&header[56], &numCells, sizeof(unsigned long long));
+        memcpy(&header[64], &groupBytes, sizeof(unsigned long long));
+        memcpy(&header[72], &nameBytes, sizeof(unsigned long long));
+        memcpy(&header[80], &compressedFlag, sizeof(unsigned int));
+        
+        //write to a temp file and rename so a reader never maps a partial file, threads reading the same table each write their own
+        string binaryName = textFile + ".bin";
+        string tempName = binaryName + "." + toString(std::hash<std::thread::id>()(std::this_thread::get_id())) + ".temp";
+        ofstream out(tempName.c_str(), ios::binary | ios::trunc);
+        if (!out) { return false; } //the table may be in a read only directory
+        
+        vector<char> padding(8, '\0');
+        out.write(&header[0], header.size());
+        out.write(groupNames.c_str(), groupNames.length());
+        out.write(&padding[0], offsets[1] - offsets[0] - groupNames.length());
+        if (numSeqs != 0) { out.write((char*)&seqTotals[0], numSeqs * sizeof(int)); }
+        out.write(&padding[0], offsets[2] - offsets[1] - numSeqs * sizeof(int));
+        out.write((char*)&nameStartsOut[0], (numSeqs+1) * sizeof(unsigned long long));
+        out.write((char*)&cellStartsOut[0], (numSeqs+1) * sizeof(unsigned long long));
+        
+        if (withGroups) {
+            vector<int> items;
+            for (int i = 0; i < rows.size(); i++) {
+                intPair* rowCells = getCells(rows[i]);
+                vector<intPair> rowItems;
+                for (int j = 0; j < rowSizes[rows[i]]; j++) {
+                    if (rowCells[j].abund != 0) { rowItems.push_back(intPair(rowCells[j].abund, sortedIndexes[rowCells[j].group])); }
+                }
+                sort(rowItems.begin(), rowItems.end(), [](const intPair& a, const intPair& b) { return a.group < b.group; });
+                for (int j = 0; j < rowItems.size(); j++) { items.push_back(rowItems[j].abund); items.push_back(rowItems[j].group); }
+                
+                if ((items.size() >= 65536) || (i == rows.size()-1)) {
+                    if (items.size() != 0) { out.write((char*)&items[0], items.size() * sizeof(int)); }
+                    items.clear();
+                }
+            }
+        }
+        
+        for (int i = 0; i < rows.size(); i++) {
+            int id = rowNames[rows[i]];
+            out.write(nameArena.data() + nameStarts[id], nameLengths[id]);
+        }
+        
+        bool good = (bool)out;
+        out.close();
+        
+        if (good) { util.renameFile(tempName, binaryName); }
+        else { util.mothurRemove(tempName); }
+        
+        return good;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "CountTable", "writeBinaryTable");
+        exit(1);
+    }
+}
+/************************************************************/
+//fills the table the same way reading the text table would, only copying the cells of the groups to save
+bool CountTable::readBinaryTable(string textFile, bool readGroups, bool mothurRunning, vector<string> selectedGroups) {
+    try {
+        string binaryName = textFile + ".bin";
+        ifstream in(binaryName.c_str(), ios::binary);
+        if (!in) { return false; }
+        
+        vector<char> header(binaryTableHeaderSize(), '\0');
+        in.read(&header[0], header.size());
+        if (!in) { in.close(); return false; }
+        
+        unsigned int fileVersion, byteOrder, compressedFlag;
+        unsigned long long textSize, textChecksum, numGroups, numSeqs, numCells, groupBytes, nameBytes;
+        memcpy(&fileVersion, &header[8], sizeof(unsigned int));
+        memcpy(&byteOrder, &header[12], sizeof(unsigned int));
+        memcpy(&textSize, &header[16], sizeof(unsigned long long));
+        memcpy(&textChecksum, &header[24], sizeof(unsigned long long));
+        memcpy(&numGroups, &header[40], sizeof(unsigned long long));
+        memcpy(&numSeqs, &header[48], sizeof(unsigned long long));
+        memcpy(&numCells, &header[56], sizeof(unsigned long long));
+        memcpy(&groupBytes, &header[64], sizeof(unsigned long long));
+        memcpy(&nameBytes, &header[72], sizeof(unsigned long long));
+        memcpy(&compressedFlag, &header[80], sizeof(unsigned int));
+        
+        bool good = (memcmp(&header[0], COUNTTABLE_BINARY_MAGIC, 8) == 0) && (fileVersion == COUNTTABLE_BINARY_VERSION) && (byteOrder == COUNTTABLE_BINARY_BYTEORDER);
+        
+        vector<unsigned long long> offsets = getBinaryTableOffsets(groupBytes, numSeqs, numCells, nameBytes);
+        unsigned long long fileSize = offsets[6];
+        if (good) { in.seekg(0, ios::end); good = ((unsigned long long)in.tellg() == fileSize); }
+        
+        //the whole text table is hashed, so any edit to it, even one keeping its size, makes the copy out of date
+        if (good) {
+            unsigned long long size, checksum;
+            good = util.getFileChecksum(textFile, size, checksum) && (size == textSize) && (checksum == textChecksum);
+        }
+        
+        //an out of date copy is removed so the text is parsed without checking it again, files that aren't a copy are left alone
+        if (!good) { in.close(); if (isBinaryCopy(textFile)) { util.mothurRemove(binaryName); } return false; }
+        
+#ifdef NON_WINDOWS
+        in.close();
+        
+        //only the pages of the sections used are read, a table read without groups never touches the cells
+        int fd = ::open(binaryName.c_str(), O_RDONLY);
+        if (fd == -1) { return false; }
+        void* mapped = mmap(nullptr, fileSize, PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (mapped == MAP_FAILED) { return false; }
+        const char* data = (const char*)mapped;
+#else
+        vector<char> buffer(fileSize, '\0');
+        in.seekg(0);
+        in.read(&buffer[0], fileSize);
+        good = (bool)in;
+        in.close();
+        if (!good) { return false; }
+        const char* data = buffer.data();
+#endif
+        
+        const int* seqTotals = (const int*)(data + offsets[1]);
+        const unsigned long long* seqNameStarts = (const unsigned long long*)(data + offsets[2]);
+        const unsigned long long* seqCellStarts = (const unsigned long long*)(data + offsets[3]);
+        const int* seqCells = (const int*)(data + offsets[4]);
+        const char* seqNames = data + offsets[5];
+        
+        vector<string> fileGroups = util.splitWhiteSpace(string(data + offsets[0], groupBytes));
+        
+        if (!readGroups) { selectedGroups.clear(); }
+        isCompressed = compressedFlag;
+        groups.clear();
+        totalGroups.clear();
+        indexGroupMap.clear();
+        clearNames();
+        clearRows();
+        if ((fileGroups.size() != 0) && readGroups) { hasGroups = true; }
+        
+        //fileIndexes[i] is the index of the binary copy's group i in the table, -1 if it is not saved
+        vector<int> fileIndexes(fileGroups.size(), -1);
+        if (readGroups) {
+            for (int i = 0; i < fileGroups.size(); i++) {
+                util.checkGroupName(fileGroups[i]);
+                if (selectedGroups.size() != 0) {
+                    if (!(util.inUsersGroups(fileGroups[i], selectedGroups))) { continue; }
+                }
+                groups.push_back(fileGroups[i]);
+                totalGroups.push_back(0);
+            }
+        }
+        
+        //sort groups to keep consistent with how we store the groups in groupmap
+        sort(groups.begin(), groups.end());
+        for (int i = 0; i < groups.size(); i++) {  indexGroupMap[groups[i]] = i; }
+        bool inOrder = true; int lastIndex = -1;
+        for (int i = 0; i < fileGroups.size(); i++) {
+            map<string, int>::iterator it = indexGroupMap.find(fileGroups[i]);
+            if (it == indexGroupMap.end()) { continue; }
+            fileIndexes[i] = it->second;
+            if (it->second < lastIndex) { inOrder = false; }
+            lastIndex = it->second;
+        }
+        
+        nameArena.reserve(nameBytes);
+        if (hasGroups && readGroups) { cells.reserve(numCells); }
+        
+        bool error = false, corrupt = (fileGroups.size() != numGroups) || (seqNameStarts[numSeqs] != nameBytes) || (seqCellStarts[numSeqs] != numCells);
+        uniques = 0;
+        total = 0;
+        vector<intPair> items;
+        for (unsigned long long i = 0; i < numSeqs; i++) {
+            
+            if (m->getControl_pressed() || corrupt) { break; }
+            if ((seqNameStarts[i] > seqNameStarts[i+1]) || (seqCellStarts[i] > seqCellStarts[i+1])) { corrupt = true; break; }
+            
+            string name(seqNames + seqNameStarts[i], seqNameStarts[i+1] - seqNameStarts[i]);
+            int thisTotal = seqTotals[i];
+            if (m->getDebug()) { m->mothurOut("[DEBUG]: " + name + '\t' + toString(thisTotal) + "\n"); }
+            
+            if ((thisTotal == 0) && !mothurRunning) { error=true; m->mothurOut("[ERROR]: Your count table contains a sequence named " + name + " with a total=0. Please correct.\n");
+            }
+            
+            items.clear();
+            if (hasGroups && readGroups) {
+                if (selectedGroups.size() != 0) { thisTotal = 0; }
+                
+                for (unsigned long long j = seqCellStarts[i]; j < seqCellStarts[i+1]; j++) {
+                    int abund = seqCells[2*j], fileGroup = seqCells[2*j+1];
+                    if ((fileGroup < 0) || (fileGroup >= fileIndexes.size())) { corrupt = true; break; }
+                    
+                    int thisIndex = fileIndexes[fileGroup];
+                    if (thisIndex == -1) { continue; } //not a group we are saving
+                    
+                    items.push_back(intPair(abund, thisIndex));
+                    totalGroups[thisIndex] += abund;
+                    if (selectedGroups.size() != 0) { thisTotal += abund; }
+                }
+                if (!inOrder) { sort(items.begin(), items.end(), [](const intPair& a, const intPair& b) { return a.group < b.group; }); }
+                
+                if (items.size() == 0) { continue; }
+            }
+            
+            addRow(name, items, thisTotal);
+            total += thisTotal;
+            uniques++;
+        }
+        
+#ifdef NON_WINDOWS
+        munmap(mapped, fileSize);
+#endif
+        
+        if (corrupt) {
+            groups.clear(); totalGroups.clear(); indexGroupMap.clear(); clearNames(); clearRows();
+            util.mothurRemove(binaryName);
+            return false;
+        }
+        
+        if (error) { m->setControl_pressed(true); }
+        else { //check for zero groups
+            if (hasGroups && readGroups) {
+                for (int i = 0; i < totalGroups.size(); i++) {
+                    if (totalGroups[i] == 0) { removeGroup(groups[i]); i--; }
+                }
+            }
+        }
+        
+        //if the file has groups, but we didn't read them
+        if (!readGroups) { hasGroups = false; }
+        
+        return true;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "CountTable", "readBinaryTable");
+        exit(1);
+    }
+}
+/************************************************************/
@@ -49,6 +49,11 @@
  GQY1XT001CNUHI	19	1,17	2,1	7,1
  ...
 
+ Printing a table also writes a binary copy, filename.bin. It holds the group names, the offsets of the sequence names
+ and each sequence's non zero counts, so later reads map it and copy what they need instead of parsing the text. The copy
+ remembers the size and a hash of the whole text table. A read that finds a copy not matching its table parses the text
+ and removes the copy. Reading never writes a copy, and printing a table that can't have one removes the old copy.
+
  */
 
 
@@ -57,11 +62,31 @@
 #include "sequence.hpp"
 #include "sharedrabundvectors.hpp"
 
+//read only view of a row of the count table
+struct countTableRow {
+    const intPair* items; //sorted by group
+    int size;
+    
+    countTableRow() : items(nullptr), size(0) {}
+    countTableRow(const intPair* i, int s) : items(i), size(s) {}
+};
+
+//read only view of a sequence in the count table, its name points into the table's name arena
+struct countTableSeq {
+    const char* name;
+    int nameLength, total;
+    countTableRow row; //empty if the table has no groups
+    
+    countTableSeq() : name(nullptr), nameLength(0), total(0) {}
+    countTableSeq(const char* n, int l, int t, countTableRow r) : name(n), nameLength(l), total(t), row(r) {}
+    string getName() const { return string(name, nameLength); }
+};
+
 class CountTable {
 
     public:
 
-        CountTable() { m = MothurOut::getInstance(); hasGroups = false; total = 0; uniques = 0; isCompressed = true; }
+        CountTable() { m = MothurOut::getInstance(); hasGroups = false; total = 0; uniques = 0; isCompressed = true; binaryFile = ""; clearNames(); clearRows(); }
         ~CountTable() = default;
 
         //reads and creates smart enough to eliminate groups with zero counts
@@ -75,9 +100,10 @@ class CountTable {
         int readTable(string, bool, bool, unordered_set<string>); //filename, readGroups, mothurRunning, namesofSeqs to save (if none provided, read all seqs)
         int readTable(string, string); //filename, format - if format=fasta, read fasta file and create unique table. if format=name, use namefile to create count table
     
-        int zeroOutTable(); //turn all counts to zeros
+        int zeroOutTable(); //turn every seq's group counts and total to zero, the table total and group totals are not changed
         int clearTable();
         bool isCountTable(string);
+        bool isBinaryCopy(string); //checks filename.bin is a count table's binary copy, does not check it is up to date
         bool isTableCompressed() { return isCompressed; }
         int copy(CountTable*); //copy countable
         bool inTable(string);  //accepts sequence name and returns true if sequence is in table, false if not present
@@ -88,6 +114,7 @@ class CountTable {
         vector<string> printNoGroupsTable(string); //preserves order in original, defaults compress to state of original file
         vector<string> printTable(string, bool compress); //preserves order in original, printing compressed or not based on compress flag pasted in
         vector<string> printSortedTable(string); //sorted by seqName
+        string getBinaryFile() { return binaryFile; } //binary copy written by the last print, "" if none
         int printHeaders(ofstream&, vector<string> optionalGroups=nullVector);
         set<int> printCompressedHeaders(ofstream&, vector<string> optionalGroups=nullVector);
         vector<string> getHardCodedHeaders(); //Representative_Sequence, total
@@ -113,10 +140,11 @@ class CountTable {
         int push_back(string, vector<int>, bool); //add a sequence with group info, no error - ignore dups
         int remove(string); //remove seq
         int get(string); //returns unique sequence index for reading distance matrices like NameAssignment
-        int size() { return (int)indexNameMap.size(); }
+        int size() { return numNames; }
 
         vector<string> getGroups(string); //returns vector of groups represented by this sequence
         vector<int> getGroupCounts(string);  //returns group counts for a seq passed in, if no group info is in file vector is blank. Order is the same as the groups returned by getGroups function.
+        countTableRow getRow(const string&); //returns the non zero group counts for a seq passed in without copying them. Only valid until the table is changed.
         int getGroupCount(string, string); //returns number of seqs for that group for that seq
         int getGroupCount(string); // returns total seqs for that group
         int getNumSeqs(string); //returns total seqs for that seq, 0 if not found
@@ -126,6 +154,7 @@ class CountTable {
         int getNumUniqueSeqs() { return uniques; } //return number of unique/representative seqs
         int getNumSeqsSmallestGroup(); //returns size of smallest group. If no groups, returns total num seqs (includes non uniques)
 
+        vector<countTableSeq> getSeqs(); //returns every seq in table order without copying names or counts. Only valid until the table is changed.
         vector<string> getNamesOfSeqs(); //return names of all seqeunce in table
         vector<string> getNamesOfSeqs(string); //returns names of seqs in specific group in table
         vector<string> getNamesOfSeqs(vector<string>); //returns names of seqs in specific set of groups in table
@@ -140,20 +169,55 @@ class CountTable {
         Utils util;
         bool hasGroups, isCompressed;
         int total, uniques;
+        string binaryFile;
         vector<string> groups;
-        vector< vector<intPair> > counts; //intPair ((int)abund, (int)group). each line in counts represents a sequence line from the count table file(sparse). The vector<intPair> are sorted by group, so that you can stop search early if group is not found. For example:  seq1 10 5 0 0 1 0 0 0 3 0 0 1 0 0 - 13 groups, but seq1 is only present in 4 samples. Let's save space by not storing 0 abunds. seq1's vector<ountTableItem> (5,0),(1,3),(3,7),(1,10). Group0 = 5, Group3 = 1, Group7 = 3, Group10 = 1.
         vector<int> totals;
         vector<int> totalGroups;
-        map<string, int> indexNameMap; //maps seqName -> vector index in counts. seq1 -> 1 would mean seq1's counts are stored in counts[1].
         map<string, int> indexGroupMap;
     
+        //each row represents a sequence line from the count table file. Only the non zero group counts are stored, intPair ((int)abund, (int)group), and all the rows share cells.
+        //Row i's counts are cells[rowStarts[i]] to cells[rowStarts[i]+rowSizes[i]-1], sorted by group, so that you can stop search early if group is not found. For example:  seq1 10 5 0 0 1 0 0 0 3 0 0 1 0 0 - 13 groups,
+        //but seq1 is only present in 4 samples. seq1's cells are (5,0),(1,3),(3,7),(1,10). Group0 = 5, Group3 = 1, Group7 = 3, Group10 = 1. A row that grows is moved to the end of cells, and cells is compacted when half of it is unused.
+        vector<intPair> cells;
+        vector<long long> rowStarts;
+        vector<int> rowSizes;
+        vector<int> rowNames; //row -> name id, -1 if mergeCounts merged the seq into another
+        long long unusedCells;
+    
+        //seqNames are stored once in nameArena and looked up in an open addressing hash of name ids. A removed or renamed name keeps its id and bytes, but its row is set to -1.
+        vector<char> nameArena;
+        vector<long long> nameStarts;
+        vector<int> nameLengths;
+        vector<int> nameRows; //name id -> row. seq1 -> 1 would mean seq1's counts are stored in row 1.
+        vector<int> nameSlots; //name id or -1, the size is a power of 2 and at most half full
+        int numNames, numSlotsUsed; //names in the table, ids in nameSlots
+    
+        int findName(const string&); //returns name id or -1
+        int addName(const string&, int row); //returns name id, name must not be in the table
+        void removeName(int id);
+        string getName(int id) { return string(nameArena.data() + nameStarts[id], nameLengths[id]); }
+        bool isNameLess(int id1, int id2);
+        vector<int> getSortedNames(); //name ids sorted by name
+        void resizeNameSlots();
+        void clearNames();
+    
+        int findRow(const string& seqName) { int id = findName(seqName); if (id == -1) { return -1; } return nameRows[id]; }
+        intPair* getCells(int row) { return cells.data() + rowStarts[row]; }
+        int addRow(const string&, const vector<intPair>&, int); //seqName, counts, total. returns row
+        void setRow(int row, const vector<intPair>&);
+        void eraseRow(int row);
+        void compactCells();
+        void clearRows();
+    
         int find(int seq, int group, bool returnNext); //returns index of intPair for group passed in. If group is not present in seq, returns -1
         int getAbund(int seq, int group); //returns abundance of intPair for seq and group passed in. If group is not present in seq, returns 0
-        vector<intPair> getItems(string); //returns group counts for a seq passed in, if no group info is in file vector is blank. sorted by group
         vector<int> expandAbunds(int index);
         vector<int> expandAbunds(vector<intPair>& items);
         vector<intPair> compressAbunds(vector<int> abunds);
         void printGroupAbunds(ofstream& out, int index);
+        bool readBinaryTable(string, bool, bool, vector<string>); //text filename, readGroups, mothurRunning, groups to save. returns false if the binary copy is missing or out of date
+        bool writeBinaryTable(string, const vector<int>&, bool, bool); //text filename, rows in the order they were printed, compressed, withGroups. returns false if not written
+        void printBinaryCopy(string, const vector<int>&, bool, bool, bool); //text filename, rows, compressed, withGroups, canWrite
         int sortCountTable();
         int sortRow(int);
 
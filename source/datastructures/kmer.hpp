@@ -20,7 +20,7 @@ public:
 	Kmer(int);
     ~Kmer() = default;
 	string getKmerString(string);
-	int getKmerNumber(string, int);
+	int getKmerNumber(const string&, int);
 	string getKmerBases(int);
 	int getReverseKmerNumber(int);
 	vector< map<int, int> > getKmerCounts(string sequence);  //for use in chimeraCheck
@@ -27,6 +27,55 @@
 #include "searchdatabase.hpp"
 #include "kmerdb.hpp"
 
+/**************************************************************************************************/
+//the numbers Kmer::getKmerNumber gives for the first numKmers positions of the sequence, computed as a rolling 2 bit code.
+//A kmer with an N in it is 4^kmerSize and any base other than A, C, G, T, U or N counts as an A.
+static void getKmerNumbers(const string& sequence, int kmerSize, int numKmers, vector<int>& kmerNumbers) {
+	kmerNumbers.clear();
+	if (numKmers <= 0) { return; }
+	
+	int nKmer = 1 << (2*kmerSize);
+	int mask = nKmer - 1;
+	int kmer = 0, lastN = -kmerSize;
+	
+	for (int i = 0; i < numKmers+kmerSize-1; i++) {
+		int code = 0;
+		switch (toupper((unsigned char)sequence[i])) {
+			case 'C': code = 1; break;
+			case 'G': code = 2; break;
+			case 'T': case 'U': code = 3; break;
+			case 'N': lastN = i; break;
+			default: break;
+		}
+		kmer = ((kmer << 2) | code) & mask;
+		
+		if (i >= kmerSize-1) { kmerNumbers.push_back(((i - lastN) < kmerSize) ? nKmer : kmer); }
+	}
+}
+/**************************************************************************************************/
+static inline int getDeltaSize(unsigned int delta) {
+	int size = 1;
+	while (delta >= 128) { delta >>= 7; size++; }
+	return size;
+}
+/**************************************************************************************************/
+static inline int writeDelta(unsigned char* out, unsigned int delta) {
+	int size = 0;
+	while (delta >= 128) { out[size++] = (unsigned char)(delta | 128); delta >>= 7; }
+	out[size++] = (unsigned char)delta;
+	return size;
+}
+/**************************************************************************************************/
+static inline const unsigned char* readDelta(const unsigned char* in, unsigned int& delta) {
+	delta = *in++;
+	if (delta < 128) { return in; } //most of the differences fit in a byte
+	
+	delta &= 127;
+	int shift = 7;
+	while (*in & 128) { delta |= (unsigned int)(*in & 127) << shift; shift += 7; in++; }
+	delta |= (unsigned int)(*in) << shift;
+	return in+1;
+}
 /**************************************************************************************************/
 
 KmerDB::KmerDB(string fastaFileName, int kSize) : SearchDatabase(), kmerSize(kSize) {
@@ -38,7 +87,11 @@ KmerDB::KmerDB(string fastaFileName, int kSize) : SearchDatabase(), kmerSize(kSi
 		count = 0;
 		
 		maxKmer = power4s[kmerSize];
-		kmerLocations.resize(maxKmer+1);
+		kmerStarts.assign(maxKmer+2, 0);
+		lastSeqs.assign(maxKmer+1, -1);
+		numIndexedSeqs = 0;
+		postingData = postings.data(); kmerStartData = kmerStarts.data();
+		index = nullptr;
         
         CurrentFile* current; current = CurrentFile::getInstance();
         version = current->getVersion();
@@ -54,10 +107,13 @@ KmerDB::KmerDB(string fastaFileName, int kSize) : SearchDatabase(), kmerSize(kSi
 KmerDB::KmerDB() : SearchDatabase() {
     CurrentFile* current; current = CurrentFile::getInstance();
     version = current->getVersion();
+    numIndexedSeqs = 0;
+    postingData = nullptr; kmerStartData = nullptr;
+    index = nullptr;
 }
 /**************************************************************************************************/
 
-KmerDB::~KmerDB(){}
+KmerDB::~KmerDB(){ if (index != nullptr) { delete index; } }
 
 /**************************************************************************************************/
 
@@ -66,43 +122,59 @@ vector<int> KmerDB::findClosestSequences(Sequence* candidateSeq, int num, vector
 		if (num > numSeqs) { m->mothurOut("[WARNING]: you requested " + toString(num) + " closest sequences, but the template only contains " + toString(numSeqs) + ", adjusting.\n");  num = numSeqs; }
 		
 		vector<int> topMatches;
-		Kmer kmer(kmerSize);
 		float searchScore = 0;
 		Scores.clear();
 		
-		vector<int> matches(numSeqs, 0);						//	a record of the sequences with shared kmers
-		vector<bool> timesKmerFound(kmerLocations.size()+1, false);	//	a record of the kmers that we have already found
+		//shared by every query this thread searches with
+		thread_local kmerDBScratch scratch;
+		if (scratch.kmerSeen.size() < maxKmer+1) { scratch.kmerSeen.resize(maxKmer+1, 0); }
+		scratch.matches.assign(max(numSeqs, numIndexedSeqs), 0);
+		vector<int>& matches = scratch.matches;					//	a record of the sequences with shared kmers
 		
 		int numKmers = candidateSeq->getNumBases() - kmerSize + 1;	
+		getKmerNumbers(candidateSeq->getUnaligned(), kmerSize, numKmers, scratch.queryKmers);
 	
-		for(int i=0;i<numKmers;i++){
-			int kmerNumber = kmer.getKmerNumber(candidateSeq->getUnaligned(), i);		//	go through the query sequence and get a kmer number
-			if(!timesKmerFound[kmerNumber]){				//	if we haven't seen it before...
-				for(int j=0;j<kmerLocations[kmerNumber].size();j++){//increase the count for each sequence that also has
-					matches[kmerLocations[kmerNumber][j]]++;	//	that kmer
-				}
+		for(int i=0;i<scratch.queryKmers.size();i++){
+			int kmerNumber = scratch.queryKmers[i];					//	go through the query sequence's kmers
+			if(scratch.kmerSeen[kmerNumber]){ continue; }			//	if we haven't seen it before...
+			scratch.kmerSeen[kmerNumber] = 1;
+			
+			const unsigned char* next = postingData + kmerStartData[kmerNumber];
+			const unsigned char* end = postingData + kmerStartData[kmerNumber+1];
+			int seq = -1;
+			while (next != end) {								//	increase the count for each sequence that also has that kmer
+				unsigned int delta; next = readDelta(next, delta);
+				seq += delta;
+				matches[seq]++;
 			}
-			timesKmerFound[kmerNumber] = true;						//	ok, we've seen the kmer now
 		}
 		
 		if (num != 1) {
-			vector<seqMatch> seqMatches; seqMatches.resize(numSeqs);
-			for(int i=0;i<numSeqs;i++){		
-				seqMatches[i].seq = i;
-				seqMatches[i].match = matches[i];
+			//the sequences with the most shared kmers, ties go to the first sequence
+			vector<seqMatch>& candidates = scratch.candidates; candidates.clear();
+			for (int i = 0; i < numSeqs; i++) {
+				if (matches[i] != 0) { candidates.push_back(seqMatch(i, matches[i])); }
+			}
+			for (int i = 0; (i < numSeqs) && (candidates.size() < max(num, 1)); i++) {
+				if (matches[i] == 0) { candidates.push_back(seqMatch(i, 0)); }
 			}
 			
-			//sorts putting largest matches first
-			sort(seqMatches.begin(), seqMatches.end(), compareSeqMatches);
+			int numTop = min(max(num, 1), (int)candidates.size());
+			partial_sort(candidates.begin(), candidates.begin()+numTop, candidates.end(), [](const seqMatch& a, const seqMatch& b) {
+				if (a.match != b.match) { return (a.match > b.match); }
+				return (a.seq < b.seq);
+			});
 			
-			searchScore = seqMatches[0].match;
-			searchScore = 100 * searchScore / (float) numKmers;		//	return the Sequence object corresponding to the db
-            Scores.push_back(searchScore);
+			if (numTop != 0) {
+				searchScore = candidates[0].match;
+				searchScore = 100 * searchScore / (float) numKmers;		//	return the Sequence object corresponding to the db
+				Scores.push_back(searchScore);
+			}
             
 			//save top matches
-			for (int i = 0; i < num; i++) {
-				topMatches.push_back(seqMatches[i].seq);
-				float thisScore = 100 * seqMatches[i].match / (float) numKmers;
+			for (int i = 0; i < min(num, numTop); i++) {
+				topMatches.push_back(candidates[i].seq);
+				float thisScore = 100 * candidates[i].match / (float) numKmers;
 				Scores.push_back(thisScore);
 			}
 		}else{
@@ -122,6 +194,10 @@ vector<int> KmerDB::findClosestSequences(Sequence* candidateSeq, int num, vector
 			topMatches.push_back(bestIndex);
 			Scores.push_back(searchScore);
 		}
+		
+		//ready for the next query
+		for (int i = 0; i < scratch.queryKmers.size(); i++) { scratch.kmerSeen[scratch.queryKmers[i]] = 0; }
+		
 		return topMatches;		
 	}
 	catch(exception& e) {
@@ -134,17 +210,19 @@ vector<int> KmerDB::findClosestSequences(Sequence* candidateSeq, int num, vector
 //print shortcut file
 void KmerDB::generateDB(){
 	try {
+		packPostings();
 		
-		ofstream kmerFile;										//	once we have the kmerLocations folder print it out
+		ofstream kmerFile;										//	once we have the postings print them out
 		util.openOutputFile(kmerDBName, kmerFile);					//	to a file
 		
 		//output version
 		kmerFile << "#" << version << endl;
 		
 		for(int i=0;i<maxKmer;i++){								//	step through all of the possible kmer numbers
-			kmerFile << i << ' ' << kmerLocations[i].size();	//	print the kmer number and the number of sequences with
-			for(int j=0;j<kmerLocations[i].size();j++){			//	that kmer.  then print out the indices of the sequences
-				kmerFile << ' ' << kmerLocations[i][j];			//	with that kmer.
+			vector<int> seqs = getSequencesWithKmer(i);
+			kmerFile << i << ' ' << seqs.size();				//	print the kmer number and the number of sequences with
+			for(int j=0;j<seqs.size();j++){						//	that kmer.  then print out the indices of the sequences
+				kmerFile << ' ' << seqs[j];						//	with that kmer.
 			}
 			kmerFile << endl;
 		}
@@ -160,21 +238,22 @@ void KmerDB::generateDB(){
 /**************************************************************************************************/
 void KmerDB::addSequence(Sequence seq) {
 	try {
-		Kmer kmer(kmerSize);
-		
 		string unaligned = seq.getUnaligned();	//	...take the unaligned sequence...
 		int numKmers = unaligned.length() - kmerSize + 1;
-			
-		vector<int> seenBefore(maxKmer+1,0);
-		for(int j=0;j<numKmers;j++){						//	...step though the sequence and get each kmer...
-			int kmerNumber = kmer.getKmerNumber(unaligned, j);
-			if(seenBefore[kmerNumber] == 0){
-				kmerLocations[kmerNumber].push_back(count);		//	...insert the sequence index into kmerLocations for
-			}												//	the appropriate kmer number
-			seenBefore[kmerNumber] = 1;
+		
+		vector<int> kmerNumbers;
+		getKmerNumbers(unaligned, kmerSize, numKmers, kmerNumbers);
+		
+		for(int j=0;j<kmerNumbers.size();j++){				//	...step though the sequence and get each kmer...
+			int kmerNumber = kmerNumbers[j];
+			if(lastSeqs[kmerNumber] != count){				//	...add the sequence index to the postings for
+				addPosting(kmerNumber, count);				//	the appropriate kmer number
+			}
 		}													
 	
 		count++;
+		
+		if (pendingKmers.size() >= 4194304) { packPostings(); } //keeps the unpacked sequences from taking more space than the postings
 	}
 	catch(exception& e) {
 		m->errorOut(e, "KmerDB", "addSequence");
@@ -182,6 +261,17 @@ void KmerDB::addSequence(Sequence seq) {
 	}	
 }
 /**************************************************************************************************/
+void KmerDB::setNumSeqs(int i) {
+	try {
+		packPostings();
+		numSeqs = i;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "KmerDB", "setNumSeqs");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
 //reads fasta file
 void KmerDB::readSeqs(ifstream& fastaFile){
     try {
@@ -212,32 +302,102 @@ void KmerDB::readDB(ifstream& kmerDBFile){
 		string line = util.getline(kmerDBFile); gobble(kmerDBFile);
 		
 		string seqName;
-		int seqNumber;
+		vector<int> seqNumbers;
 
 		for(int i=0;i<maxKmer;i++){
 			int numValues = 0;	
 			kmerDBFile >> seqName >> numValues;
 			
+			seqNumbers.resize(numValues);
 			for(int j=0;j<numValues;j++){						//	for each kmer number get the...
-				kmerDBFile >> seqNumber;						//		1. number of sequences with the kmer number
-				kmerLocations[i].push_back(seqNumber);			//		2. sequence indices
-			}
+				kmerDBFile >> seqNumbers[j];					//		1. number of sequences with the kmer number
+			}													//		2. sequence indices
+			
+			sort(seqNumbers.begin(), seqNumbers.end());
+			for(int j=0;j<numValues;j++){ addPosting(i, seqNumbers[j]); }
 		}
 		kmerDBFile.close();
 		
+		packPostings();
 	}
 	catch(exception& e) {
 		m->errorOut(e, "KmerDB", "readDB");
 		exit(1);
 	}	
 }
-
+/**************************************************************************************************/
+//sequences must be added to a kmer in increasing order
+void KmerDB::addPosting(int kmerNumber, int seq) {
+	pendingKmers.push_back(kmerNumber);
+	pendingDeltas.push_back(seq - lastSeqs[kmerNumber]);
+	lastSeqs[kmerNumber] = seq;
+	numIndexedSeqs = max(numIndexedSeqs, seq+1);
+}
+/**************************************************************************************************/
+//moves the pending sequences to the end of their kmers' postings
+void KmerDB::packPostings() {
+	try {
+		if (pendingKmers.size() == 0) { return; }
+		
+		vector<long long> newStarts(maxKmer+2, 0);
+		for (int i = 0; i <= maxKmer; i++) { newStarts[i+1] = kmerStarts[i+1] - kmerStarts[i]; }
+		for (long long i = 0; i < pendingKmers.size(); i++) { newStarts[pendingKmers[i]+1] += getDeltaSize(pendingDeltas[i]); }
+		for (int i = 0; i <= maxKmer; i++) { newStarts[i+1] += newStarts[i]; }
+		
+		vector<unsigned char> newPostings(newStarts[maxKmer+1], 0);
+		vector<long long> ends(newStarts.begin(), newStarts.end()-1);
+		for (int i = 0; i <= maxKmer; i++) {
+			long long size = kmerStarts[i+1] - kmerStarts[i];
+			if (size != 0) { memcpy(&newPostings[ends[i]], &postings[kmerStarts[i]], size); }
+			ends[i] += size;
+		}
+		for (long long i = 0; i < pendingKmers.size(); i++) {
+			int kmerNumber = pendingKmers[i];
+			ends[kmerNumber] += writeDelta(&newPostings[ends[kmerNumber]], pendingDeltas[i]);
+		}
+		
+		postings.swap(newPostings);
+		kmerStarts.swap(newStarts);
+		postingData = postings.data(); kmerStartData = kmerStarts.data();
+		vector<int> emptyKmers, emptyDeltas;
+		pendingKmers.swap(emptyKmers); pendingDeltas.swap(emptyDeltas);
+	}
+	catch(exception& e) {
+		m->errorOut(e, "KmerDB", "packPostings");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+void KmerDB::setIndex(ReferenceIndex* referenceIndex) {
+	try {
+		index = referenceIndex;
+		postingData = index->getPostings();
+		kmerStartData = index->getKmerStarts();
+		numIndexedSeqs = index->getNumSeqs();
+		count = numIndexedSeqs;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "KmerDB", "setIndex");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+bool KmerDB::writeIndex(ReferenceIndex* referenceIndex) {
+	try {
+		packPostings();
+		return referenceIndex->write(postingData, kmerStartData);
+	}
+	catch(exception& e) {
+		m->errorOut(e, "KmerDB", "writeIndex");
+		exit(1);
+	}
+}
 /**************************************************************************************************/
 int KmerDB::getCount(int kmer) {
 	try {
 		if (kmer < 0) { return 0; }  //if user gives negative number
 		else if (kmer > maxKmer) {	return 0;	}  //or a kmer that is bigger than maxkmer
-		else {	return kmerLocations[kmer].size();	}  // kmer is in vector range
+		else {	return getSequencesWithKmer(kmer).size();	}  // kmer is in vector range
 	}
 	catch(exception& e) {
 		m->errorOut(e, "KmerDB", "getCount");
@@ -266,7 +426,18 @@ vector<int> KmerDB::getSequencesWithKmer(int kmer) {
 	
 		if (kmer < 0) { }  //if user gives negative number
 		else if (kmer > maxKmer) {	}  //or a kmer that is bigger than maxkmer
-		else {	seqs = kmerLocations[kmer];	}
+		else {
+			packPostings();
+			
+			const unsigned char* next = postingData + kmerStartData[kmer];
+			const unsigned char* end = postingData + kmerStartData[kmer+1];
+			int seq = -1;
+			while (next != end) {
+				unsigned int delta; next = readDelta(next, delta);
+				seq += delta;
+				seqs.push_back(seq);
+			}
+		}
 		
 		return seqs;
 	}
@@ -10,8 +10,10 @@
  *
  *	This class is a child class of the Database class, which stores the template sequences as a kmer table and provides
  *	a method of searching the kmer table for the sequence with the most kmers in common with a query sequence.
- *	kmerLocations is the primary storage variable that is a two-dimensional vector where each row represents the
- *	different number of kmers and each column contains the index to sequences that use that kmer.
+ *	postings is the primary storage variable. It holds the indexes of the sequences that use each kmer, one kmer after
+ *	another, in increasing order. Each index is stored as the difference from the one before it, 7 bits to a byte with
+ *	the high bit set on all but the last byte. Kmer i's sequences are postings[kmerStarts[i]] to postings[kmerStarts[i+1]-1].
+ *	The postings can also be searched where they are in a mapped ReferenceIndex, without reading the shortcut file.
  *
  *	Construction of an object of this type will first look for an appropriately named database file and if it is found
  *	then will read in the database file (readKmerDB), otherwise it will generate one and store the data in memory
@@ -21,6 +23,17 @@
 
 #include "mothur.h"
 #include "searchdatabase.hpp"
+#include "referenceindex.hpp"
+
+/**************************************************************************************************/
+//working space for searching with one query, reused by each thread so the database can be shared without allocating per query
+struct kmerDBScratch {
+	vector<int> queryKmers;
+	vector<char> kmerSeen;          //one per kmer, cleared after each query
+	vector<int> matches;            //one per sequence
+	vector<seqMatch> candidates;
+};
+/**************************************************************************************************/
 
 class KmerDB : public SearchDatabase {
 	
@@ -31,6 +44,7 @@ public:
 	
 	void generateDB();
 	void addSequence(Sequence);
+	void setNumSeqs(int); //call when all the sequences are added, before searching
 	vector<int> findClosestSequences(Sequence*, int, vector<float>&) const;
 	void readDB(ifstream&); //reads in a shortcut file
     void readSeqs(ifstream&); //reads in a fasta file
@@ -38,6 +52,8 @@ public:
 	vector<int> getSequencesWithKmer(int);  //returns vector of sequences that contain kmer passed in
 	int getReversed(int);  //returns reverse compliment kmerNumber 
 	int getMaxKmer() { return maxKmer; }
+	void setIndex(ReferenceIndex*); //searches the index's postings, the database deletes the index
+	bool writeIndex(ReferenceIndex*); //writes the postings to an index the sequences were added to
 	
 private:
 	
@@ -45,7 +61,22 @@ private:
 	int kmerSize;
 	int maxKmer, count;
 	string kmerDBName;
-	vector<vector<int> > kmerLocations;
+	
+	vector<unsigned char> postings;
+	vector<long long> kmerStarts;   //maxKmer+2 of them, the N kmer is maxKmer
+	int numIndexedSeqs;             //largest sequence index in postings + 1
+	
+	//what the search reads, the packed postings or the index's
+	const unsigned char* postingData;
+	const long long* kmerStartData;
+	ReferenceIndex* index;
+	
+	//sequences added since the postings were packed, as (kmer, difference from the kmer's last sequence)
+	vector<int> pendingKmers, pendingDeltas;
+	vector<int> lastSeqs;           //kmer -> last sequence added with it, -1 if none
+	
+	void addPosting(int, int); //kmer, seq
+	void packPostings();
 };
 
 #endif
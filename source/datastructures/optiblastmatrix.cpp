@@ -41,8 +41,8 @@ int OptiBlastMatrix::readBlast(){
         if (namefile != "") { util.readNames(namefile, nameAssignment); }
         else if (countfile != "") {
             CountTable ct; ct.readTable(countfile, false, true);
-            map<string, int> temp = ct.getNameMap();
-            for (map<string, int>::iterator it = temp.begin(); it!= temp.end(); it++) {  nameAssignment[it->first] = it->second; }
+            vector<countTableSeq> seqs = ct.getSeqs();
+            for (int i = 0; i < seqs.size(); i++) {  nameAssignment[seqs[i].getName()] = seqs[i].total; }
         }
         else { readBlastNames(nameAssignment);  }
         int count = 0;
@@ -407,8 +407,7 @@ int OptiBlastMatrix::readBlast(){
                                 
                                 int newB = singletonIndexSwap[indexB];
                                 int newA = singletonIndexSwap[indexA];
-                                closeness[newA].insert(newB);
-                                closeness[newB].insert(newA);
+                                closeness.addPair(newA, newB);
                             }
                             //not going to need this again
                             dists[itB->second].erase(itDist);
@@ -479,8 +478,7 @@ int OptiBlastMatrix::readBlast(){
                     
                     int newB = singletonIndexSwap[indexB];
                     int newA = singletonIndexSwap[indexA];
-                    closeness[newA].insert(newB);
-                    closeness[newB].insert(newA);
+                    closeness.addPair(newA, newB);
                 }
                 //not going to need this again
                 dists[itB->second].erase(itDist);
@@ -492,6 +490,7 @@ int OptiBlastMatrix::readBlast(){
         thisRowsBlastScores.clear();
         dists.clear();
         nameAssignment.clear();
+        closeness.build();
         
         m->mothurOut(" done.\n");
         
@@ -0,0 +1,101 @@
+//
+//  opticloseness.cpp
+//  Mothur
+//
+//  Created by agent on 10/17/26.
+//  Copyright © 2026 Schloss Lab. All rights reserved.
+//
+
+#include "opticloseness.hpp"
+
+/***********************************************************************/
+void OptiCloseness::clear() {
+    numSeqs = 0;
+    vector< pair<unsigned int, unsigned int> > emptyPairs; pairs.swap(emptyPairs);
+    vector<unsigned long long> emptyOffsets; offsets.swap(emptyOffsets);
+    vector<unsigned int> emptyNeighbors; neighbors.swap(emptyNeighbors);
+    vector<unsigned long long> emptyDense; dense.swap(emptyDense);
+}
+/***********************************************************************/
+void OptiCloseness::build() {
+    try {
+        //count each pair in both rows
+        offsets.assign(numSeqs+1, 0);
+        for (long long k = 0; k < pairs.size(); k++) { offsets[pairs[k].first+1]++; offsets[pairs[k].second+1]++; }
+        for (long long i = 0; i < numSeqs; i++) { offsets[i+1] += offsets[i]; }
+
+        neighbors.resize(offsets[numSeqs]);
+        vector<unsigned long long> next(offsets.begin(), offsets.end()-1);
+        for (long long k = 0; k < pairs.size(); k++) {
+            neighbors[next[pairs[k].first]++] = pairs[k].second;
+            neighbors[next[pairs[k].second]++] = pairs[k].first;
+        }
+        vector< pair<unsigned int, unsigned int> > emptyPairs; pairs.swap(emptyPairs);
+        vector<unsigned long long> emptyNext; next.swap(emptyNext);
+
+        //sort the rows and remove pairs found twice, like a lt and square file or a column file with both A B and B A
+        unsigned long long spot = 0;
+        for (long long i = 0; i < numSeqs; i++) {
+            unsigned int* rowStart = neighbors.data() + offsets[i];
+            unsigned int* rowEnd = neighbors.data() + offsets[i+1];
+            sort(rowStart, rowEnd);
+            unsigned int* uniqueEnd = unique(rowStart, rowEnd);
+
+            offsets[i] = spot;
+            for (unsigned int* it = rowStart; it != uniqueEnd; it++) { neighbors[spot] = *it; spot++; }
+        }
+        offsets[numSeqs] = spot;
+        neighbors.resize(spot); neighbors.shrink_to_fit();
+
+        buildDense();
+    }
+    catch(exception& e) {
+        MothurOut::getInstance()->errorOut(e, "OptiCloseness", "build");
+        exit(1);
+    }
+}
+/***********************************************************************/
+void OptiCloseness::assign(const vector< set<long long> >& close) {
+    try {
+        clear();
+        numSeqs = close.size();
+
+        offsets.assign(numSeqs+1, 0);
+        for (long long i = 0; i < numSeqs; i++) { offsets[i+1] = offsets[i] + close[i].size(); }
+
+        neighbors.reserve(offsets[numSeqs]);
+        for (long long i = 0; i < numSeqs; i++) {
+            for (set<long long>::const_iterator it = close[i].begin(); it != close[i].end(); it++) { neighbors.push_back((unsigned int)*it); }
+        }
+
+        buildDense();
+    }
+    catch(exception& e) {
+        MothurOut::getInstance()->errorOut(e, "OptiCloseness", "assign");
+        exit(1);
+    }
+}
+/***********************************************************************/
+//only worth it if the bit matrix is no bigger than the neighbor list
+void OptiCloseness::buildDense() {
+    try {
+        vector<unsigned long long> emptyDense; dense.swap(emptyDense);
+
+        unsigned long long numBits = (unsigned long long)numSeqs * numSeqs;
+        unsigned long long denseBytes = (numBits + 63) / 64 * sizeof(unsigned long long);
+        if ((numSeqs == 0) || (denseBytes > (neighbors.size() * sizeof(unsigned int)))) { return; }
+
+        dense.assign((numBits + 63) / 64, 0);
+        for (long long i = 0; i < numSeqs; i++) {
+            for (unsigned long long k = offsets[i]; k < offsets[i+1]; k++) {
+                unsigned long long bit = (unsigned long long)i * numSeqs + neighbors[k];
+                dense[bit >> 6] |= (1ULL << (bit & 63));
+            }
+        }
+    }
+    catch(exception& e) {
+        MothurOut::getInstance()->errorOut(e, "OptiCloseness", "buildDense");
+        exit(1);
+    }
+}
+/***********************************************************************/
@@ -0,0 +1,69 @@
+//
+//  opticloseness.hpp
+//  Mothur
+//
+//  Created by agent on 10/17/26.
+//  Copyright © 2026 Schloss Lab. All rights reserved.
+//
+
+#ifndef opticloseness_hpp
+#define opticloseness_hpp
+
+#include "mothurout.h"
+
+/**************************************************************************************************/
+//sorted indexes of the seqs close to one seq, iterates like the set it replaces without copying
+struct closeSeqs {
+    const unsigned int* first;
+    const unsigned int* last;
+
+    closeSeqs() : first(nullptr), last(nullptr) {}
+    closeSeqs(const unsigned int* f, const unsigned int* l) : first(f), last(l) {}
+
+    const unsigned int* begin() const   { return first;             }
+    const unsigned int* end() const     { return last;              }
+    long long size() const              { return (long long)(last - first); }
+    bool empty() const                  { return (first == last);   }
+    long long count(long long j) const  { return binary_search(first, last, (unsigned int)j) ? 1 : 0; }
+};
+/**************************************************************************************************/
+
+//  OptiCloseness stores which seqs are within the cutoff of each other as a compressed sparse row
+//  adjacency list, 32-bit neighbor indexes sorted within each row. The readers add each close pair
+//  once with addPair and call build when the file is read. When the matrix is dense enough that a
+//  bit matrix is no bigger than the neighbor list, isClose uses the bit matrix instead of searching the row.
+
+class OptiCloseness {
+
+public:
+    OptiCloseness() : numSeqs(0) {}
+    ~OptiCloseness() = default;
+
+    void resize(long long n) { clear(); numSeqs = n; offsets.assign(n+1, 0); } //starts a new matrix with n seqs
+    void clear();
+    void addPair(long long i, long long j) { pairs.push_back(pair<unsigned int, unsigned int>((unsigned int)i, (unsigned int)j)); }
+    void build(); //turns the pairs added into rows, removing duplicate pairs
+    void assign(const vector< set<long long> >&);
+
+    long long size() const                      { return numSeqs; }
+    long long getNumClose(long long i) const    { return (long long)(offsets[i+1] - offsets[i]); }
+    long long getNumDists() const               { return (long long)neighbors.size(); } //each dist is counted for both seqs
+    closeSeqs operator[](long long i) const     { return closeSeqs(neighbors.data()+offsets[i], neighbors.data()+offsets[i+1]); }
+
+    bool isClose(long long i, long long j) const {
+        if (!dense.empty()) { unsigned long long bit = (unsigned long long)i * numSeqs + j; return ((dense[bit >> 6] >> (bit & 63)) & 1); }
+        return binary_search(neighbors.data()+offsets[i], neighbors.data()+offsets[i+1], (unsigned int)j);
+    }
+
+private:
+    long long numSeqs;
+    vector< pair<unsigned int, unsigned int> > pairs; //filled while reading, released by build
+    vector<unsigned long long> offsets; //numSeqs+1, row i is neighbors[offsets[i]] to neighbors[offsets[i+1]-1]
+    vector<unsigned int> neighbors;
+    vector<unsigned long long> dense; //numSeqs * numSeqs bits, empty if the matrix is sparse
+
+    void buildDense();
+};
+/**************************************************************************************************/
+
+#endif /* opticloseness_hpp */
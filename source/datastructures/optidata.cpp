@@ -14,7 +14,8 @@ long long OptiData::print(ostream& out) {
         long long count = 0;
         for (long long i = 0; i < closeness.size(); i++) {
             out << i << '\t' << getName(i) << '\t';
-            for(set<long long>::iterator it = closeness[i].begin(); it != closeness[i].end(); it++){
+            closeSeqs thisSeqsCloseSeqs = closeness[i];
+            for(const unsigned int* it = thisSeqsCloseSeqs.begin(); it != thisSeqsCloseSeqs.end(); it++){
                 out << *it << '\t';
                 count++;
             }
@@ -33,7 +34,7 @@ long long OptiData::getNumClose(long long index) {
     try {
         if (index < 0) { return 0; }
         else if (index > closeness.size()) { m->mothurOut("[ERROR]: index is not valid.\n"); m->setControl_pressed(true); return 0; }
-        else { return closeness[index].size(); }
+        else { return closeness.getNumClose(index); }
     }
     catch(exception& e) {
         m->errorOut(e, "OptiData", "getNumClose");
@@ -46,9 +47,7 @@ bool OptiData::isClose(long long i, long long toFind){
         if (i < 0) { return false; }
         else if (i > closeness.size()) { m->mothurOut("[ERROR]: index is not valid.\n"); m->setControl_pressed(true); return false; }
         
-        bool found = false;
-        if (closeness[i].count(toFind) != 0) { found = true; }
-        return found;
+        return closeness.isClose(i, toFind);
     }
     catch(exception& e) {
         m->errorOut(e, "OptiData", "isClose");
@@ -56,10 +55,10 @@ bool OptiData::isClose(long long i, long long toFind){
     }
 }
 /***********************************************************************/
-set<long long> OptiData::getCloseSeqs(long long i){
+closeSeqs OptiData::getCloseSeqs(long long i){
     try {
-        if (i < 0) { set<long long> temp; return temp; }
-        else if (i > closeness.size()) { m->mothurOut("[ERROR]: index is not valid.\n"); m->setControl_pressed(true); set<long long> temp; return temp; }
+        if (i < 0) { closeSeqs temp; return temp; }
+        else if (i > closeness.size()) { m->mothurOut("[ERROR]: index is not valid.\n"); m->setControl_pressed(true); closeSeqs temp; return temp; }
         
         return closeness[i];
     }
@@ -136,9 +135,7 @@ set<string> OptiData::getNames(set<long long> indexes) {
 /***********************************************************************/
 long long OptiData::getNumDists(){
     try {
-        long long foundDists = 0;
-        for (int i = 0; i < closeness.size(); i++) { foundDists += closeness[i].size(); }
-        return foundDists;
+        return closeness.getNumDists();
     }
     catch(exception& e) {
         m->errorOut(e, "OptiData", "getNumDists");
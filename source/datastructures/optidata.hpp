@@ -13,6 +13,7 @@
 #include "listvector.hpp"
 #include "sparsedistancematrix.h"
 #include "counttable.h"
+#include "opticloseness.hpp"
 
 
 /*
@@ -28,7 +29,7 @@ public:
     OptiData(double c)  { m = MothurOut::getInstance(); cutoff = c; }
     virtual ~OptiData(){}
     
-    set<long long> getCloseSeqs(long long i);
+    closeSeqs getCloseSeqs(long long i);
     bool isClose(long long, long long);
     long long getNumClose(long long);
     map<string, long long> getNameIndexMap();
@@ -69,7 +70,7 @@ public:
     
 protected:
     Utils util; MothurOut* m;
-    vector< set<long long> > closeness;  //closeness[0] contains indexes of seqs "close" to seq 0.
+    OptiCloseness closeness;  //closeness[0] contains indexes of seqs "close" to seq 0.
     vector<string> singletons; //name of seqs with NO distances in matrix, if name file is given then it contains 2nd column of namefile
     vector<string> nameMap;  //name of seqs with distances in matrix, if name file is given then it contains 2nd column of namefile
     double cutoff;
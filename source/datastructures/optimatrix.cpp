@@ -11,7 +11,7 @@
 
 /***********************************************************************/
 OptiMatrix::OptiMatrix(vector< set<long long> > close, vector<string> name, vector<string> single, double c) : OptiData(c) {
-    closeness = close;
+    closeness.assign(close);
     nameMap = name;
     singletons = single;
 }
@@ -146,8 +146,7 @@ int OptiMatrix::readPhylip(){
                     if(distance <= cutoff){
                         long long newB = singletonIndexSwap[j];
                         long long newA = singletonIndexSwap[i];
-                        closeness[newA].insert(newB);
-                        closeness[newB].insert(newA);
+                        closeness.addPair(newA, newB);
                     }
                     index++; 
                 }
@@ -173,14 +172,14 @@ int OptiMatrix::readPhylip(){
                     if(distance <= cutoff && j < i){
                         long long newB = singletonIndexSwap[j];
                         long long newA = singletonIndexSwap[i];
-                        closeness[newA].insert(newB);
-                        closeness[newB].insert(newA);
+                        closeness.addPair(newA, newB);
                     }
                     index++; 
                 }
             }
         }
         in.close();
+        closeness.build();
         
         return 0;
     }
@@ -191,15 +190,16 @@ int OptiMatrix::readPhylip(){
 }
 /***********************************************************************/
 
-int OptiMatrix::readColumn(){
+//numbers the seqs in the name or count file in name order and fills nameMap
+map<string, long long> OptiMatrix::readNameAssignment(){
     try {
         Utils util;
         map<string, long long> nameAssignment;
         if (namefile != "") { util.readNames(namefile, nameAssignment); }
         else  {
             CountTable ct; ct.readTable(countfile, false, true);
-            map<string, int> temp = ct.getNameMap();
-            for (map<string, int>::iterator it = temp.begin(); it!= temp.end(); it++) {  nameAssignment[it->first] = it->second; }
+            vector<countTableSeq> seqs = ct.getSeqs();
+            for (int i = 0; i < seqs.size(); i++) {  nameAssignment[seqs[i].getName()] = seqs[i].total; }
         }
         long long count = 0;
         for (map<string, long long>::iterator it = nameAssignment.begin(); it!= nameAssignment.end(); it++) {
@@ -207,6 +207,52 @@ int OptiMatrix::readColumn(){
             nameMap.push_back(it->first);
         }
         
+        return nameAssignment;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "OptiMatrix", "readNameAssignment");
+        exit(1);
+    }
+}
+/***********************************************************************/
+//saves the singletons, sizes closeness for the rest and returns the new index of each seq, -1 for singletons.
+//names is filled with the redundant names when reading a name file.
+vector<long long> OptiMatrix::removeSingletons(vector<bool>& singleton, map<string, string>& names){
+    try {
+        vector<long long> singletonIndexSwap(singleton.size(), -1);
+        long long nonSingletonCount = 0;
+        for (long long i = 0; i < singleton.size(); i++) {
+            if (!singleton[i]) { //if you are a singleton
+                singletonIndexSwap[i] = nonSingletonCount;
+                nonSingletonCount++;
+            }else { singletons.push_back(nameMap[i]); }
+        }
+        singleton.clear();
+        
+        closeness.resize(nonSingletonCount);
+        
+        if (namefile != "") {
+            Utils util; util.readNames(namefile, names);
+            for (long long i = 0; i < singletons.size(); i++) {
+                singletons[i] = names[singletons[i]];
+            }
+        }
+        
+        return singletonIndexSwap;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "OptiMatrix", "removeSingletons");
+        exit(1);
+    }
+}
+/***********************************************************************/
+int OptiMatrix::readColumn(){
+    try {
+        if (BinaryDistFile::isBinary(distFile)) { return readBinaryColumn(); }
+        
+        Utils util;
+        map<string, long long> nameAssignment = readNameAssignment();
+        
         string firstName, secondName;
         float distance;
         
@@ -214,7 +260,6 @@ int OptiMatrix::readColumn(){
         ifstream fileHandle;
         util.openInputFile(distFile, fileHandle);
         vector<bool> singleton; singleton.resize(nameAssignment.size(), true);
-        map<long long, long long> singletonIndexSwap;
         while(fileHandle){  //let's assume it's a triangular matrix...
             
             fileHandle >> firstName; gobble(fileHandle);
@@ -235,35 +280,15 @@ int OptiMatrix::readColumn(){
                 if(itA == nameAssignment.end()){  m->mothurOut("AAError: Sequence '" + firstName + "' was not found in the name or count file, please correct\n"); exit(1);  }
                 if(itB == nameAssignment.end()){  m->mothurOut("ABError: Sequence '" + secondName + "' was not found in the name or count file, please correct\n"); exit(1);  }
 
-                long long indexA = (itA->second);
-                long long indexB = (itB->second);
-                singleton[indexA] = false;
-                singleton[indexB] = false;
-                singletonIndexSwap[indexA] = indexA;
-                singletonIndexSwap[indexB] = indexB;
+                singleton[itA->second] = false;
+                singleton[itB->second] = false;
             }
         }
         fileHandle.close();
         //////////////////////////////////////////////////////////////////////////
         
-        long long nonSingletonCount = 0;
-        for (long long i = 0; i < singleton.size(); i++) {
-            if (!singleton[i]) { //if you are a singleton
-                singletonIndexSwap[i] = nonSingletonCount;
-                nonSingletonCount++;
-            }else { singletons.push_back(nameMap[i]); }
-        }
-        singleton.clear();
-        
-        closeness.resize(nonSingletonCount);
-        
         map<string, string> names;
-        if (namefile != "") {
-            util.readNames(namefile, names);
-            for (long long i = 0; i < singletons.size(); i++) {
-                singletons[i] = names[singletons[i]];
-            }
-        }
+        vector<long long> singletonIndexSwap = removeSingletons(singleton, names);
         
         ifstream in; util.openInputFile(distFile, in);
         
@@ -281,19 +306,9 @@ int OptiMatrix::readColumn(){
             else if (sim) { distance = 1.0 - distance;  }  //user has entered a sim matrix that we need to convert.
             
             if(distance <= cutoff){
-                map<string,long long>::iterator itA = nameAssignment.find(firstName);
-                map<string,long long>::iterator itB = nameAssignment.find(secondName);
-                
-                if(itA == nameAssignment.end()){  m->mothurOut("AAError: Sequence '" + firstName + "' was not found in the name or count file, please correct\n"); exit(1);  }
-                if(itB == nameAssignment.end()){  m->mothurOut("ABError: Sequence '" + secondName + "' was not found in the name or count file, please correct\n"); exit(1);  }
-
-                long long indexA = (itA->second);
-                long long indexB = (itB->second);
-                
-                long long newB = singletonIndexSwap[indexB];
-                long long newA = singletonIndexSwap[indexA];
-                closeness[newA].insert(newB);
-                closeness[newB].insert(newA);
+                long long newA = singletonIndexSwap[nameAssignment[firstName]];
+                long long newB = singletonIndexSwap[nameAssignment[secondName]];
+                closeness.addPair(newA, newB);
                 
                 if (namefile != "") {
                     firstName = names[firstName];  //redundant names
@@ -306,6 +321,7 @@ int OptiMatrix::readColumn(){
         }
         in.close();
         nameAssignment.clear();
+        closeness.build();
         
         return 1;
         
@@ -317,5 +333,83 @@ int OptiMatrix::readColumn(){
 }
 
 /***********************************************************************/
-
-
+//same as readColumn, but the names are looked up once per sequence in the binary file instead of once per distance,
+//and the distances are read in place from the mapped file
+int OptiMatrix::readBinaryColumn(){
+    try {
+        map<string, long long> nameAssignment = readNameAssignment();
+        
+        BinaryDistFile distMatrix;
+        if (!distMatrix.read(distFile)) { return 0; }
+        
+        //index in the name or count file for each sequence in the distance file, -1 if not found
+        long long numDistSeqs = distMatrix.getNumSeqs();
+        vector<long long> distIndexes(numDistSeqs, -1);
+        for (long long i = 0; i < numDistSeqs; i++) {
+            map<string,long long>::iterator it = nameAssignment.find(distMatrix.getName(i));
+            if (it != nameAssignment.end()) { distIndexes[i] = it->second; }
+        }
+        nameAssignment.clear();
+        
+        ///////////////////// Read to eliminate singletons ///////////////////////
+        vector<bool> singleton; singleton.resize(nameMap.size(), true);
+        for (long long i = 0; i < numDistSeqs; i++) {
+            
+            if (m->getControl_pressed()) {  return 0; }
+            
+            for (long long k = distMatrix.getRowStart(i); k < distMatrix.getRowEnd(i); k++) {
+                float distance = distMatrix.getDist(k);
+                if (sim) { distance = 1.0 - distance;  }  //user has entered a sim matrix that we need to convert.
+                
+                if(distance <= cutoff){
+                    long long indexA = distIndexes[i];
+                    long long indexB = distIndexes[distMatrix.getCol(k)];
+                    
+                    if(indexA == -1){  m->mothurOut("AAError: Sequence '" + distMatrix.getName(i) + "' was not found in the name or count file, please correct\n"); exit(1);  }
+                    if(indexB == -1){  m->mothurOut("ABError: Sequence '" + distMatrix.getName(distMatrix.getCol(k)) + "' was not found in the name or count file, please correct\n"); exit(1);  }
+                    
+                    singleton[indexA] = false;
+                    singleton[indexB] = false;
+                }
+            }
+        }
+        //////////////////////////////////////////////////////////////////////////
+        
+        map<string, string> names;
+        vector<long long> singletonIndexSwap = removeSingletons(singleton, names);
+        
+        vector<string> seqNames = nameMap;
+        if (namefile != "") { for (long long i = 0; i < seqNames.size(); i++) { seqNames[i] = names[seqNames[i]]; } } //redundant names
+        
+        for (long long i = 0; i < numDistSeqs; i++) {
+            
+            if (m->getControl_pressed()) {  return 0; }
+            
+            for (long long k = distMatrix.getRowStart(i); k < distMatrix.getRowEnd(i); k++) {
+                float distance = distMatrix.getDist(k);
+                if (sim) { distance = 1.0 - distance;  }  //user has entered a sim matrix that we need to convert.
+                
+                if(distance <= cutoff){
+                    long long indexA = distIndexes[i];
+                    long long indexB = distIndexes[distMatrix.getCol(k)];
+                    
+                    long long newB = singletonIndexSwap[indexB];
+                    long long newA = singletonIndexSwap[indexA];
+                    closeness.addPair(newA, newB);
+                    
+                    nameMap[newA] = seqNames[indexA];
+                    nameMap[newB] = seqNames[indexB];
+                }
+            }
+        }
+        closeness.build();
+        
+        return 1;
+        
+    }
+    catch(exception& e) {
+        m->errorOut(e, "OptiMatrix", "readBinaryColumn");
+        exit(1);
+    }
+}
+/***********************************************************************/
@@ -10,6 +10,7 @@
 #define __Mothur__optimatrix__
 
 #include "optidata.hpp"
+#include "binarydist.h"
 /*
 #ifdef UNIT_TEST
     OptiMatrix() : OptiData(0.03) {};
@@ -30,6 +31,9 @@ protected:
 
     int readPhylip();
     int readColumn();
+    int readBinaryColumn();
+    map<string, long long> readNameAssignment();
+    vector<long long> removeSingletons(vector<bool>&, map<string, string>&);
 };
 
 
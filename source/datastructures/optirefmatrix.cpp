@@ -96,8 +96,8 @@ OptiData* OptiRefMatrix::extractRefMatrix() {
             thisNameMap[seqNum] = count;
             nonSingletonNameMap[count] = seqNum;
             
-            set<long long> thisSeqsCloseSeqs = getCloseSeqs(seqNum);
-            for (set<long long>::iterator itClose = thisSeqsCloseSeqs.begin(); itClose != thisSeqsCloseSeqs.end(); itClose++) {
+            closeSeqs thisSeqsCloseSeqs = getCloseSeqs(seqNum);
+            for (const unsigned int* itClose = thisSeqsCloseSeqs.begin(); itClose != thisSeqsCloseSeqs.end(); itClose++) {
                 
                 if (m->getControl_pressed()) { break; }
                 
@@ -125,9 +125,9 @@ OptiData* OptiRefMatrix::extractRefMatrix() {
             
             long long seqNum = *it;
             
-            set<long long> thisSeqsCloseSeqs = getCloseSeqs(seqNum);
+            closeSeqs thisSeqsCloseSeqs = getCloseSeqs(seqNum);
             set<long long> thisSeqsCloseUnFittedSeqs;
-            for (set<long long>::iterator itClose = thisSeqsCloseSeqs.begin(); itClose != thisSeqsCloseSeqs.end(); itClose++) {
+            for (const unsigned int* itClose = thisSeqsCloseSeqs.begin(); itClose != thisSeqsCloseSeqs.end(); itClose++) {
                 
                 if (m->getControl_pressed()) { break; }
                 
@@ -186,8 +186,8 @@ OptiData* OptiRefMatrix::extractMatrixSubset(set<long long> & seqs) {
             thisNameMap[seqNum] = count;
             nonSingletonNameMap[count] = seqNum;
             
-            set<long long> thisSeqsCloseSeqs = getCloseSeqs(seqNum);
-            for (set<long long>::iterator itClose = thisSeqsCloseSeqs.begin(); itClose != thisSeqsCloseSeqs.end(); itClose++) {
+            closeSeqs thisSeqsCloseSeqs = getCloseSeqs(seqNum);
+            for (const unsigned int* itClose = thisSeqsCloseSeqs.begin(); itClose != thisSeqsCloseSeqs.end(); itClose++) {
                 
                 if (m->getControl_pressed()) { break; }
                 
@@ -215,9 +215,9 @@ OptiData* OptiRefMatrix::extractMatrixSubset(set<long long> & seqs) {
             
             long long seqNum = *it;
             
-            set<long long> thisSeqsCloseSeqs = getCloseSeqs(seqNum);
+            closeSeqs thisSeqsCloseSeqs = getCloseSeqs(seqNum);
             set<long long> thisSeqsCloseUnFittedSeqs;
-            for (set<long long>::iterator itClose = thisSeqsCloseSeqs.begin(); itClose != thisSeqsCloseSeqs.end(); itClose++) {
+            for (const unsigned int* itClose = thisSeqsCloseSeqs.begin(); itClose != thisSeqsCloseSeqs.end(); itClose++) {
                 
                 if (m->getControl_pressed()) { break; }
                 
@@ -293,7 +293,7 @@ bool OptiRefMatrix::isCloseFit(long long i, long long toFind, bool& isFit){
         
         bool found = false;
         if (!isRef[toFind]) { //are you a fit seq
-            if (closeness[i].count(toFind) != 0) {  //are you close
+            if (closeness.isClose(i, toFind)) {  //are you close
                 found = true;
             }
             isFit = true;
@@ -375,7 +375,7 @@ long long OptiRefMatrix::getNumFitClose(long long index) {
         else if (index > closeness.size()) { m->mothurOut("[ERROR]: index is not valid.\n"); m->setControl_pressed(true);  }
         else {
             //reference seqs all have indexes less than refEnd
-            for (set<long long>::iterator it = closeness[index].begin(); it != closeness[index].end(); it++) {
+            for (const unsigned int* it = closeness[index].begin(); it != closeness[index].end(); it++) {
                 if (!isRef[*it]) {  numClose++; } //you are a fit seq
             }
         }
@@ -396,7 +396,7 @@ long long OptiRefMatrix::getNumRefClose(long long index) {
         else if (index > closeness.size()) { m->mothurOut("[ERROR]: index is not valid.\n"); m->setControl_pressed(true);  }
         else {
             //reference seqs all have indexes less than refEnd
-            for (set<long long>::iterator it = closeness[index].begin(); it != closeness[index].end(); it++) {
+            for (const unsigned int* it = closeness[index].begin(); it != closeness[index].end(); it++) {
                 if (isRef[*it]) {  numClose++; } //you are a ref seq
             }
         }
@@ -417,7 +417,7 @@ set<long long> OptiRefMatrix::getCloseFitSeqs(long long index){
         else if (index > closeness.size()) { m->mothurOut("[ERROR]: index is not valid.\n"); m->setControl_pressed(true);  } //
         else {
             //reference seqs all have indexes less than refEnd
-            for (set<long long>::iterator it = closeness[index].begin(); it != closeness[index].end(); it++) {
+            for (const unsigned int* it = closeness[index].begin(); it != closeness[index].end(); it++) {
                 if (!isRef[*it]) {  closeSeqs.insert(*it); } //you are a fit seq
             }
         }
@@ -438,7 +438,7 @@ set<long long> OptiRefMatrix::getCloseRefSeqs(long long index){
         else if (index > closeness.size()) { m->mothurOut("[ERROR]: index is not valid.\n"); m->setControl_pressed(true);  }
         else {
             //reference seqs all have indexes less than refEnd
-            for (set<long long>::iterator it = closeness[index].begin(); it != closeness[index].end(); it++) {
+            for (const unsigned int* it = closeness[index].begin(); it != closeness[index].end(); it++) {
                 if (isRef[*it]) { closeSeqs.insert(*it); } //you are a ref seq
             }
         }
@@ -531,8 +531,8 @@ int OptiRefMatrix::readFiles(string distFile, string distFormat, string dupsFile
         if (namefile != "") { util.readNames(namefile, nameAssignment); }
         else  {
             CountTable ct; ct.readTable(countfile, false, true);
-            map<string, int> temp = ct.getNameMap();
-            for (map<string, int>::iterator it = temp.begin(); it!= temp.end(); it++) {  nameAssignment[it->first] = it->second; }
+            vector<countTableSeq> seqs = ct.getSeqs();
+            for (int i = 0; i < seqs.size(); i++) {  nameAssignment[seqs[i].getName()] = seqs[i].total; }
         }
         
         //select sequences to be reference
@@ -615,6 +615,8 @@ int OptiRefMatrix::readFiles(string distFile, string distFormat, string dupsFile
         }
         singleton.clear();
         
+        closeness.build();
+        
         //find number of fitDists, refDists and between dists
         calcCounts();
         
@@ -633,8 +635,8 @@ int OptiRefMatrix::readFiles(string refdistfile, string refnamefile, string refc
         if (refnamefile != "") { util.readNames(refnamefile, nameAssignment); }
         else  {
             CountTable ct; ct.readTable(refcountfile, false, true);
-            map<string, int> temp = ct.getNameMap();
-            for (map<string, int>::iterator it = temp.begin(); it!= temp.end(); it++) {  nameAssignment[it->first] = it->second; }
+            vector<countTableSeq> seqs = ct.getSeqs();
+            for (int i = 0; i < seqs.size(); i++) {  nameAssignment[seqs[i].getName()] = seqs[i].total; }
         }
         
         long long count = 0;
@@ -656,8 +658,8 @@ int OptiRefMatrix::readFiles(string refdistfile, string refnamefile, string refc
         if (fitnamefile != "") { util.readNames(fitnamefile, fitnameAssignment); }
         else  {
             CountTable ct; ct.readTable(fitcountfile, false, true);
-            map<string, int> temp = ct.getNameMap();
-            for (map<string, int>::iterator it = temp.begin(); it!= temp.end(); it++) {  fitnameAssignment[it->first] = it->second; }
+            vector<countTableSeq> seqs = ct.getSeqs();
+            for (int i = 0; i < seqs.size(); i++) {  fitnameAssignment[seqs[i].getName()] = seqs[i].total; }
         }
         
         for (map<string, long long>::iterator it = fitnameAssignment.begin(); it!= fitnameAssignment.end(); it++) {
@@ -744,6 +746,8 @@ int OptiRefMatrix::readFiles(string refdistfile, string refnamefile, string refc
         if (betweendistformat == "column")        {  readColumn(betweendistfile, hasName, names, nameAssignment, singletonIndexSwap);     }
         else if (betweendistformat == "phylip")   {  readPhylip(betweendistfile, hasName, names, nameAssignment, singletonIndexSwap);     }
         
+        closeness.build();
+        
         //find number of fitDists, refDists and between dists
         calcCounts();
         
@@ -927,8 +931,7 @@ int OptiRefMatrix::readPhylip(string distFile, bool hasName, map<string, string>
                         }
                         long long newB = singletonIndexSwap[j];
                         long long newA = singletonIndexSwap[i];
-                        closeness[newA].insert(newB);
-                        closeness[newB].insert(newA);
+                        closeness.addPair(newA, newB);
                     }
                 }
             }
@@ -954,8 +957,7 @@ int OptiRefMatrix::readPhylip(string distFile, bool hasName, map<string, string>
                         }
                         long long newB = singletonIndexSwap[j];
                         long long newA = singletonIndexSwap[i];
-                        closeness[newA].insert(newB);
-                        closeness[newB].insert(newA);
+                        closeness.addPair(newA, newB);
                     }
                 }
             }
@@ -1006,8 +1008,7 @@ int OptiRefMatrix::readColumn(string distFile, bool hasName, map<string, string>
                 
                 long long newB = singletonIndexSwap[indexB];
                 long long newA = singletonIndexSwap[indexA];
-                closeness[newA].insert(newB);
-                closeness[newB].insert(newA);
+                closeness.addPair(newA, newB);
                 
                 if (hasName) {
                     map<string, string>::iterator itName1 = names.find(firstName);
@@ -1050,7 +1051,7 @@ void OptiRefMatrix::calcCounts(){
             long long thisSeqsNumRefDists = 0;
             long long thisSeqsNumFitDists = 0;
             
-            for (set<long long>::iterator it = closeness[i].begin(); it != closeness[i].end(); it++) {
+            for (const unsigned int* it = closeness[i].begin(); it != closeness[i].end(); it++) {
                 long long newB = *it;
                 
                 if ((thisSeqIsRef) && (isRef[newB])) {  thisSeqsNumRefDists++; } //both refs
@@ -48,12 +48,12 @@ public:
 	void updateReverseMap(vector<vector<int> >&, int, int, int);
     void setName(string n);
     void setScores(vector<int> qs) { qScores = qs; seqLength = (int)qScores.size(); }
+	double calculateExpectedErrors(void);
     vector<int> getScores() { return qScores; }
 
 private:
 
 	double calculateAverage(bool);
-	double calculateExpectedErrors(void);
 	MothurOut* m;
 	vector<int> qScores;
     Utils util;
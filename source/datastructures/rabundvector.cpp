@@ -47,7 +47,7 @@ RAbundVector::RAbundVector(string id, vector<int> rav) : DataVector(id), data(ra
 }
 /***********************************************************************/
 
-RAbundVector::RAbundVector(vector<int> rav) :  DataVector(), maxRank(0), numBins(0), numSeqs(0)  {
+RAbundVector::RAbundVector(vector<int> rav) :  DataVector(), data(rav.size(), 0), maxRank(0), numBins(0), numSeqs(0)  {
     try {
         for(int i=0;i<rav.size();i++){ set(i, rav[i]); }
     }
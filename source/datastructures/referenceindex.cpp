@@ -0,0 +1,292 @@
+/*
+ *  referenceindex.cpp
+ *  Mothur
+ *
+ *  Created by agent on 10/18/26.
+ *  Copyright 2026 Schloss Lab. All rights reserved.
+ *
+ */
+
+#include "referenceindex.hpp"
+
+#ifdef NON_WINDOWS
+#include <sys/mman.h>
+#include <fcntl.h>
+#endif
+
+#define REFERENCEINDEX_MAGIC "MOTHKIDX"
+#define REFERENCEINDEX_VERSION 1
+#define REFERENCEINDEX_BYTEORDER 0x01020304
+
+/**************************************************************************************************/
+static unsigned long long indexHeaderSize() { return 128; }
+static unsigned long long alignIndex(unsigned long long bytes) { return ((bytes + 7) / 8) * 8; }
+
+//offsets of the kmer starts, postings, name starts, sequence starts, names, sequences and the end of the file
+static vector<unsigned long long> getIndexOffsets(int kmerSize, unsigned long long numSeqs, unsigned long long postingBytes, unsigned long long nameBytes, unsigned long long seqBytes) {
+    unsigned long long numKmerStarts = (1ULL << (2*kmerSize)) + 2;
+    vector<unsigned long long> offsets(7, 0);
+    offsets[0] = indexHeaderSize();
+    offsets[1] = offsets[0] + numKmerStarts * sizeof(long long);
+    offsets[2] = offsets[1] + alignIndex(postingBytes);
+    offsets[3] = offsets[2] + (numSeqs+1) * sizeof(unsigned long long);
+    offsets[4] = offsets[3] + (numSeqs+1) * sizeof(unsigned long long);
+    offsets[5] = offsets[4] + alignIndex(nameBytes);
+    offsets[6] = offsets[5] + seqBytes;
+    return offsets;
+}
+/**************************************************************************************************/
+//runs of gaps shorter than this are stored as they are
+static const int minGapRun = 3;
+
+static void packSequence(const string& raw, string& packed) {
+    for (int i = 0; i < raw.length();) {
+        char c = raw[i];
+        int run = 1;
+        if ((c == '-') || (c == '.')) { while (((i+run) < raw.length()) && (raw[i+run] == c)) { run++; } }
+
+        if (run >= minGapRun) {
+            packed += (char)((c == '-') ? 128 : 129);
+            unsigned int length = run;
+            while (length >= 128) { packed += (char)(length | 128); length >>= 7; }
+            packed += (char)length;
+        }else { packed.append(run, c); }
+        i += run;
+    }
+}
+/**************************************************************************************************/
+static string unpackSequence(const unsigned char* next, const unsigned char* end) {
+    string raw = "";
+    while (next != end) {
+        unsigned char c = *next++;
+        if (c < 128) { raw += (char)c; continue; }
+
+        unsigned int length = 0; int shift = 0;
+        while (*next & 128) { length |= (unsigned int)(*next & 127) << shift; shift += 7; next++; }
+        length |= (unsigned int)(*next) << shift; next++;
+        raw.append(length, (c == 128) ? '-' : '.');
+    }
+    return raw;
+}
+/**************************************************************************************************/
+//the fasta reader sets the aligned and unaligned strings from the same text, this is what makes both
+static void setSequence(Sequence& seq, string name, string raw) {
+    seq.setName(name);
+    seq.setAligned(raw);
+    seq.setUnaligned(raw);
+}
+/**************************************************************************************************/
+
+ReferenceIndex::ReferenceIndex(string fastaFile, int k) : fastaFileName(fastaFile), kmerSize(k) {
+    try {
+        m = MothurOut::getInstance();
+        indexFileName = fastaFileName.substr(0,fastaFileName.find_last_of(".")+1) + char('0'+ kmerSize) + "mer.index";
+        numSeqs = 0; longest = 0;
+        data = nullptr; fileSize = 0;
+        postings = nullptr; kmerStarts = nullptr; nameStarts = nullptr; seqStarts = nullptr; names = nullptr; seqs = nullptr;
+        canWrite = true;
+        newNameStarts.push_back(0); newSeqStarts.push_back(0);
+    }
+    catch(exception& e) {
+        m->errorOut(e, "ReferenceIndex", "ReferenceIndex");
+        exit(1);
+    }
+}
+/**************************************************************************************************/
+ReferenceIndex::~ReferenceIndex() { close(); }
+/**************************************************************************************************/
+void ReferenceIndex::close() {
+#ifdef NON_WINDOWS
+    if (data != nullptr) { munmap((void*)data, fileSize); }
+#endif
+    vector<char> empty; buffer.swap(empty);
+    data = nullptr; fileSize = 0;
+}
+/**************************************************************************************************/
+bool ReferenceIndex::open() {
+    try {
+        close();
+
+        ifstream in(indexFileName.c_str(), ios::binary);
+        if (!in) { return false; }
+
+        vector<char> header(indexHeaderSize(), '\0');
+        in.read(&header[0], header.size());
+        if (!in) { in.close(); return false; }
+
+        unsigned int fileVersion, byteOrder;
+        unsigned long long fastaSize, fastaSample, fileKmerSize, fileNumSeqs, fileLongest, postingBytes, nameBytes, seqBytes;
+        long long fastaModified;
+        memcpy(&fileVersion, &header[8], sizeof(unsigned int));
+        memcpy(&byteOrder, &header[12], sizeof(unsigned int));
+        memcpy(&fastaSize, &header[16], sizeof(unsigned long long));
+        memcpy(&fastaModified, &header[24], sizeof(long long));
+        memcpy(&fastaSample, &header[32], sizeof(unsigned long long));
+        memcpy(&fileKmerSize, &header[40], sizeof(unsigned long long));
+        memcpy(&fileNumSeqs, &header[48], sizeof(unsigned long long));
+        memcpy(&fileLongest, &header[56], sizeof(unsigned long long));
+        memcpy(&postingBytes, &header[64], sizeof(unsigned long long));
+        memcpy(&nameBytes, &header[72], sizeof(unsigned long long));
+        memcpy(&seqBytes, &header[80], sizeof(unsigned long long));
+
+        bool good = (memcmp(&header[0], REFERENCEINDEX_MAGIC, 8) == 0) && (fileVersion == REFERENCEINDEX_VERSION) && (byteOrder == REFERENCEINDEX_BYTEORDER) && (fileKmerSize == kmerSize);
+        if (good) {
+            unsigned long long size, sample; long long modified;
+            good = util.getFileStamp(fastaFileName, size, modified, sample) && (size == fastaSize) && (modified == fastaModified) && (sample == fastaSample);
+        }
+
+        vector<unsigned long long> offsets = getIndexOffsets(kmerSize, fileNumSeqs, postingBytes, nameBytes, seqBytes);
+        if (good) { in.seekg(0, ios::end); good = ((unsigned long long)in.tellg() == offsets[6]); }
+        if (!good) { in.close(); return false; }
+
+#ifdef NON_WINDOWS
+        in.close();
+
+        //only the pages a search touches are read, and the processes using the same reference share them
+        int fd = ::open(indexFileName.c_str(), O_RDONLY);
+        if (fd == -1) { return false; }
+        void* mapped = mmap(nullptr, offsets[6], PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (mapped == MAP_FAILED) { return false; }
+        data = (const char*)mapped;
+#else
+        buffer.resize(offsets[6]);
+        in.seekg(0);
+        in.read(&buffer[0], offsets[6]);
+        good = (bool)in;
+        in.close();
+        if (!good) { close(); return false; }
+        data = buffer.data();
+#endif
+        fileSize = offsets[6];
+
+        kmerStarts = (const long long*)(data + offsets[0]);
+        postings = (const unsigned char*)(data + offsets[1]);
+        nameStarts = (const unsigned long long*)(data + offsets[2]);
+        seqStarts = (const unsigned long long*)(data + offsets[3]);
+        names = data + offsets[4];
+        seqs = (const unsigned char*)(data + offsets[5]);
+        numSeqs = fileNumSeqs;
+        longest = fileLongest;
+
+        unsigned long long numKmerStarts = (1ULL << (2*kmerSize)) + 2;
+        if ((kmerStarts[numKmerStarts-1] != postingBytes) || (nameStarts[numSeqs] != nameBytes) || (seqStarts[numSeqs] != seqBytes)) { close(); numSeqs = 0; longest = 0; return false; }
+
+        return true;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "ReferenceIndex", "open");
+        exit(1);
+    }
+}
+/**************************************************************************************************/
+//templates are stored as the text the fasta reader would make them from, so they come back exactly as they were read
+void ReferenceIndex::addSequence(Sequence& seq) {
+    try {
+        if (!canWrite) { return; }
+
+        string name = seq.getName();
+        string aligned = seq.getAligned();
+        string unaligned = seq.getUnaligned();
+
+        //the unaligned bases keep the case they had in the fasta file
+        string raw = aligned;
+        int next = 0;
+        for (int i = 0; i < raw.length(); i++) {
+            if (isalpha((unsigned char)raw[i]) && (next < unaligned.length())) { raw[i] = unaligned[next]; next++; }
+            if ((unsigned char)raw[i] >= 128) { canWrite = false; }
+        }
+
+        Sequence copy; setSequence(copy, name, raw);
+        if ((name == "") || (copy.getName() != name) || (copy.getAligned() != aligned) || (copy.getUnaligned() != unaligned)) { canWrite = false; }
+        if (!canWrite) { string emptyNames, emptySeqs; newNames.swap(emptyNames); newSeqs.swap(emptySeqs); return; }
+
+        newNames += name;
+        packSequence(raw, newSeqs);
+        newNameStarts.push_back(newNames.length());
+        newSeqStarts.push_back(newSeqs.length());
+
+        //same as AlignmentDB
+        if (unaligned.length() >= longest) { longest = ((int)unaligned.length()+1); }
+    }
+    catch(exception& e) {
+        m->errorOut(e, "ReferenceIndex", "addSequence");
+        exit(1);
+    }
+}
+/**************************************************************************************************/
+//Write errors are ignored, the fasta file is still read if there is no index.
+bool ReferenceIndex::write(const unsigned char* newPostings, const long long* newKmerStarts) {
+    try {
+        if (!canWrite || m->getControl_pressed()) { return false; }
+
+        unsigned long long fastaSize, fastaSample; long long fastaModified;
+        if (!util.getFileStamp(fastaFileName, fastaSize, fastaModified, fastaSample)) { return false; }
+
+        unsigned long long numKmerStarts = (1ULL << (2*kmerSize)) + 2;
+        unsigned long long newNumSeqs = newNameStarts.size()-1, newLongest = longest, fileKmerSize = kmerSize;
+        unsigned long long postingBytes = newKmerStarts[numKmerStarts-1], nameBytes = newNames.length(), seqBytes = newSeqs.length();
+        vector<unsigned long long> offsets = getIndexOffsets(kmerSize, newNumSeqs, postingBytes, nameBytes, seqBytes);
+
+        vector<char> header(indexHeaderSize(), '\0');
+        unsigned int fileVersion = REFERENCEINDEX_VERSION;
+        unsigned int byteOrder = REFERENCEINDEX_BYTEORDER;
+        memcpy(&header[0], REFERENCEINDEX_MAGIC, 8);
+        memcpy(&header[8], &fileVersion, sizeof(unsigned int));
+        memcpy(&header[12], &byteOrder, sizeof(unsigned int));
+        memcpy(&header[16], &fastaSize, sizeof(unsigned long long));
+        memcpy(&header[24], &fastaModified, sizeof(long long));
+        memcpy(&header[32], &fastaSample, sizeof(unsigned long long));
+        memcpy(&header[40], &fileKmerSize, sizeof(unsigned long long));
+        memcpy(&header[48], &newNumSeqs, sizeof(unsigned long long));
+        memcpy(&header[56], &newLongest, sizeof(unsigned long long));
+        memcpy(&header[64], &postingBytes, sizeof(unsigned long long));
+        memcpy(&header[72], &nameBytes, sizeof(unsigned long long));
+        memcpy(&header[80], &seqBytes, sizeof(unsigned long long));
+
+        //write to a temp file and rename so a reader never maps a partial file, threads making the same index each write their own
+        string tempName = indexFileName + "." + toString(std::hash<std::thread::id>()(std::this_thread::get_id())) + ".temp";
+        ofstream out(tempName.c_str(), ios::binary | ios::trunc);
+        if (!out) { return false; } //the reference may be in a read only directory
+
+        vector<char> padding(8, '\0');
+        out.write(&header[0], header.size());
+        out.write((const char*)newKmerStarts, numKmerStarts * sizeof(long long));
+        out.write((const char*)newPostings, postingBytes);
+        out.write(&padding[0], offsets[2] - offsets[1] - postingBytes);
+        out.write((const char*)&newNameStarts[0], newNameStarts.size() * sizeof(unsigned long long));
+        out.write((const char*)&newSeqStarts[0], newSeqStarts.size() * sizeof(unsigned long long));
+        out.write(newNames.data(), nameBytes);
+        out.write(&padding[0], offsets[5] - offsets[4] - nameBytes);
+        out.write(newSeqs.data(), seqBytes);
+
+        bool good = (bool)out;
+        out.close();
+
+        if (good) { util.renameFile(tempName, indexFileName); }
+        else { util.mothurRemove(tempName); }
+
+        return good;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "ReferenceIndex", "write");
+        exit(1);
+    }
+}
+/**************************************************************************************************/
+string ReferenceIndex::getName(int i) const {
+    return string(names + nameStarts[i], nameStarts[i+1] - nameStarts[i]);
+}
+/**************************************************************************************************/
+Sequence ReferenceIndex::getSequence(int i) const {
+    try {
+        Sequence seq;
+        setSequence(seq, getName(i), unpackSequence(seqs + seqStarts[i], seqs + seqStarts[i+1]));
+        return seq;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "ReferenceIndex", "getSequence");
+        exit(1);
+    }
+}
+/**************************************************************************************************/
@@ -0,0 +1,79 @@
+#ifndef REFERENCEINDEX_HPP
+#define REFERENCEINDEX_HPP
+
+/*
+ *  referenceindex.hpp
+ *  Mothur
+ *
+ *  Created by agent on 10/18/26.
+ *  Copyright 2026 Schloss Lab. All rights reserved.
+ *
+ */
+
+#include "mothur.h"
+#include "sequence.hpp"
+#include "utils.hpp"
+
+/* This class is the binary shortcut file for a kmer searched reference, fastaFileRoot.8mer.index for ksize=8.  It holds
+ the kmer postings in the format KmerDB searches, the template names and the aligned templates, and is memory mapped read only
+ so align.seqs and classify.seqs can start searching without reading the fasta file or the .8mer shortcut.  The index is stamped
+ with the size, modification time and a sample hash of the fasta file it was made from, and is remade if the fasta file changes.
+
+ The file is a 128 byte header, then 8 byte aligned sections:
+    uint64 start of each kmer's postings, 4^ksize+2 of them
+    the postings
+    uint64 start of each template's name, numSeqs+1 of them
+    uint64 start of each template's packed sequence, numSeqs+1 of them
+    the names back to back
+    the packed sequences back to back, bytes under 128 are literal and 128 or 129 followed by a length is a run of '-' or '.'
+ */
+
+/**************************************************************************************************/
+
+class ReferenceIndex {
+
+public:
+    ReferenceIndex(string, int); //fasta file, ksize
+    ~ReferenceIndex();
+
+    bool open(); //false if there is no index, or it is from another version, ksize or fasta file
+
+    //making the index, add the templates in the order the kmer database numbers them
+    void addSequence(Sequence&);
+    bool write(const unsigned char*, const long long*); //postings, kmer starts
+
+    int getNumSeqs()    { return numSeqs;   }
+    int getLongest()    { return longest;   }
+    string getName(int) const;
+    Sequence getSequence(int) const;
+    const unsigned char* getPostings() const    { return postings;      }
+    const long long* getKmerStarts() const      { return kmerStarts;    }
+
+private:
+    MothurOut* m;
+    Utils util;
+    string fastaFileName, indexFileName;
+    int kmerSize, numSeqs, longest;
+
+    //the opened index
+    const char* data;
+    unsigned long long fileSize;
+    vector<char> buffer; //holds the file where it can't be mapped
+    const unsigned char* postings;
+    const long long* kmerStarts;
+    const unsigned long long* nameStarts;
+    const unsigned long long* seqStarts;
+    const char* names;
+    const unsigned char* seqs;
+
+    //the index being made, canWrite is false if a template can't be stored exactly
+    bool canWrite;
+    string newNames, newSeqs;
+    vector<unsigned long long> newNameStarts, newSeqStarts;
+
+    void close();
+};
+
+/**************************************************************************************************/
+
+#endif
@@ -344,12 +344,23 @@ SharedRAbundVectors* SharedListVector::getSharedRAbundVector() {
         map<string, SharedRAbundVector*>::iterator it;
         
 		for (int i = 0; i < groups.size(); i++) {
-            SharedRAbundVector* temp = new SharedRAbundVector(numBins);
+            SharedRAbundVector* temp = new SharedRAbundVector(numBins, true); //filled in bin order, so the sparse rows are appended to
             finder[groups[i]] = temp;
             finder[groups[i]]->setLabel(label);
             finder[groups[i]]->setGroup(groups[i]);
             lookup.push_back(finder[groups[i]]);
         }
+        
+        //vector for each of the count table's groups, nullptr if the group was not selected
+        vector<SharedRAbundVector*> countTableGroups;
+        if (groupMode != "group") {
+            vector<string> allGroups = countTable->getNamesOfGroups();
+            for (int k = 0; k < allGroups.size(); k++) {
+                it = finder.find(allGroups[k]);
+                if (it != finder.end()) { countTableGroups.push_back(it->second); }
+                else { countTableGroups.push_back(nullptr); }
+            }
+        }
         Utils util;
 		//fill vectors
 		for(int i=0;i<numBins;i++){
@@ -363,11 +374,10 @@ SharedRAbundVectors* SharedListVector::getSharedRAbundVector() {
                     it = finder.find(group);
                     if (it != finder.end()) { it->second->set(i, it->second->get(i) + 1); } //i represents what bin you are in
                 }else{
-                    vector<int> counts = countTable->getGroupCounts(binNames[j]);
-                    vector<string> allGroups = countTable->getNamesOfGroups();
-                    for (int k = 0; k < allGroups.size(); k++) {
-                        it = finder.find(allGroups[k]);
-                        if (it != finder.end()) { it->second->set(i, it->second->get(i) + counts[k]); } //i represents what bin you are in
+                    countTableRow row = countTable->getRow(binNames[j]);
+                    for (int k = 0; k < row.size; k++) {
+                        SharedRAbundVector* temp = countTableGroups[row.items[k].group];
+                        if (temp != nullptr) { temp->set(i, temp->get(i) + row.items[k].abund); } //i represents what bin you are in
                     }
                 }
 			}
@@ -377,6 +387,7 @@ SharedRAbundVectors* SharedListVector::getSharedRAbundVector() {
         for (int j = 0; j < lookup.size(); j++) {  shared->push_back(lookup[j]);  }
         shared->setOTUNames(binLabels);
         shared->eliminateZeroOTUS();
+        for (int j = 0; j < lookup.size(); j++) {  lookup[j]->fitStorage();  }
 
 		return shared;
 	}
@@ -11,15 +11,21 @@
 
 /***********************************************************************/
 
-SharedRAbundVector::SharedRAbundVector() : DataVector(), maxRank(0), numBins(0), numSeqs(0), group("") {}
+SharedRAbundVector::SharedRAbundVector() : DataVector(), maxRank(0), numBins(0), numSeqs(0), sparse(false), group("") {}
 
 /***********************************************************************/
 
-SharedRAbundVector::SharedRAbundVector(int n) : DataVector(), data(n,0) , maxRank(0), numBins(n), numSeqs(0), group("") {}
+SharedRAbundVector::SharedRAbundVector(int n) : DataVector(), data(n,0) , maxRank(0), numBins(n), numSeqs(0), sparse(false), group("") {}
 
 /***********************************************************************/
 
-SharedRAbundVector::SharedRAbundVector(vector<int> rav) :  DataVector(), maxRank(0), numBins(rav.size()), numSeqs(0), group("")  {
+SharedRAbundVector::SharedRAbundVector(int n, bool s) : DataVector(), maxRank(0), numBins(n), numSeqs(0), sparse(s), group("") {
+    if (!sparse) { data.assign(n, 0); }
+}
+
+/***********************************************************************/
+
+SharedRAbundVector::SharedRAbundVector(vector<int> rav) :  DataVector(), maxRank(0), numBins(rav.size()), numSeqs(0), sparse(false), group("")  {
     try {
         data.assign(numBins, 0);
         for(int i=0;i<rav.size();i++){ set(i, rav[i]); }
@@ -32,7 +38,7 @@ SharedRAbundVector::SharedRAbundVector(vector<int> rav) :  DataVector(), maxRank
 
 /***********************************************************************/
 
-SharedRAbundVector::SharedRAbundVector(vector<int> rav, int mr, int nb, int ns) :  DataVector(), group(""){
+SharedRAbundVector::SharedRAbundVector(vector<int> rav, int mr, int nb, int ns) :  DataVector(), sparse(false), group(""){
     try {
         numBins = nb;
         maxRank = mr;
@@ -47,7 +53,7 @@ SharedRAbundVector::SharedRAbundVector(vector<int> rav, int mr, int nb, int ns)
 /***********************************************************************/
 
 
-SharedRAbundVector::SharedRAbundVector(ifstream& f) : DataVector(), maxRank(0), numBins(0), numSeqs(0) {
+SharedRAbundVector::SharedRAbundVector(ifstream& f) : DataVector(), maxRank(0), numBins(0), numSeqs(0), sparse(false) {
     try {
         f >> label >> group >> numBins;
         
@@ -67,24 +73,40 @@ SharedRAbundVector::SharedRAbundVector(ifstream& f) : DataVector(), maxRank(0),
 }
 
 /***********************************************************************/
-SharedRAbundVector::SharedRAbundVector(ifstream& f, string l, string g, int n) : DataVector(), maxRank(0), numBins(n), numSeqs(0) {
+//reads the row sparse, so a mostly empty row never takes more than its bins with sequences
+SharedRAbundVector::SharedRAbundVector(ifstream& f, string l, string g, int n) : DataVector(), maxRank(0), numBins(n), numSeqs(0), sparse(true) {
     try {
         label = l;
         group = g;
-        data.assign(numBins, 0);
         
         string otuCountsData = util.getline(f);
         
-        vector<string> o = util.splitWhiteSpace(otuCountsData);
-        
-        if (o.size() != n) { m->mothurOut("[ERROR] : group " + group + " contains otu data for " + toString(o.size()) + " otus, but your sharedfile indicates you have " + toString(n) + " otus. Please correct.\n");  m->setControl_pressed(true);  }
-        else {
-            int inputData;
-            for(int i=0;i<o.size();i++){
-                util.mothurConvert(o[i], inputData);
-                set(i, inputData);
+        int numRead = 0;
+        int length = otuCountsData.length();
+        int i = 0;
+        while (i < length) {
+            while ((i < length) && isspace(otuCountsData[i])) { i++; }
+            if (i == length) { break; }
+            
+            int start = i;
+            int inputData = 0; bool digits = true;
+            while ((i < length) && !isspace(otuCountsData[i])) {
+                char c = otuCountsData[i];
+                if (isdigit(c) && digits) { inputData = inputData*10 + (c - '0'); }
+                else { digits = false; }
+                i++;
             }
+            if (!digits || ((i - start) > 9)) { util.mothurConvert(otuCountsData.substr(start, i-start), inputData); }
+            
+            if ((inputData != 0) && (numRead < n)) { otus.push_back(numRead); data.push_back(inputData); }
+            numRead++;
         }
+        
+        if (numRead != n) { m->mothurOut("[ERROR] : group " + group + " contains otu data for " + toString(numRead) + " otus, but your sharedfile indicates you have " + toString(n) + " otus. Please correct.\n");  m->setControl_pressed(true); otus.clear(); data.clear(); }
+        
+        for (int j = 0; j < data.size(); j++) { numSeqs += data[j]; }
+        setMaxRank();
+        fitStorage();
     }
     catch(exception& e) {
         m->errorOut(e, "SharedRAbundVector", "SharedRAbundVector");
@@ -100,8 +122,18 @@ SharedRAbundVector::~SharedRAbundVector() { }
 
 void SharedRAbundVector::set(int binNumber, int newBinSize){
     try {
-        int oldBinSize = data[binNumber];
-        data[binNumber] = newBinSize;
+        int oldBinSize = 0;
+        if (sparse) {
+            int pos = findEntry(binNumber);
+            if ((pos < otus.size()) && (otus[pos] == binNumber)) {
+                oldBinSize = data[pos];
+                if (newBinSize == 0) { otus.erase(otus.begin()+pos); data.erase(data.begin()+pos); }
+                else { data[pos] = newBinSize; }
+            }else if (newBinSize != 0) { otus.insert(otus.begin()+pos, binNumber); data.insert(data.begin()+pos, newBinSize); }
+        }else {
+            oldBinSize = data[binNumber];
+            data[binNumber] = newBinSize;
+        }
         
         if(newBinSize > maxRank)	{	maxRank = newBinSize;	}
         
@@ -116,8 +148,16 @@ void SharedRAbundVector::set(int binNumber, int newBinSize){
 
 int SharedRAbundVector::increment(int binNumber){
     try {
-        data[binNumber]++;
-        int newBinSize = data[binNumber];
+        int newBinSize;
+        if (sparse) {
+            int pos = findEntry(binNumber);
+            if ((pos < otus.size()) && (otus[pos] == binNumber)) { data[pos]++; }
+            else { otus.insert(otus.begin()+pos, binNumber); data.insert(data.begin()+pos, 1); }
+            newBinSize = data[pos];
+        }else {
+            data[binNumber]++;
+            newBinSize = data[binNumber];
+        }
         
         if(newBinSize > maxRank)	{	maxRank = newBinSize;	}
         
@@ -133,7 +173,73 @@ int SharedRAbundVector::increment(int binNumber){
 
 /***********************************************************************/
 
-int SharedRAbundVector::get(int index){ return data[index]; }
+int SharedRAbundVector::get(int index){
+    if (sparse) {
+        int pos = findEntry(index);
+        if ((pos < otus.size()) && (otus[pos] == index)) { return data[pos]; }
+        return 0;
+    }
+    return data[index];
+}
+/***********************************************************************/
+
+vector<int> SharedRAbundVector::get(){
+    if (sparse) {
+        vector<int> abunds(numBins, 0);
+        for (int i = 0; i < otus.size(); i++) { abunds[otus[i]] = data[i]; }
+        return abunds;
+    }
+    return data;
+}
+/***********************************************************************/
+
+int SharedRAbundVector::findEntry(int bin){
+    return (int)(lower_bound(otus.begin(), otus.end(), bin) - otus.begin());
+}
+/***********************************************************************/
+
+void SharedRAbundVector::setMaxRank(){
+    maxRank = 0;
+    for (int i = 0; i < data.size(); i++) { if (data[i] > maxRank) { maxRank = data[i]; } }
+}
+/***********************************************************************/
+
+void SharedRAbundVector::setSparse(bool s){
+    try {
+        if (s == sparse) { return; }
+        
+        if (s) {
+            vector<int> abunds;
+            for (int i = 0; i < data.size(); i++) {
+                if (data[i] != 0) { otus.push_back(i); abunds.push_back(data[i]); }
+            }
+            data = abunds;
+        }else {
+            data = get();
+            otus.clear();
+        }
+        sparse = s;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "SharedRAbundVector", "setSparse");
+        exit(1);
+    }
+}
+/***********************************************************************/
+
+void SharedRAbundVector::fitStorage(){
+    try {
+        int numWithSeqs = 0;
+        if (sparse) { numWithSeqs = otus.size(); }
+        else { for (int i = 0; i < data.size(); i++) { if (data[i] != 0) { numWithSeqs++; } } }
+        
+        setSparse(((long long)numWithSeqs * 4) < numBins);
+    }
+    catch(exception& e) {
+        m->errorOut(e, "SharedRAbundVector", "fitStorage");
+        exit(1);
+    }
+}
 /***********************************************************************/
 
 void SharedRAbundVector::clear(){
@@ -142,12 +248,14 @@ void SharedRAbundVector::clear(){
     numSeqs = 0;
     group = "";
     data.clear();
+    otus.clear();
 }
 /***********************************************************************/
 
 void SharedRAbundVector::push_back(int binSize){
     try {
-        data.push_back(binSize);
+        if (!sparse) { data.push_back(binSize); }
+        else if (binSize != 0) { otus.push_back(numBins); data.push_back(binSize); }
         numBins++;
         
         if(binSize > maxRank){ maxRank = binSize; }
@@ -163,14 +271,21 @@ void SharedRAbundVector::push_back(int binSize){
 
 int SharedRAbundVector::remove(int bin){
     try {
-        int abund = data[bin];
-        data.erase(data.begin()+bin);
+        int abund = 0;
+        if (sparse) {
+            int pos = findEntry(bin);
+            if ((pos < otus.size()) && (otus[pos] == bin)) {
+                abund = data[pos];
+                otus.erase(otus.begin()+pos); data.erase(data.begin()+pos);
+            }
+            for (int i = pos; i < otus.size(); i++) { otus[i]--; }
+        }else {
+            abund = data[bin];
+            data.erase(data.begin()+bin);
+        }
         numBins--;
         
-        if(abund == maxRank){
-            vector<int>::iterator it = max_element(data.begin(), data.end());
-            maxRank = *it;
-        }
+        if(abund == maxRank){ setMaxRank(); }
         
         numSeqs -= abund;
         
@@ -188,6 +303,23 @@ int SharedRAbundVector::remove(vector<int> bins){
         if (bins.size() == 0) { return 0; }
         
         int numRemoved = 0;
+        if (sparse) {
+            //bins are sorted, an otu moves down by the number of removed bins before it
+            vector<int> newOTUs, newData; int binIndex = 0;
+            for (int i = 0; i < otus.size(); i++) {
+                while ((binIndex < bins.size()) && (bins[binIndex] < otus[i])) { binIndex++; }
+                
+                if ((binIndex < bins.size()) && (bins[binIndex] == otus[i])) { numRemoved += data[i]; }
+                else { newOTUs.push_back(otus[i] - binIndex); newData.push_back(data[i]); }
+            }
+            otus = newOTUs; data = newData;
+            numBins -= bins.size();
+            setMaxRank();
+            numSeqs -= numRemoved;
+            
+            return numRemoved;
+        }
+        
         vector<int> newData; int binIndex = 0;
         for (int i = 0; i < data.size(); i++) {
             if (m->getControl_pressed()) { break; }
@@ -222,22 +354,32 @@ int SharedRAbundVector::remove(vector<int> bins){
 
 /***********************************************************************/
 void SharedRAbundVector::resize(int size){
-    data.resize(size);
+    if (sparse) {
+        int pos = findEntry(size);
+        otus.resize(pos); data.resize(pos);
+    }else { data.resize(size); }
     
-    vector<int>::iterator it = max_element(data.begin(), data.end());
-    maxRank = *it;
+    setMaxRank();
     numSeqs = util.sum(data);
     numBins = size;
 }
 /***********************************************************************/
-int SharedRAbundVector::size(){ return data.size(); }
+int SharedRAbundVector::size(){ if (sparse) { return numBins; } return data.size(); }
 /***********************************************************************/
 void SharedRAbundVector::print(ostream& output){
     try {
         output << label;
         output << '\t' << group << '\t' << numBins;
         
-        for(int i=0;i<numBins;i++){		output  << '\t' << int(data[i]);		}
+        if (sparse) {
+            int next = 0;
+            for(int i=0;i<numBins;i++){
+                if ((next < otus.size()) && (otus[next] == i)) { output  << '\t' << data[next]; next++; }
+                else { output << "\t0"; }
+            }
+        }else {
+            for(int i=0;i<numBins;i++){		output  << '\t' << int(data[i]);		}
+        }
         output << endl;
     }
     catch(exception& e) {
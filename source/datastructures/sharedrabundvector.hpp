@@ -52,7 +52,8 @@ public:
     SharedRAbundVector(int);
     SharedRAbundVector(vector<int>, int, int, int);
     SharedRAbundVector(vector<int>);
-    SharedRAbundVector(const SharedRAbundVector& bv) : DataVector(bv), data(bv.data), maxRank(bv.maxRank), numBins(bv.numBins), numSeqs(bv.numSeqs), group(bv.group) { };
+    SharedRAbundVector(int, bool); //numBins, sparse
+    SharedRAbundVector(const SharedRAbundVector& bv) : DataVector(bv), data(bv.data), otus(bv.otus), maxRank(bv.maxRank), numBins(bv.numBins), numSeqs(bv.numSeqs), sparse(bv.sparse), group(bv.group) { };
     SharedRAbundVector(ifstream&);
     SharedRAbundVector(ifstream& f, string l, string g, int); //filehandle, label, numBins
     ~SharedRAbundVector();
@@ -63,7 +64,7 @@ public:
     
     void set(int, int);
     int get(int);
-    vector<int> get() { return data; }
+    vector<int> get(); //all bins, a sparse vector is expanded
     string getGroup() { return group; } //group = "" for rabunds without groupInfo
     void setGroup(string g) { group = g;  }
     
@@ -82,13 +83,29 @@ public:
     SAbundVector getSAbundVector();
     OrderVector getOrderVector(map<string,int>*); 
     
+    //sparse vectors only store the bins with sequences. The entries are what is stored, every bin of a dense vector
+    //or the bins with sequences of a sparse vector, in bin order, so callers can walk either without expanding it.
+    //On a sparse vector get, set and increment are a binary search, and setting a bin that is not stored inserts it,
+    //moving the entries after it. Fill a sparse vector in bin order, or fill it dense and call fitStorage.
+    bool isSparse() { return sparse; }
+    void setSparse(bool);
+    void fitStorage(); //sparse if under a quarter of the bins have sequences, dense otherwise
+    int getNumEntries() { return data.size(); }
+    int getEntryBin(int i) { if (sparse) { return otus[i]; } return i; }
+    int getEntryAbund(int i) { return data[i]; }
+    
     protected:
     
-    vector<int> data;
+    vector<int> data; //abundance of every bin, or of the bins in otus when sparse
+    vector<int> otus; //sparse only, bins with sequences in bin order
     int maxRank;
     int numBins;
     int numSeqs;
+    bool sparse;
     string group;
+    
+    int findEntry(int); //sparse only, position of the bin in otus or where it would be inserted
+    void setMaxRank();
 };
 
 
@@ -172,14 +172,21 @@ void SharedRAbundVectors::printTidy(ostream& output, bool& printOTUHeaders, bool
         for (int i = 0; i < lookup.size(); i++) {
             if (m->getControl_pressed()) { break; }
             
-            vector<int> data = lookup[i]->get();
             string thisGroup = lookup[i]->getGroup();
             
             //if keepzero=false, zeroed otus are not outputted
-            for (int j = 0; j < data.size(); j++) {
-                if ((data[j] != 0) || (keepZero)) {
+            if (keepZero) {
+                vector<int> data = lookup[i]->get();
+                for (int j = 0; j < data.size(); j++) {
                     output << label << '\t' << thisGroup << '\t' << otuLabels[j] << '\t' << data[j] << endl;
                 }
+            }else {
+                for (int j = 0; j < lookup[i]->getNumEntries(); j++) {
+                    int abund = lookup[i]->getEntryAbund(j);
+                    if (abund != 0) {
+                        output << label << '\t' << thisGroup << '\t' << otuLabels[lookup[i]->getEntryBin(j)] << '\t' << abund << endl;
+                    }
+                }
             }
         }
     }
@@ -381,6 +388,59 @@ vector<int> SharedRAbundVectors::getOTU(int bin){
     }
 }
 /***********************************************************************/
+vector<int> SharedRAbundVectors::getOTUTotals(){
+    try {
+        vector<int> totals(numBins, 0);
+        for (int i = 0; i < lookup.size(); i++) {
+            for (int j = 0; j < lookup[i]->getNumEntries(); j++) { totals[lookup[i]->getEntryBin(j)] += lookup[i]->getEntryAbund(j); }
+        }
+        return totals;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "SharedRAbundVectors", "getOTUTotals");
+        exit(1);
+    }
+}
+/***********************************************************************/
+//transposes the samples into the otus, starts[i] to starts[i+1] are the samples in otu i in sample order
+void SharedRAbundVectors::getColumns(vector<long long>& starts, vector<int>& groups, vector<int>& abunds){
+    try {
+        starts.assign(numBins+1, 0);
+        for (int i = 0; i < lookup.size(); i++) {
+            for (int j = 0; j < lookup[i]->getNumEntries(); j++) {
+                if (lookup[i]->getEntryAbund(j) != 0) { starts[lookup[i]->getEntryBin(j)+1]++; }
+            }
+        }
+        for (int i = 0; i < numBins; i++) { starts[i+1] += starts[i]; }
+        
+        groups.resize(starts[numBins]); abunds.resize(starts[numBins]);
+        vector<long long> next(starts.begin(), starts.end()-1);
+        for (int i = 0; i < lookup.size(); i++) {
+            for (int j = 0; j < lookup[i]->getNumEntries(); j++) {
+                int abund = lookup[i]->getEntryAbund(j);
+                if (abund != 0) {
+                    long long pos = next[lookup[i]->getEntryBin(j)]++;
+                    groups[pos] = i; abunds[pos] = abund;
+                }
+            }
+        }
+    }
+    catch(exception& e) {
+        m->errorOut(e, "SharedRAbundVectors", "getColumns");
+        exit(1);
+    }
+}
+/***********************************************************************/
+void SharedRAbundVectors::setSparse(bool s){
+    try {
+        for (int i = 0; i < lookup.size(); i++) { lookup[i]->setSparse(s); }
+    }
+    catch(exception& e) {
+        m->errorOut(e, "SharedRAbundVectors", "setSparse");
+        exit(1);
+    }
+}
+/***********************************************************************/
 void SharedRAbundVectors::setLabels(string l){
     try {
         label = l;
@@ -505,11 +565,10 @@ SharedOrderVector SharedRAbundVectors::getSharedOrderVector(){
     try {
         SharedOrderVector order;
         for (int i = 0; i < lookup.size(); i++) {
-            for (int j = 0; j < lookup[i]->getNumBins(); j++) {
-                int abund = lookup[i]->get(j);
-                if (abund != 0) {
-                    for (int k = 0; k < abund; k++) {  order.push_back(j, lookup[i]->getGroup());  }
-                }
+            for (int j = 0; j < lookup[i]->getNumEntries(); j++) {
+                int abund = lookup[i]->getEntryAbund(j);
+                int bin = lookup[i]->getEntryBin(j);
+                for (int k = 0; k < abund; k++) {  order.push_back(bin, lookup[i]->getGroup());  }
             }
         }
         
@@ -634,10 +693,8 @@ vector<SharedRAbundFloatVector*> SharedRAbundVectors::getSharedRAbundFloatVector
 RAbundVector SharedRAbundVectors::getRAbundVector(){
     try {
         RAbundVector rav; rav.setLabel(label);
-        for (int i = 0; i < numBins; i++) {
-            int abund = getOTUTotal(i);
-            rav.push_back(abund);
-        }
+        vector<int> totals = getOTUTotals();
+        for (int i = 0; i < numBins; i++) { rav.push_back(totals[i]); }
         return rav;
     }
     catch(exception& e) {
@@ -654,7 +711,8 @@ RAbundVector SharedRAbundVectors::getRAbundVector(string group){
         for (vector<SharedRAbundVector*>::iterator it = lookup.begin(); it != lookup.end();) {
             //if this sharedrabund is not from a group the user wants then delete it.
             if ((*it)->getGroup() == group) {
-                for (int i = 0; i < (*it)->getNumBins(); i++) { rav.push_back((*it)->get(i)); }
+                vector<int> abunds = (*it)->get();
+                for (int i = 0; i < abunds.size(); i++) { rav.push_back(abunds[i]); }
 		return rav;
             }else { ++it; }
         }
@@ -694,13 +752,12 @@ void SharedRAbundVectors::eliminateZeroOTUS() {
         if (currentLabels.size() != numBins) { currentLabels = getOTUNames(); }
         if (lookup.size() > 1) {
             vector<int> otusToRemove;
+            vector<int> totals = getOTUTotals();
             for (int i = 0; i < lookup[0]->getNumBins(); i++) {
                 if (m->getControl_pressed()) { break; }
                 
-                int total = getOTUTotal(i);
-                
                 //if they are not all zero add this bin
-                if (total == 0) {  otusToRemove.push_back(i); } //sorted order
+                if (totals[i] == 0) {  otusToRemove.push_back(i); } //sorted order
             }
             removeOTUs(otusToRemove, true); //sorted
         }
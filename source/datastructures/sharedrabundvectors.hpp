@@ -41,6 +41,8 @@ public:
     int getOTUTotal(int bin);
     int getOTUTotal(string otuLabel); //returns 0 if otuLabel is not found
     vector<int> getOTU(int bin);
+    vector<int> getOTUTotals(); //total of every otu, reads each sample's stored bins once
+    void getColumns(vector<long long>&, vector<int>&, vector<int>&); //otu starts, sample index, abund. nonzero abunds by otu
     int get(int bin, string group);
     void set(int bin, int binSize, string group);
     void setOTUNames(vector<string> names);
@@ -56,6 +58,7 @@ public:
     int push_back(vector<int>, string binLabel=""); //add otu. mothur assumes abunds are in same order as groups.
     int push_back(SharedRAbundVector*);
     void eliminateZeroOTUS(); //run after push_backs if groups are chosen
+    void setSparse(bool); //stores every sample sparse or dense, see SharedRAbundVector::setSparse
     int removeOTU(int bin);
     int removeOTUs(vector<int>, bool sorted=false); //bins to remove, sorted or not
     void removeGroups(vector<string> g);
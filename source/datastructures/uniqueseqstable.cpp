@@ -0,0 +1,208 @@
+/*
+ *  uniqueseqstable.cpp
+ *  Mothur
+ *
+ *  Created by agent on 10/18/26.
+ *  Copyright 2026 Schloss Lab. All rights reserved.
+ *
+ */
+
+#include "uniqueseqstable.hpp"
+
+/**************************************************************************************************/
+//MurmurHash3 x64 128
+static inline unsigned long long rotl64(unsigned long long x, int r) { return (x << r) | (x >> (64 - r)); }
+
+static inline unsigned long long fmix64(unsigned long long k) {
+    k ^= k >> 33; k *= 0xff51afd7ed558ccdULL;
+    k ^= k >> 33; k *= 0xc4ceb9fe1a85ec53ULL;
+    k ^= k >> 33;
+    return k;
+}
+
+static void hashString(const string& s, unsigned long long& hashLow, unsigned long long& hashHigh) {
+    const unsigned long long c1 = 0x87c37b91114253d5ULL;
+    const unsigned long long c2 = 0x4cf5ad432745937fULL;
+    const unsigned char* data = (const unsigned char*)s.data();
+    int length = s.length();
+    int numBlocks = length / 16;
+
+    unsigned long long h1 = 0, h2 = 0;
+    for (int i = 0; i < numBlocks; i++) {
+        unsigned long long k1, k2;
+        memcpy(&k1, data + i*16, 8);
+        memcpy(&k2, data + i*16 + 8, 8);
+
+        k1 *= c1; k1 = rotl64(k1, 31); k1 *= c2; h1 ^= k1;
+        h1 = rotl64(h1, 27); h1 += h2; h1 = h1*5 + 0x52dce729;
+
+        k2 *= c2; k2 = rotl64(k2, 33); k2 *= c1; h2 ^= k2;
+        h2 = rotl64(h2, 31); h2 += h1; h2 = h2*5 + 0x38495ab5;
+    }
+
+    const unsigned char* tail = data + numBlocks*16;
+    unsigned long long k1 = 0, k2 = 0;
+    int remaining = length & 15;
+    for (int i = remaining-1; i >= 8; i--) { k2 ^= ((unsigned long long)tail[i]) << ((i-8)*8); }
+    if (remaining > 8) { k2 *= c2; k2 = rotl64(k2, 33); k2 *= c1; h2 ^= k2; }
+    for (int i = min(remaining, 8)-1; i >= 0; i--) { k1 ^= ((unsigned long long)tail[i]) << (i*8); }
+    if (remaining > 0) { k1 *= c1; k1 = rotl64(k1, 31); k1 *= c2; h1 ^= k1; }
+
+    h1 ^= length; h2 ^= length;
+    h1 += h2; h2 += h1;
+    h1 = fmix64(h1); h2 = fmix64(h2);
+    h1 += h2; h2 += h1;
+
+    hashLow = h1; hashHigh = h2;
+}
+/**************************************************************************************************/
+//packs 4 bases to a byte, returns false if the string has anything other than A, C, G and T
+static bool packString(const string& s, vector<unsigned char>& packed) {
+    packed.assign((s.length()+3)/4, 0);
+    for (int i = 0; i < s.length(); i++) {
+        unsigned char code;
+        switch (s[i]) {
+            case 'A': code = 0; break;
+            case 'C': code = 1; break;
+            case 'G': code = 2; break;
+            case 'T': code = 3; break;
+            default: return false;
+        }
+        packed[i >> 2] |= (code << ((i & 3) * 2));
+    }
+    return true;
+}
+/**************************************************************************************************/
+
+bool UniqueSeqsShard::isEqual(const uniqueSeqsEntry& entry, const string& s, bool packed) {
+    if ((entry.length != s.length()) || (entry.packed != packed)) { return false; }
+    if (s.length() == 0) { return true; }
+
+    if (packed) { return (memcmp(&arena[entry.offset], &packedSeq[0], packedSeq.size()) == 0);   }
+    return (memcmp(&arena[entry.offset], s.data(), s.length()) == 0);
+}
+/**************************************************************************************************/
+
+void UniqueSeqsShard::resize() {
+    slots.assign(slots.size()*2, -1);
+    unsigned long long mask = slots.size() - 1;
+
+    for (int i = 0; i < entries.size(); i++) {
+        unsigned long long slot = entries[i].hashLow & mask;
+        while (slots[slot] != -1) { slot = (slot + 1) & mask; }
+        slots[slot] = i;
+    }
+}
+/**************************************************************************************************/
+
+int UniqueSeqsShard::find(const string& s, unsigned long long hashLow, unsigned long long hashHigh) {
+    bool packed = packString(s, packedSeq);
+    unsigned long long mask = slots.size() - 1;
+    unsigned long long slot = hashLow & mask;
+
+    while (slots[slot] != -1) {
+        const uniqueSeqsEntry& entry = entries[slots[slot]];
+        if ((entry.hashLow == hashLow) && (entry.hashHigh == hashHigh) && isEqual(entry, s, packed)) { return slots[slot]; }
+        slot = (slot + 1) & mask;
+    }
+
+    //new string
+    unsigned long long offset = arena.size();
+    if (packed) { arena.insert(arena.end(), packedSeq.begin(), packedSeq.end()); }
+    else        { arena.insert(arena.end(), s.begin(), s.end());                 }
+
+    int index = entries.size();
+    entries.push_back(uniqueSeqsEntry(hashLow, hashHigh, offset, s.length(), packed));
+    slots[slot] = index;
+
+    if (entries.size() * 2 > slots.size()) { resize(); }
+
+    return index;
+}
+/**************************************************************************************************/
+
+struct uniqueSeqsData {
+    const vector<string>* strings;
+    vector<unsigned long long>* hashLows;
+    vector<unsigned long long>* hashHighs;
+    vector<int>* entries;
+    UniqueSeqsShard* shard;
+    int threadID, numThreads;
+
+    uniqueSeqsData(const vector<string>* s, vector<unsigned long long>* l, vector<unsigned long long>* h, vector<int>* e, UniqueSeqsShard* sh, int t, int n) :
+    strings(s), hashLows(l), hashHighs(h), entries(e), shard(sh), threadID(t), numThreads(n) {}
+};
+/**************************************************************************************************/
+//hashes every numThreads string starting at threadID
+static void driverHashStrings(uniqueSeqsData* params) {
+    for (int i = params->threadID; i < params->strings->size(); i += params->numThreads) {
+        hashString((*params->strings)[i], (*params->hashLows)[i], (*params->hashHighs)[i]);
+    }
+}
+/**************************************************************************************************/
+//looks up the strings that belong to this thread's shard, in the order of the batch
+static void driverFindStrings(uniqueSeqsData* params) {
+    for (int i = 0; i < params->strings->size(); i++) {
+        if (((*params->hashHighs)[i] % params->numThreads) != params->threadID) { continue; }
+        (*params->entries)[i] = params->shard->find((*params->strings)[i], (*params->hashLows)[i], (*params->hashHighs)[i]);
+    }
+}
+/**************************************************************************************************/
+
+UniqueSeqsTable::UniqueSeqsTable(int p) {
+    try {
+        m = MothurOut::getInstance();
+        numUniques = 0;
+        if (p < 1) { p = 1; }
+        for (int i = 0; i < p; i++) { shards.push_back(new UniqueSeqsShard()); }
+    }
+    catch(exception& e) {
+        m->errorOut(e, "UniqueSeqsTable", "UniqueSeqsTable");
+        exit(1);
+    }
+}
+/**************************************************************************************************/
+
+UniqueSeqsTable::~UniqueSeqsTable() {
+    for (int i = 0; i < shards.size(); i++) { delete shards[i]; }
+}
+/**************************************************************************************************/
+
+void UniqueSeqsTable::add(const vector<string>& strings, vector<int>& ids, vector<bool>& isNew) {
+    try {
+        int numThreads = shards.size();
+        vector<unsigned long long> hashLows(strings.size(), 0), hashHighs(strings.size(), 0);
+        vector<int> entries(strings.size(), -1);
+
+        vector<uniqueSeqsData*> data;
+        for (int i = 0; i < numThreads; i++) { data.push_back(new uniqueSeqsData(&strings, &hashLows, &hashHighs, &entries, shards[i], i, numThreads)); }
+
+        if (numThreads == 1) { driverHashStrings(data[0]); driverFindStrings(data[0]); }
+        else {
+            vector<std::thread*> workerThreads;
+            for (int i = 0; i < numThreads; i++) { workerThreads.push_back(new std::thread(driverHashStrings, data[i])); }
+            for (int i = 0; i < numThreads; i++) { workerThreads[i]->join(); delete workerThreads[i]; }
+
+            //each shard is only touched by its own thread
+            workerThreads.clear();
+            for (int i = 0; i < numThreads; i++) { workerThreads.push_back(new std::thread(driverFindStrings, data[i])); }
+            for (int i = 0; i < numThreads; i++) { workerThreads[i]->join(); delete workerThreads[i]; }
+        }
+
+        for (int i = 0; i < data.size(); i++) { delete data[i]; }
+
+        //number the new strings in the order of the batch
+        ids.assign(strings.size(), -1);
+        isNew.assign(strings.size(), false);
+        for (int i = 0; i < strings.size(); i++) {
+            uniqueSeqsEntry& entry = shards[hashHighs[i] % numThreads]->getEntry(entries[i]);
+            if (entry.id == -1) { entry.id = numUniques; numUniques++; isNew[i] = true; }
+            ids[i] = entry.id;
+        }
+    }
+    catch(exception& e) {
+        m->errorOut(e, "UniqueSeqsTable", "add");
+        exit(1);
+    }
+}
+/**************************************************************************************************/
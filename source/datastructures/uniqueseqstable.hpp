@@ -0,0 +1,71 @@
+#ifndef UNIQUESEQSTABLE_HPP
+#define UNIQUESEQSTABLE_HPP
+
+/*
+ *  uniqueseqstable.hpp
+ *  Mothur
+ *
+ *  Created by agent on 10/18/26.
+ *  Copyright 2026 Schloss Lab. All rights reserved.
+ *
+ */
+
+#include "mothurout.h"
+
+/* This class finds the identical strings in the batches of sequences unique.seqs reads.  Each string is looked up by a
+ 128 bit hash in an open addressing table, and stored once in an arena, 4 bases to a byte if it only has A, C, G and T.
+ Strings with the same hash are compared, so only identical strings are merged.  The table is split into one shard per
+ thread by hash, and each thread hashes part of the batch and then adds the strings that belong to its shard. */
+
+/**************************************************************************************************/
+
+struct uniqueSeqsEntry {
+    unsigned long long hashLow, hashHigh;
+    unsigned long long offset;  //start of the string in the shard's arena
+    int length;
+    int id;                     //-1 until the batch that added it is numbered
+    bool packed;
+
+    uniqueSeqsEntry(unsigned long long l, unsigned long long h, unsigned long long o, int len, bool p) : hashLow(l), hashHigh(h), offset(o), length(len), id(-1), packed(p) {}
+};
+/**************************************************************************************************/
+
+class UniqueSeqsShard {
+
+public:
+    UniqueSeqsShard() : slots(1024, -1) {}
+    ~UniqueSeqsShard() = default;
+
+    int find(const string&, unsigned long long, unsigned long long);    //returns the entry for the string, adding it if it's new
+    uniqueSeqsEntry& getEntry(int i) { return entries[i]; }
+
+private:
+    vector<int> slots;                  //entry index or -1, the size is a power of 2 and at most half full
+    vector<uniqueSeqsEntry> entries;
+    vector<unsigned char> arena;
+    vector<unsigned char> packedSeq;    //the string being looked up, packed if it can be
+
+    bool isEqual(const uniqueSeqsEntry&, const string&, bool);
+    void resize();
+};
+/**************************************************************************************************/
+
+class UniqueSeqsTable {
+
+public:
+    UniqueSeqsTable(int);   //number of threads, the table has a shard for each
+    ~UniqueSeqsTable();
+
+    //ids[i] is the unique strings[i] is a copy of, numbered in the order they are first seen. isNew[i] is true for the first copy.
+    void add(const vector<string>& strings, vector<int>& ids, vector<bool>& isNew);
+    int size() { return numUniques; }
+
+private:
+    MothurOut* m;
+    vector<UniqueSeqsShard*> shards;
+    int numUniques;
+};
+
+/**************************************************************************************************/
+
+#endif
@@ -18,6 +18,8 @@ public:
     virtual bool isCalcMultiple() = 0;
 	virtual void setAll(bool){}
 	virtual bool hasLciHci(){ return false; }
+	virtual bool hasExpectedCurve() { return false; } //rarefied value has a closed form, so the curve needs no iterations
+	virtual void updateExpected(int, vector<double>) {} //numSeqs, mean lci hci
 	virtual bool getAll()	{	bool a; return a;	}
 	virtual bool calcNeedsAll()    { bool a; return a;	}
 	virtual string getName() { return ""; };
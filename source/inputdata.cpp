@@ -23,6 +23,7 @@ InputData::InputData(string fName, string f, vector<string> userGroups) : format
 	nextDistanceLabel = "";
     groups = userGroups;
     otuTag = util.getTag(fName);
+    sparse = false;
 }
 /***********************************************************************/
 
@@ -36,6 +37,7 @@ InputData::~InputData(){
 InputData::InputData(string fName, string orderFileName, string f) : format(f){
 	try {
 		m = MothurOut::getInstance();
+        sparse = false;
 		ifstream ofHandle;
 		util.openInputFile(orderFileName, ofHandle);
 		string name;
@@ -452,7 +454,7 @@ SharedRAbundVectors* InputData::getSharedRAbundVectors(){
                     else { shared->setOTUNames(currentLabels);  }
                     if (shared->getNumBins() == 0) { delete shared; shared = nullptr; } //no valid groups
                 }
-                return shared;
+                return fitStorage(shared);
             }else if (format == "shared") {
                 SharedList = new SharedListVector(fileHandle, groups, nextDistanceLabel, otuTag);
                 
@@ -461,7 +463,7 @@ SharedRAbundVectors* InputData::getSharedRAbundVectors(){
                     if (currentLabels.size() == 0) { currentLabels = SharedList->getLabels(); }
                     else { SharedList->setLabels(currentLabels);  }
 
-                    return SharedList->getSharedRAbundVector();
+                    return fitStorage(SharedList->getSharedRAbundVector());
                 }
             }
             gobble(fileHandle);
@@ -502,7 +504,7 @@ SharedRAbundVectors* InputData::getSharedRAbundVectors(string label){
                         
 
 						//if you are at the last label
-						if (thisLabel == label) {  in.close(); return SharedRAbund;  }
+						if (thisLabel == label) {  in.close(); return fitStorage(SharedRAbund);  }
 						else {
 							delete SharedRAbund;
 						}
@@ -522,7 +524,7 @@ SharedRAbundVectors* InputData::getSharedRAbundVectors(string label){
                         else { SharedList->setLabels(currentLabels);  }
 
 						//if you are at the last label
-						if (thisLabel == label) {  in.close(); return SharedList->getSharedRAbundVector();  }
+						if (thisLabel == label) {  in.close(); return fitStorage(SharedList->getSharedRAbundVector());  }
 						else {
 							//so you don't loose this memory
 							delete SharedList;
@@ -547,6 +549,19 @@ SharedRAbundVectors* InputData::getSharedRAbundVectors(string label){
 	}
 }
 
+/***********************************************************************/
+//the reader stores mostly empty rows sparse. get(bin) on a sparse row is a binary search, so the rows are made dense for the
+//calculators and other callers looping over every bin, unless the caller walks the stored bins and asked for sparse rows
+SharedRAbundVectors* InputData::fitStorage(SharedRAbundVectors* shared){
+	try {
+        if ((shared != nullptr) && !sparse) { shared->setSparse(false); }
+        return shared;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "InputData", "fitStorage");
+		exit(1);
+	}
+}
 /***********************************************************************/
 //this is used when you don't need the order vector
 SharedRAbundFloatVectors* InputData::getSharedRAbundFloatVectors(){
@@ -31,6 +31,7 @@ public:
 	RAbundVector* getRAbundVector(string);  //pass the label you want
 	SharedRAbundVectors* getSharedRAbundVectors();
 	SharedRAbundVectors* getSharedRAbundVectors(string);  //pass the label you want
+    void setSparse(bool s) { sparse = s; } //shared rows are returned dense unless set, for callers only walking the stored bins. default=false
 	SharedRAbundFloatVectors* getSharedRAbundFloatVectors();
 	SharedRAbundFloatVectors* getSharedRAbundFloatVectors(string);  //pass the label you want
     SharedCLRVectors* getSharedCLRVectors();
@@ -54,6 +55,9 @@ private:
     vector<string> groups;
     string nextDistanceLabel;
     string otuTag;
+    bool sparse;
+    
+    SharedRAbundVectors* fitStorage(SharedRAbundVectors*);
 };
 
 
@@ -575,7 +575,7 @@ struct spearmanRank {
 };
 //***********************************************************************
 inline bool compareGroups(intPair left, intPair right){
-	return (left.group > right.group);
+	return (left.group < right.group);
 }
 //***********************************************************************
 inline bool compareIndexes(PDistCell left, PDistCell right){
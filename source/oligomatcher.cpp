@@ -0,0 +1,133 @@
+/*
+ *  oligomatcher.cpp
+ *  Mothur
+ *
+ *  Created by agent on 10/18/26.
+ *  Copyright 2026 Schloss Lab. All rights reserved.
+ *
+ */
+
+#include "oligomatcher.hpp"
+
+/**************************************************************************************************/
+//same rules as TrimOligos::countDiffs for a base of the oligo against a base of the sequence
+bool OligoMatcher::isMatch(char oligo, char seq) {
+	if (oligo == seq) { return true; }
+
+	switch (oligo) {
+		case 'R': return ((seq == 'A') || (seq == 'G'));
+		case 'Y': return ((seq == 'C') || (seq == 'T'));
+		case 'M': return ((seq == 'C') || (seq == 'A'));
+		case 'K': return ((seq == 'T') || (seq == 'G'));
+		case 'W': return ((seq == 'T') || (seq == 'A'));
+		case 'S': return ((seq == 'C') || (seq == 'G'));
+		case 'B': return ((seq == 'C') || (seq == 'T') || (seq == 'G'));
+		case 'D': return ((seq == 'A') || (seq == 'T') || (seq == 'G'));
+		case 'H': return ((seq == 'A') || (seq == 'T') || (seq == 'C'));
+		case 'V': return ((seq == 'A') || (seq == 'C') || (seq == 'G'));
+		default: return false;
+	}
+}
+/**************************************************************************************************/
+
+void OligoMatcher::setOligos(const vector<string>& o) {
+	try {
+		oligos = o;
+		maxLength = 0; hasNone = false; canHash = true;
+		exactOligos.clear(); exactLengths.clear();
+
+		hasPattern.assign(oligos.size(), false);
+		patterns.assign(oligos.size() * 256, 0);
+
+		set<int> lengths;
+		for (int k = 0; k < oligos.size(); k++) {
+			const string& oligo = oligos[k];
+			if (oligo == "NONE") { hasNone = true; canHash = false; continue; }
+
+			maxLength = max(maxLength, (int)oligo.length());
+			lengths.insert(oligo.length());
+			if (exactOligos.count(oligo) == 0) { exactOligos[oligo] = k; }
+
+			bool supported = ((oligo.length() != 0) && (oligo.length() <= 64));
+			for (int i = 0; i < oligo.length(); i++) {
+				if (string("ACGT").find(oligo[i]) == string::npos)				{ canHash = false;		}
+				if (string("ACGTRYMKWSBDHV").find(oligo[i]) == string::npos)	{ supported = false;	}
+			}
+			if (!supported) { continue; }
+
+			hasPattern[k] = true;
+			unsigned long long* pattern = &patterns[k * 256];
+			for (int c = 0; c < 256; c++) {
+				for (int i = 0; i < oligo.length(); i++) {
+					if (isMatch(oligo[i], (char)c)) { pattern[c] |= (1ULL << i); }
+				}
+			}
+		}
+		exactLengths.assign(lengths.begin(), lengths.end());
+	}
+	catch(exception& e) {
+		MothurOut::getInstance()->errorOut(e, "OligoMatcher", "setOligos");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+//the oligos that match the start of seq are prefixes of each other, so the first in the loop's order is the shortest
+bool OligoMatcher::findExact(const string& seq, int& index) const {
+	try {
+		index = -1;
+		if (!canHash || (seq.length() < maxLength)) { return false; } //the loop stops at an oligo longer than the sequence
+
+		for (int i = 0; i < exactLengths.size(); i++) {
+			unordered_map<string, int>::const_iterator it = exactOligos.find(seq.substr(0, exactLengths[i]));
+			if (it != exactOligos.end()) { index = it->second; break; }
+		}
+		return true;
+	}
+	catch(exception& e) {
+		MothurOut::getInstance()->errorOut(e, "OligoMatcher", "findExact");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
+//edit distance of each oligo against the closest prefix of the first oligo length + diffs bases of seq
+void OligoMatcher::getLowerBounds(const string& seq, int diffs, vector<int>& bounds) const {
+	try {
+		bounds.assign(oligos.size(), 0);
+
+		for (int k = 0; k < oligos.size(); k++) {
+			if (!hasPattern[k]) { continue; }
+
+			int length = oligos[k].length();
+			int fragmentLength = min((int)seq.length(), length + diffs);
+			const unsigned long long* pattern = &patterns[k * 256];
+			unsigned long long lastBit = 1ULL << (length-1);
+
+			//the sequence must start at its first base, so each column of the top row adds a gap
+			unsigned long long pv = ~0ULL, mv = 0;
+			int score = length, best = length;
+			for (int j = 0; j < fragmentLength; j++) {
+				unsigned long long eq = pattern[(unsigned char)seq[j]];
+				unsigned long long xv = eq | mv;
+				unsigned long long xh = (((eq & pv) + pv) ^ pv) | eq;
+				unsigned long long ph = mv | ~(xh | pv);
+				unsigned long long mh = pv & xh;
+
+				if (ph & lastBit)		{ score++; }
+				else if (mh & lastBit)	{ score--; }
+
+				ph = (ph << 1) | 1;
+				mh = mh << 1;
+				pv = mh | ~(xv | ph);
+				mv = ph & xv;
+
+				best = min(best, score);
+			}
+			bounds[k] = best;
+		}
+	}
+	catch(exception& e) {
+		MothurOut::getInstance()->errorOut(e, "OligoMatcher", "getLowerBounds");
+		exit(1);
+	}
+}
+/**************************************************************************************************/
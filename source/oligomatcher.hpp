@@ -0,0 +1,69 @@
+#ifndef OLIGOMATCHER_H
+#define OLIGOMATCHER_H
+
+/*
+ *  oligomatcher.hpp
+ *  Mothur
+ *
+ *  Created by agent on 10/18/26.
+ *  Copyright 2026 Schloss Lab. All rights reserved.
+ *
+ *	This class holds the barcodes or primers one of TrimOligos' search loops goes through, in the loop's order, and
+ *	answers two questions about the start of a sequence before any alignments are done.
+ *
+ *	findExact looks the start of the sequence up in a hash of the oligos, giving the same oligo the compareDNASeq loop
+ *	would find first. It only works when all the oligos are A, C, G and T.
+ *
+ *	getLowerBounds runs Myers' bit-vector edit distance for each oligo against the first oligo length + diffs bases.
+ *	The diffs countDiffs finds after the needleman alignment are never less than this edit distance, because that
+ *	alignment is one of the alignments the edit distance is the minimum of. So the oligos whose bound is more than the
+ *	best diffs found can be skipped without changing which oligo wins, how many tie or the diffs reported. Oligos with
+ *	N, I or other bases a gap doesn't count against get a bound of 0 and are always aligned.
+ *
+ */
+
+#include "mothurout.h"
+
+/**************************************************************************************************/
+//	the alignments TrimOligos::alignOligos made for one sequence, indexed like the matcher's oligos and empty for the
+//	oligos that were skipped
+struct oligoAlignments {
+	vector<string> oligoAlns, seqAlns;
+
+	bool getAlignment(int k, string& oligo, string& seq) const {
+		if (seqAlns[k] == "") { return false; }
+		oligo = oligoAlns[k]; seq = seqAlns[k]; return true;
+	}
+};
+/**************************************************************************************************/
+
+class OligoMatcher {
+
+public:
+	OligoMatcher() : maxLength(0), hasNone(false), canHash(false) {}
+	~OligoMatcher() = default;
+
+	void setOligos(const vector<string>&);		//	"NONE" for the unused side of a pair
+
+	int size() const						{ return (int)oligos.size();	}
+	const string& getOligo(int k) const		{ return oligos[k];				}
+	bool getHasNone() const					{ return hasNone;				}
+
+	bool findExact(const string&, int&) const;	//	false if the oligos have to be compared one at a time
+	void getLowerBounds(const string&, int, vector<int>&) const;
+
+private:
+	vector<string> oligos;
+	vector<bool> hasPattern;					//	false if the oligo always gets a bound of 0
+	vector<unsigned long long> patterns;		//	256 masks per oligo, bit i set if base i of the oligo matches the character
+	unordered_map<string, int> exactOligos;		//	first index of each oligo
+	vector<int> exactLengths;					//	lengths of the oligos, shortest first
+	int maxLength;
+	bool hasNone, canHash;
+
+	static bool isMatch(char, char);
+};
+
+/**************************************************************************************************/
+
+#endif
@@ -9,7 +9,7 @@
 #include "opticluster.h"
 
 OptiCluster::OptiCluster(OptiData* mt, ClusterMetric* met, long long ns) : Cluster() {
-    matrix = mt; metric = met; truePositives = 0; trueNegatives = 0; falseNegatives = 0; falsePositives = 0; numSingletons = ns;
+    matrix = mt; metric = met; truePositives = 0; trueNegatives = 0; falseNegatives = 0; falsePositives = 0; numSingletons = ns; processors = 1;
 }
 /***********************************************************************/
 //randomly assign sequences to OTUs
@@ -25,7 +25,9 @@ int OptiCluster::initialize(double& value, bool randomize, string initialize) {
         
         vector<long long> temp;
         bins.push_back(temp);
+        seqBin.assign(numSeqs+1, 0);
         seqBin[numSeqs] = -1;
+        closeInBin.assign(numSeqs+1, 0);
         insertLocation = numSeqs;
         Utils util;
         
@@ -43,10 +45,10 @@ int OptiCluster::initialize(double& value, bool randomize, string initialize) {
             if (randomize) { util.mothurRandomShuffle(randomizeSeqs); }
             
             //for each sequence (singletons removed on read)
-            for (map<long long, long long>::iterator it = seqBin.begin(); it != seqBin.end(); it++) {
-                if (it->second == -1) { }
+            for (long long j = 0; j < seqBin.size(); j++) {
+                if (seqBin[j] == -1) { }
                 else {
-                    long long numCloseSeqs = (matrix->getNumClose(it->first)); //does not include self
+                    long long numCloseSeqs = (matrix->getNumClose(j)); //does not include self
                     falseNegatives += numCloseSeqs;
                 }
             }
@@ -64,10 +66,10 @@ int OptiCluster::initialize(double& value, bool randomize, string initialize) {
             if (randomize) { util.mothurRandomShuffle(randomizeSeqs); }
             
             //for each sequence (singletons removed on read)
-            for (map<long long, long long>::iterator it = seqBin.begin(); it != seqBin.end(); it++) {
-                if (it->second == -1) { }
+            for (long long j = 0; j < seqBin.size(); j++) {
+                if (seqBin[j] == -1) { }
                 else {
-                    long long numCloseSeqs = (matrix->getNumClose(it->first)); //does not include self
+                    long long numCloseSeqs = (matrix->getNumClose(j)); //does not include self
                     truePositives += numCloseSeqs;
                 }
             }
@@ -91,73 +93,20 @@ int OptiCluster::initialize(double& value, bool randomize, string initialize) {
 bool OptiCluster::update(double& listMetric) {
     try {
         
-        //for each sequence (singletons removed on read)
-        for (int i = 0; i < randomizeSeqs.size(); i++) {
+        if (processors > 1) { updateBatches(); }
+        else {
+            optiClusterMove move;
             
-            if (m->getControl_pressed()) { break; }
-            
-            map<long long, long long>::iterator it = seqBin.find(randomizeSeqs[i]);
-            
-            long long seqNumber = it->first;
-            long long binNumber = it->second;
-            
-            if (binNumber == -1) { }
-            else {
-                
-                double tn, tp, fp, fn;
-                double bestMetric = -1;
-                double bestBin, bestTp, bestTn, bestFn, bestFp;
-                tn = trueNegatives; tp = truePositives; fp = falsePositives; fn = falseNegatives;
-                
-                //close / far count in current bin
-                vector<double> results = getCloseFarCounts(seqNumber, binNumber);
-                double cCount = results[0];  double fCount = results[1];
-                
-                //metric in current bin
-                bestMetric = metric->getValue(tp, tn, fp, fn); bestBin = binNumber; bestTp = tp; bestTn = tn; bestFp = fp; bestFn = fn;
-                
-                //if not already singleton, then calc value if singleton was created
-                if (!((bins[binNumber].size()) == 1)) {
-                    //make a singleton
-                    //move out of old bin
-                    fn+=cCount; tn+=fCount; fp-=fCount; tp-=cCount;
-                    double singleMetric = metric->getValue(tp, tn, fp, fn);
-                    if (singleMetric > bestMetric) {
-                        bestBin = -1; bestTp = tp; bestTn = tn; bestFp = fp; bestFn = fn;
-                        bestMetric = singleMetric;
-                    }
-                }
-                
-                set<long long> binsToTry;
-                set<long long> closeSeqs = matrix->getCloseSeqs(seqNumber);
-                for (set<long long>::iterator itClose = closeSeqs.begin(); itClose != closeSeqs.end(); itClose++) {  binsToTry.insert(seqBin[*itClose]); }
-                
-                //merge into each "close" otu
-                for (set<long long>::iterator it = binsToTry.begin(); it != binsToTry.end(); it++) {
-                    tn = trueNegatives; tp = truePositives; fp = falsePositives; fn = falseNegatives;
-                    fn+=cCount; tn+=fCount; fp-=fCount; tp-=cCount; //move out of old bin
-                    results = getCloseFarCounts(seqNumber, *it);
-                    fn-=results[0]; tn-=results[1];  tp+=results[0]; fp+=results[1]; //move into new bin
-                    double newMetric = metric->getValue(tp, tn, fp, fn); //score when sequence is moved
-                    //new best
-                    if (newMetric > bestMetric) { bestMetric = newMetric; bestBin = (*it); bestTp = tp; bestTn = tn; bestFp = fp; bestFn = fn; }
-                }
+            //for each sequence (singletons removed on read)
+            for (int i = 0; i < randomizeSeqs.size(); i++) {
                 
-                bool usedInsert = false;
-                if (bestBin == -1) {  bestBin = insertLocation;  usedInsert = true;  }
+                if (m->getControl_pressed()) { break; }
                 
-                if (bestBin != binNumber) {
-                    truePositives = bestTp; trueNegatives = bestTn; falsePositives = bestFp; falseNegatives = bestFn;
-                    
-                    //move seq from i to j
-                    bins[bestBin].push_back(seqNumber); //add seq to bestbin
-                    bins[binNumber].erase(remove(bins[binNumber].begin(), bins[binNumber].end(), seqNumber), bins[binNumber].end()); //remove from old bin i
+                if (seqBin[randomizeSeqs[i]] == -1) { }
+                else {
+                    evaluateMove(randomizeSeqs[i], closeInBin, move);
+                    commitMove(move);
                 }
-                
-                if (usedInsert) { insertLocation = findInsert(); }
-                
-                //update seqBins
-                seqBin[seqNumber] = bestBin; //set new OTU location
             }
         }
         
@@ -174,27 +123,253 @@ bool OptiCluster::update(double& listMetric) {
     }
 }
 /***********************************************************************/
-vector<double> OptiCluster::getCloseFarCounts(long long seq, long long newBin) {
+void driverOptiEvaluate(optiEvaluateData* params) {
+    params->cluster->evaluateMoves(params->start, params->end, params->offset, *(params->moves), params->closeInBin);
+}
+/***********************************************************************/
+//the worker threads are started once per update and wait for each batch, instead of being created for every batch
+optiEvaluateWorkers::optiEvaluateWorkers(vector<optiEvaluateData*>& d) : data(d), batch(0), numFinished(0), done(false) {
+    for (int i = 1; i < data.size(); i++) { workerThreads.push_back(new std::thread(&optiEvaluateWorkers::driver, this, i)); }
+}
+/***********************************************************************/
+optiEvaluateWorkers::~optiEvaluateWorkers() {
+    {
+        std::lock_guard<std::mutex> lock(workerMutex);
+        done = true;
+    }
+    batchReady.notify_all();
+    for (int i = 0; i < workerThreads.size(); i++) { workerThreads[i]->join(); delete workerThreads[i]; }
+}
+/***********************************************************************/
+//runs data[0] on the calling thread and returns once every worker has finished its part of the batch
+void optiEvaluateWorkers::evaluate() {
+    {
+        std::lock_guard<std::mutex> lock(workerMutex);
+        batch++; numFinished = 0;
+    }
+    batchReady.notify_all();
+    
+    driverOptiEvaluate(data[0]);
+    
+    std::unique_lock<std::mutex> lock(workerMutex);
+    batchFinished.wait(lock, [this]{ return (numFinished == workerThreads.size()); });
+}
+/***********************************************************************/
+void optiEvaluateWorkers::driver(int i) {
+    long long lastBatch = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(workerMutex);
+            batchReady.wait(lock, [this, lastBatch]{ return ((batch != lastBatch) || done); });
+            if (done) { return; }
+            lastBatch = batch;
+        }
+        
+        driverOptiEvaluate(data[i]);
+        
+        {
+            std::lock_guard<std::mutex> lock(workerMutex);
+            numFinished++;
+        }
+        batchFinished.notify_one();
+    }
+}
+/***********************************************************************/
+/* multithreaded update. The seqs are taken in batches in randomized order, the threads find the best move for each seq in
+ * the batch against the bins and tp, tn, fp and fn from before the batch, then the moves are made in batch order. A move is
+ * only made as found if none of the bins it looked at changed earlier in the batch, otherwise the seq is reevaluated. The
+ * batch size does not depend on the number of processors, so the results only depend on the seed. */
+void OptiCluster::updateBatches() {
     try {
-        vector<double> results; results.push_back(0); results.push_back(0);
-        
-        if (newBin == -1) { }  //making a singleton bin. Close but we are forcing apart.
-        else { //merging a bin
-            for (int i = 0; i < bins[newBin].size(); i++) {
-                if (seq == bins[newBin][i]) {} //ignore self
-                else if (!matrix->isClose(seq, bins[newBin][i])) { results[1]++; }  //this sequence is "far away" from sequence i - above the cutoff
-                else { results[0]++;  }  //this sequence is "close" to sequence i - distance between them is less than cutoff
+        long long batchSize = 4096;
+        
+        vector<optiEvaluateData*> data;
+        for (int i = 0; i < processors; i++) {
+            optiEvaluateData* dataBundle = new optiEvaluateData(this);
+            dataBundle->closeInBin.assign(bins.size(), 0);
+            data.push_back(dataBundle);
+        }
+        
+        vector<long long> binChanged(bins.size(), -1); //binChanged[bin#] -> last batch a seq moved in or out of the bin
+        vector<optiClusterMove> moves;
+        optiEvaluateWorkers workers(data);
+        
+        for (long long batchStart = 0; batchStart < randomizeSeqs.size(); batchStart += batchSize) {
+            
+            if (m->getControl_pressed()) { break; }
+            
+            long long batchEnd = min(batchStart + batchSize, (long long)randomizeSeqs.size());
+            moves.resize(batchEnd - batchStart);
+            
+            //divide the batch between the processors
+            long long numPerProcessor = (batchEnd - batchStart) / processors;
+            long long extra = (batchEnd - batchStart) % processors;
+            long long start = batchStart;
+            for (int i = 0; i < processors; i++) {
+                data[i]->start = start; data[i]->end = start + numPerProcessor + ((i < extra) ? 1 : 0);
+                data[i]->moves = &moves; data[i]->offset = batchStart;
+                start = data[i]->end;
+            }
+            
+            workers.evaluate();
+            
+            long long batch = batchStart / batchSize;
+            for (long long k = 0; k < moves.size(); k++) {
+                optiClusterMove& move = moves[k];
+                if (move.fromBin == -1) { continue; }
+                
+                bool changed = (binChanged[move.fromBin] == batch);
+                for (int j = 0; j < move.binsTried.size(); j++) { if (binChanged[move.binsTried[j]] == batch) { changed = true; break; } }
+                
+                if (changed) { evaluateMove(move.seq, closeInBin, move); }
+                else if (move.toBin != move.fromBin) {
+                    //the bins are the same, but earlier moves changed tp, tn, fp and fn. Make sure the move still helps
+                    double tp = truePositives - move.closeFrom + move.closeTo;
+                    double tn = trueNegatives + move.farFrom - move.farTo;
+                    double fp = falsePositives - move.farFrom + move.farTo;
+                    double fn = falseNegatives + move.closeFrom - move.closeTo;
+                    if (!(metric->getValue(tp, tn, fp, fn) > metric->getValue(truePositives, trueNegatives, falsePositives, falseNegatives))) { move.toBin = move.fromBin; }
+                }
+                
+                long long fromBin = move.fromBin;
+                if (commitMove(move)) { binChanged[fromBin] = batch; binChanged[seqBin[move.seq]] = batch; }
             }
         }
         
-        return results;
+        for (int i = 0; i < data.size(); i++) { delete data[i]; }
     }
     catch(exception& e) {
-        m->errorOut(e, "OptiCluster", "getCloseFarCounts");
+        m->errorOut(e, "OptiCluster", "updateBatches");
+        exit(1);
+    }
+}
+/***********************************************************************/
+void OptiCluster::evaluateMoves(long long start, long long end, long long offset, vector<optiClusterMove>& moves, vector<long long>& counts) {
+    try {
+        for (long long i = start; i < end; i++) {
+            
+            if (m->getControl_pressed()) { break; }
+            
+            if (seqBin[randomizeSeqs[i]] == -1) { moves[i-offset].fromBin = -1; }
+            else { evaluateMove(randomizeSeqs[i], counts, moves[i-offset]); }
+        }
+    }
+    catch(exception& e) {
+        m->errorOut(e, "OptiCluster", "evaluateMoves");
+        exit(1);
+    }
+}
+/***********************************************************************/
+//finds the best bin for seq without changing the clusters, counts is zeroed scratch space the size of bins
+void OptiCluster::evaluateMove(long long seqNumber, vector<long long>& counts, optiClusterMove& move) {
+    try {
+        long long binNumber = seqBin[seqNumber];
+        
+        double tn, tp, fp, fn;
+        double bestMetric = -1;
+        tn = trueNegatives; tp = truePositives; fp = falsePositives; fn = falseNegatives;
+        
+        //bins with a seq close to this one, and how many close seqs each has
+        move.seq = seqNumber; move.fromBin = binNumber; move.toBin = binNumber;
+        move.binsTried = getCloseBins(seqNumber, counts);
+        
+        //close / far count in current bin
+        double cCount = counts[binNumber];  double fCount = bins[binNumber].size() - 1 - cCount;
+        move.closeFrom = cCount; move.farFrom = fCount; move.closeTo = 0; move.farTo = 0;
+        
+        //metric in current bin
+        bestMetric = metric->getValue(tp, tn, fp, fn);
+        
+        //if not already singleton, then calc value if singleton was created
+        if (!((bins[binNumber].size()) == 1)) {
+            //make a singleton
+            //move out of old bin
+            fn+=cCount; tn+=fCount; fp-=fCount; tp-=cCount;
+            double singleMetric = metric->getValue(tp, tn, fp, fn);
+            if (singleMetric > bestMetric) {
+                move.toBin = -1;
+                bestMetric = singleMetric;
+            }
+        }
+        
+        //merge into each "close" otu
+        for (int j = 0; j < move.binsTried.size(); j++) {
+            long long thisBin = move.binsTried[j];
+            double close = counts[thisBin];
+            double far = bins[thisBin].size() - close;
+            if (thisBin == binNumber) { far--; } //ignore self
+            
+            tn = trueNegatives; tp = truePositives; fp = falsePositives; fn = falseNegatives;
+            fn+=cCount; tn+=fCount; fp-=fCount; tp-=cCount; //move out of old bin
+            fn-=close; tn-=far;  tp+=close; fp+=far; //move into new bin
+            double newMetric = metric->getValue(tp, tn, fp, fn); //score when sequence is moved
+            //new best
+            if (newMetric > bestMetric) { bestMetric = newMetric; move.toBin = thisBin; move.closeTo = close; move.farTo = far; }
+        }
+        for (int j = 0; j < move.binsTried.size(); j++) { counts[move.binsTried[j]] = 0; }
+    }
+    catch(exception& e) {
+        m->errorOut(e, "OptiCluster", "evaluateMove");
+        exit(1);
+    }
+}
+/***********************************************************************/
+//moves the seq to the bin found by evaluateMove, returns true if the seq moved
+bool OptiCluster::commitMove(optiClusterMove& move) {
+    try {
+        long long seqNumber = move.seq;
+        long long binNumber = move.fromBin;
+        long long bestBin = move.toBin;
+        
+        if (bestBin == binNumber) { return false; }
+        
+        truePositives = truePositives - move.closeFrom + move.closeTo;
+        trueNegatives = trueNegatives + move.farFrom - move.farTo;
+        falsePositives = falsePositives - move.farFrom + move.farTo;
+        falseNegatives = falseNegatives + move.closeFrom - move.closeTo;
+        
+        bool usedInsert = false;
+        if (bestBin == -1) {  bestBin = insertLocation;  usedInsert = true;  }
+        
+        //move seq from i to j
+        bins[bestBin].push_back(seqNumber); //add seq to bestbin
+        bins[binNumber].erase(remove(bins[binNumber].begin(), bins[binNumber].end(), seqNumber), bins[binNumber].end()); //remove from old bin i
+        
+        if (usedInsert) { insertLocation = findInsert(); }
+        
+        //update seqBins
+        seqBin[seqNumber] = bestBin; //set new OTU location
+        
+        return true;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "OptiCluster", "commitMove");
+        exit(1);
+    }
+}
+/***********************************************************************/
+//returns the bins containing a seq close to seq in bin order and fills counts with the number of close seqs in each
+vector<long long> OptiCluster::getCloseBins(long long seq, vector<long long>& counts) {
+    try {
+        vector<long long> closeBins;
+        
+        closeSeqs thisSeqsCloseSeqs = matrix->getCloseSeqs(seq);
+        for (const unsigned int* it = thisSeqsCloseSeqs.begin(); it != thisSeqsCloseSeqs.end(); it++) {
+            if (seq == *it) { continue; } //ignore self
+            
+            long long thisBin = seqBin[*it];
+            if (counts[thisBin] == 0) { closeBins.push_back(thisBin); }
+            counts[thisBin]++;
+        }
+        sort(closeBins.begin(), closeBins.end());
+        
+        return closeBins;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "OptiCluster", "getCloseBins");
         exit(1);
     }
 }
-
 /***********************************************************************/
 vector<double> OptiCluster::getStats( double& tp,  double& tn,  double& fp,  double& fn) {
     try {
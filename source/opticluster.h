@@ -26,25 +26,67 @@
 #include "tn.hpp"
 #include "fn.hpp"
 #include "accuracy.hpp"
+#include <condition_variable>
 
 /***********************************************************************/
+//the best bin found for a seq and the close / far counts to move it there
+struct optiClusterMove {
+    long long seq, fromBin, toBin; //toBin = -1 to move to a new bin, toBin = fromBin to stay
+    double closeFrom, farFrom, closeTo, farTo;
+    vector<long long> binsTried;
+    
+    optiClusterMove() : seq(0), fromBin(-1), toBin(-1), closeFrom(0), farFrom(0), closeTo(0), farTo(0) {}
+};
+/***********************************************************************/
+class OptiCluster;
 
-/*
- #ifdef UNIT_TEST
-     friend class TestOptiCluster;
-     OptiCluster() : Cluster() { m = MothurOut::getInstance(); truePositives = 0; trueNegatives = 0; falseNegatives = 0; falsePositives = 0;  } //for testing class
-     void setVariables(OptiData* mt, ClusterMetric* met) { matrix = mt; metric = met; }
- #endif
-     
- */
+struct optiEvaluateData {
+    OptiCluster* cluster;
+    long long start, end, offset; //randomizeSeqs[start] to randomizeSeqs[end-1] are stored in moves[start-offset] ...
+    vector<optiClusterMove>* moves;
+    vector<long long> closeInBin;
+    
+    optiEvaluateData(OptiCluster* c) : cluster(c), start(0), end(0), offset(0), moves(nullptr) {}
+};
+/***********************************************************************/
+//threads for data[1] ... data[n-1], kept for all the batches of an update. evaluate() runs one batch with data[0] on the calling thread
+class optiEvaluateWorkers {
+    
+public:
+    optiEvaluateWorkers(vector<optiEvaluateData*>&);
+    ~optiEvaluateWorkers();
+    
+    void evaluate();
+    
+private:
+    vector<optiEvaluateData*>& data;
+    vector<std::thread*> workerThreads;
+    std::mutex workerMutex;
+    std::condition_variable batchReady, batchFinished;
+    long long batch; //number of the current batch, the workers start when it changes
+    size_t numFinished;
+    bool done;
+    
+    void driver(int);
+};
+/***********************************************************************/
 
 class OptiCluster : public Cluster {
+    
+#ifdef UNIT_TEST
+    friend class TestOptiCluster;
+    OptiCluster() : Cluster() { truePositives = 0; trueNegatives = 0; falseNegatives = 0; falsePositives = 0; numSingletons = 0; processors = 1; } //for testing class
+    void setVariables(OptiData* mt, ClusterMetric* met) { matrix = mt; metric = met; }
+#endif
 
 public:
     
     OptiCluster(OptiData* mt, ClusterMetric* met, long long ns);
     ~OptiCluster() = default;
     
+    void setProcessors(int p) { processors = max(1, p); } //more than 1 evaluates the seqs in batches, see updateBatches
+    void evaluateMoves(long long, long long, long long, vector<optiClusterMove>&, vector<long long>&);
+    
     bool updateDistance(PDistCell& colCell, PDistCell& rowCell) { return false; } 
     string getTag() { string tag = "opti_" + metric->getName(); return tag; }
     long long getNumBins();
@@ -60,13 +102,18 @@ protected:
     vector<int> randomizeSeqs;
     vector< vector<long long> > bins; //bin[0] -> seqs in bin[0]
     map<long long, string> binLabels; //for fitting - maps binNumber to existing reference label
-    map<long long, long long> seqBin; //sequence# -> bin#
+    vector<long long> seqBin; //sequence# -> bin#, seqBin[numSeqs] = -1
+    vector<long long> closeInBin; //closeInBin[bin#] -> number of seqs close to the current seq in that bin, zeroed after each seq
     
     long long numSeqs, insertLocation, numSingletons;
+    int processors;
     double truePositives, trueNegatives, falsePositives, falseNegatives;
     
     long long findInsert();
-    vector<double> getCloseFarCounts(long long seq, long long newBin);
+    vector<long long> getCloseBins(long long seq, vector<long long>&);
+    void evaluateMove(long long, vector<long long>&, optiClusterMove&);
+    bool commitMove(optiClusterMove&);
+    void updateBatches();
     vector<double> getFitStats( long long&, long long&, long long&, long long&);
 };
 
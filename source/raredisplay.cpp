@@ -70,6 +70,19 @@ void RareDisplay::update(vector<SharedRAbundVector*> shared, int numSeqs) {
 
 /***********************************************************************/
 
+void RareDisplay::updateExpected(int numSeqs, vector<double> data){
+	try {
+        lock_guard<std::mutex> guard(mutex);
+		expected[numSeqs] = data;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "RareDisplay", "updateExpected");
+		exit(1);
+	}
+}
+
+/***********************************************************************/
+
 void RareDisplay::reset(){
 	try {
         lock_guard<std::mutex> guard(mutex);
@@ -102,8 +115,10 @@ void RareDisplay::close(){
 			output->updateOutput(it->first, data);
 		}
 		
+		for (map<int, vector<double> >::iterator it = expected.begin(); it != expected.end(); it++) { output->updateOutput(it->first, it->second); }
+		
 		nIters = 1;
-        results.clear();
+        results.clear(); expected.clear();
 		
 		output->resetFile();
 	}
@@ -21,12 +21,15 @@ public:
 	void update(vector<SharedRAbundVector*> shared, int numSeqs);
 	void close();
 	bool isCalcMultiple() { return estimate->getMultiple(); }
+	bool hasExpectedCurve() { return (estimate->getName() == "sobs"); }
+	void updateExpected(int, vector<double>);
 	
 private:
 	Calculator* estimate;
 	FileOutput* output;
 	string label;
 	map<int, vector<double> > results; //maps seqCount to results for that number of sequences
+	map<int, vector<double> > expected; //maps seqCount to mean, lci and hci when they are computed rather than sampled
 	int nIters;
     Utils util;
     std::mutex mutex;
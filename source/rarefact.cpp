@@ -8,6 +8,7 @@
  */
 
 #include "rarefact.h"
+#include "subsample.h"
 
 
 /**************************************************************************************************/
@@ -21,6 +22,9 @@ struct singleRarefactData {
     vector<Display*> displays;
     string label;
     int increment;
+    bool useSampler;
+    vector<int> abunds, points;
+    int numBins, maxRank;
     
     singleRarefactData(){}
     singleRarefactData(long long st, Utils u, OrderVector o, set<int> ed, vector<Display*>& dis, string l, long long ns, int inc) {
@@ -33,6 +37,23 @@ struct singleRarefactData {
         label = l;
         numSeqs = ns;
         increment = inc;
+        useSampler = false;
+        numBins = order.getNumBins();
+        maxRank = order.getMaxRank();
+    }
+    //draws the curve's points from the abundances instead of walking a shuffled order
+    singleRarefactData(long long st, vector<int>& a, vector<int>& p, int mr, vector<Display*>& dis, string l, long long ns) {
+        m = MothurOut::getInstance();
+        nIters = st;
+        abunds = a;
+        points = p;
+        displays = dis;
+        label = l;
+        numSeqs = ns;
+        increment = 1;
+        useSampler = true;
+        numBins = abunds.size();
+        maxRank = mr;
     }
 };
 /***********************************************************************/
@@ -40,33 +61,62 @@ int singleDriver(singleRarefactData* params){
     try {
         
         RarefactionCurveData rcd; rcd.registerDisplays(params->displays);
+        SubSample sample;
         
         for(int iter=0;iter<params->nIters;iter++){
             
             for(int i=0;i<params->displays.size();i++){ params->displays[i]->init(params->label); }
             
-            RAbundVector lookup(params->order.getNumBins());
-            SAbundVector rank(params->order.getMaxRank()+1);
-            params->util.mothurRandomShuffle(params->order);
+            RAbundVector lookup(params->numBins);
+            SAbundVector rank(params->maxRank+1);
             
-            for(int i=0;i<params->numSeqs;i++){
-                
-                if (params->m->getControl_pressed()) {  return 0;  }
+            if (params->useSampler) {
+                //each point adds a draw of the reads not yet used, the same as the next reads of a shuffled order
+                vector<int> remaining = params->abunds;
+                long long numSampled = 0;
                 
-                int binNumber = params->order.get(i);
-                int abundance = lookup.get(binNumber);
+                for (int p = 0; p < params->points.size(); p++) {
+                    
+                    if (params->m->getControl_pressed()) {  return 0;  }
+                    
+                    vector<int> counts = sample.getSampleCounts(remaining, params->points[p] - numSampled);
+                    for (int binNumber = 0; binNumber < counts.size(); binNumber++) {
+                        if (counts[binNumber] == 0) { continue; }
+                        
+                        int abundance = lookup.get(binNumber);
+                        rank.set(abundance, rank.get(abundance)-1);
+                        abundance += counts[binNumber];
+                        
+                        lookup.set(binNumber, abundance);
+                        rank.set(abundance, rank.get(abundance)+1);
+                        remaining[binNumber] -= counts[binNumber];
+                    }
+                    numSampled = params->points[p];
+                    
+                    rcd.updateRankData(rank);
+                }
+            }else {
+                params->util.mothurRandomShuffle(params->order);
                 
-                rank.set(abundance, rank.get(abundance)-1);
-                abundance++;
+                for(int i=0;i<params->numSeqs;i++){
+                    
+                    if (params->m->getControl_pressed()) {  return 0;  }
+                    
+                    int binNumber = params->order.get(i);
+                    int abundance = lookup.get(binNumber);
+                    
+                    rank.set(abundance, rank.get(abundance)-1);
+                    abundance++;
+                    
+                    lookup.set(binNumber, abundance);
+                    rank.set(abundance, rank.get(abundance)+1);
+                    
+                    if((i == 0) || ((i+1) % params->increment == 0) || (params->ends.count(i+1) != 0)){ rcd.updateRankData(rank); }
+                }
                 
-                lookup.set(binNumber, abundance);
-                rank.set(abundance, rank.get(abundance)+1);
-                
-                if((i == 0) || ((i+1) % params->increment == 0) || (params->ends.count(i+1) != 0)){ rcd.updateRankData(rank); }
+                if((params->numSeqs % params->increment != 0) || (params->ends.count(params->numSeqs) != 0)){ rcd.updateRankData(rank); }
             }
             
-            if((params->numSeqs % params->increment != 0) || (params->ends.count(params->numSeqs) != 0)){ rcd.updateRankData(rank); }
-            
             for(int i=0;i<params->displays.size();i++){ params->displays[i]->reset(); }
         }
         
@@ -77,7 +127,75 @@ int singleDriver(singleRarefactData* params){
         exit(1);
     }
 }
-
+/***********************************************************************/
+//sobs has a closed form at each point, the expected number of otus seen in a draw of n reads is Hurlbert's
+//numOTUs - sum over the otus of C(N-abund, n) / C(N, n), and its variance is Heck's. lci and hci are the mean -/+ 1.96 standard deviations,
+//clamped to the counts a draw can actually see: at least the fewest otus holding n reads, at most min(n, numOTUs).
+void Rarefact::getExpectedCurve(vector<Display*>& expectedDisplays, vector<int>& points){
+    try {
+        SAbundVector sabund = order.getSAbundVector();
+        int maxRank = sabund.getMaxRank();
+        double numOTUs = sabund.getNumBins();
+        long long N = numSeqs;
+        
+        vector<int> ranks;
+        for (int i = 1; i <= maxRank; i++) { if (sabund.get(i) != 0) { ranks.push_back(i); } }
+        
+        //pairs[s] is the number of ordered pairs of different otus whose abundances add to s
+        vector<double> pairs(2*maxRank+1, 0);
+        for (int i = 0; i < ranks.size(); i++) {
+            double fi = sabund.get(ranks[i]);
+            for (int j = 0; j < ranks.size(); j++) { pairs[ranks[i]+ranks[j]] += fi * sabund.get(ranks[j]); }
+            pairs[2*ranks[i]] -= fi;
+        }
+        
+        for(int i=0;i<expectedDisplays.size();i++){ expectedDisplays[i]->init(label); }
+        
+        set<int> done;
+        for (int p = 0; p < points.size(); p++) {
+            
+            if (m->getControl_pressed()) { break; }
+            
+            long long n = points[p];
+            if (done.count(n) != 0) { continue; }
+            done.insert(n);
+            
+            //q is C(N-s, n) / C(N, n), the chance a draw of n reads misses s given reads
+            //absent is the expected number of otus missed, absentPairs the expected number of ordered pairs of otus both missed
+            double absent = 0, absentPairs = 0, q = 1.0;
+            for (int s = 1; s <= 2*maxRank; s++) {
+                q *= (N - s + 1 - n) / (double)(N - s + 1);
+                if (q < 1e-20) { break; }
+                
+                if (s <= maxRank) { absent += sabund.get(s) * q; }
+                absentPairs += pairs[s] * q;
+            }
+            
+            double variance = absent + absentPairs - (absent * absent);
+            if (variance < 0) { variance = 0; }
+            
+            //fewest otus a draw of n reads can see, filling the most abundant otus first
+            double fewest = 0; long long filled = 0;
+            for (int i = ranks.size()-1; i >= 0; i--) {
+                long long canFill = (long long)ranks[i] * sabund.get(ranks[i]);
+                if (filled + canFill >= n) { fewest += ceil((n - filled) / (double)ranks[i]); break; }
+                filled += canFill; fewest += sabund.get(ranks[i]);
+            }
+            double most = min((double)n, numOTUs);
+            
+            vector<double> data(3, 0);
+            data[0] = numOTUs - absent;
+            data[1] = max(data[0] - 1.96 * sqrt(variance), fewest);
+            data[2] = min(data[0] + 1.96 * sqrt(variance), most);
+            
+            for(int i=0;i<expectedDisplays.size();i++){ expectedDisplays[i]->updateExpected(n, data); }
+        }
+    }
+    catch(exception& e) {
+        m->errorOut(e, "Rarefact", "getExpectedCurve");
+        exit(1);
+    }
+}
 /***********************************************************************/
 
 int Rarefact::getCurve(float percentFreq = 0.01, int nIters = 1000){
@@ -87,44 +205,78 @@ int Rarefact::getCurve(float percentFreq = 0.01, int nIters = 1000){
 		if (percentFreq < 1.0) {  increment = numSeqs * percentFreq;  }
 		else { increment = percentFreq;  }
         
-        vector<int> lines;
-        if (processors > (nIters)) { processors = nIters; }
+        //the numbers of sequences the curve reports
+        vector<int> points;
+        for(int i=0;i<numSeqs;i++){ if((i == 0) || ((i+1) % increment == 0) || (ends.count(i+1) != 0)){ points.push_back(i+1); } }
+        if((numSeqs % increment != 0) || (ends.count(numSeqs) != 0)){ points.push_back(numSeqs); }
         
-        //figure out how many sequences you have to process
-        int numItersPerProcessor = nIters / processors;
-        for (int i = 0; i < processors; i++) {
-            if(i == (processors - 1)){	numItersPerProcessor = (nIters) - i * numItersPerProcessor; 	}
-            lines.push_back(numItersPerProcessor);
+        //calculators with a closed form are computed once, the rest are averaged over the iterations
+        vector<Display*> iterDisplays, expectedDisplays;
+        for(int i=0;i<displays.size();i++){
+            if (expected && displays[i]->hasExpectedCurve()) { expectedDisplays.push_back(displays[i]); }
+            else { iterDisplays.push_back(displays[i]); }
         }
         
-        //create array of worker threads
-        vector<std::thread*> workerThreads;
-        vector<singleRarefactData*> data;
-        
-        //Lauch worker threads
-        for (int i = 0; i < processors-1; i++) {
+        if (iterDisplays.size() == 0) { getExpectedCurve(expectedDisplays, points); }
+        else {
+            //drawing a point costs a pass over the otus, walking a shuffled order costs a step per read
+            bool useSampler = (((long long)points.size() * order.getNumBins()) < numSeqs);
+            vector<int> abunds;
+            if (useSampler) {
+                RAbundVector rabund = order.getRAbundVector();
+                for (int i = 0; i < rabund.size(); i++) { abunds.push_back(rabund.get(i)); }
+            }
             
-            //make copy of order so we don't get access violations
-            OrderVector newOrder(order);
-            singleRarefactData* dataBundle = new singleRarefactData(lines[i+1], util, newOrder, ends, displays, label, numSeqs, increment);
+            vector<int> lines;
+            if (processors > (nIters)) { processors = nIters; }
             
-            data.push_back(dataBundle);
+            //figure out how many sequences you have to process
+            int numItersPerProcessor = nIters / processors;
+            for (int i = 0; i < processors; i++) {
+                if(i == (processors - 1)){	numItersPerProcessor = (nIters) - i * numItersPerProcessor; 	}
+                lines.push_back(numItersPerProcessor);
+            }
             
-            workerThreads.push_back(new std::thread(singleDriver, dataBundle));
-        }
-        
-        //make copy of lookup so we don't get access violations
-        OrderVector newOrder(order);
-        singleRarefactData* dataBundle = new singleRarefactData(lines[0], util, newOrder, ends, displays, label, numSeqs, increment);
-        singleDriver(dataBundle);
-        
-        for (int i = 0; i < processors-1; i++) {
-            workerThreads[i]->join();
+            //create array of worker threads
+            vector<std::thread*> workerThreads;
+            vector<singleRarefactData*> data;
             
-            delete data[i];
-            delete workerThreads[i];
+            //Lauch worker threads
+            for (int i = 0; i < processors-1; i++) {
+                
+                singleRarefactData* dataBundle = nullptr;
+                if (useSampler) { dataBundle = new singleRarefactData(lines[i+1], abunds, points, order.getMaxRank(), iterDisplays, label, numSeqs); }
+                else {
+                    //make copy of order so we don't get access violations
+                    OrderVector newOrder(order);
+                    dataBundle = new singleRarefactData(lines[i+1], util, newOrder, ends, iterDisplays, label, numSeqs, increment);
+                }
+                
+                data.push_back(dataBundle);
+                
+                workerThreads.push_back(new std::thread(singleDriver, dataBundle));
+            }
+            
+            //the closed form runs while the workers iterate, its displays are not shared with them
+            if (expectedDisplays.size() != 0) { getExpectedCurve(expectedDisplays, points); }
+            
+            singleRarefactData* dataBundle = nullptr;
+            if (useSampler) { dataBundle = new singleRarefactData(lines[0], abunds, points, order.getMaxRank(), iterDisplays, label, numSeqs); }
+            else {
+                //make copy of lookup so we don't get access violations
+                OrderVector newOrder(order);
+                dataBundle = new singleRarefactData(lines[0], util, newOrder, ends, iterDisplays, label, numSeqs, increment);
+            }
+            singleDriver(dataBundle);
+            
+            for (int i = 0; i < processors-1; i++) {
+                workerThreads[i]->join();
+                
+                delete data[i];
+                delete workerThreads[i];
+            }
+            delete dataBundle;
         }
-        delete dataBundle;
 
 		for(int i=0;i<displays.size();i++){ displays[i]->close(); }
 		
@@ -11,11 +11,11 @@
 class Rarefact {
 	
 public:
-	Rarefact(OrderVector& o, vector<Display*> disp, set<int> en, int proc) :
-    numSeqs(o.getNumSeqs()), order(o), displays(disp), label(o.getLabel()),  ends(en)  { m = MothurOut::getInstance(); jumble = false; processors = proc; }
+	Rarefact(OrderVector& o, vector<Display*> disp, set<int> en, int proc, bool exp) :
+    numSeqs(o.getNumSeqs()), order(o), displays(disp), label(o.getLabel()),  ends(en)  { m = MothurOut::getInstance(); jumble = false; processors = proc; expected = exp; }
     
 	Rarefact(SharedRAbundVectors* shared, vector<Display*> disp, bool j, int proc) :
-					 lookup(shared), displays(disp), jumble(j) {  m = MothurOut::getInstance(); processors = proc; }
+					 lookup(shared), displays(disp), jumble(j) {  m = MothurOut::getInstance(); processors = proc; expected = false; }
 
 	~Rarefact(){};
 	int getCurve(float, int);
@@ -31,10 +31,11 @@ private:
 	void mergeVectors(SharedRAbundVector*, SharedRAbundVector*);
 	SharedRAbundVectors* lookup;
 	MothurOut* m;
-    bool jumble;
+    bool jumble, expected; //expected computes the calcs with a closed form instead of averaging them over the iterations
     Utils util;
 	
 	int driver(vector<Display*>&, int, int);
+	void getExpectedCurve(vector<Display*>&, vector<int>&);
 
 };
 
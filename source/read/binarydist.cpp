@@ -0,0 +1,186 @@
+//
+//  binarydist.cpp
+//  Mothur
+//
+//  Created by agent on 10/17/26.
+//  Copyright © 2026 Schloss Lab. All rights reserved.
+//
+
+#include "binarydist.h"
+
+#ifdef NON_WINDOWS
+#include <sys/mman.h>
+#include <fcntl.h>
+#endif
+
+#define BINARYDIST_MAGIC "MOTHBDST"
+#define BINARYDIST_VERSION 2
+#define BINARYDIST_BYTEORDER 0x01020304
+
+/***********************************************************************/
+
+BinaryDistFile::BinaryDistFile() {
+    m = MothurOut::getInstance();
+    data = nullptr; fileSize = 0; numDists = 0;
+    rowOffsets = nullptr; cells = nullptr;
+}
+/***********************************************************************/
+BinaryDistFile::~BinaryDistFile() { close(); }
+/***********************************************************************/
+void BinaryDistFile::close() {
+#ifdef NON_WINDOWS
+    if (data != nullptr) { munmap((void*)data, fileSize); }
+#endif
+    vector<char> empty; buffer.swap(empty);
+    data = nullptr; fileSize = 0; numDists = 0;
+    rowOffsets = nullptr; cells = nullptr;
+}
+/***********************************************************************/
+bool BinaryDistFile::isBinary(string filename) {
+    ifstream in(filename.c_str(), ios::binary);
+    if (!in) { return false; }
+
+    char magic[8];
+    in.read(magic, 8);
+    if (in.gcount() != 8) { return false; }
+
+    return (memcmp(magic, BINARYDIST_MAGIC, 8) == 0);
+}
+/***********************************************************************/
+//pads the file to the next multiple of 8 bytes so the following array is aligned
+static void padTo8(ofstream& out, unsigned long long written) {
+    char zeros[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+    if ((written % 8) != 0) { out.write(zeros, 8 - (written % 8)); }
+}
+/***********************************************************************/
+static unsigned long long roundUpTo8(unsigned long long bytes) {
+    return ((bytes + 7) / 8) * 8;
+}
+/***********************************************************************/
+//column files are written with toString, so the distance is rounded the same way before it is stored
+float BinaryDistFile::roundDist(double dist) {
+    char text[32];
+    snprintf(text, 32, "%g", dist);
+    return strtof(text, nullptr);
+}
+/***********************************************************************/
+void BinaryDistFile::writeRow(ofstream& out, const vector<sparseDistCell>& row) {
+    if (row.size() != 0) { out.write((char*)&row[0], row.size()*sizeof(sparseDistCell)); }
+}
+/***********************************************************************/
+long long BinaryDistFile::write(string filename, const vector<string>& seqNames, const vector<string>& rowFiles, const vector<unsigned long long>& rowSizes) {
+    try {
+        unsigned long long numSeqs = seqNames.size();
+
+        vector<unsigned long long> offsets(numSeqs+1, 0);
+        for (unsigned long long i = 0; i < numSeqs; i++) {
+            offsets[i+1] = offsets[i];
+            if (i < rowSizes.size()) { offsets[i+1] += rowSizes[i]; }
+        }
+        unsigned long long numDists = offsets[numSeqs];
+
+        string nameTable = "";
+        for (unsigned long long i = 0; i < numSeqs; i++) { nameTable += seqNames[i]; nameTable += '\0'; }
+        unsigned long long nameBytes = nameTable.length();
+
+        ofstream out; util.openOutputFileBinary(filename, out);
+
+        unsigned int version = BINARYDIST_VERSION;
+        unsigned int byteOrder = BINARYDIST_BYTEORDER;
+        out.write(BINARYDIST_MAGIC, 8);
+        out.write((char*)&version, sizeof(unsigned int));
+        out.write((char*)&byteOrder, sizeof(unsigned int));
+        out.write((char*)&numSeqs, sizeof(unsigned long long));
+        out.write((char*)&numDists, sizeof(unsigned long long));
+        out.write((char*)&nameBytes, sizeof(unsigned long long));
+
+        out.write(nameTable.c_str(), nameBytes); padTo8(out, nameBytes);
+
+        for (int i = 0; i < rowFiles.size(); i++) {
+            ifstream in; util.openInputFileBinary(rowFiles[i], in);
+            if (in.peek() != EOF) { out << in.rdbuf(); }
+            in.close();
+            util.mothurRemove(rowFiles[i]);
+        }
+
+        out.write((char*)&offsets[0], (numSeqs+1)*sizeof(unsigned long long));
+        out.close();
+
+        return numDists;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "BinaryDistFile", "write");
+        exit(1);
+    }
+}
+/***********************************************************************/
+bool BinaryDistFile::read(string filename) {
+    try {
+        close();
+        
+        ifstream in; util.openInputFileBinary(filename, in);
+
+        char magic[8]; unsigned int version, byteOrder;
+        unsigned long long numSeqs, nameBytes;
+
+        in.read(magic, 8);
+        in.read((char*)&version, sizeof(unsigned int));
+        in.read((char*)&byteOrder, sizeof(unsigned int));
+
+        if (!in || (memcmp(magic, BINARYDIST_MAGIC, 8) != 0)) { m->mothurOut("[ERROR]: " + filename + " is not a binary distance file.\n"); m->setControl_pressed(true); return false; }
+        if (version != BINARYDIST_VERSION) { m->mothurOut("[ERROR]: " + filename + " was written by an incompatible version of mothur.\n"); m->setControl_pressed(true); return false; }
+        if (byteOrder != BINARYDIST_BYTEORDER) { m->mothurOut("[ERROR]: " + filename + " was written on a machine with a different byte order.\n"); m->setControl_pressed(true); return false; }
+
+        in.read((char*)&numSeqs, sizeof(unsigned long long));
+        in.read((char*)&numDists, sizeof(unsigned long long));
+        in.read((char*)&nameBytes, sizeof(unsigned long long));
+
+        //section offsets, see the layout in binarydist.h
+        unsigned long long nameStart = 40;
+        unsigned long long cellStart = nameStart + roundUpTo8(nameBytes);
+        unsigned long long rowStart = cellStart + (numDists * sizeof(sparseDistCell));
+        unsigned long long expectedSize = rowStart + ((numSeqs+1) * sizeof(unsigned long long));
+
+        in.seekg(0, ios::end);
+        unsigned long long size = in.tellg();
+        if (!in || (size < expectedSize)) { m->mothurOut("[ERROR]: " + filename + " is truncated.\n"); m->setControl_pressed(true); in.close(); numDists = 0; return false; }
+
+#ifdef NON_WINDOWS
+        in.close();
+
+        //only the pages the reader touches are loaded, and they can be dropped again under memory pressure
+        int fd = ::open(filename.c_str(), O_RDONLY);
+        if (fd == -1) { m->mothurOut("[ERROR]: Could not open " + filename + ".\n"); m->setControl_pressed(true); numDists = 0; return false; }
+        void* mapped = mmap(nullptr, expectedSize, PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (mapped == MAP_FAILED) { m->mothurOut("[ERROR]: Could not map " + filename + ".\n"); m->setControl_pressed(true); numDists = 0; return false; }
+        data = (const char*)mapped;
+#else
+        buffer.resize(expectedSize);
+        in.seekg(0);
+        in.read(&buffer[0], expectedSize);
+        bool good = (bool)in;
+        in.close();
+        if (!good) { m->mothurOut("[ERROR]: " + filename + " is truncated.\n"); m->setControl_pressed(true); close(); return false; }
+        data = buffer.data();
+#endif
+        fileSize = expectedSize;
+
+        names.clear(); names.reserve(numSeqs);
+        const char* name = data + nameStart;
+        for (unsigned long long i = 0; i < numSeqs; i++) {
+            names.push_back(string(name));
+            name += names.back().length() + 1;
+        }
+
+        rowOffsets = (const unsigned long long*)(data + rowStart);
+        cells = (const sparseDistCell*)(data + cellStart);
+
+        return true;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "BinaryDistFile", "read");
+        exit(1);
+    }
+}
+/***********************************************************************/
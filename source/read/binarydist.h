@@ -0,0 +1,82 @@
+#ifndef BINARYDIST_H
+#define BINARYDIST_H
+
+//
+//  binarydist.h
+//  Mothur
+//
+//  Created by agent on 10/17/26.
+//  Copyright © 2026 Schloss Lab. All rights reserved.
+//
+
+#include "mothurout.h"
+#include "utils.hpp"
+
+/******************************************************/
+//a distance below the cutoff to seq col of the name table, the row is implied by where it is stored
+struct sparseDistCell {
+    unsigned int col;
+    float dist;
+
+    sparseDistCell() : col(0), dist(0) {}
+    sparseDistCell(unsigned int c, float d) : col(c), dist(d) {}
+};
+/******************************************************/
+
+//  Binary sparse distance matrix. Each pair is stored once, like the column format, in compressed sparse row order.
+//
+//  header: magic "MOTHBDST", uint32 version, uint32 byte order check, uint64 numSeqs, uint64 numDists, uint64 nameBytes
+//  names:  nameBytes of '\0' terminated sequence names, padded to 8 bytes
+//  cells:  numDists of uint32 col and float32 dist, row by row and sorted by column within a row
+//  rows:   uint64 rowOffsets[numSeqs+1], the cells for row i are at rowOffsets[i] to rowOffsets[i+1]-1
+//
+//  The row offsets come last so the rows can be streamed to disk as they are calculated. The arrays are fixed width
+//  and aligned, so read() memory maps the file and the rows are read in place instead of loading every distance into
+//  memory. Readers index the name table instead of parsing and looking up names on every line.
+
+class BinaryDistFile {
+
+public:
+	BinaryDistFile();
+	~BinaryDistFile();
+
+    static bool isBinary(string); //true if the file starts with the binary distance header
+
+    static float roundDist(double); //the value a reader gets from the same distance in a column file
+    static void writeRow(ofstream&, const vector<sparseDistCell>&);
+
+    //the row files hold consecutive rows written with writeRow, in order, rowSizes has the number of cells in each row.
+    //The row files are removed once they are copied
+    long long write(string, const vector<string>&, const vector<string>&, const vector<unsigned long long>&);
+    bool read(string);
+
+    long long getNumSeqs()              { return (long long)names.size();   }
+    long long getNumDists()             { return (long long)numDists;       }
+    const string& getName(long long i)  { return names[i];                  }
+    const vector<string>& getNames()    { return names;                     }
+
+    long long getRowStart(long long i)  { return rowOffsets[i];             }
+    long long getRowEnd(long long i)    { return rowOffsets[i+1];           }
+    unsigned int getCol(long long k)    { return cells[k].col;              }
+    float getDist(long long k)          { return cells[k].dist;             }
+
+private:
+    MothurOut* m;
+    Utils util;
+
+    vector<string> names;
+    unsigned long long numDists;
+
+    //the mapped file
+    const char* data;
+    unsigned long long fileSize;
+    vector<char> buffer; //holds the file where it can't be mapped
+    const unsigned long long* rowOffsets;
+    const sparseDistCell* cells;
+
+    void close();
+};
+
+/******************************************************/
+
+#endif
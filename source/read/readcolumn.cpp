@@ -36,6 +36,21 @@ int ReadColumnMatrix::read(NameAssignment* nameMap){
 		int nseqs = nameMap->size();
         DMatrix->resize(nseqs);
 		list = new ListVector(nameMap->getListVector());
+        
+        if (BinaryDistFile::isBinary(distFile)) {
+            fileHandle.close();
+            BinaryDistFile distMatrix;
+            if (!distMatrix.read(distFile)) { return 0; }
+            
+            vector<int> indexes;
+            for (long long i = 0; i < distMatrix.getNumSeqs(); i++) {
+                map<string,int>::iterator it = nameMap->find(distMatrix.getName(i));
+                if(it == nameMap->end()){  m->mothurOut("AAError: Sequence '" + distMatrix.getName(i) + "' was not found in the names file, please correct\n"); exit(1);  }
+                indexes.push_back(it->second);
+            }
+            
+            return readBinary(distMatrix, indexes);
+        }
 	
         int lt = 1;
 		int refRow = 0;	//we'll keep track of one cell - Cell(refRow,refCol) - and see if it's transpose
@@ -158,6 +173,19 @@ int ReadColumnMatrix::read(CountTable* countTable){
         DMatrix->resize(nseqs);
 		list = new ListVector(countTable->getListVector());
         
+        if (BinaryDistFile::isBinary(distFile)) {
+            fileHandle.close();
+            BinaryDistFile distMatrix;
+            if (!distMatrix.read(distFile)) { return 0; }
+            
+            vector<int> indexes;
+            for (long long i = 0; i < distMatrix.getNumSeqs(); i++) { indexes.push_back(countTable->get(distMatrix.getName(i))); }
+            
+            if (m->getControl_pressed()) { exit(1); }
+            
+            return readBinary(distMatrix, indexes);
+        }
+        
 		int lt = 1;
 		int refRow = 0;	//we'll keep track of one cell - Cell(refRow,refCol) - and see if it's transpose
 		int refCol = 0; //shows up later - Cell(refCol,refRow).  If it does, then its a square matrix
@@ -265,6 +293,37 @@ int ReadColumnMatrix::read(CountTable* countTable){
 	}
 }
 
+//binary distance files are always lower triangle, indexes are the matrix index of each sequence in the binary file
+int ReadColumnMatrix::readBinary(BinaryDistFile& distMatrix, vector<int>& indexes){
+	try {
+        for (long long i = 0; i < distMatrix.getNumSeqs(); i++) {
+            
+            if (m->getControl_pressed()) {  return 0; }
+            
+            int itA = indexes[i];
+            
+            for (long long k = distMatrix.getRowStart(i); k < distMatrix.getRowEnd(i); k++) {
+                int itB = indexes[distMatrix.getCol(k)];
+                float distance = distMatrix.getDist(k);
+                
+                if (sim) { distance = 1.0 - distance;  }  //user has entered a sim matrix that we need to convert.
+                
+                if(distance <= cutoff && itA != itB){
+                    if(itA > itB)   { PDistCell value(itA, distance); DMatrix->addCell(itB, value); }
+                    else            { PDistCell value(itB, distance); DMatrix->addCell(itA, value); }
+                }
+            }
+        }
+        
+        list->setLabel("0");
+        
+        return 1;
+	}
+	catch(exception& e) {
+		m->errorOut(e, "ReadColumnMatrix", "readBinary");
+		exit(1);
+	}
+}
 /***********************************************************************/
 ReadColumnMatrix::~ReadColumnMatrix(){}
 /***********************************************************************/
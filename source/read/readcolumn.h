@@ -10,6 +10,7 @@
  */
 
 #include "readmatrix.hpp"
+#include "binarydist.h"
 
 /******************************************************/
 
@@ -24,6 +25,8 @@ public:
 private:
 	ifstream fileHandle;
 	string distFile;
+    
+    int readBinary(BinaryDistFile&, vector<int>&);
 	
 };
 
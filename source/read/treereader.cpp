@@ -22,9 +22,11 @@ TreeReader::TreeReader(string tf, string cf) : treefile(tf), countfile(cf)  {
         //if no groupinfo in count file we need to add it
         if (!ct->hasGroupInfo()) {
             ct->addGroup("Group1");
-            vector<string> namesOfSeqs = ct->getNamesOfSeqs();
+            vector<string> namesOfSeqs; vector<int> seqTotals;
+            vector<countTableSeq> seqs = ct->getSeqs();
+            for (int i = 0; i < seqs.size(); i++) { namesOfSeqs.push_back(seqs[i].getName()); seqTotals.push_back(seqs[i].total); }
             for (int i = 0; i < namesOfSeqs.size(); i++) { 
-                ct->setAbund(namesOfSeqs[i], "Group1", ct->getNumSeqs(namesOfSeqs[i]));
+                ct->setAbund(namesOfSeqs[i], "Group1", seqTotals[i]);
             }
         }
         namefile = "";
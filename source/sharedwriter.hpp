@@ -12,27 +12,126 @@
 #include "mothurout.h"
 #include "utils.hpp"
 
+#define WRITER_BUFFER_SIZE 65536        //output an OutputWriter collects before taking the file's lock
+#define WRITER_SPILL_SIZE 8388608       //output an ordered writer keeps in memory while waiting for its turn
+
+/***********************************************************************/
+//the output of one OutputWriter that hasn't been written to the file yet
+struct writerChunk {
+    long long order;        //-1 if the writer's output can go anywhere in the file
+    string buffer;
+    size_t commitSize;      //size of the buffer when the writer should commit it
+    string spillName;       //temp file holding output that is waiting for the writers before it
+    ofstream spill;
+    bool finished;
+
+    writerChunk(long long o) : order(o), commitSize(WRITER_BUFFER_SIZE), spillName(""), finished(false) { buffer.reserve(WRITER_BUFFER_SIZE); }
+};
 /***********************************************************************/
+//  The OutputWriters sharing a file collect their output and commit it in large pieces, so the threads
+//  rarely wait for the lock. Writers created with an order keep the order of the input: the output of
+//  order 1 is written after all the output of order 0 and so on. The threads processing the input in
+//  order get orders 0, 1, 2..., and the file matches the one processors=1 makes.
 class SynchronizedOutputFile {
 public:
-    SynchronizedOutputFile (const string& p)                : path(p) { util.openOutputFile(p, out);        }
-    SynchronizedOutputFile (const string& p, bool append)   : path(p) { util.openOutputFileAppend(p, out);  }
-    ~SynchronizedOutputFile() { if (out.is_open()) { out.close(); } } //if we forgot to close()
-    
+    SynchronizedOutputFile (const string& p)                : path(p), nextOrder(0), closed(false) { util.openOutputFile(p, out);        }
+    SynchronizedOutputFile (const string& p, bool append)   : path(p), nextOrder(0), closed(false) { util.openOutputFileAppend(p, out);  }
+    ~SynchronizedOutputFile() { close(); for (set<writerChunk*>::iterator it = chunks.begin(); it != chunks.end(); it++) { delete *it; } } //if we forgot to close()
+
     void write (const string& dataToWrite) {
         std::lock_guard<std::mutex> lock((writerMutex)); // Ensure that only one thread can execute at a time
         out << dataToWrite;
     }
-    void close() { if (out.is_open()) { out.close(); } }
-    
+
+    writerChunk* addWriter(long long order) {
+        std::lock_guard<std::mutex> lock((writerMutex));
+        writerChunk* chunk = new writerChunk(order);
+        chunks.insert(chunk);
+        if (order != -1) { orderedChunks[order] = chunk; }
+        return chunk;
+    }
+
+    //called by the writer's thread when its buffer is full
+    void commit(writerChunk* chunk) {
+        std::unique_lock<std::mutex> lock((writerMutex));
+        if ((chunk->order == -1) || (chunk->order == nextOrder)) { writeChunk(chunk); return; }
+        lock.unlock();
+
+        //not this writer's turn yet, only its own thread touches the chunk until it finishes
+        if (chunk->buffer.size() >= WRITER_SPILL_SIZE) {
+            if (chunk->spillName == "") {
+                chunk->spillName = path + "." + toString(chunk->order) + ".writer.temp";
+                Utils spillUtil; spillUtil.openOutputFile(chunk->spillName, chunk->spill);
+            }
+            chunk->spill << chunk->buffer;
+            chunk->buffer.clear();
+        }
+        chunk->commitSize = chunk->buffer.size() + WRITER_BUFFER_SIZE;
+    }
+
+    //called when the writer is deleted
+    void finish(writerChunk* chunk) {
+        std::lock_guard<std::mutex> lock((writerMutex));
+        if (closed) { return; }
+
+        chunk->finished = true;
+        if (chunk->order == -1) { writeChunk(chunk); removeChunk(chunk); return; }
+
+        //write the finished writers whose turn it is
+        map<long long, writerChunk*>::iterator it = orderedChunks.find(nextOrder);
+        while ((it != orderedChunks.end()) && (it->first == nextOrder) && (it->second->finished)) {
+            writeChunk(it->second);
+            removeChunk(it->second);
+            orderedChunks.erase(it++);
+            nextOrder++;
+        }
+    }
+
+    void close() {
+        std::lock_guard<std::mutex> lock((writerMutex));
+        if (closed) { return; }
+
+        //anything the writers haven't committed yet, in order for the ordered writers
+        for (set<writerChunk*>::iterator it = chunks.begin(); it != chunks.end(); it++) { if ((*it)->order == -1) { writeChunk(*it); } }
+        for (map<long long, writerChunk*>::iterator it = orderedChunks.begin(); it != orderedChunks.end(); it++) { writeChunk(it->second); }
+
+        if (out.is_open()) { out.close(); }
+        closed = true;
+    }
+
     void setFixedShowPoint()    {  out.setf(ios::fixed, ios::showpoint);    }
     void setPrecision(int p)    {  out << setprecision(p);                  }
-    
+
 private:
     string path;
     std::mutex writerMutex;
     Utils util;
     ofstream out;
+    set<writerChunk*> chunks; //the writers that haven't finished, or are waiting for their turn
+    map<long long, writerChunk*> orderedChunks;
+    long long nextOrder; //the ordered writer whose output can be written now
+    bool closed;
+
+    //must hold the lock
+    void writeChunk(writerChunk* chunk) {
+        if (chunk->spillName != "") {
+            chunk->spill.close();
+            ifstream in; util.openInputFile(chunk->spillName, in);
+            out << in.rdbuf();
+            in.close();
+            util.mothurRemove(chunk->spillName);
+            chunk->spillName = "";
+        }
+        out << chunk->buffer;
+        chunk->buffer.clear();
+        chunk->commitSize = WRITER_BUFFER_SIZE;
+    }
+
+    //must hold the lock, the chunk's writer is deleted
+    void removeChunk(writerChunk* chunk) {
+        chunks.erase(chunk);
+        delete chunk;
+    }
 };
 
 /***********************************************************************/
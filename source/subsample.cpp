@@ -8,6 +8,187 @@
 
 #include "subsample.h"
 //**********************************************************************************************************************
+/* The abundance vector samplers draw each bin's count directly instead of expanding the bins into one entry per read and shuffling.
+ Without replacement, bin i's count is hypergeometric given the reads not yet used by bins 0 to i-1, and with replacement it is binomial
+ given the draws left, so the counts have the same distribution as the shuffle. Each draw is by inversion, walking out from 0 when few
+ reads are expected and from the mode otherwise, so it takes about as many steps as the draw's standard deviation. */
+//**********************************************************************************************************************
+vector<int> SubSample::getSampleCounts(vector<int>& abunds, long long size) {
+    try {
+        vector<int> counts(abunds.size(), 0);
+        
+        long long remainingReads = 0;
+        for (int i = 0; i < abunds.size(); i++) { remainingReads += abunds[i]; }
+        
+        long long remainingSize = size;
+        for (int i = 0; i < abunds.size(); i++) {
+            if (remainingSize == 0) { break; }
+            if (abunds[i] == 0) { continue; }
+            
+            counts[i] = (int)getHypergeometric(abunds[i], remainingReads-abunds[i], remainingSize);
+            remainingSize -= counts[i];
+            remainingReads -= abunds[i];
+        }
+        
+        return counts;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "SubSample", "getSampleCounts");
+        exit(1);
+    }
+}
+//**********************************************************************************************************************
+vector<int> SubSample::getSampleCountsWithReplacement(vector<int>& abunds, long long size) {
+    try {
+        vector<int> counts(abunds.size(), 0);
+        
+        long long remainingReads = 0;
+        for (int i = 0; i < abunds.size(); i++) { remainingReads += abunds[i]; }
+        
+        long long remainingSize = size;
+        for (int i = 0; i < abunds.size(); i++) {
+            if (remainingSize == 0) { break; }
+            if (abunds[i] == 0) { continue; }
+            
+            counts[i] = (int)getBinomial(remainingSize, abunds[i] / (double)remainingReads);
+            remainingSize -= counts[i];
+            remainingReads -= abunds[i];
+        }
+        
+        return counts;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "SubSample", "getSampleCountsWithReplacement");
+        exit(1);
+    }
+}
+//**********************************************************************************************************************
+long long SubSample::getHypergeometric(long long good, long long bad, long long sample) {
+    try {
+        long long total = good + bad;
+        if ((sample <= 0) || (good == 0)) { return 0; }
+        if (sample >= total) { return good; }
+        if (bad == 0) { return sample; }
+        
+        //the distribution is the same with good and sample swapped, k is the smaller
+        long long k = min(good, sample);
+        long long n = max(good, sample);
+        long long low = max((long long)0, n + k - total);
+        long long high = k;
+        if (low == high) { return low; }
+        
+        double u = util.getRandomDouble0to1();
+        
+        //P(x+1) / P(x) = (k-x)(n-x) / ((x+1)(total-k-n+x+1))
+        if ((low == 0) && (k <= 32)) {
+            double p = 1.0;
+            for (long long j = 0; j < k; j++) { p *= (total - n - j) / (double)(total - j); }
+            
+            if (p > 1e-100) {
+                long long x = 0;
+                while ((u > p) && (x < high)) {
+                    u -= p;
+                    p *= (k - x) * (double)(n - x) / ((x + 1) * (double)(total - k - n + x + 1));
+                    x++;
+                }
+                return x;
+            }
+        }
+        
+        long long mode = (long long)floor((n + 1) * ((k + 1) / (double)(total + 2)));
+        if (mode < low) { mode = low; } if (mode > high) { mode = high; }
+        
+        double logP = lgamma(k+1) - lgamma(mode+1) - lgamma(k-mode+1)
+                    + lgamma(total-k+1) - lgamma(n-mode+1) - lgamma(total-k-n+mode+1)
+                    - lgamma(total+1) + lgamma(n+1) + lgamma(total-n+1);
+        double pMode = exp(logP);
+        
+        //take the values in the order mode, mode+1, mode-1, mode+2...
+        u -= pMode;
+        if (u <= 0) { return mode; }
+        long long up = mode, down = mode;
+        double pUp = pMode, pDown = pMode;
+        while ((up < high) || (down > low)) {
+            if (up < high) {
+                pUp *= (k - up) * (double)(n - up) / ((up + 1) * (double)(total - k - n + up + 1));
+                up++;
+                u -= pUp;
+                if (u <= 0) { return up; }
+            }
+            if (down > low) {
+                down--;
+                pDown /= (k - down) * (double)(n - down) / ((down + 1) * (double)(total - k - n + down + 1));
+                u -= pDown;
+                if (u <= 0) { return down; }
+            }
+        }
+        
+        return mode; //rounding left u above the total probability
+    }
+    catch(exception& e) {
+        m->errorOut(e, "SubSample", "getHypergeometric");
+        exit(1);
+    }
+}
+//**********************************************************************************************************************
+long long SubSample::getBinomial(long long trials, double prob) {
+    try {
+        if ((trials <= 0) || (prob <= 0)) { return 0; }
+        if (prob >= 1) { return trials; }
+        if (prob > 0.5) { return trials - getBinomial(trials, 1.0 - prob); }
+        
+        double u = util.getRandomDouble0to1();
+        double odds = prob / (1.0 - prob);
+        
+        //P(x+1) / P(x) = (trials-x) / (x+1) * odds
+        if ((trials * prob) < 30) {
+            double p = exp(trials * log1p(-prob));
+            
+            if (p > 1e-100) {
+                long long x = 0;
+                while ((u > p) && (x < trials)) {
+                    u -= p;
+                    p *= (trials - x) / (double)(x + 1) * odds;
+                    x++;
+                }
+                return x;
+            }
+        }
+        
+        long long mode = (long long)floor((trials + 1) * prob);
+        if (mode > trials) { mode = trials; }
+        
+        double logP = lgamma(trials+1) - lgamma(mode+1) - lgamma(trials-mode+1) + mode * log(prob) + (trials - mode) * log1p(-prob);
+        double pMode = exp(logP);
+        
+        //take the values in the order mode, mode+1, mode-1, mode+2...
+        u -= pMode;
+        if (u <= 0) { return mode; }
+        long long up = mode, down = mode;
+        double pUp = pMode, pDown = pMode;
+        while ((up < trials) || (down > 0)) {
+            if (up < trials) {
+                pUp *= (trials - up) / (double)(up + 1) * odds;
+                up++;
+                u -= pUp;
+                if (u <= 0) { return up; }
+            }
+            if (down > 0) {
+                down--;
+                pDown /= (trials - down) / (double)(down + 1) * odds;
+                u -= pDown;
+                if (u <= 0) { return down; }
+            }
+        }
+        
+        return mode; //rounding left u above the total probability
+    }
+    catch(exception& e) {
+        m->errorOut(e, "SubSample", "getBinomial");
+        exit(1);
+    }
+}
+//**********************************************************************************************************************
 Tree* SubSample::getSample(Tree* T, CountTable* ct, CountTable* newCt, int size, vector<string>& mGroups) {
     try {
         //remove seqs not in sample from counttable
@@ -245,21 +426,18 @@ vector<string> SubSample::getSample(vector<SharedRAbundVector*>& rabunds, int si
             
             if (thisSize != size) {
                 
-                vector<int> order;
-                for (int j = 0; j < rabunds[i]->size(); j++) {
-                    int abund = rabunds[i]->get(j);
-                    for(int k=0;k<abund;k++){ order.push_back(j);  }
-                }
+                vector<int> abunds;
+                for (int j = 0; j < rabunds[i]->getNumEntries(); j++) { abunds.push_back(rabunds[i]->getEntryAbund(j)); }
                 
-                util.mothurRandomShuffle(order);
+                vector<int> counts = getSampleCounts(abunds, size); //only allows you to select a read once
                 
-                SharedRAbundVector* temp = new SharedRAbundVector(numBins);
+                SharedRAbundVector* temp = new SharedRAbundVector(numBins, rabunds[i]->isSparse());
                 temp->setLabel(rabunds[i]->getLabel());
                 temp->setGroup(rabunds[i]->getGroup());
                 
-                for (int j = 0; j < size; j++) { //only allows you to select a read once
+                for (int j = 0; j < counts.size(); j++) {
                     if (m->getControl_pressed()) {  return currentLabels; }
-                    temp->increment(order[j]);
+                    if (counts[j] != 0) { temp->set(rabunds[i]->getEntryBin(j), counts[j]); }
                 }
                 newLookup->push_back(temp);
             }else { SharedRAbundVector* temp = new SharedRAbundVector(*rabunds[i]); newLookup->push_back(temp); }
@@ -293,22 +471,18 @@ vector<string> SubSample::getSampleWithReplacement(vector<SharedRAbundVector*>&
         int numBins = rabunds[0]->getNumBins();
         for (int i = 0; i < rabunds.size(); i++) {
 
-            vector<int> order;
-            for (int j = 0; j < rabunds[i]->size(); j++) {
-                int abund = rabunds[i]->get(j);
-                for(int k=0;k<abund;k++){ order.push_back(j);  }
-            }
+            vector<int> abunds;
+            for (int j = 0; j < rabunds[i]->getNumEntries(); j++) { abunds.push_back(rabunds[i]->getEntryAbund(j)); }
             
-            SharedRAbundVector* temp = new SharedRAbundVector(numBins);
+            vector<int> counts = getSampleCountsWithReplacement(abunds, size); //allows you to select a read multiple times
+            
+            SharedRAbundVector* temp = new SharedRAbundVector(numBins, rabunds[i]->isSparse());
             temp->setLabel(rabunds[i]->getLabel());
             temp->setGroup(rabunds[i]->getGroup());
             
-            long long orderSize = order.size()-1;
-            for (int j = 0; j < size; j++) { //allows you to select a read multiple times
+            for (int j = 0; j < counts.size(); j++) {
                 if (m->getControl_pressed()) {  return currentLabels; }
-                //"grab random from bag"
-                long long randomRead = util.getRandomIndex(orderSize);
-                temp->increment(order[randomRead]);
+                if (counts[j] != 0) { temp->set(rabunds[i]->getEntryBin(j), counts[j]); }
             }
             newLookup->push_back(temp);
 
@@ -381,25 +555,20 @@ vector<string> SubSample::getSampleWithReplacement(SharedRAbundVectors*& thisloo
 int SubSample::getSample(SAbundVector*& sabund, int size) {
 	try {
 		
-        int numBins = sabund->getNumBins();
         int thisSize = sabund->getNumSeqs();
-
-        OrderVector order = sabund->getOrderVector();
         
 		if (thisSize > size) {
-			util.mothurRandomShuffle(order);
-			
-            RAbundVector rabund(numBins);
+            RAbundVector sabundsRabund = sabund->getRAbundVector();
+            vector<int> abunds;
+            for (int j = 0; j < sabundsRabund.size(); j++) { abunds.push_back(sabundsRabund.get(j)); }
+            
+            vector<int> counts = getSampleCounts(abunds, size);
+            if (m->getControl_pressed()) { return 0; }
+            
+            RAbundVector rabund(counts.size());
+            for (int j = 0; j < counts.size(); j++) { if (counts[j] != 0) { rabund.set(j, counts[j]); } }
 			rabund.setLabel(sabund->getLabel());
 
-			for (int j = 0; j < size; j++) {
-                
-				if (m->getControl_pressed()) { return 0; }
-				
-                int abund = rabund.get(order.get(j));
-				rabund.set(order.get(j), (abund+1));
-			}
-
             delete sabund;
             sabund = new SAbundVector();
             *sabund = rabund.getSAbundVector();
@@ -418,26 +587,19 @@ int SubSample::getSample(SAbundVector*& sabund, int size) {
 int SubSample::getSampleWithReplacement(SAbundVector*& sabund, int size) {
     try {
         
-        int numBins = sabund->getNumBins();
         int thisSize = sabund->getNumSeqs();
         
-        OrderVector order = sabund->getOrderVector();
-        
         if (thisSize > size) {
-            RAbundVector rabund(numBins);
-            rabund.setLabel(sabund->getLabel());
+            RAbundVector sabundsRabund = sabund->getRAbundVector();
+            vector<int> abunds;
+            for (int j = 0; j < sabundsRabund.size(); j++) { abunds.push_back(sabundsRabund.get(j)); }
             
-            long long orderSize = order.size()-1;
-            for (int j = 0; j < size; j++) {
-                
-                if (m->getControl_pressed()) { return 0; }
-                
-                //"grab random from bag"
-                long long randomRead = util.getRandomIndex(orderSize);
-                
-                int abund = rabund.get(order.get(randomRead));
-                rabund.set(order.get(randomRead), (abund+1));
-            }
+            vector<int> counts = getSampleCountsWithReplacement(abunds, size); //"grab random from bag"
+            if (m->getControl_pressed()) { return 0; }
+            
+            RAbundVector rabund(counts.size());
+            for (int j = 0; j < counts.size(); j++) { if (counts[j] != 0) { rabund.set(j, counts[j]); } }
+            rabund.setLabel(sabund->getLabel());
             
             delete sabund;
             sabund = new SAbundVector();
@@ -457,24 +619,18 @@ int SubSample::getSampleWithReplacement(SAbundVector*& sabund, int size) {
 int SubSample::getSample(RAbundVector*& rabund, int size) {
     try {
         
-        int numBins = rabund->getNumBins();
         int thisSize = rabund->getNumSeqs();
         
-        OrderVector order = rabund->getOrderVector(nullptr);
-        
         if (thisSize > size) {
-            util.mothurRandomShuffle(order);
+            vector<int> abunds;
+            for (int j = 0; j < rabund->size(); j++) { abunds.push_back(rabund->get(j)); }
             
-            RAbundVector sampledRabund(numBins);
-            sampledRabund.setLabel(rabund->getLabel());
+            vector<int> counts = getSampleCounts(abunds, size);
+            if (m->getControl_pressed()) { return 0; }
             
-            for (int j = 0; j < size; j++) {
-                
-                if (m->getControl_pressed()) { return 0; }
-                
-                int abund = sampledRabund.get(order.get(j));
-                sampledRabund.set(order.get(j), (abund+1));
-            }
+            RAbundVector sampledRabund(counts.size());
+            for (int j = 0; j < counts.size(); j++) { if (counts[j] != 0) { sampledRabund.set(j, counts[j]); } }
+            sampledRabund.setLabel(rabund->getLabel());
             
             delete rabund;
             rabund = new RAbundVector(sampledRabund);
@@ -493,26 +649,18 @@ int SubSample::getSample(RAbundVector*& rabund, int size) {
 int SubSample::getSampleWithReplacement(RAbundVector*& rabund, int size) {
     try {
         
-        int numBins = rabund->getNumBins();
         int thisSize = rabund->getNumSeqs();
         
-        OrderVector order = rabund->getOrderVector(nullptr);
-        
         if (thisSize > size) {
-            RAbundVector sampledRabund(numBins);
-            sampledRabund.setLabel(rabund->getLabel());
+            vector<int> abunds;
+            for (int j = 0; j < rabund->size(); j++) { abunds.push_back(rabund->get(j)); }
             
-            long long orderSize = order.size()-1;
-            for (int j = 0; j < size; j++) {
-                
-                if (m->getControl_pressed()) { return 0; }
-                
-                //"grab random from bag"
-                long long randomRead = util.getRandomIndex(orderSize);
-                
-                int abund = sampledRabund.get(order.get(randomRead));
-                sampledRabund.set(order.get(randomRead), (abund+1));
-            }
+            vector<int> counts = getSampleCountsWithReplacement(abunds, size); //"grab random from bag"
+            if (m->getControl_pressed()) { return 0; }
+            
+            RAbundVector sampledRabund(counts.size());
+            for (int j = 0; j < counts.size(); j++) { if (counts[j] != 0) { sampledRabund.set(j, counts[j]); } }
+            sampledRabund.setLabel(rabund->getLabel());
             
             delete rabund;
             rabund = new RAbundVector(sampledRabund);
@@ -539,31 +687,32 @@ CountTable SubSample::getSample(CountTable& ct, int size, vector<string> Groups,
             sampledCt.addGroup(Groups[i]);
             
             vector<string> names = ct.getNamesOfSeqs(Groups[i]);
-            vector<int> allNames;
+            vector<int> abunds; long long numReads = 0;
             for (int j = 0; j < names.size(); j++) {
                 
                 if (m->getControl_pressed()) { return sampledCt; }
                 
                 int num = ct. getGroupCount(names[j], Groups[i]);
-                for (int k = 0; k < num; k++) { allNames.push_back(j); }
+                abunds.push_back(num); numReads += num;
             }
             
-            util.mothurRandomShuffle(allNames);
-            
-            if (allNames.size() < size) { m->mothurOut("[ERROR]: You have selected a size that is larger than "+Groups[i]+" number of sequences.\n"); m->setControl_pressed(true); }
+            if (numReads < size) { m->mothurOut("[ERROR]: You have selected a size that is larger than "+Groups[i]+" number of sequences.\n"); m->setControl_pressed(true); }
             else{
-                for (int j = 0; j < size; j++) {
+                vector<int> counts = getSampleCounts(abunds, size);
+                
+                for (int j = 0; j < counts.size(); j++) {
                     
                     if (m->getControl_pressed()) { return sampledCt; }
+                    if (counts[j] == 0) { continue; }
                     
-                    map<string, vector<int> >::iterator it = tempCount.find(names[allNames[j]]);
+                    map<string, vector<int> >::iterator it = tempCount.find(names[j]);
                     
                     if (it == tempCount.end()) { //we have not seen this sequence at all yet
                         vector<int> tempGroups; tempGroups.resize(Groups.size(), 0);
-                        tempGroups[i]++;
-                        tempCount[names[allNames[j]]] = tempGroups;
+                        tempGroups[i] += counts[j];
+                        tempCount[names[j]] = tempGroups;
                     }else{
-                        tempCount[names[allNames[j]]][i]++;
+                        tempCount[names[j]][i] += counts[j];
                     }
                 }
             }
@@ -595,34 +744,33 @@ CountTable SubSample::getSampleWithReplacement(CountTable& ct, int size, vector<
             sampledCt.addGroup(Groups[i]);
             
             vector<string> names = ct.getNamesOfSeqs(Groups[i]);
-            vector<int> allNames;
+            vector<int> abunds; long long numReads = 0;
             for (int j = 0; j < names.size(); j++) {
                 
                 if (m->getControl_pressed()) { return sampledCt; }
                 
                 int num = ct.getGroupCount(names[j], Groups[i]);
-                for (int k = 0; k < num; k++) { allNames.push_back(j); }
+                abunds.push_back(num); numReads += num;
             }
             
-            long long allNamesSize = allNames.size()-1;
-            
-            if (allNames.size() < size) { m->mothurOut("[ERROR]: You have selected a size that is larger than "+Groups[i]+" number of sequences.\n"); m->setControl_pressed(true); }
+            if (numReads < size) { m->mothurOut("[ERROR]: You have selected a size that is larger than "+Groups[i]+" number of sequences.\n"); m->setControl_pressed(true); }
             else{
-                for (int j = 0; j < size; j++) {
+                //"grab random from bag"
+                vector<int> counts = getSampleCountsWithReplacement(abunds, size);
+                
+                for (int j = 0; j < counts.size(); j++) {
                     
                     if (m->getControl_pressed()) { return sampledCt; }
+                    if (counts[j] == 0) { continue; }
                     
-                    //"grab random from bag"
-                    long long randomRead = util.getRandomIndex(allNamesSize);
-                    
-                    map<string, vector<int> >::iterator it = tempCount.find(names[allNames[randomRead]]);
+                    map<string, vector<int> >::iterator it = tempCount.find(names[j]);
                     
                     if (it == tempCount.end()) { //we have not seen this sequence at all yet
                         vector<int> tempGroups; tempGroups.resize(Groups.size(), 0);
-                        tempGroups[i]++;
-                        tempCount[names[allNames[randomRead]]] = tempGroups;
+                        tempGroups[i] += counts[j];
+                        tempCount[names[j]] = tempGroups;
                     }else{
-                        tempCount[names[allNames[randomRead]]][i]++;
+                        tempCount[names[j]][i] += counts[j];
                     }
                 }
             }
@@ -752,35 +900,27 @@ CountTable SubSample::getSample(CountTable& ct, int size, vector<string> Groups)
             for (int i = 0; i < Groups.size(); i++) { sampledCt.addGroup(Groups[i]);  }
                 
             vector<string> names = ct.getNamesOfSeqs(Groups); //names of sequences in groups
-            vector<intPair> allNames;
+            vector<int> abunds; long long numReads = 0; //reads of names[j] in Groups[i] are abunds[j*Groups.size()+i]
             for (int j = 0; j < names.size(); j++) {
                     
                 if (m->getControl_pressed()) { return sampledCt; }
                 
                 for (int i = 0; i < Groups.size(); i++) {
                     int num = ct.getGroupCount(names[j], Groups[i]); //num reads in this group from this seq
-                    intPair thisSeq(j,i);
-                    for (int k = 0; k < num; k++) { allNames.push_back(thisSeq); }
+                    abunds.push_back(num); numReads += num;
                 }
             }
                 
-            util.mothurRandomShuffle(allNames);
-                
-            if (allNames.size() < size) { m->mothurOut("[ERROR]: You have selected a size that is larger than the number of sequences.\n"); m->setControl_pressed(true); }
+            if (numReads < size) { m->mothurOut("[ERROR]: You have selected a size that is larger than the number of sequences.\n"); m->setControl_pressed(true); }
             else{
-                for (int j = 0; j < size; j++) {
+                vector<int> counts = getSampleCounts(abunds, size);
+                
+                for (int j = 0; j < names.size(); j++) {
                         
                     if (m->getControl_pressed()) { return sampledCt; }
-                        
-                    map<string, vector<int> >::iterator it = tempCount.find(names[allNames[j].abund]);
-                        
-                    if (it == tempCount.end()) { //we have not seen this sequence at all yet
-                        vector<int> tempGroups; tempGroups.resize(Groups.size(), 0);
-                        tempGroups[allNames[j].group]++;
-                        tempCount[names[allNames[j].abund]] = tempGroups;
-                    }else{
-                        tempCount[names[allNames[j].abund]][allNames[j].group]++;
-                    }
+                    
+                    vector<int> tempGroups(counts.begin()+(j*Groups.size()), counts.begin()+((j+1)*Groups.size()));
+                    if (util.sum(tempGroups) != 0) { tempCount[names[j]] = tempGroups; }
                 }
             }
             
@@ -793,32 +933,21 @@ CountTable SubSample::getSample(CountTable& ct, int size, vector<string> Groups)
 
         }else { //no groups
             vector<string> names = ct.getNamesOfSeqs();
-            map<int, int> nameMap;
-            vector<int> allNames;
+            vector<int> abunds; long long numReads = 0;
             
             for (int i = 0; i < names.size(); i++) {
                 int num = ct.getNumSeqs(names[i]);
-                for (int j = 0; j < num; j++) { allNames.push_back(i); }
+                abunds.push_back(num); numReads += num;
             }
             
-            if (allNames.size() < size) { m->mothurOut("[ERROR]: You have selected a size that is larger than the number of sequences.\n"); m->setControl_pressed(true); return sampledCt; }
+            if (numReads < size) { m->mothurOut("[ERROR]: You have selected a size that is larger than the number of sequences.\n"); m->setControl_pressed(true); return sampledCt; }
             else {
-                util.mothurRandomShuffle(allNames);
-                
-                for (int j = 0; j < size; j++) {
-                    if (m->getControl_pressed()) { return sampledCt; }
-                    
-                    map<int, int>::iterator it = nameMap.find(allNames[j]);
-                    
-                    //we have not seen this sequence at all yet
-                    if (it == nameMap.end()) { nameMap[allNames[j]] = 1;  }
-                    else{  nameMap[allNames[j]]++;  }
-                }
+                vector<int> counts = getSampleCounts(abunds, size);
                 
                 //build count table
-                for (map<int, int>::iterator it = nameMap.begin(); it != nameMap.end();) {
-                    sampledCt.push_back(names[it->first], it->second);
-                    nameMap.erase(it++);
+                for (int j = 0; j < counts.size(); j++) {
+                    if (m->getControl_pressed()) { return sampledCt; }
+                    if (counts[j] != 0) { sampledCt.push_back(names[j], counts[j]); }
                 }
             }
         }
@@ -842,37 +971,27 @@ CountTable SubSample::getSampleWithReplacement(CountTable& ct, int size, vector<
             for (int i = 0; i < Groups.size(); i++) { sampledCt.addGroup(Groups[i]);  }
             
             vector<string> names = ct.getNamesOfSeqs(Groups); //names of sequences in groups
-            vector<intPair> allNames;
+            vector<int> abunds; long long numReads = 0; //reads of names[j] in Groups[i] are abunds[j*Groups.size()+i]
             for (int j = 0; j < names.size(); j++) {
                 
                 if (m->getControl_pressed()) { return sampledCt; }
                 
                 for (int i = 0; i < Groups.size(); i++) {
                     int num = ct.getGroupCount(names[j], Groups[i]); //num reads in this group from this seq
-                    intPair thisSeq(j,i);
-                    for (int k = 0; k < num; k++) { allNames.push_back(thisSeq); }
+                    abunds.push_back(num); numReads += num;
                 }
             }
             
-            if (allNames.size() < size) { m->mothurOut("[ERROR]: You have selected a size that is larger than the number of sequences.\n"); m->setControl_pressed(true); }
+            if (numReads < size) { m->mothurOut("[ERROR]: You have selected a size that is larger than the number of sequences.\n"); m->setControl_pressed(true); }
             else{
-                long long allNamesSize = allNames.size()-1;
+                vector<int> counts = getSampleCountsWithReplacement(abunds, size);
                 
-                for (int j = 0; j < size; j++) {
-                    
+                for (int j = 0; j < names.size(); j++) {
+                        
                     if (m->getControl_pressed()) { return sampledCt; }
                     
-                    long long randomRead = util.getRandomIndex(allNamesSize);
-                    
-                    map<string, vector<int> >::iterator it = tempCount.find(names[allNames[randomRead].abund]);
-                    
-                    if (it == tempCount.end()) { //we have not seen this sequence at all yet
-                        vector<int> tempGroups; tempGroups.resize(Groups.size(), 0);
-                        tempGroups[allNames[randomRead].group]++;
-                        tempCount[names[allNames[randomRead].abund]] = tempGroups;
-                    }else{
-                        tempCount[names[allNames[randomRead].abund]][allNames[randomRead].group]++;
-                    }
+                    vector<int> tempGroups(counts.begin()+(j*Groups.size()), counts.begin()+((j+1)*Groups.size()));
+                    if (util.sum(tempGroups) != 0) { tempCount[names[j]] = tempGroups; }
                 }
             }
             
@@ -885,34 +1004,21 @@ CountTable SubSample::getSampleWithReplacement(CountTable& ct, int size, vector<
             
         }else { //no groups
             vector<string> names = ct.getNamesOfSeqs();
-            map<int, int> nameMap;
-            vector<int> allNames;
+            vector<int> abunds; long long numReads = 0;
             
             for (int i = 0; i < names.size(); i++) {
                 int num = ct.getNumSeqs(names[i]);
-                for (int j = 0; j < num; j++) { allNames.push_back(i); }
+                abunds.push_back(num); numReads += num;
             }
             
-            if (allNames.size() < size) { m->mothurOut("[ERROR]: You have selected a size that is larger than the number of sequences.\n"); m->setControl_pressed(true); return sampledCt; }
+            if (numReads < size) { m->mothurOut("[ERROR]: You have selected a size that is larger than the number of sequences.\n"); m->setControl_pressed(true); return sampledCt; }
             else {
-                long long allNamesSize = allNames.size()-1;
-                
-                for (int j = 0; j < size; j++) {
-                    if (m->getControl_pressed()) { return sampledCt; }
-                    
-                    long long randomRead = util.getRandomIndex(allNamesSize);
-                    
-                    map<int, int>::iterator it = nameMap.find(allNames[randomRead]);
-                    
-                    //we have not seen this sequence at all yet
-                    if (it == nameMap.end()) { nameMap[allNames[randomRead]] = 1;  }
-                    else{  nameMap[allNames[randomRead]]++;  }
-                }
+                vector<int> counts = getSampleCountsWithReplacement(abunds, size);
                 
                 //build count table
-                for (map<int, int>::iterator it = nameMap.begin(); it != nameMap.end();) {
-                    sampledCt.push_back(names[it->first], it->second);
-                    nameMap.erase(it++);
+                for (int j = 0; j < counts.size(); j++) {
+                    if (m->getControl_pressed()) { return sampledCt; }
+                    if (counts[j] != 0) { sampledCt.push_back(names[j], counts[j]); }
                 }
             }
         }
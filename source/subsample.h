@@ -51,10 +51,15 @@ class SubSample {
     
         set<long long> getWeightedSample(map<long long, long long>&, long long); //map of sequence names -> weight (could be abundance or some other measure), num to sample
     
+        vector<int> getSampleCounts(vector<int>&, long long); //abunds, size. returns the number of each bin's reads in a subsample of size reads, without replacement
+        vector<int> getSampleCountsWithReplacement(vector<int>&, long long); //abunds, size. returns the number of times each bin is drawn in size draws, with replacement
+    
     private:
     
         MothurOut* m;
         Utils util;
+        long long getHypergeometric(long long, long long, long long); //good, bad, sample
+        long long getBinomial(long long, double); //trials, probability
         map<string, string> deconvolute(map<string, string> wholeSet, vector<string>& subsampleWanted); //returns new nameMap containing only subsampled names, and removes redundants from subsampled wanted because it makes the new nameMap.
         GroupMap getSample(GroupMap&, int, vector<string> groupsWanted);
         CountTable getSample(CountTable&, int, vector<string>); //subsample a countTable bygroup(same number sampled from each group), returns subsampled countTable
@@ -91,6 +91,12 @@ int TrimOligos::preProcess(int p, int b, int l, int s, int rd, map<string, int>
             }
         }
         
+        vector<string> barcodeOligos, primerOligos;
+        for(map<string,int>::iterator it=barcodes.begin();it!=barcodes.end();it++){ barcodeOligos.push_back(it->first); }
+        for(it=primers.begin();it!=primers.end();it++){ primerOligos.push_back(it->first); }
+        barcodeMatcher.setOligos(barcodeOligos);
+        primerMatcher.setOligos(primerOligos);
+        
         return 0;
     }
     catch(exception& e) {
@@ -164,6 +170,11 @@ int TrimOligos::preProcess(int p, int b, int l, int s, map<int, oligosPair> pr,
         
         ipbarcodes = br;
         ipprimers = pr;
+        
+        setPairedMatchers(ifbarcodes, fBarcodeMatcher, nullptr);
+        setPairedMatchers(irbarcodes, rBarcodeMatcher, &reversedRBarcodeMatcher);
+        setPairedMatchers(ifprimers, fPrimerMatcher, nullptr);
+        setPairedMatchers(irprimers, rPrimerMatcher, &reversedRPrimerMatcher);
 
         return 0;
     }
@@ -412,13 +423,18 @@ vector<int> TrimOligos::stripBarcode(Sequence& seq, QualityScores& qual, int& gr
         if (barcodes.size() == 0) { return success;  }
         
         //can you find the barcode
+        int exactIndex;
+        bool exactChecked = barcodeMatcher.findExact(rawSequence, exactIndex);
+        int oligoIndex = -1;
         for(map<string,int>::iterator it=barcodes.begin();it!=barcodes.end();it++){
+            oligoIndex++;
             string oligo = it->first;
             if(rawSequence.length() < oligo.length()){	//let's just assume that the barcodes are the same length
                 success[0] = rawSequence.length();
                 success[1] = bdiffs + 1000;	//if the sequence is shorter than the barcode then bail out
                 break;
             }
+            if (exactChecked && (oligoIndex != exactIndex)) { continue; } //only the oligo the hash found can match
             
             if(compareDNASeq(oligo, rawSequence.substr(0,oligo.length()))){
                 group = it->second;
@@ -445,7 +461,10 @@ vector<int> TrimOligos::stripBarcode(Sequence& seq, QualityScores& qual, int& gr
             int minGroup = -1;
             int minPos = 0;
             
+            oligoAlignments barcodeAlns; alignOligos(barcodeMatcher, rawSequence, bdiffs, alignment, barcodeAlns);
+            oligoIndex = -1;
             for(map<string,int>::iterator it=barcodes.begin();it!=barcodes.end();it++){
+                oligoIndex++;
                 string oligo = it->first;
                 // int length = oligo.length();
                 
@@ -455,10 +474,9 @@ vector<int> TrimOligos::stripBarcode(Sequence& seq, QualityScores& qual, int& gr
                     break;
                 }
                 
-                //use needleman to align first barcode.length()+numdiffs of sequence to each barcode
-                alignment->alignPrimer(oligo, rawSequence.substr(0,oligo.length()+bdiffs));
-                oligo = alignment->getSeqAAln();
-                string temp = alignment->getSeqBAln();
+                //needleman alignment of the first barcode.length()+numdiffs of sequence to the barcode, done by alignOligos
+                string temp;
+                if (!barcodeAlns.getAlignment(oligoIndex, oligo, temp)) { continue; } //can not beat the best match
                 
                 int alnLength = oligo.length();
                 
@@ -590,7 +608,10 @@ vector<int> TrimOligos::stripBarcode(Sequence& forwardSeq, Sequence& reverseSeq,
              but if best match forward = 4, and reverse = 1, we want to count as a valid match because forward 1 and forward 4 are the same. so both barcodes map to same group.
              */
             
+            oligoAlignments fBarcodeAlns; alignOligos(fBarcodeMatcher, rawFSequence, bdiffs, alignment, fBarcodeAlns);
+            int oligoIndex = -1;
             for(map<string, vector<int> >::iterator it=ifbarcodes.begin();it!=ifbarcodes.end();it++){
+                oligoIndex++;
                 string oligo = it->first;
                 
                 if(rawFSequence.length() < maxFBarcodeLength){	//let's just assume that the barcodes are the same length
@@ -601,10 +622,9 @@ vector<int> TrimOligos::stripBarcode(Sequence& forwardSeq, Sequence& reverseSeq,
                 
                 if (oligo != "NONE") {
                     
-                    //use needleman to align first barcode.length()+numdiffs of sequence to each barcode
-                    alignment->alignPrimer(oligo, rawFSequence.substr(0,oligo.length()+bdiffs));
-                    oligo = alignment->getSeqAAln();
-                    string temp = alignment->getSeqBAln();
+                    //needleman alignment of the first barcode.length()+numdiffs of sequence to the barcode, done by alignOligos
+                    string temp;
+                    if (!fBarcodeAlns.getAlignment(oligoIndex, oligo, temp)) { continue; } //can not beat the best match
                     
                     int alnLength = oligo.length();
                     
@@ -663,7 +683,10 @@ vector<int> TrimOligos::stripBarcode(Sequence& forwardSeq, Sequence& reverseSeq,
                 vector< vector<int> > minRGroup;
                 vector<int> minRPos;
                 
+                oligoAlignments rBarcodeAlns; alignOligos(rBarcodeMatcher, rawRSequence, bdiffs, alignment, rBarcodeAlns);
+                int rOligoIndex = -1;
                 for(map<string, vector<int> >::iterator it=irbarcodes.begin();it!=irbarcodes.end();it++){
+                    rOligoIndex++;
                     string oligo = it->first;
                     
                     if(rawRSequence.length() < maxRBarcodeLength){	//let's just assume that the barcodes are the same length
@@ -673,10 +696,9 @@ vector<int> TrimOligos::stripBarcode(Sequence& forwardSeq, Sequence& reverseSeq,
                     }
                     
                     if (oligo != "NONE") {
-                        //use needleman to align first barcode.length()+numdiffs of sequence to each barcode
-                        alignment->alignPrimer(oligo, rawRSequence.substr(0,oligo.length()+bdiffs));
-                        oligo = alignment->getSeqAAln();
-                        string temp = alignment->getSeqBAln();
+                        //needleman alignment of the first barcode.length()+numdiffs of sequence to the barcode, done by alignOligos
+                        string temp;
+                        if (!rBarcodeAlns.getAlignment(rOligoIndex, oligo, temp)) { continue; } //can not beat the best match
                         
                         int alnLength = oligo.length();
                         for(int i=oligo.length()-1;i>=0;i--){ if(oligo[i] != '-'){	alnLength = i+1;	break;	} }
@@ -839,7 +861,10 @@ vector<int> TrimOligos::stripIndexBarcode(Sequence& forwardSeq, Sequence& revers
              reverse = Westcott, Schloss, Brown, Moore
              but if best match forward = 4, and reverse = 1, we want to count as a valid match because forward 1 and forward 4 are the same. so both barcodes map to same group.
              */
+            oligoAlignments fBarcodeAlns; alignOligos(fBarcodeMatcher, rawFSequence, bdiffs, alignment, fBarcodeAlns);
+            int oligoIndex = -1;
             for(map<string, vector<int> >::iterator it=ifbarcodes.begin();it!=ifbarcodes.end();it++){
+                oligoIndex++;
                 string oligo = it->first;
                 //cout << "trying forward oligos " << oligo << endl;
                 if (oligo != "NONE") {
@@ -850,10 +875,9 @@ vector<int> TrimOligos::stripIndexBarcode(Sequence& forwardSeq, Sequence& revers
                         break;
                     }
                     
-                    //use needleman to align first barcode.length()+numdiffs of sequence to each barcode
-                    alignment->alignPrimer(oligo, rawFSequence.substr(0,oligo.length()+bdiffs));
-                    oligo = alignment->getSeqAAln();
-                    string temp = alignment->getSeqBAln();
+                    //needleman alignment of the first barcode.length()+numdiffs of sequence to the barcode, done by alignOligos
+                    string temp;
+                    if (!fBarcodeAlns.getAlignment(oligoIndex, oligo, temp)) { continue; } //can not beat the best match
                     
                     int alnLength = oligo.length();
                     
@@ -916,7 +940,10 @@ vector<int> TrimOligos::stripIndexBarcode(Sequence& forwardSeq, Sequence& revers
                 vector< vector<int> > minRGroup;
                 vector<int> minRPos;
                 
+                oligoAlignments rBarcodeAlns; alignOligos(rBarcodeMatcher, rawRSequence, bdiffs, alignment, rBarcodeAlns);
+                int rOligoIndex = -1;
                 for(map<string, vector<int> >::iterator it=irbarcodes.begin();it!=irbarcodes.end();it++){
+                    rOligoIndex++;
                     string oligo = it->first;
                     //cout << "trying reverse oligos " << oligo << endl;
                     if (oligo != "NONE") {
@@ -927,10 +954,9 @@ vector<int> TrimOligos::stripIndexBarcode(Sequence& forwardSeq, Sequence& revers
                             break;
                         }
                         
-                        //use needleman to align first barcode.length()+numdiffs of sequence to each barcode
-                        alignment->alignPrimer(oligo, rawRSequence.substr(0,oligo.length()+bdiffs));
-                        oligo = alignment->getSeqAAln();
-                        string temp = alignment->getSeqBAln();
+                        //needleman alignment of the first barcode.length()+numdiffs of sequence to the barcode, done by alignOligos
+                        string temp;
+                        if (!rBarcodeAlns.getAlignment(rOligoIndex, oligo, temp)) { continue; } //can not beat the best match
                         //cout << oligo <<endl;
                         //cout << temp << endl;
                         int alnLength = oligo.length();
@@ -1108,7 +1134,10 @@ vector<int> TrimOligos::stripBarcode(Sequence& forwardSeq, Sequence& reverseSeq,
              reverse = Westcott, Schloss, Brown, Moore
              but if best match forward = 4, and reverse = 1, we want to count as a valid match because forward 1 and forward 4 are the same. so both barcodes map to same group.
              */
+            oligoAlignments fBarcodeAlns; alignOligos(fBarcodeMatcher, rawFSequence, bdiffs, alignment, fBarcodeAlns);
+            int oligoIndex = -1;
             for(map<string, vector<int> >::iterator it=ifbarcodes.begin();it!=ifbarcodes.end();it++){
+                oligoIndex++;
                 string oligo = it->first;
                 
                 if (oligo != "NONE") {
@@ -1119,10 +1148,9 @@ vector<int> TrimOligos::stripBarcode(Sequence& forwardSeq, Sequence& reverseSeq,
                         break;
                     }
                     
-                    //use needleman to align first barcode.length()+numdiffs of sequence to each barcode
-                    alignment->alignPrimer(oligo, rawFSequence.substr(0,oligo.length()+bdiffs));
-                    oligo = alignment->getSeqAAln();
-                    string temp = alignment->getSeqBAln();
+                    //needleman alignment of the first barcode.length()+numdiffs of sequence to the barcode, done by alignOligos
+                    string temp;
+                    if (!fBarcodeAlns.getAlignment(oligoIndex, oligo, temp)) { continue; } //can not beat the best match
                     
                     int alnLength = oligo.length();
                     
@@ -1185,7 +1213,10 @@ vector<int> TrimOligos::stripBarcode(Sequence& forwardSeq, Sequence& reverseSeq,
                 vector< vector<int> > minRGroup;
                 vector<int> minRPos;
                 
+                oligoAlignments rBarcodeAlns; alignOligos(rBarcodeMatcher, rawRSequence, bdiffs, alignment, rBarcodeAlns);
+                int rOligoIndex = -1;
                 for(map<string, vector<int> >::iterator it=irbarcodes.begin();it!=irbarcodes.end();it++){
+                    rOligoIndex++;
                     string oligo = it->first;
                     
                     if (oligo != "NONE") {
@@ -1196,10 +1227,9 @@ vector<int> TrimOligos::stripBarcode(Sequence& forwardSeq, Sequence& reverseSeq,
                             break;
                         }
                         
-                        //use needleman to align first barcode.length()+numdiffs of sequence to each barcode
-                        alignment->alignPrimer(oligo, rawRSequence.substr(0,oligo.length()+bdiffs));
-                        oligo = alignment->getSeqAAln();
-                        string temp = alignment->getSeqBAln();
+                        //needleman alignment of the first barcode.length()+numdiffs of sequence to the barcode, done by alignOligos
+                        string temp;
+                        if (!rBarcodeAlns.getAlignment(rOligoIndex, oligo, temp)) { continue; } //can not beat the best match
                         //cout << oligo <<endl;
                         //cout << temp << endl;
                         int alnLength = oligo.length();
@@ -1386,7 +1416,10 @@ vector<int> TrimOligos::stripPairedBarcode(Sequence& seq, QualityScores& qual, i
              but if best match forward = 4, and reverse = 1, we want to count as a valid match because forward 1 and forward 4 are the same. so both barcodes map to same group.
              */
             
+            oligoAlignments fBarcodeAlns; alignOligos(fBarcodeMatcher, rawSeq, bdiffs, alignment, fBarcodeAlns);
+            int oligoIndex = -1;
             for(map<string, vector<int> >::iterator it=ifbarcodes.begin();it!=ifbarcodes.end();it++){
+                oligoIndex++;
                 string oligo = it->first;
 
                 if (oligo != "NONE") {
@@ -1396,10 +1429,9 @@ vector<int> TrimOligos::stripPairedBarcode(Sequence& seq, QualityScores& qual, i
                         break;
                     }
                     
-                    //use needleman to align first barcode.length()+numdiffs of sequence to each barcode
-                    alignment->alignPrimer(oligo, rawSeq.substr(0,oligo.length()+bdiffs));
-                    oligo = alignment->getSeqAAln();
-                    string temp = alignment->getSeqBAln();
+                    //needleman alignment of the first barcode.length()+numdiffs of sequence to the barcode, done by alignOligos
+                    string temp;
+                    if (!fBarcodeAlns.getAlignment(oligoIndex, oligo, temp)) { continue; } //can not beat the best match
                     
                     int alnLength = oligo.length();
                     
@@ -1459,7 +1491,10 @@ vector<int> TrimOligos::stripPairedBarcode(Sequence& seq, QualityScores& qual, i
                 
                 string rawRSequence = reverseOligo(seq.getUnaligned());
                 
+                oligoAlignments reversedRBarcodeAlns; alignOligos(reversedRBarcodeMatcher, rawRSequence, bdiffs, alignment, reversedRBarcodeAlns);
+                int rOligoIndex = -1;
                 for(map<string, vector<int> >::iterator it=irbarcodes.begin();it!=irbarcodes.end();it++){
+                    rOligoIndex++;
                     string oligo = it->first;
                     if (oligo != "NONE") { oligo = reverseOligo(oligo); }
                     
@@ -1471,10 +1506,9 @@ vector<int> TrimOligos::stripPairedBarcode(Sequence& seq, QualityScores& qual, i
                             break;
                         }
                         
-                        //use needleman to align first barcode.length()+numdiffs of sequence to each barcode
-                        alignment->alignPrimer(oligo, rawRSequence.substr(0,oligo.length()+bdiffs));
-                        oligo = alignment->getSeqAAln();
-                        string temp = alignment->getSeqBAln();
+                        //needleman alignment of the first barcode.length()+numdiffs of sequence to the barcode, done by alignOligos
+                        string temp;
+                        if (!reversedRBarcodeAlns.getAlignment(rOligoIndex, oligo, temp)) { continue; } //can not beat the best match
                         
                         int alnLength = oligo.length();
                         for(int i=oligo.length()-1;i>=0;i--){ if(oligo[i] != '-'){	alnLength = i+1;	break;	} }
@@ -1663,7 +1697,10 @@ vector<int> TrimOligos::stripPairedPrimers(Sequence& seq, QualityScores& qual, i
              but if best match forward = 4, and reverse = 1, we want to count as a valid match because forward 1 and forward 4 are the same. so both barcodes map to same group.
              */
             
+            oligoAlignments fPrimerAlns; alignOligos(fPrimerMatcher, rawSeq, pdiffs, alignment, fPrimerAlns);
+            int oligoIndex = -1;
             for(map<string, vector<int> >::iterator it=ifprimers.begin();it!=ifprimers.end();it++){
+                oligoIndex++;
                 string oligo = it->first;
                 
                 if(rawSeq.length() < maxFPrimerLength){	//let's just assume that the barcodes are the same length
@@ -1673,10 +1710,9 @@ vector<int> TrimOligos::stripPairedPrimers(Sequence& seq, QualityScores& qual, i
                 }
                 
                 if (oligo != "NONE") {
-                    //use needleman to align first barcode.length()+numdiffs of sequence to each barcode
-                    alignment->alignPrimer(oligo, rawSeq.substr(0,oligo.length()+pdiffs));
-                    oligo = alignment->getSeqAAln();
-                    string temp = alignment->getSeqBAln();
+                    //needleman alignment of the first barcode.length()+numdiffs of sequence to the barcode, done by alignOligos
+                    string temp;
+                    if (!fPrimerAlns.getAlignment(oligoIndex, oligo, temp)) { continue; } //can not beat the best match
                     
                     int alnLength = oligo.length();
                     
@@ -1738,7 +1774,10 @@ vector<int> TrimOligos::stripPairedPrimers(Sequence& seq, QualityScores& qual, i
                 
                 string rawRSequence = reverseOligo(seq.getUnaligned());
                 
+                oligoAlignments reversedRPrimerAlns; alignOligos(reversedRPrimerMatcher, rawRSequence, pdiffs, alignment, reversedRPrimerAlns);
+                int rOligoIndex = -1;
                 for(map<string, vector<int> >::iterator it=irprimers.begin();it!=irprimers.end();it++){
+                    rOligoIndex++;
                     string oligo = it->first;
                     if (oligo != "NONE") { oligo = reverseOligo(oligo); }
                     
@@ -1749,10 +1788,9 @@ vector<int> TrimOligos::stripPairedPrimers(Sequence& seq, QualityScores& qual, i
                     }
                     
                     if (oligo != "NONE") {
-                        //use needleman to align first barcode.length()+numdiffs of sequence to each barcode
-                        alignment->alignPrimer(oligo, rawRSequence.substr(0,oligo.length()+pdiffs));
-                        oligo = alignment->getSeqAAln();
-                        string temp = alignment->getSeqBAln();
+                        //needleman alignment of the first barcode.length()+numdiffs of sequence to the barcode, done by alignOligos
+                        string temp;
+                        if (!reversedRPrimerAlns.getAlignment(rOligoIndex, oligo, temp)) { continue; } //can not beat the best match
                         
                         int alnLength = oligo.length();
                         for(int i=oligo.length()-1;i>=0;i--){ if(oligo[i] != '-'){	alnLength = i+1;	break;	} }
@@ -1927,7 +1965,10 @@ vector<int> TrimOligos::stripForward(Sequence& forwardSeq, Sequence& reverseSeq,
              but if best match forward = 4, and reverse = 1, we want to count as a valid match because forward 1 and forward 4 are the same. so both barcodes map to same group.
              */
             
+            oligoAlignments fPrimerAlns; alignOligos(fPrimerMatcher, rawFSequence, pdiffs, alignment, fPrimerAlns);
+            int oligoIndex = -1;
             for(map<string, vector<int> >::iterator it=ifprimers.begin();it!=ifprimers.end();it++){
+                oligoIndex++;
                 string oligo = it->first;
                 
                 if(rawFSequence.length() < maxFPrimerLength){	//let's just assume that the barcodes are the same length
@@ -1937,10 +1978,9 @@ vector<int> TrimOligos::stripForward(Sequence& forwardSeq, Sequence& reverseSeq,
                 }
                 
                 if (oligo != "NONE") {
-                    //use needleman to align first barcode.length()+numdiffs of sequence to each barcode
-                    alignment->alignPrimer(oligo, rawFSequence.substr(0,oligo.length()+pdiffs));
-                    oligo = alignment->getSeqAAln();
-                    string temp = alignment->getSeqBAln();
+                    //needleman alignment of the first barcode.length()+numdiffs of sequence to the barcode, done by alignOligos
+                    string temp;
+                    if (!fPrimerAlns.getAlignment(oligoIndex, oligo, temp)) { continue; } //can not beat the best match
                     
                     int alnLength = oligo.length();
                     
@@ -1999,7 +2039,10 @@ vector<int> TrimOligos::stripForward(Sequence& forwardSeq, Sequence& reverseSeq,
                 vector< vector<int> > minRGroup;
                 vector<int> minRPos;
                 
+                oligoAlignments rPrimerAlns; alignOligos(rPrimerMatcher, rawRSequence, pdiffs, alignment, rPrimerAlns);
+                int rOligoIndex = -1;
                 for(map<string, vector<int> >::iterator it=irprimers.begin();it!=irprimers.end();it++){
+                    rOligoIndex++;
                     string oligo = it->first;
                     
                     if(rawRSequence.length() < maxRPrimerLength){	//let's just assume that the barcodes are the same length
@@ -2009,10 +2052,9 @@ vector<int> TrimOligos::stripForward(Sequence& forwardSeq, Sequence& reverseSeq,
                     }
                     
                     if (oligo != "NONE") {
-                        //use needleman to align first barcode.length()+numdiffs of sequence to each barcode
-                        alignment->alignPrimer(oligo, rawRSequence.substr(0,oligo.length()+pdiffs));
-                        oligo = alignment->getSeqAAln();
-                        string temp = alignment->getSeqBAln();
+                        //needleman alignment of the first barcode.length()+numdiffs of sequence to the barcode, done by alignOligos
+                        string temp;
+                        if (!rPrimerAlns.getAlignment(rOligoIndex, oligo, temp)) { continue; } //can not beat the best match
                         
                         int alnLength = oligo.length();
                         for(int i=oligo.length()-1;i>=0;i--){ if(oligo[i] != '-'){	alnLength = i+1;	break;	} }
@@ -2176,7 +2218,10 @@ vector<int> TrimOligos::stripForward(Sequence& forwardSeq, Sequence& reverseSeq,
              but if best match forward = 4, and reverse = 1, we want to count as a valid match because forward 1 and forward 4 are the same. so both barcodes map to same group.
              */
             
+            oligoAlignments fPrimerAlns; alignOligos(fPrimerMatcher, rawFSequence, pdiffs, alignment, fPrimerAlns);
+            int oligoIndex = -1;
             for(map<string, vector<int> >::iterator it=ifprimers.begin();it!=ifprimers.end();it++){
+                oligoIndex++;
                 string oligo = it->first;
                 
                 if(rawFSequence.length() < maxFPrimerLength){	//let's just assume that the barcodes are the same length
@@ -2186,10 +2231,9 @@ vector<int> TrimOligos::stripForward(Sequence& forwardSeq, Sequence& reverseSeq,
                 }
                 
                 if (oligo != "NONE") {
-                    //use needleman to align first barcode.length()+numdiffs of sequence to each barcode
-                    alignment->alignPrimer(oligo, rawFSequence.substr(0,oligo.length()+pdiffs));
-                    oligo = alignment->getSeqAAln();
-                    string temp = alignment->getSeqBAln();
+                    //needleman alignment of the first barcode.length()+numdiffs of sequence to the barcode, done by alignOligos
+                    string temp;
+                    if (!fPrimerAlns.getAlignment(oligoIndex, oligo, temp)) { continue; } //can not beat the best match
                     
                     int alnLength = oligo.length();
                     
@@ -2248,7 +2292,10 @@ vector<int> TrimOligos::stripForward(Sequence& forwardSeq, Sequence& reverseSeq,
                 vector< vector<int> > minRGroup;
                 vector<int> minRPos;
                 
+                oligoAlignments rPrimerAlns; alignOligos(rPrimerMatcher, rawRSequence, pdiffs, alignment, rPrimerAlns);
+                int rOligoIndex = -1;
                 for(map<string, vector<int> >::iterator it=irprimers.begin();it!=irprimers.end();it++){
+                    rOligoIndex++;
                     string oligo = it->first;
                     
                     if(rawRSequence.length() < maxRPrimerLength){	//let's just assume that the barcodes are the same length
@@ -2258,10 +2305,9 @@ vector<int> TrimOligos::stripForward(Sequence& forwardSeq, Sequence& reverseSeq,
                     }
                     
                     if (oligo != "NONE") {
-                        //use needleman to align first barcode.length()+numdiffs of sequence to each barcode
-                        alignment->alignPrimer(oligo, rawRSequence.substr(0,oligo.length()+pdiffs));
-                        oligo = alignment->getSeqAAln();
-                        string temp = alignment->getSeqBAln();
+                        //needleman alignment of the first barcode.length()+numdiffs of sequence to the barcode, done by alignOligos
+                        string temp;
+                        if (!rPrimerAlns.getAlignment(rOligoIndex, oligo, temp)) { continue; } //can not beat the best match
                         
                         int alnLength = oligo.length();
                         for(int i=oligo.length()-1;i>=0;i--){ if(oligo[i] != '-'){	alnLength = i+1;	break;	} }
@@ -2358,13 +2404,18 @@ vector<int> TrimOligos::stripBarcode(Sequence& seq, int& group){
         success.push_back(MOTHURMAX);
         
         //can you find the barcode
+        int exactIndex;
+        bool exactChecked = barcodeMatcher.findExact(rawSequence, exactIndex);
+        int oligoIndex = -1;
         for(map<string,int>::iterator it=barcodes.begin();it!=barcodes.end();it++){
+            oligoIndex++;
             string oligo = it->first;
             if(rawSequence.length() < oligo.length()){	//let's just assume that the barcodes are the same length
                 success[0] = rawSequence.length();
                 success[1] = bdiffs + 1000;
                 break;
             }
+            if (exactChecked && (oligoIndex != exactIndex)) { continue; } //only the oligo the hash found can match
             
             if(compareDNASeq(oligo, rawSequence.substr(0,oligo.length()))){
                 group = it->second;
@@ -2388,7 +2439,10 @@ vector<int> TrimOligos::stripBarcode(Sequence& seq, int& group){
             int minGroup = -1;
             int minPos = 0;
             
+            oligoAlignments barcodeAlns; alignOligos(barcodeMatcher, rawSequence, bdiffs, alignment, barcodeAlns);
+            oligoIndex = -1;
             for(map<string,int>::iterator it=barcodes.begin();it!=barcodes.end();it++){
+                oligoIndex++;
                 string oligo = it->first;
                 // int length = oligo.length();
                 
@@ -2398,10 +2452,9 @@ vector<int> TrimOligos::stripBarcode(Sequence& seq, int& group){
                     break;
                 }
                 
-                //use needleman to align first barcode.length()+numdiffs of sequence to each barcode
-                alignment->alignPrimer(oligo, rawSequence.substr(0,oligo.length()+bdiffs));
-                oligo = alignment->getSeqAAln();
-                string temp = alignment->getSeqBAln();
+                //needleman alignment of the first barcode.length()+numdiffs of sequence to the barcode, done by alignOligos
+                string temp;
+                if (!barcodeAlns.getAlignment(oligoIndex, oligo, temp)) { continue; } //can not beat the best match
                 
                 int alnLength = oligo.length();
                 
@@ -2463,13 +2516,18 @@ vector<int> TrimOligos::stripForward(Sequence& seq, int& group){
         success.push_back(MOTHURMAX);
         
         //can you find the primer
+        int exactIndex;
+        bool exactChecked = primerMatcher.findExact(rawSequence, exactIndex);
+        int oligoIndex = -1;
         for(map<string,int>::iterator it=primers.begin();it!=primers.end();it++){
+            oligoIndex++;
             string oligo = it->first;
             if(rawSequence.length() < oligo.length()){	//let's just assume that the primers are the same length
                 success[0] = rawSequence.length();
                 success[1] = pdiffs + 1000;
                 break;
             }
+            if (exactChecked && (oligoIndex != exactIndex)) { continue; } //only the oligo the hash found can match
             
             if(compareDNASeq(oligo, rawSequence.substr(0,oligo.length()))){
                 group = it->second;
@@ -2493,7 +2551,10 @@ vector<int> TrimOligos::stripForward(Sequence& seq, int& group){
             int minGroup = -1;
             int minPos = 0;
             
+            oligoAlignments primerAlns; alignOligos(primerMatcher, rawSequence, pdiffs, alignment, primerAlns);
+            oligoIndex = -1;
             for(map<string,int>::iterator it=primers.begin();it!=primers.end();it++){
+                oligoIndex++;
                 string oligo = it->first;
                 // int length = oligo.length();
                 
@@ -2503,10 +2564,9 @@ vector<int> TrimOligos::stripForward(Sequence& seq, int& group){
                     break;
                 }
                 
-                //use needleman to align first barcode.length()+numdiffs of sequence to each barcode
-                alignment->alignPrimer(oligo, rawSequence.substr(0,oligo.length()+pdiffs));
-                oligo = alignment->getSeqAAln();
-                string temp = alignment->getSeqBAln();
+                //needleman alignment of the first barcode.length()+numdiffs of sequence to the barcode, done by alignOligos
+                string temp;
+                if (!primerAlns.getAlignment(oligoIndex, oligo, temp)) { continue; } //can not beat the best match
                 
                 int alnLength = oligo.length();
                 
@@ -2571,13 +2631,18 @@ vector<int> TrimOligos::stripForward(Sequence& seq, QualityScores& qual, int& gr
         string rawSequence = seq.getUnaligned();
         
         //can you find the primer
+        int exactIndex;
+        bool exactChecked = primerMatcher.findExact(rawSequence, exactIndex);
+        int oligoIndex = -1;
         for(map<string,int>::iterator it=primers.begin();it!=primers.end();it++){
+            oligoIndex++;
             string oligo = it->first;
             if(rawSequence.length() < oligo.length()){	//let's just assume that the primers are the same length
                 success[0] = rawSequence.length();
                 success[1] = pdiffs + 1000;
                 break;
             }
+            if (exactChecked && (oligoIndex != exactIndex)) { continue; } //only the oligo the hash found can match
             
             if(compareDNASeq(oligo, rawSequence.substr(0,oligo.length()))){
                 group = it->second;
@@ -2604,7 +2669,10 @@ vector<int> TrimOligos::stripForward(Sequence& seq, QualityScores& qual, int& gr
             int minGroup = -1;
             int minPos = 0;
             
+            oligoAlignments primerAlns; alignOligos(primerMatcher, rawSequence, pdiffs, alignment, primerAlns);
+            oligoIndex = -1;
             for(map<string,int>::iterator it=primers.begin();it!=primers.end();it++){
+                oligoIndex++;
                 string oligo = it->first;
                 // int length = oligo.length();
                 
@@ -2614,10 +2682,9 @@ vector<int> TrimOligos::stripForward(Sequence& seq, QualityScores& qual, int& gr
                     break;
                 }
                 
-                //use needleman to align first barcode.length()+numdiffs of sequence to each barcode
-                alignment->alignPrimer(oligo, rawSequence.substr(0,oligo.length()+pdiffs));
-                oligo = alignment->getSeqAAln();
-                string temp = alignment->getSeqBAln();
+                //needleman alignment of the first barcode.length()+numdiffs of sequence to the barcode, done by alignOligos
+                string temp;
+                if (!primerAlns.getAlignment(oligoIndex, oligo, temp)) { continue; } //can not beat the best match
                 
                 int alnLength = oligo.length();
                 
@@ -3266,7 +3333,7 @@ int TrimOligos::stripSpacer(Sequence& seq){
 }
 
 //******************************************************************/
-bool TrimOligos::compareDNASeq(string oligo, string seq){
+bool TrimOligos::compareDNASeq(const string& oligo, const string& seq){
     try {
         bool success = true;
         int length = oligo.length();
@@ -3301,7 +3368,7 @@ bool TrimOligos::compareDNASeq(string oligo, string seq){
     
 }
 //********************************************************************/
-int TrimOligos::countDiffs(string oligo, string seq){
+int TrimOligos::countDiffs(const string& oligo, const string& seq){
     try {
         
         int length = oligo.length();
@@ -3334,6 +3401,76 @@ int TrimOligos::countDiffs(string oligo, string seq){
     }
 }
 //********************************************************************/
+//oligos in the order of the map, reversed is for the loops that search the reverse complement of the sequence
+void TrimOligos::setPairedMatchers(map<string, vector<int> >& oligos, OligoMatcher& matcher, OligoMatcher* reversed){
+    try {
+        vector<string> forwardOligos, reversedOligos;
+        for(map<string, vector<int> >::iterator it=oligos.begin();it!=oligos.end();it++){
+            forwardOligos.push_back(it->first);
+            if (it->first != "NONE") { reversedOligos.push_back(reverseOligo(it->first)); }
+            else { reversedOligos.push_back(it->first); }
+        }
+        
+        matcher.setOligos(forwardOligos);
+        if (reversed != nullptr) { reversed->setOligos(reversedOligos); }
+    }
+    catch(exception& e) {
+        m->errorOut(e, "TrimOligos", "setPairedMatchers");
+        exit(1);
+    }
+}
+//********************************************************************/
+//Aligns the start of seq to the oligos that could be the best match, the loops skip the rest. An oligo's numDiff is never
+//less than its bound from the matcher, so once the bound is more than the best numDiff found the oligo can not win or tie.
+void TrimOligos::alignOligos(const OligoMatcher& matcher, const string& seq, int diffs, Alignment* alignment, oligoAlignments& alns){
+    try {
+        int numOligos = matcher.size();
+        alns.oligoAlns.assign(numOligos, "");
+        alns.seqAlns.assign(numOligos, "");
+        
+        if (alignment == nullptr) { return; }
+        
+        vector<int> bounds;
+        matcher.getLowerBounds(seq, diffs, bounds);
+        
+        //in the loop's order, a "NONE" is a match with 0 diffs
+        vector<int> order;
+        if (!matcher.getHasNone()) {
+            vector< pair<int, int> > sorted;
+            for (int i = 0; i < numOligos; i++) { sorted.push_back(make_pair(bounds[i], i)); }
+            sort(sorted.begin(), sorted.end());
+            for (int i = 0; i < sorted.size(); i++) { order.push_back(sorted[i].second); }
+        }else { for (int i = 0; i < numOligos; i++) { order.push_back(i); } }
+        
+        int minDiff = MOTHURMAX;
+        for (int i = 0; i < order.size(); i++) {
+            int k = order[i];
+            const string& oligo = matcher.getOligo(k);
+            
+            if (oligo == "NONE")        { minDiff = 0; continue;    }
+            if (bounds[k] > minDiff)    {
+                if (matcher.getHasNone()) { continue; } //skipped in the loop's order, a later oligo could still beat it
+                break;
+            }
+            
+            alignment->alignPrimer(oligo, seq.substr(0,oligo.length()+diffs));
+            alns.oligoAlns[k] = alignment->getSeqAAln();
+            alns.seqAlns[k] = alignment->getSeqBAln();
+            
+            const string& oligoAln = alns.oligoAlns[k];
+            int alnLength = oligoAln.length();
+            for(int j=oligoAln.length()-1;j>=0;j--){ if(oligoAln[j] != '-'){	alnLength = j+1;	break;	} }
+            
+            int numDiff = countDiffs(oligoAln.substr(0,alnLength), alns.seqAlns[k].substr(0,alnLength));
+            if (numDiff < minDiff) { minDiff = numDiff; }
+        }
+    }
+    catch(exception& e) {
+        m->errorOut(e, "TrimOligos", "alignOligos");
+        exit(1);
+    }
+}
+//********************************************************************/
 string TrimOligos::reverseOligo(string oligo){
     try {
         string reverse = "";
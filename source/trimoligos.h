@@ -13,6 +13,8 @@
 #include "mothurout.h"
 #include "sequence.hpp"
 #include "qualityscores.h"
+#include "oligomatcher.hpp"
+#include "alignment.hpp"
 
 
 class TrimOligos {
@@ -77,11 +79,18 @@ class TrimOligos {
         map<int, oligosPair> ipprimers;
     
         int maxFBarcodeLength, maxRBarcodeLength, maxFPrimerLength, maxRPrimerLength, maxLinkerLength, maxSpacerLength;
+    
+        //the oligos in the order the search loops go through them, the reversed ones are for the paired loops that search the reverse complement of the sequence
+        OligoMatcher barcodeMatcher, primerMatcher;
+        OligoMatcher fBarcodeMatcher, rBarcodeMatcher, fPrimerMatcher, rPrimerMatcher;
+        OligoMatcher reversedRBarcodeMatcher, reversedRPrimerMatcher;
 	
 		MothurOut* m;
 	
-		bool compareDNASeq(string, string);				
-		int countDiffs(string, string);
+		bool compareDNASeq(const string&, const string&);
+		int countDiffs(const string&, const string&);
+        void alignOligos(const OligoMatcher&, const string&, int, Alignment*, oligoAlignments&);
+        void setPairedMatchers(map<string, vector<int> >&, OligoMatcher&, OligoMatcher*);
         
         vector<int> stripPairedBarcode(Sequence& seq, QualityScores& qual, int& group);
         vector<int> stripPairedPrimers(Sequence& seq, QualityScores& qual, int& group, bool);
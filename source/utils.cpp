@@ -15,6 +15,10 @@
 #include "sharedclrvectors.hpp"
 #include "sharedrabundfloatvectors.hpp"
 
+#ifndef NON_WINDOWS
+#include <sys/stat.h>
+#endif
+
 /***********************************************************************/
 string getLabelTag(string label){
     
@@ -6102,6 +6106,62 @@ int Utils::getTimeStamp(string filename) {
         exit(1);
     }
 }
+/***********************************************************************/
+//used to tell if a file has changed since a binary copy of it was made, an edited file will not match the old stamp
+bool Utils::getFileStamp(string filename, unsigned long long& size, long long& modified, unsigned long long& sample) {
+    try {
+        struct stat info;
+        if (stat(filename.c_str(), &info) != 0) { return false; }
+        size = info.st_size; modified = info.st_mtime;
+        
+        ifstream in(filename.c_str(), ios::binary);
+        if (!in) { return false; }
+        
+        vector<char> buffer(8192, '\0');
+        unsigned long long firstBytes = min(size, 4096ULL);
+        unsigned long long lastBytes = min(size - firstBytes, 4096ULL);
+        in.read(&buffer[0], firstBytes);
+        in.seekg(size - lastBytes);
+        in.read(&buffer[firstBytes], lastBytes);
+        if (!in) { return false; }
+        
+        //FNV-1a
+        sample = 14695981039346656037ULL;
+        for (unsigned long long i = 0; i < firstBytes + lastBytes; i++) { sample ^= (unsigned char)buffer[i]; sample *= 1099511628211ULL; }
+        sample ^= (sample >> 32);
+        
+        return true;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "Utils", "getFileStamp");
+        exit(1);
+    }
+}
+/***********************************************************************/
+//used to tell if a count table has changed since its binary copy was made, reads the whole file
+bool Utils::getFileChecksum(string filename, unsigned long long& size, unsigned long long& checksum) {
+    try {
+        ifstream in(filename.c_str(), ios::binary);
+        if (!in) { return false; }
+        
+        //FNV-1a
+        size = 0; checksum = 14695981039346656037ULL;
+        vector<char> buffer(1 << 20, '\0');
+        while (in) {
+            in.read(&buffer[0], buffer.size());
+            long long numRead = in.gcount();
+            for (long long i = 0; i < numRead; i++) { checksum ^= (unsigned char)buffer[i]; checksum *= 1099511628211ULL; }
+            size += numRead;
+        }
+        if (!in.eof()) { return false; }
+        
+        return true;
+    }
+    catch(exception& e) {
+        m->errorOut(e, "Utils", "getFileChecksum");
+        exit(1);
+    }
+}
 /**************************************************************************************************/
 //Referenced - https://genome.sph.umich.edu/w/images/d/d5/Biostat615-Fall2011-lecture03-handout.pdf
 double Utils::geometricMean(vector<float>& abunds, double zeroReplacementValue) {
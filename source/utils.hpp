@@ -99,6 +99,8 @@ public:
     string getRootName(string);
     string getSimpleName(string);
     int getTimeStamp(string filename);
+    bool getFileStamp(string, unsigned long long&, long long&, unsigned long long&); //size, modification time and a hash of the first and last 4k, false if the file can't be read
+    bool getFileChecksum(string, unsigned long long&, unsigned long long&); //size and a hash of the whole file, false if the file can't be read
     string hasPath(string);
     bool isBlank(string);
     int getAlignmentLength(string);
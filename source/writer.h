@@ -13,15 +13,25 @@
 
 /***********************************************************************/
 
+//collects one thread's output and commits it to the shared file in large pieces. The output is written by the time the writer is deleted or the file is closed.
 class OutputWriter {
 public:
 
-    OutputWriter (std::shared_ptr<SynchronizedOutputFile> s) : sf(s) {}
+    OutputWriter (std::shared_ptr<SynchronizedOutputFile> s) : sf(s) { chunk = sf->addWriter(-1); }
+    OutputWriter (std::shared_ptr<SynchronizedOutputFile> s, long long order) : sf(s) { chunk = sf->addWriter(order); } //output is written after the writers with smaller orders
+    ~OutputWriter() { sf->finish(chunk); }
     
-    void write (const string& dataToWrite) { sf->write(dataToWrite); }
+    void write (const string& dataToWrite) {
+        chunk->buffer += dataToWrite;
+        if (chunk->buffer.size() >= chunk->commitSize) { sf->commit(chunk); }
+    }
     
 private:
     std::shared_ptr<SynchronizedOutputFile> sf;
+    writerChunk* chunk;
+
+    OutputWriter(const OutputWriter&);
+    OutputWriter& operator=(const OutputWriter&);
 };
 /***********************************************************************/
 